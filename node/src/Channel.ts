@@ -10,6 +10,7 @@ import { Response } from './fbs/response';
 import { Message, Body as MessageBody } from './fbs/message';
 import {
 	Notification,
+	NotificationBatch,
 	Body as NotificationBody,
 	Event,
 } from './fbs/notification';
@@ -41,6 +42,12 @@ export class Channel extends EnhancedEventEmitter {
 	// Unix Socket instance for receiving messages to the worker process.
 	readonly #consumerSocket: Duplex;
 
+	// Whether messages written within the same tick must be written at once.
+	readonly #writeCoalescing: boolean;
+
+	// Whether the producer Socket is corked until next tick.
+	#corked = false;
+
 	// Next id for messages sent to the worker process.
 	#nextId = 0;
 
@@ -60,10 +67,12 @@ export class Channel extends EnhancedEventEmitter {
 		producerSocket,
 		consumerSocket,
 		pid,
+		writeCoalescing = false,
 	}: {
 		producerSocket: any;
 		consumerSocket: any;
 		pid: number;
+		writeCoalescing?: boolean;
 	}) {
 		super();
 
@@ -71,6 +80,7 @@ export class Channel extends EnhancedEventEmitter {
 
 		this.#producerSocket = producerSocket as Duplex;
 		this.#consumerSocket = consumerSocket as Duplex;
+		this.#writeCoalescing = writeCoalescing;
 
 		// Read Channel responses/notifications from the worker.
 		this.#consumerSocket.on('data', (buffer: Buffer) => {
@@ -145,6 +155,18 @@ export class Channel extends EnhancedEventEmitter {
 							break;
 						}
 
+						case MessageBody.NotificationBatch: {
+							const batch = new NotificationBatch();
+
+							message.data(batch);
+
+							for (let i = 0; i < batch.notificationsLength(); ++i) {
+								this.processNotification(batch.notifications(i)!);
+							}
+
+							break;
+						}
+
 						case MessageBody.Log: {
 							const log = new Log();
 
@@ -227,6 +249,15 @@ export class Channel extends EnhancedEventEmitter {
 		this.#producerSocket.removeAllListeners('error');
 		this.#producerSocket.on('error', () => {});
 
+		// Write coalesced messages (if any) before destroying the sockets.
+		if (this.#corked) {
+			this.#corked = false;
+
+			try {
+				this.#producerSocket.uncork();
+			} catch (error) {}
+		}
+
 		// Destroy the sockets.
 		try {
 			this.#producerSocket.destroy();
@@ -297,7 +328,7 @@ export class Channel extends EnhancedEventEmitter {
 
 		try {
 			// This may throw if closed or remote side ended.
-			this.#producerSocket.write(buffer, 'binary');
+			this.write(buffer);
 		} catch (error) {
 			logger.warn(`notify() | sending notification failed: ${error}`);
 
@@ -372,7 +403,7 @@ export class Channel extends EnhancedEventEmitter {
 		}
 
 		// This may throw if closed or remote side ended.
-		this.#producerSocket.write(buffer, 'binary');
+		this.write(buffer);
 
 		return new Promise((pResolve, pReject) => {
 			const sent: Sent = {
@@ -406,6 +437,26 @@ export class Channel extends EnhancedEventEmitter {
 		});
 	}
 
+	private write(buffer: Uint8Array): void {
+		// If coalescing, keep the Socket corked until next tick so all messages
+		// written meanwhile go to the worker in a single write.
+		if (this.#writeCoalescing && !this.#corked) {
+			this.#corked = true;
+			this.#producerSocket.cork();
+
+			process.nextTick(() => {
+				if (!this.#corked) {
+					return;
+				}
+
+				this.#corked = false;
+				this.#producerSocket.uncork();
+			});
+		}
+
+		this.#producerSocket.write(buffer, 'binary');
+	}
+
 	private processResponse(response: Response): void {
 		const sent = this.#sents.get(response.id());
 
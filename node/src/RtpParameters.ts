@@ -322,7 +322,8 @@ export type RtpHeaderExtensionUri =
 	| 'http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01'
 	| 'http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time'
 	| 'http://www.webrtc.org/experiments/rtp-hdrext/abs-capture-time'
-	| 'http://www.webrtc.org/experiments/rtp-hdrext/playout-delay';
+	| 'http://www.webrtc.org/experiments/rtp-hdrext/playout-delay'
+	| 'https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension';
 
 /**
  * Defines a RTP header extension within the RTP parameters. The list of RTP
@@ -758,6 +759,10 @@ export function rtpHeaderExtensionUriFromFbs(
 		case FbsRtpHeaderExtensionUri.PlayoutDelay: {
 			return 'http://www.webrtc.org/experiments/rtp-hdrext/playout-delay';
 		}
+
+		case FbsRtpHeaderExtensionUri.DependencyDescriptor: {
+			return 'https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension';
+		}
 	}
 }
 
@@ -813,6 +818,10 @@ export function rtpHeaderExtensionUriToFbs(
 			return FbsRtpHeaderExtensionUri.PlayoutDelay;
 		}
 
+		case 'https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension': {
+			return FbsRtpHeaderExtensionUri.DependencyDescriptor;
+		}
+
 		default: {
 			throw new TypeError(`invalid RtpHeaderExtensionUri: ${uri}`);
 		}
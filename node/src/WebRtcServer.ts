@@ -16,12 +16,49 @@ export type WebRtcServerOptions<WebRtcServerAppData extends AppData = AppData> =
 		 */
 		listenInfos: TransportListenInfo[];
 
+		/**
+		 * Shard of a WebRtcServer whose UDP port is shared by many Workers (Linux
+		 * only). See WebRtcServerShard.
+		 */
+		shard?: WebRtcServerShard;
+
 		/**
 		 * Custom application data.
 		 */
 		appData?: WebRtcServerAppData;
 	};
 
+/**
+ * Many Workers (up to 36) can listen on the same UDP port(s) if each of them
+ * creates a WebRtcServer with same UDP listenInfos (with a fixed port) and a
+ * different shard index. The kernel delivers each STUN request to the Worker
+ * whose shard index is encoded in the local ICE username fragment and, once
+ * ICE is connected, all packets of the tuple to that Worker.
+ *
+ * Shards can be created and closed in any order. The steering eBPF program
+ * requires CAP_BPF (or CAP_SYS_ADMIN). It steers the rest of packets by the
+ * ICE tuples each Worker adds to a map. Its maps are pinned in the BPF
+ * filesystem (/sys/fs/bpf) so Workers in different processes share them. The
+ * pins are removed when the last shard of the UDP port is closed.
+ * Without them, a classic BPF program steers STUN requests by the position of
+ * the shard in the SO_REUSEPORT group, which only matches its index while
+ * shards are created in index order and none but the last one is closed, and
+ * each ICE tuple gets a UDP socket connected to its remote address (so a file
+ * descriptor). TCP listenInfos are not shared so each shard must use a
+ * different TCP port.
+ */
+export type WebRtcServerShard = {
+	/**
+	 * Index of this shard (from 0 to count - 1).
+	 */
+	index: number;
+
+	/**
+	 * Number of shards.
+	 */
+	count: number;
+};
+
 /**
  * @deprecated Use TransportListenInfo instead.
  */
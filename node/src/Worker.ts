@@ -88,6 +88,51 @@ export type WorkerSettings<WorkerAppData extends AppData = AppData> = {
 	 */
 	disableLiburing?: boolean;
 
+	/**
+	 * Coalesce Channel messages written within the same event loop iteration
+	 * (or phase in the worker) into a single write on both sides of the Channel.
+	 * Default false.
+	 */
+	channelWriteCoalescing?: boolean;
+
+	/**
+	 * Batch notifications sent by the worker into a single Channel message.
+	 * If 0, notifications generated within the same event loop iteration are
+	 * batched. Otherwise it's the maximum time (in ms, up to 1000) a notification
+	 * can be delayed. Score notifications of the same entity within a batch are
+	 * coalesced into the latest one. Not set by default (no batching).
+	 */
+	notificationBatchWindow?: number;
+
+	/**
+	 * Number of extra threads (up to 16) used to SRTP encrypt the RTP packets
+	 * sent over UDP. Packets are encrypted by these threads and then sent by the
+	 * worker thread, keeping their order within each transport. Default 0
+	 * (packets are encrypted by the worker thread).
+	 */
+	srtpCryptoThreads?: number;
+
+	/**
+	 * Run the DTLS handshakes (key exchange and certificate signature and
+	 * verification) in a separate thread so many simultaneous handshakes don't
+	 * delay the media being forwarded by the worker. Default false.
+	 */
+	dtlsHandshakeOffload?: boolean;
+
+	/**
+	 * Path of a file in which the generated DTLS certificate and private key
+	 * are stored so they can be reused by workers started later (instead of
+	 * generating new ones) while not older than dtlsCertificateCacheMaxAge.
+	 * Cannot be used together with dtlsCertificateFile. Not set by default.
+	 */
+	dtlsCertificateCacheFile?: string;
+
+	/**
+	 * Max age (in seconds) of the DTLS certificate stored in
+	 * dtlsCertificateCacheFile. Default 2592000 (30 days).
+	 */
+	dtlsCertificateCacheMaxAge?: number;
+
 	/**
 	 * Custom application data.
 	 */
@@ -199,6 +244,42 @@ export type WorkerDump = {
 		sqeProcessCount: number;
 		sqeMissCount: number;
 		userDataMissCount: number;
+		recvEnabled: boolean;
+		recvCount: number;
+		recvBytes: number;
+		recvTruncatedCount: number;
+		recvBufferMissCount: number;
+		recvFileMissCount: number;
+		sqeMissRate: number;
+		userDataMissRate: number;
+		sendBuffers: number;
+		socketBackpressureCount: number;
+		highWatermarkSubmitCount: number;
+	};
+	rtpPacketBufferPool: {
+		capacity: number;
+		inUse: number;
+		highWaterMark: number;
+	};
+	channelNotifier: {
+		rawNotifications: number;
+		batchedNotifications: number;
+		coalescedNotifications: number;
+		batches: number;
+	};
+	srtpCryptoPool: {
+		threads: number;
+		protectedPackets: number;
+		inlinePackets: number;
+		failedPackets: number;
+		queueDepth: number;
+		maxQueueDepth: number;
+		avgLatencyNs: number;
+	};
+	startup: {
+		durationUs: number;
+		dtlsSetupDurationUs: number;
+		dtlsCertificateGenerated: boolean;
 	};
 };
 
@@ -293,6 +374,12 @@ export class Worker<
 		dtlsPrivateKeyFile,
 		libwebrtcFieldTrials,
 		disableLiburing,
+		channelWriteCoalescing,
+		notificationBatchWindow,
+		srtpCryptoThreads,
+		dtlsHandshakeOffload,
+		dtlsCertificateCacheFile,
+		dtlsCertificateCacheMaxAge,
 		appData,
 	}: WorkerSettings<WorkerAppData>) {
 		super();
@@ -348,6 +435,35 @@ export class Worker<
 			spawnArgs.push(`--disableLiburing=true`);
 		}
 
+		if (channelWriteCoalescing) {
+			spawnArgs.push(`--channelWriteCoalescing=true`);
+		}
+
+		if (typeof notificationBatchWindow === 'number') {
+			spawnArgs.push(`--notificationBatchWindow=${notificationBatchWindow}`);
+		}
+
+		if (typeof srtpCryptoThreads === 'number') {
+			spawnArgs.push(`--srtpCryptoThreads=${srtpCryptoThreads}`);
+		}
+
+		if (dtlsHandshakeOffload) {
+			spawnArgs.push(`--dtlsHandshakeOffload=true`);
+		}
+
+		if (
+			typeof dtlsCertificateCacheFile === 'string' &&
+			dtlsCertificateCacheFile
+		) {
+			spawnArgs.push(`--dtlsCertificateCacheFile=${dtlsCertificateCacheFile}`);
+		}
+
+		if (typeof dtlsCertificateCacheMaxAge === 'number') {
+			spawnArgs.push(
+				`--dtlsCertificateCacheMaxAge=${dtlsCertificateCacheMaxAge}`
+			);
+		}
+
 		logger.debug(`spawning worker process: ${spawnBin} ${spawnArgs.join(' ')}`);
 
 		this.#child = spawn(
@@ -383,6 +499,7 @@ export class Worker<
 			producerSocket: this.#child.stdio[3],
 			consumerSocket: this.#child.stdio[4],
 			pid: this.#pid,
+			writeCoalescing: Boolean(channelWriteCoalescing),
 		});
 
 		this.#appData = appData ?? ({} as WorkerAppData);
@@ -671,6 +788,7 @@ export class Worker<
 	 */
 	async createWebRtcServer<WebRtcServerAppData extends AppData = AppData>({
 		listenInfos,
+		shard,
 		appData,
 	}: WebRtcServerOptions<WebRtcServerAppData>): Promise<
 		WebRtcServer<WebRtcServerAppData>
@@ -706,7 +824,10 @@ export class Worker<
 		const createWebRtcServerRequestOffset =
 			new FbsWorker.CreateWebRtcServerRequestT(
 				webRtcServerId,
-				fbsListenInfos
+				fbsListenInfos,
+				shard
+					? new FbsWorker.WebRtcServerShardT(shard.index, shard.count)
+					: null
 			).pack(this.#channel.bufferBuilder);
 
 		await this.#channel.request(
@@ -833,6 +954,35 @@ export function parseWorkerDumpResponse(
 				'channelNotificationHandlers'
 			),
 		},
+		rtpPacketBufferPool: {
+			capacity: binary.rtpPacketBufferPool()!.capacity(),
+			inUse: binary.rtpPacketBufferPool()!.inUse(),
+			highWaterMark: binary.rtpPacketBufferPool()!.highWaterMark(),
+		},
+		channelNotifier: {
+			rawNotifications: Number(binary.channelNotifier()!.rawNotifications()),
+			batchedNotifications: Number(
+				binary.channelNotifier()!.batchedNotifications()
+			),
+			coalescedNotifications: Number(
+				binary.channelNotifier()!.coalescedNotifications()
+			),
+			batches: Number(binary.channelNotifier()!.batches()),
+		},
+		srtpCryptoPool: {
+			threads: binary.srtpCryptoPool()!.threads(),
+			protectedPackets: Number(binary.srtpCryptoPool()!.protectedPackets()),
+			inlinePackets: Number(binary.srtpCryptoPool()!.inlinePackets()),
+			failedPackets: Number(binary.srtpCryptoPool()!.failedPackets()),
+			queueDepth: binary.srtpCryptoPool()!.queueDepth(),
+			maxQueueDepth: binary.srtpCryptoPool()!.maxQueueDepth(),
+			avgLatencyNs: Number(binary.srtpCryptoPool()!.avgLatencyNs()),
+		},
+		startup: {
+			durationUs: Number(binary.startup()!.durationUs()),
+			dtlsSetupDurationUs: Number(binary.startup()!.dtlsSetupDurationUs()),
+			dtlsCertificateGenerated: binary.startup()!.dtlsCertificateGenerated(),
+		},
 	};
 
 	if (binary.liburing()) {
@@ -840,6 +990,21 @@ export function parseWorkerDumpResponse(
 			sqeProcessCount: Number(binary.liburing()!.sqeProcessCount()),
 			sqeMissCount: Number(binary.liburing()!.sqeMissCount()),
 			userDataMissCount: Number(binary.liburing()!.userDataMissCount()),
+			recvEnabled: binary.liburing()!.recvEnabled(),
+			recvCount: Number(binary.liburing()!.recvCount()),
+			recvBytes: Number(binary.liburing()!.recvBytes()),
+			recvTruncatedCount: Number(binary.liburing()!.recvTruncatedCount()),
+			recvBufferMissCount: Number(binary.liburing()!.recvBufferMissCount()),
+			recvFileMissCount: Number(binary.liburing()!.recvFileMissCount()),
+			sqeMissRate: binary.liburing()!.sqeMissRate(),
+			userDataMissRate: binary.liburing()!.userDataMissRate(),
+			sendBuffers: binary.liburing()!.sendBuffers(),
+			socketBackpressureCount: Number(
+				binary.liburing()!.socketBackpressureCount()
+			),
+			highWatermarkSubmitCount: Number(
+				binary.liburing()!.highWatermarkSubmitCount()
+			),
 		};
 	}
 
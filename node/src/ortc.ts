@@ -908,6 +908,19 @@ function matchCodecs(
 
 			break;
 		}
+
+		case 'video/av1': {
+			if (strict) {
+				const aProfile = aCodec.parameters['profile'] || 0;
+				const bProfile = bCodec.parameters['profile'] || 0;
+
+				if (aProfile !== bProfile) {
+					return false;
+				}
+			}
+
+			break;
+		}
 	}
 
 	return true;
@@ -4,6 +4,7 @@ import { enhancedOnce } from '../enhancedEvents';
 import {
 	WorkerEvents,
 	ConsumerEvents,
+	PipeTransportEvents,
 	ProducerObserverEvents,
 	DataConsumerEvents,
 } from '../types';
@@ -381,6 +382,12 @@ test('router.pipeToRouter() succeeds with video', async () => {
 			encrypt: false,
 			parameters: {},
 		},
+		{
+			uri: 'https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension',
+			id: 8,
+			encrypt: false,
+			parameters: {},
+		},
 		{
 			uri: 'urn:3gpp:video-orientation',
 			id: 11,
@@ -448,6 +455,12 @@ test('router.pipeToRouter() succeeds with video', async () => {
 			encrypt: false,
 			parameters: {},
 		},
+		{
+			uri: 'https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension',
+			id: 8,
+			encrypt: false,
+			parameters: {},
+		},
 		{
 			uri: 'urn:3gpp:video-orientation',
 			id: 11,
@@ -567,6 +580,12 @@ test('router.createPipeTransport() with enableRtx succeeds', async () => {
 			encrypt: false,
 			parameters: {},
 		},
+		{
+			uri: 'https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension',
+			id: 8,
+			encrypt: false,
+			parameters: {},
+		},
 		{
 			uri: 'urn:3gpp:video-orientation',
 			id: 11,
@@ -1126,3 +1145,316 @@ test('router.pipeToRouter() called in two Routers passing one to each other as a
 	expect(pipeTransportsA.size).toBe(0);
 	expect(pipeTransportsB.size).toBe(0);
 }, 2000);
+
+function createRtpPacket({
+	payloadType,
+	ssrc,
+	seq,
+	payload,
+}: {
+	payloadType: number;
+	ssrc: number;
+	seq: number;
+	payload: Buffer;
+}): Buffer {
+	const packet = Buffer.alloc(12 + payload.length);
+
+	packet.writeUInt8(0x80, 0);
+	packet.writeUInt8(payloadType, 1);
+	packet.writeUInt16BE(seq, 2);
+	packet.writeUInt32BE(seq * 3000, 4);
+	packet.writeUInt32BE(ssrc, 8);
+	payload.copy(packet, 12);
+
+	return packet;
+}
+
+// Whether the given RTCP (compound) packet contains a payload specific
+// feedback (PLI or FIR).
+function hasRtcpPsfb(packet: Buffer): boolean {
+	let offset = 0;
+
+	while (offset + 4 <= packet.length) {
+		if (packet.readUInt8(offset + 1) === 206) {
+			return true;
+		}
+
+		offset += (packet.readUInt16BE(offset + 2) + 1) * 4;
+	}
+
+	return false;
+}
+
+// Creates two PipeTransports in different Routers of worker1 connected to each
+// other, so they are linked as local peers.
+async function createLocalPipeTransportPair(): Promise<{
+	router1bis: mediasoup.types.Router;
+	pipeTransport1: mediasoup.types.PipeTransport;
+	pipeTransport2: mediasoup.types.PipeTransport;
+}> {
+	const router1bis = await ctx.worker1!.createRouter({
+		mediaCodecs: ctx.mediaCodecs,
+	});
+	const pipeTransport1 = await ctx.router1!.createPipeTransport({
+		listenInfo: { protocol: 'udp', ip: '127.0.0.1' },
+		enableSctp: true,
+	});
+	const pipeTransport2 = await router1bis.createPipeTransport({
+		listenInfo: { protocol: 'udp', ip: '127.0.0.1' },
+		enableSctp: true,
+	});
+
+	await pipeTransport1.connect({
+		ip: '127.0.0.1',
+		port: pipeTransport2.tuple.localPort,
+	});
+
+	await pipeTransport2.connect({
+		ip: '127.0.0.1',
+		port: pipeTransport1.tuple.localPort,
+	});
+
+	return { router1bis, pipeTransport1, pipeTransport2 };
+}
+
+test('PipeTransports of the same Worker hand RTP over to each other', async () => {
+	const { router1bis, pipeTransport1, pipeTransport2 } =
+		await createLocalPipeTransportPair();
+	const directTransport1 = await ctx.router1!.createDirectTransport();
+	const directTransport2 = await router1bis.createDirectTransport();
+	const producer = await directTransport1.produce({
+		kind: 'audio',
+		rtpParameters: {
+			codecs: [
+				{
+					mimeType: 'audio/opus',
+					payloadType: 111,
+					clockRate: 48000,
+					channels: 2,
+				},
+			],
+			encodings: [{ ssrc: 11111111 }],
+		},
+	});
+	const pipeConsumer = await pipeTransport1.consume({
+		producerId: producer.id,
+	});
+	// NOTE: Use a new id since the original Producer lives in this Worker.
+	const pipeProducer = await pipeTransport2.produce({
+		kind: pipeConsumer.kind,
+		rtpParameters: pipeConsumer.rtpParameters,
+	});
+	const consumer = await directTransport2.consume({
+		producerId: pipeProducer.id,
+		rtpCapabilities: router1bis.rtpCapabilities,
+	});
+	const numPackets = 10;
+	const receivedSeqs: number[] = [];
+
+	const received = new Promise<void>(resolve => {
+		consumer.on('rtp', (packet: Buffer) => {
+			receivedSeqs.push(packet.readUInt16BE(2));
+
+			if (receivedSeqs.length === numPackets) {
+				resolve();
+			}
+		});
+	});
+
+	for (let seq = 1; seq <= numPackets; ++seq) {
+		producer.send(
+			createRtpPacket({
+				payloadType: 111,
+				ssrc: 11111111,
+				seq,
+				payload: Buffer.alloc(100, seq),
+			})
+		);
+	}
+
+	await received;
+
+	// Consumer sequence numbers are consecutive.
+	for (let i = 1; i < numPackets; ++i) {
+		expect((receivedSeqs[i] - receivedSeqs[i - 1]) & 0xffff).toBe(1);
+	}
+
+	const [stats1] = await pipeTransport1.getStats();
+	const [stats2] = await pipeTransport2.getStats();
+
+	expect(stats1.bytesSent).toBeGreaterThan(0);
+	expect(stats2.bytesReceived).toBeGreaterThan(0);
+}, 3000);
+
+test('PipeTransports of the same Worker hand RTCP over to each other', async () => {
+	const { router1bis, pipeTransport1, pipeTransport2 } =
+		await createLocalPipeTransportPair();
+	const directTransport1 = await ctx.router1!.createDirectTransport();
+	const directTransport2 = await router1bis.createDirectTransport();
+	const producer = await directTransport1.produce({
+		kind: 'video',
+		rtpParameters: {
+			codecs: [
+				{
+					mimeType: 'video/VP8',
+					payloadType: 112,
+					clockRate: 90000,
+					rtcpFeedback: [{ type: 'nack', parameter: 'pli' }],
+				},
+			],
+			encodings: [{ ssrc: 22222222 }],
+		},
+	});
+	const pipeConsumer = await pipeTransport1.consume({
+		producerId: producer.id,
+	});
+	const pipeProducer = await pipeTransport2.produce({
+		kind: pipeConsumer.kind,
+		rtpParameters: pipeConsumer.rtpParameters,
+	});
+	const consumer = await directTransport2.consume({
+		producerId: pipeProducer.id,
+		rtpCapabilities: router1bis.rtpCapabilities,
+	});
+
+	const keyFrameRequested = new Promise<void>(resolve => {
+		directTransport1.on('rtcp', (packet: Buffer) => {
+			if (hasRtcpPsfb(packet)) {
+				resolve();
+			}
+		});
+	});
+
+	// Let the pipe Producer get its RTP stream, so it can request key frames.
+	// VP8 payload descriptor (start of partition) and inter frame header.
+	producer.send(
+		createRtpPacket({
+			payloadType: 112,
+			ssrc: 22222222,
+			seq: 1,
+			payload: Buffer.from([0x10, 0x01, 0x00, 0x00]),
+		})
+	);
+
+	for (let i = 0; i < 20; ++i) {
+		const [stats2] = await pipeTransport2.getStats();
+
+		if (stats2.bytesReceived > 0) {
+			break;
+		}
+
+		await new Promise(resolve => setTimeout(resolve, 50));
+	}
+
+	// The PLI goes from pipeTransport2 to pipeTransport1 and then to the
+	// original Producer.
+	await consumer.requestKeyFrame();
+
+	await keyFrameRequested;
+
+	const [stats1] = await pipeTransport1.getStats();
+
+	expect(stats1.bytesReceived).toBeGreaterThan(0);
+}, 3000);
+
+test('PipeTransports of the same Worker hand SCTP over to each other', async () => {
+	const { router1bis, pipeTransport1, pipeTransport2 } =
+		await createLocalPipeTransportPair();
+	const directTransport1 = await ctx.router1!.createDirectTransport();
+	const directTransport2 = await router1bis.createDirectTransport();
+	const dataProducer = await directTransport1.produceData({
+		label: 'foo',
+		protocol: 'bar',
+	});
+	const pipeDataConsumer = await pipeTransport1.consumeData({
+		dataProducerId: dataProducer.id,
+	});
+	const pipeDataProducer = await pipeTransport2.produceData({
+		sctpStreamParameters: pipeDataConsumer.sctpStreamParameters,
+		label: pipeDataConsumer.label,
+		protocol: pipeDataConsumer.protocol,
+	});
+	const dataConsumer = await directTransport2.consumeData({
+		dataProducerId: pipeDataProducer.id,
+	});
+
+	while (pipeTransport1.sctpState !== 'connected') {
+		await enhancedOnce<PipeTransportEvents>(pipeTransport1, 'sctpstatechange');
+	}
+
+	expect(pipeTransport1.sctpState).toBe('connected');
+
+	const received = new Promise<string>(resolve => {
+		dataConsumer.on('message', (message: Buffer) => {
+			resolve(message.toString());
+		});
+	});
+
+	dataProducer.send('hello');
+
+	await expect(received).resolves.toBe('hello');
+}, 3000);
+
+test('PipeTransport of the same Worker is unlinked when its peer is closed', async () => {
+	const { router1bis, pipeTransport1, pipeTransport2 } =
+		await createLocalPipeTransportPair();
+	const directTransport1 = await ctx.router1!.createDirectTransport();
+	const producer = await directTransport1.produce({
+		kind: 'audio',
+		rtpParameters: {
+			codecs: [
+				{
+					mimeType: 'audio/opus',
+					payloadType: 111,
+					clockRate: 48000,
+					channels: 2,
+				},
+			],
+			encodings: [{ ssrc: 11111111 }],
+		},
+	});
+	const pipeConsumer = await pipeTransport1.consume({
+		producerId: producer.id,
+	});
+
+	await pipeTransport2.produce({
+		kind: pipeConsumer.kind,
+		rtpParameters: pipeConsumer.rtpParameters,
+	});
+
+	// Packets queued for the closed PipeTransport are dropped.
+	for (let seq = 1; seq <= 10; ++seq) {
+		producer.send(
+			createRtpPacket({
+				payloadType: 111,
+				ssrc: 11111111,
+				seq,
+				payload: Buffer.alloc(100),
+			})
+		);
+	}
+
+	pipeTransport2.close();
+
+	const [statsBefore] = await pipeTransport1.getStats();
+
+	// pipeTransport1 keeps sending, now through its UDP socket.
+	for (let seq = 11; seq <= 20; ++seq) {
+		producer.send(
+			createRtpPacket({
+				payloadType: 111,
+				ssrc: 11111111,
+				seq,
+				payload: Buffer.alloc(100),
+			})
+		);
+	}
+
+	const [statsAfter] = await pipeTransport1.getStats();
+
+	expect(statsAfter.bytesSent).toBeGreaterThan(statsBefore.bytesSent);
+	expect(router1bis.closed).toBe(false);
+	expect(ctx.worker1!.died).toBe(false);
+
+	await expect(ctx.worker1!.dump()).resolves.toBeDefined();
+}, 3000);
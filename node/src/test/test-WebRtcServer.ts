@@ -1,3 +1,6 @@
+import * as dgram from 'node:dgram';
+import * as fs from 'node:fs';
+import * as os from 'node:os';
 import { pickPort } from 'pick-port';
 import * as mediasoup from '../';
 import { enhancedOnce } from '../enhancedEvents';
@@ -236,6 +239,211 @@ test('worker.createWebRtcServer() with wrong arguments rejects with TypeError',
 	).rejects.toThrow(TypeError);
 }, 2000);
 
+test('worker.createWebRtcServer() with wrong shard rejects with TypeError', async () => {
+	const port = await pickPort({
+		type: 'udp',
+		ip: '127.0.0.1',
+		reserveTimeout: 0,
+	});
+
+	// Index must be lower than count.
+	await expect(
+		ctx.worker!.createWebRtcServer({
+			listenInfos: [{ protocol: 'udp', ip: '127.0.0.1', port }],
+			shard: { index: 2, count: 2 },
+		})
+	).rejects.toThrow(TypeError);
+
+	// Too many shards.
+	await expect(
+		ctx.worker!.createWebRtcServer({
+			listenInfos: [{ protocol: 'udp', ip: '127.0.0.1', port }],
+			shard: { index: 0, count: 37 },
+		})
+	).rejects.toThrow(TypeError);
+
+	// UDP port must be fixed.
+	await expect(
+		ctx.worker!.createWebRtcServer({
+			listenInfos: [
+				{
+					protocol: 'udp',
+					ip: '127.0.0.1',
+					portRange: { min: port, max: port },
+				},
+			],
+			shard: { index: 0, count: 2 },
+		})
+	).rejects.toThrow(TypeError);
+
+	expect(ctx.worker!.webRtcServersForTesting.size).toBe(0);
+}, 2000);
+
+// Sharding is only supported in Linux.
+if (os.platform() === 'linux') {
+	test('worker.createWebRtcServer() with shard succeeds in many Workers with same UDP port', async () => {
+		const worker2 = await mediasoup.createWorker();
+
+		const port = await pickPort({
+			type: 'udp',
+			ip: '127.0.0.1',
+			reserveTimeout: 0,
+		});
+
+		// NOTE: Without CAP_BPF the Workers fall back to the classic BPF steering
+		// program, so this works too.
+		const webRtcServer1 = await ctx.worker!.createWebRtcServer({
+			listenInfos: [{ protocol: 'udp', ip: '127.0.0.1', port }],
+			shard: { index: 0, count: 2 },
+		});
+		const webRtcServer2 = await worker2.createWebRtcServer({
+			listenInfos: [{ protocol: 'udp', ip: '127.0.0.1', port }],
+			shard: { index: 1, count: 2 },
+		});
+
+		const router1 = await ctx.worker!.createRouter();
+		const router2 = await worker2.createRouter();
+
+		const transport1 = await router1.createWebRtcTransport({
+			webRtcServer: webRtcServer1,
+		});
+		const transport2 = await router2.createWebRtcTransport({
+			webRtcServer: webRtcServer2,
+		});
+
+		// First character of the local ICE usernameFragment is the shard index.
+		expect(transport1.iceParameters.usernameFragment[0]).toBe('0');
+		expect(transport2.iceParameters.usernameFragment[0]).toBe('1');
+		expect(transport1.iceCandidates[0].port).toBe(port);
+		expect(transport2.iceCandidates[0].port).toBe(port);
+
+		// And also after restarting ICE.
+		const iceParameters = await transport2.restartIce();
+
+		expect(iceParameters.usernameFragment[0]).toBe('1');
+
+		worker2.close();
+	}, 2000);
+
+	test('worker.createWebRtcServer() with shard steers STUN requests to their shard after closing a middle one', async () => {
+		// Just the eBPF steering program (which requires CAP_BPF) keeps steering
+		// after a middle shard is closed.
+		if (!hasBpfCapability()) {
+			return;
+		}
+
+		const worker2 = await mediasoup.createWorker();
+		const worker3 = await mediasoup.createWorker();
+
+		const port = await pickPort({
+			type: 'udp',
+			ip: '127.0.0.1',
+			reserveTimeout: 0,
+		});
+
+		const webRtcServer1 = await ctx.worker!.createWebRtcServer({
+			listenInfos: [{ protocol: 'udp', ip: '127.0.0.1', port }],
+			shard: { index: 0, count: 3 },
+		});
+		const webRtcServer2 = await worker2.createWebRtcServer({
+			listenInfos: [{ protocol: 'udp', ip: '127.0.0.1', port }],
+			shard: { index: 1, count: 3 },
+		});
+		const webRtcServer3 = await worker3.createWebRtcServer({
+			listenInfos: [{ protocol: 'udp', ip: '127.0.0.1', port }],
+			shard: { index: 2, count: 3 },
+		});
+
+		const router1 = await ctx.worker!.createRouter();
+		const router3 = await worker3.createRouter();
+
+		const transport1 = await router1.createWebRtcTransport({
+			webRtcServer: webRtcServer1,
+		});
+		const transport3 = await router3.createWebRtcTransport({
+			webRtcServer: webRtcServer3,
+		});
+
+		webRtcServer2.close();
+
+		// Only the shard of the WebRtcTransport knows its local ICE
+		// usernameFragment, so just it replies (400 since the request has no
+		// FINGERPRINT).
+		for (const transport of [transport1, transport3, transport1, transport3]) {
+			const response = await sendStunRequest(
+				port,
+				transport.iceParameters.usernameFragment
+			);
+
+			// Binding error response.
+			expect(response.readUInt16BE(0)).toBe(0x0111);
+		}
+
+		worker2.close();
+		worker3.close();
+	}, 4000);
+}
+
+/**
+ * Whether this process (and so its Workers) has CAP_BPF or CAP_SYS_ADMIN in
+ * its effective capabilities.
+ */
+function hasBpfCapability(): boolean {
+	const status = fs.readFileSync('/proc/self/status', 'utf8');
+	const match = status.match(/^CapEff:\s*([0-9a-f]+)$/m);
+
+	if (!match) {
+		return false;
+	}
+
+	const capabilities = BigInt(`0x${match[1]}`);
+	const CAP_SYS_ADMIN = 21n;
+	const CAP_BPF = 39n;
+
+	return (
+		((capabilities >> CAP_SYS_ADMIN) & 1n) === 1n ||
+		((capabilities >> CAP_BPF) & 1n) === 1n
+	);
+}
+
+async function sendStunRequest(
+	port: number,
+	usernameFragment: string
+): Promise<Buffer> {
+	const username = Buffer.from(`${usernameFragment}:remote`);
+	const paddedLength = Math.ceil(username.length / 4) * 4;
+	const request = Buffer.alloc(20 + 4 + paddedLength);
+
+	// Binding request with just USERNAME attribute.
+	request.writeUInt16BE(0x0001, 0);
+	request.writeUInt16BE(4 + paddedLength, 2);
+	request.writeUInt32BE(0x2112a442, 4);
+	request.fill(0x11, 8, 20);
+	request.writeUInt16BE(0x0006, 20);
+	request.writeUInt16BE(username.length, 22);
+	username.copy(request, 24);
+
+	const socket = dgram.createSocket('udp4');
+
+	try {
+		return await new Promise<Buffer>((resolve, reject) => {
+			const timeout = setTimeout(
+				() => reject(new Error('no STUN response received')),
+				1000
+			);
+
+			socket.once('message', message => {
+				clearTimeout(timeout);
+				resolve(message);
+			});
+
+			socket.send(request, port, '127.0.0.1');
+		});
+	} finally {
+		socket.close();
+	}
+}
+
 test('worker.createWebRtcServer() with unavailable listenInfos rejects with Error', async () => {
 	const worker2 = await mediasoup.createWorker();
 	const port1 = await pickPort({
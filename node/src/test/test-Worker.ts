@@ -1,3 +1,5 @@
+import * as dgram from 'node:dgram';
+import * as fs from 'node:fs';
 import * as os from 'node:os';
 import * as process from 'node:process';
 import * as path from 'node:path';
@@ -104,6 +106,14 @@ test('createWorker() with wrong settings rejects with TypeError', async () => {
 		mediasoup.createWorker({ dtlsPrivateKeyFile: '/notfound/priv.pem' })
 	).rejects.toThrow(TypeError);
 
+	await expect(
+		mediasoup.createWorker({ srtpCryptoThreads: 17 })
+	).rejects.toThrow(TypeError);
+
+	await expect(
+		mediasoup.createWorker({ dtlsCertificateCacheMaxAge: 0 })
+	).rejects.toThrow(TypeError);
+
 	await expect(
 		// @ts-expect-error --- Testing purposes.
 		mediasoup.createWorker({ appData: 'NOT-AN-OBJECT' })
@@ -158,6 +168,24 @@ test('worker.dump() succeeds', async () => {
 			channelRequestHandlers: [],
 			channelNotificationHandlers: [],
 		},
+		rtpPacketBufferPool: {
+			capacity: 0,
+			inUse: 0,
+			highWaterMark: 0,
+		},
+		channelNotifier: {
+			batchedNotifications: 0,
+			coalescedNotifications: 0,
+			batches: 0,
+		},
+		srtpCryptoPool: {
+			threads: 0,
+			protectedPackets: 0,
+			queueDepth: 0,
+		},
+		startup: {
+			dtlsCertificateGenerated: true,
+		},
 	});
 
 	worker.close();
@@ -183,6 +211,149 @@ test('worker.getResourceUsage() succeeds', async () => {
 	await enhancedOnce<WorkerEvents>(worker, 'subprocessclose');
 }, 2000);
 
+test('worker with channelWriteCoalescing handles concurrent requests', async () => {
+	const worker = await mediasoup.createWorker({ channelWriteCoalescing: true });
+
+	// Requests written within the same tick go to the worker in a single write.
+	const routers = await Promise.all(
+		Array.from({ length: 20 }, () => worker.createRouter())
+	);
+
+	await expect(worker.dump()).resolves.toMatchObject({
+		pid: worker.pid,
+		routerIds: expect.arrayContaining(routers.map(router => router.id)),
+	});
+
+	await Promise.all(routers.map(router => router.dump()));
+
+	worker.close();
+
+	await enhancedOnce<WorkerEvents>(worker, 'subprocessclose');
+
+	expect(worker.died).toBe(false);
+}, 2000);
+
+test('worker with notificationBatchWindow sends notifications', async () => {
+	const worker = await mediasoup.createWorker({ notificationBatchWindow: 0 });
+
+	// The worker is running, so its 'running' notification reached us.
+	await expect(worker.dump()).resolves.toMatchObject({
+		pid: worker.pid,
+		channelNotifier: {
+			rawNotifications: 1,
+			batchedNotifications: 0,
+			batches: 0,
+		},
+	});
+
+	worker.close();
+
+	await enhancedOnce<WorkerEvents>(worker, 'subprocessclose');
+
+	expect(worker.died).toBe(false);
+}, 2000);
+
+test('worker with srtpCryptoThreads succeeds', async () => {
+	const worker = await mediasoup.createWorker({ srtpCryptoThreads: 2 });
+
+	const dump = await worker.dump();
+
+	expect(dump.srtpCryptoPool.threads).toBe(2);
+	expect(dump.srtpCryptoPool.queueDepth).toBe(0);
+
+	worker.close();
+
+	await enhancedOnce<WorkerEvents>(worker, 'subprocessclose');
+
+	expect(worker.died).toBe(false);
+}, 2000);
+
+test('worker with dtlsHandshakeOffload succeeds', async () => {
+	const worker = await mediasoup.createWorker({ dtlsHandshakeOffload: true });
+	const router = await worker.createRouter();
+	const transport = await router.createWebRtcTransport({
+		listenInfos: [{ protocol: 'udp', ip: '127.0.0.1' }],
+	});
+
+	await expect(transport.dump()).resolves.toMatchObject({
+		dtlsState: 'new',
+	});
+
+	worker.close();
+
+	await enhancedOnce<WorkerEvents>(worker, 'subprocessclose');
+
+	expect(worker.died).toBe(false);
+}, 2000);
+
+test('worker with dtlsCertificateCacheFile reuses the cached certificate', async () => {
+	const dtlsCertificateCacheFile = path.join(
+		os.tmpdir(),
+		`mediasoup-test-dtls-${process.pid}.pem`
+	);
+
+	const getFingerprints = async (
+		worker: mediasoup.types.Worker
+	): Promise<mediasoup.types.DtlsFingerprint[]> => {
+		const router = await worker.createRouter();
+		const transport = await router.createWebRtcTransport({
+			listenInfos: [{ protocol: 'udp', ip: '127.0.0.1' }],
+		});
+
+		return transport.dtlsParameters.fingerprints;
+	};
+
+	const worker1 = await mediasoup.createWorker({ dtlsCertificateCacheFile });
+	const dump1 = await worker1.dump();
+	const fingerprints1 = await getFingerprints(worker1);
+
+	expect(dump1.startup.dtlsCertificateGenerated).toBe(true);
+	expect(fs.existsSync(dtlsCertificateCacheFile)).toBe(true);
+
+	const worker2 = await mediasoup.createWorker({ dtlsCertificateCacheFile });
+	const dump2 = await worker2.dump();
+	const fingerprints2 = await getFingerprints(worker2);
+
+	expect(dump2.startup.dtlsCertificateGenerated).toBe(false);
+	expect(fingerprints2).toEqual(fingerprints1);
+
+	worker1.close();
+	worker2.close();
+
+	fs.unlinkSync(dtlsCertificateCacheFile);
+}, 2000);
+
+test('worker with liburing receives UDP datagrams via io_uring', async () => {
+	const worker = await mediasoup.createWorker();
+	const dump = await worker.dump();
+
+	// io_uring may not be available in current host.
+	if (!dump.liburing?.recvEnabled) {
+		worker.close();
+
+		return;
+	}
+
+	const router = await worker.createRouter();
+	const transport = await router.createPlainTransport({
+		listenInfo: { protocol: 'udp', ip: '127.0.0.1' },
+		comedia: true,
+	});
+	const socket = dgram.createSocket('udp4');
+
+	socket.send(Buffer.alloc(100), transport.tuple.localPort, '127.0.0.1');
+
+	await new Promise(resolve => setTimeout(resolve, 100));
+
+	const dump2 = await worker.dump();
+
+	expect(dump2.liburing!.recvCount).toBeGreaterThan(0);
+	expect(dump2.liburing!.recvBytes).toBeGreaterThanOrEqual(100);
+
+	socket.close();
+	worker.close();
+}, 2000);
+
 test('worker.close() succeeds', async () => {
 	const worker = await mediasoup.createWorker({ logLevel: 'warn' });
 	const onObserverClose = jest.fn();
@@ -24,12 +24,15 @@ use crate::srtp_parameters::{SrtpCryptoSuite, SrtpParameters};
 use crate::transport::{TransportId, TransportTraceEventType};
 use crate::webrtc_server::{
     WebRtcServerDump, WebRtcServerIceUsernameFragment, WebRtcServerId, WebRtcServerIpPort,
-    WebRtcServerListenInfos, WebRtcServerTupleHash,
+    WebRtcServerListenInfos, WebRtcServerShard, WebRtcServerTupleHash,
 };
 use crate::webrtc_transport::{
     WebRtcTransportListen, WebRtcTransportListenInfos, WebRtcTransportOptions,
 };
-use crate::worker::{ChannelMessageHandlers, LibUringDump, WorkerDump, WorkerUpdateSettings};
+use crate::worker::{
+    ChannelMessageHandlers, ChannelNotifierDump, LibUringDump, RtpPacketBufferPoolDump,
+    SrtpCryptoPoolDump, StartupDump, WorkerDump, WorkerUpdateSettings,
+};
 use mediasoup_sys::fbs::{
     active_speaker_observer, audio_level_observer, consumer, data_consumer, data_producer,
     direct_transport, message, notification, pipe_transport, plain_transport, producer, request,
@@ -169,7 +172,43 @@ impl Request for WorkerDumpRequest {
                 sqe_process_count: liburing.sqe_process_count,
                 sqe_miss_count: liburing.sqe_miss_count,
                 user_data_miss_count: liburing.user_data_miss_count,
+                recv_enabled: liburing.recv_enabled,
+                recv_count: liburing.recv_count,
+                recv_bytes: liburing.recv_bytes,
+                recv_truncated_count: liburing.recv_truncated_count,
+                recv_buffer_miss_count: liburing.recv_buffer_miss_count,
+                recv_file_miss_count: liburing.recv_file_miss_count,
+                sqe_miss_rate: liburing.sqe_miss_rate,
+                user_data_miss_rate: liburing.user_data_miss_rate,
+                send_buffers: liburing.send_buffers,
+                socket_backpressure_count: liburing.socket_backpressure_count,
+                high_watermark_submit_count: liburing.high_watermark_submit_count,
             }),
+            rtp_packet_buffer_pool: RtpPacketBufferPoolDump {
+                capacity: data.rtp_packet_buffer_pool.capacity,
+                in_use: data.rtp_packet_buffer_pool.in_use,
+                high_water_mark: data.rtp_packet_buffer_pool.high_water_mark,
+            },
+            channel_notifier: ChannelNotifierDump {
+                raw_notifications: data.channel_notifier.raw_notifications,
+                batched_notifications: data.channel_notifier.batched_notifications,
+                coalesced_notifications: data.channel_notifier.coalesced_notifications,
+                batches: data.channel_notifier.batches,
+            },
+            srtp_crypto_pool: SrtpCryptoPoolDump {
+                threads: data.srtp_crypto_pool.threads,
+                protected_packets: data.srtp_crypto_pool.protected_packets,
+                inline_packets: data.srtp_crypto_pool.inline_packets,
+                failed_packets: data.srtp_crypto_pool.failed_packets,
+                queue_depth: data.srtp_crypto_pool.queue_depth,
+                max_queue_depth: data.srtp_crypto_pool.max_queue_depth,
+                avg_latency_ns: data.srtp_crypto_pool.avg_latency_ns,
+            },
+            startup: StartupDump {
+                duration_us: data.startup.duration_us,
+                dtls_setup_duration_us: data.startup.dtls_setup_duration_us,
+                dtls_certificate_generated: data.startup.dtls_certificate_generated,
+            },
         })
     }
 }
@@ -224,6 +263,7 @@ impl Request for WorkerUpdateSettingsRequest {
 pub(crate) struct WorkerCreateWebRtcServerRequest {
     pub(crate) webrtc_server_id: WebRtcServerId,
     pub(crate) listen_infos: WebRtcServerListenInfos,
+    pub(crate) shard: Option<WebRtcServerShard>,
 }
 
 impl Request for WorkerCreateWebRtcServerRequest {
@@ -237,6 +277,7 @@ impl Request for WorkerCreateWebRtcServerRequest {
             &mut builder,
             self.webrtc_server_id.to_string(),
             self.listen_infos.to_fbs(),
+            self.shard.map(|shard| shard.to_fbs()),
         );
         let request_body =
             request::Body::create_worker_create_web_rtc_server_request(&mut builder, data);
@@ -1156,6 +1156,23 @@ fn match_codecs(
                 }
             }
         }
+        MimeType::Video(MimeTypeVideo::Av1) => {
+            // If strict matching check profile.
+            if strict {
+                let profile_a = codec_a
+                    .parameters
+                    .get("profile")
+                    .unwrap_or(&RtpCodecParametersParametersValue::Number(0));
+                let profile_b = codec_b
+                    .parameters
+                    .get("profile")
+                    .unwrap_or(&RtpCodecParametersParametersValue::Number(0));
+
+                if profile_a != profile_b {
+                    return Err(());
+                }
+            }
+        }
 
         _ => {}
     }
@@ -943,6 +943,10 @@ impl Router {
 
     /// Pipes [`Producer`] with the given `producer_id` into another [`Router`] on same host.
     ///
+    /// Since all workers run in this process, the pipe transports of routers in different workers
+    /// (without SRTP) exchange packets through in-memory single producer single consumer queues
+    /// instead of loopback UDP.
+    ///
     /// # Example
     /// ```rust
     /// use mediasoup::prelude::*;
@@ -371,6 +371,9 @@ pub enum MimeTypeVideo {
     /// H265
     #[serde(rename = "video/H265")]
     H265,
+    /// AV1
+    #[serde(rename = "video/AV1")]
+    Av1,
     /// RTX
     #[serde(rename = "video/rtx")]
     Rtx,
@@ -392,6 +395,7 @@ impl FromStr for MimeTypeVideo {
             "video/H264" => Ok(Self::H264),
             "video/H264-SVC" => Ok(Self::H264Svc),
             "video/H265" => Ok(Self::H265),
+            "video/AV1" => Ok(Self::Av1),
             "video/rtx" => Ok(Self::Rtx),
             "video/red" => Ok(Self::Red),
             "video/ulpfec" => Ok(Self::Ulpfec),
@@ -413,6 +417,7 @@ impl MimeTypeVideo {
             Self::H264 => "video/H264",
             Self::H264Svc => "video/H264-SVC",
             Self::H265 => "video/H265",
+            Self::Av1 => "video/AV1",
             Self::Rtx => "video/rtx",
             Self::Red => "video/red",
             Self::Ulpfec => "video/ulpfec",
@@ -588,6 +593,11 @@ pub enum RtpHeaderExtensionUri {
     /// <http://www.webrtc.org/experiments/rtp-hdrext/playout-delay>
     #[serde(rename = "http://www.webrtc.org/experiments/rtp-hdrext/playout-delay")]
     PlayoutDelay,
+    /// <https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension>
+    #[serde(
+        rename = "https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension"
+    )]
+    DependencyDescriptor,
 
     #[doc(hidden)]
     #[serde(other, rename = "unsupported")]
@@ -627,6 +637,9 @@ impl RtpHeaderExtensionUri {
             RtpHeaderExtensionUri::PlayoutDelay => {
                 rtp_parameters::RtpHeaderExtensionUri::PlayoutDelay
             }
+            RtpHeaderExtensionUri::DependencyDescriptor => {
+                rtp_parameters::RtpHeaderExtensionUri::DependencyDescriptor
+            }
             RtpHeaderExtensionUri::Unsupported => panic!("Invalid RTP extension header URI"),
         }
     }
@@ -663,6 +676,9 @@ impl RtpHeaderExtensionUri {
             rtp_parameters::RtpHeaderExtensionUri::PlayoutDelay => {
                 RtpHeaderExtensionUri::PlayoutDelay
             }
+            rtp_parameters::RtpHeaderExtensionUri::DependencyDescriptor => {
+                RtpHeaderExtensionUri::DependencyDescriptor
+            }
         }
     }
 }
@@ -690,6 +706,9 @@ impl FromStr for RtpHeaderExtensionUri {
                 Ok(Self::AbsCaptureTime)
             }
             "http://www.webrtc.org/experiments/rtp-hdrext/playout-delay" => Ok(Self::PlayoutDelay),
+            "https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension" => {
+                Ok(Self::DependencyDescriptor)
+            }
             _ => Err(RtpHeaderExtensionUriParseError::Unsupported),
         }
     }
@@ -724,6 +743,9 @@ impl RtpHeaderExtensionUri {
             RtpHeaderExtensionUri::PlayoutDelay => {
                 "http://www.webrtc.org/experiments/rtp-hdrext/playout-delay"
             }
+            RtpHeaderExtensionUri::DependencyDescriptor => {
+                "https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension"
+            }
             RtpHeaderExtensionUri::Unsupported => "unsupported",
         }
     }
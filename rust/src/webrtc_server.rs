@@ -20,7 +20,7 @@ use async_executor::Executor;
 use event_listener_primitives::{BagOnce, HandlerId};
 use hash_hasher::HashedSet;
 use log::{debug, error};
-use mediasoup_sys::fbs::transport;
+use mediasoup_sys::fbs::{transport, worker};
 use parking_lot::Mutex;
 use serde::{Deserialize, Serialize};
 use std::fmt;
@@ -125,12 +125,45 @@ impl TryFrom<Vec<ListenInfo>> for WebRtcServerListenInfos {
     }
 }
 
+/// Shard of a [`WebRtcServer`] whose UDP port is shared by many workers (Linux only).
+///
+/// Many workers (up to 36) can listen on the same UDP port(s) if each of them creates a WebRTC
+/// server with same UDP listen infos (with a fixed port) and a different shard index. The kernel
+/// delivers each STUN request to the worker whose shard index is encoded in the local ICE username
+/// fragment and, once ICE is connected, all packets of the tuple to that worker.
+///
+/// Shards can be created and closed in any order. The steering eBPF program requires `CAP_BPF`
+/// (or `CAP_SYS_ADMIN`) and steers the rest of packets by the ICE tuples each worker adds to a map.
+/// Without them, a classic BPF program steers STUN requests by the position of the shard in the
+/// `SO_REUSEPORT` group, which only matches its index while shards are created in index order and
+/// none but the last one is closed, and each ICE tuple gets a UDP socket connected to its remote
+/// address (so a file descriptor). TCP listen infos are not shared so each shard must use a
+/// different TCP port.
+#[derive(Debug, Copy, Clone, Eq, PartialEq, Serialize)]
+pub struct WebRtcServerShard {
+    /// Index of this shard (from 0 to `count - 1`).
+    pub index: u8,
+    /// Number of shards.
+    pub count: u8,
+}
+
+impl WebRtcServerShard {
+    pub(crate) fn to_fbs(self) -> worker::WebRtcServerShard {
+        worker::WebRtcServerShard {
+            index: self.index,
+            count: self.count,
+        }
+    }
+}
+
 /// [`WebRtcServer`] options.
 #[derive(Debug)]
 #[non_exhaustive]
 pub struct WebRtcServerOptions {
     /// Listening infos in order of preference (first one is the preferred one).
     pub listen_infos: WebRtcServerListenInfos,
+    /// Shard of a WebRTC server whose UDP port is shared by many workers (Linux only).
+    pub shard: Option<WebRtcServerShard>,
     /// Custom application data.
     pub app_data: AppData,
 }
@@ -140,6 +173,7 @@ impl WebRtcServerOptions {
     pub fn new(listen_infos: WebRtcServerListenInfos) -> Self {
         Self {
             listen_infos,
+            shard: None,
             app_data: AppData::default(),
         }
     }
@@ -183,7 +183,8 @@ pub struct WorkerSettings {
     pub rtc_port_range: RangeInclusive<u16>,
     /// DTLS certificate and private key.
     ///
-    /// If `None`, a certificate is dynamically created.
+    /// If `None`, a certificate is dynamically created. It is shared (along with its DTLS context)
+    /// by all workers of this process created without DTLS files.
     pub dtls_files: Option<WorkerDtlsFiles>,
     /// Field trials for libwebrtc.
     ///
@@ -197,6 +198,20 @@ pub struct WorkerSettings {
     ///
     /// Default `true`.
     pub enable_liburing: bool,
+    /// Batch notifications sent by the worker into a single channel message.
+    ///
+    /// If `Some(0)`, notifications generated within the same event loop iteration are batched.
+    /// Otherwise it's the maximum time (in ms, up to 1000) a notification can be delayed. Score
+    /// notifications of the same entity within a batch are coalesced into the latest one.
+    ///
+    /// Default `None` (no batching).
+    pub notification_batch_window: Option<u32>,
+    /// Number of extra threads (up to 16) used to SRTP encrypt the RTP packets sent over UDP.
+    /// Packets are encrypted by these threads and then sent by the worker thread, keeping their
+    /// order within each transport.
+    ///
+    /// Default `0` (packets are encrypted by the worker thread).
+    pub srtp_crypto_threads: u8,
     /// Function that will be called under worker thread before worker starts, can be used for
     /// pinning worker threads to CPU cores.
     pub thread_initializer: Option<Arc<dyn Fn() + Send + Sync>>,
@@ -227,6 +242,8 @@ impl Default for WorkerSettings {
             dtls_files: None,
             libwebrtc_field_trials: None,
             enable_liburing: true,
+            notification_batch_window: None,
+            srtp_crypto_threads: 0,
             thread_initializer: None,
             app_data: AppData::default(),
         }
@@ -242,6 +259,8 @@ impl fmt::Debug for WorkerSettings {
             dtls_files,
             libwebrtc_field_trials,
             enable_liburing,
+            notification_batch_window,
+            srtp_crypto_threads,
             thread_initializer,
             app_data,
         } = self;
@@ -253,6 +272,8 @@ impl fmt::Debug for WorkerSettings {
             .field("dtls_files", &dtls_files)
             .field("libwebrtc_field_trials", &libwebrtc_field_trials)
             .field("enable_liburing", &enable_liburing)
+            .field("notification_batch_window", &notification_batch_window)
+            .field("srtp_crypto_threads", &srtp_crypto_threads)
             .field(
                 "thread_initializer",
                 &thread_initializer.as_ref().map(|_| "ThreadInitializer"),
@@ -292,6 +313,54 @@ pub struct LibUringDump {
     pub sqe_process_count: u64,
     pub sqe_miss_count: u64,
     pub user_data_miss_count: u64,
+    pub recv_enabled: bool,
+    pub recv_count: u64,
+    pub recv_bytes: u64,
+    pub recv_truncated_count: u64,
+    pub recv_buffer_miss_count: u64,
+    pub recv_file_miss_count: u64,
+    pub sqe_miss_rate: u32,
+    pub user_data_miss_rate: u32,
+    pub send_buffers: u32,
+    pub socket_backpressure_count: u64,
+    pub high_watermark_submit_count: u64,
+}
+
+#[derive(Debug, Clone, Deserialize, Serialize, Eq, PartialEq)]
+#[doc(hidden)]
+pub struct RtpPacketBufferPoolDump {
+    pub capacity: u32,
+    pub in_use: u32,
+    pub high_water_mark: u32,
+}
+
+#[derive(Debug, Clone, Deserialize, Serialize, Eq, PartialEq)]
+#[doc(hidden)]
+pub struct ChannelNotifierDump {
+    pub raw_notifications: u64,
+    pub batched_notifications: u64,
+    pub coalesced_notifications: u64,
+    pub batches: u64,
+}
+
+#[derive(Debug, Clone, Deserialize, Serialize, Eq, PartialEq)]
+#[doc(hidden)]
+pub struct SrtpCryptoPoolDump {
+    pub threads: u8,
+    pub protected_packets: u64,
+    pub inline_packets: u64,
+    pub failed_packets: u64,
+    pub queue_depth: u32,
+    pub max_queue_depth: u32,
+    pub avg_latency_ns: u64,
+}
+
+#[derive(Debug, Clone, Deserialize, Serialize, Eq, PartialEq)]
+#[doc(hidden)]
+pub struct StartupDump {
+    pub duration_us: u64,
+    pub dtls_setup_duration_us: u64,
+    pub dtls_certificate_generated: bool,
 }
 
 #[derive(Debug, Clone, Deserialize, Serialize)]
@@ -305,6 +374,10 @@ pub struct WorkerDump {
     pub webrtc_server_ids: Vec<WebRtcServerId>,
     pub channel_message_handlers: ChannelMessageHandlers,
     pub liburing: Option<LibUringDump>,
+    pub rtp_packet_buffer_pool: RtpPacketBufferPoolDump,
+    pub channel_notifier: ChannelNotifierDump,
+    pub srtp_crypto_pool: SrtpCryptoPoolDump,
+    pub startup: StartupDump,
 }
 
 /// Error that caused [`Worker::create_webrtc_server`] to fail.
@@ -365,6 +438,8 @@ impl Inner {
             dtls_files,
             libwebrtc_field_trials,
             enable_liburing,
+            notification_batch_window,
+            srtp_crypto_threads,
             thread_initializer,
             app_data,
         }: WorkerSettings,
@@ -417,6 +492,29 @@ impl Inner {
             spawn_args.push("--disableLiburing=true".to_string());
         }
 
+        if let Some(notification_batch_window) = notification_batch_window {
+            if notification_batch_window > 1000 {
+                return Err(io::Error::new(
+                    io::ErrorKind::InvalidInput,
+                    "Invalid notification batch window",
+                ));
+            }
+            spawn_args.push(format!(
+                "--notificationBatchWindow={notification_batch_window}"
+            ));
+        }
+
+        if srtp_crypto_threads > 16 {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidInput,
+                "Invalid SRTP crypto threads",
+            ));
+        }
+
+        if srtp_crypto_threads != 0 {
+            spawn_args.push(format!("--srtpCryptoThreads={srtp_crypto_threads}"));
+        }
+
         let id = WorkerId::new();
         debug!(
             "spawning worker with arguments [id:{}]: {}",
@@ -673,6 +771,7 @@ impl Worker {
 
         let WebRtcServerOptions {
             listen_infos,
+            shard,
             app_data,
         } = webrtc_server_options;
 
@@ -690,6 +789,7 @@ impl Worker {
                 WorkerCreateWebRtcServerRequest {
                     webrtc_server_id,
                     listen_infos,
+                    shard,
                 },
             )
             .await
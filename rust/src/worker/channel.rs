@@ -10,7 +10,7 @@ use lru::LruCache;
 use mediasoup_sys::fbs::{message, notification, request, response};
 use mediasoup_sys::UvAsyncT;
 use parking_lot::Mutex;
-use planus::ReadAsRoot;
+use planus::{Builder, ReadAsRoot};
 use serde::Deserialize;
 use std::collections::VecDeque;
 use std::fmt::{Debug, Display};
@@ -87,6 +87,7 @@ impl Drop for BufferMessagesGuard {
 #[derive(Debug)]
 enum ChannelReceiveMessage<'a> {
     Notification(notification::NotificationRef<'a>),
+    NotificationBatch(notification::NotificationBatchRef<'a>),
     Response(response::ResponseRef<'a>),
     Event(InternalMessage),
 }
@@ -122,12 +123,58 @@ fn deserialize_message(bytes: &[u8]) -> ChannelReceiveMessage<'_> {
             _ => ChannelReceiveMessage::Event(InternalMessage::Unexpected(Vec::from(bytes))),
         },
         message::BodyRef::Notification(data) => ChannelReceiveMessage::Notification(data),
+        message::BodyRef::NotificationBatch(data) => ChannelReceiveMessage::NotificationBatch(data),
         message::BodyRef::Response(data) => ChannelReceiveMessage::Response(data),
 
         _ => ChannelReceiveMessage::Event(InternalMessage::Unexpected(Vec::from(bytes))),
     }
 }
 
+// Serialize a notification contained in a batch as a standalone message, so it can be
+// buffered like any other notification.
+fn serialize_notification(notification_ref: notification::NotificationRef<'_>) -> Vec<u8> {
+    let mut builder = Builder::new();
+
+    let notification = notification::Notification::try_from(notification_ref).unwrap();
+    let message_body = message::Body::create_notification(&mut builder, notification);
+    let message = message::Message::create(&mut builder, message_body);
+
+    builder.finish(message, None).to_vec()
+}
+
+#[allow(clippy::type_complexity)]
+fn dispatch_notification(
+    notification: notification::NotificationRef<'_>,
+    message_bytes: impl FnOnce() -> Vec<u8>,
+    buffered_notifications_for: &Mutex<HashedMap<SubscriptionTarget, Vec<Vec<u8>>>>,
+    non_buffered_notifications: &mut LruCache<SubscriptionTarget, ()>,
+    event_handlers: &EventHandlers<
+        Arc<dyn Fn(notification::NotificationRef<'_>) + Send + Sync + 'static>,
+    >,
+) {
+    let target_id = notification.handler_id().unwrap();
+    // Target id can be either the worker PID or a UUID.
+    let target_id = match target_id.parse::<u64>() {
+        Ok(_) => SubscriptionTarget::String(target_id.to_string()),
+        Err(_) => SubscriptionTarget::Uuid(Uuid::parse_str(target_id).unwrap()),
+    };
+
+    if !non_buffered_notifications.contains(&target_id) {
+        let mut buffer_notifications_for = buffered_notifications_for.lock();
+        // Check if we need to buffer notifications for this
+        // target_id
+        if let Some(list) = buffer_notifications_for.get_mut(&target_id) {
+            // Store the whole message removing the size prefix.
+            list.push(message_bytes());
+            return;
+        }
+
+        // Remember we don't need to buffer these
+        non_buffered_notifications.put(target_id.clone(), ());
+    }
+    event_handlers.call_callbacks_with_single_value(&target_id, notification);
+}
+
 struct ResponseError {
     reason: String,
 }
@@ -249,27 +296,26 @@ impl Channel {
 
                 match deserialize_message(message) {
                     ChannelReceiveMessage::Notification(notification) => {
-                        let target_id = notification.handler_id().unwrap();
-                        // Target id can be either the worker PID or a UUID.
-                        let target_id = match target_id.parse::<u64>() {
-                            Ok(_) => SubscriptionTarget::String(target_id.to_string()),
-                            Err(_) => SubscriptionTarget::Uuid(Uuid::parse_str(target_id).unwrap()),
-                        };
-
-                        if !non_buffered_notifications.contains(&target_id) {
-                            let mut buffer_notifications_for = buffered_notifications_for.lock();
-                            // Check if we need to buffer notifications for this
-                            // target_id
-                            if let Some(list) = buffer_notifications_for.get_mut(&target_id) {
-                                // Store the whole message removing the size prefix.
-                                list.push(Vec::from(message));
-                                return;
-                            }
-
-                            // Remember we don't need to buffer these
-                            non_buffered_notifications.put(target_id.clone(), ());
+                        dispatch_notification(
+                            notification,
+                            || Vec::from(message),
+                            &buffered_notifications_for,
+                            &mut non_buffered_notifications,
+                            &event_handlers,
+                        );
+                    }
+                    ChannelReceiveMessage::NotificationBatch(batch) => {
+                        for notification in batch.notifications().unwrap() {
+                            let notification = notification.unwrap();
+
+                            dispatch_notification(
+                                notification,
+                                || serialize_notification(notification),
+                                &buffered_notifications_for,
+                                &mut non_buffered_notifications,
+                                &event_handlers,
+                            );
                         }
-                        event_handlers.call_callbacks_with_single_value(&target_id, notification);
                     }
                     ChannelReceiveMessage::Response(response) => {
                         let sender = requests_container
@@ -1,8 +1,10 @@
+use async_io::Timer;
 use futures_lite::future;
 use mediasoup::consumer::{ConsumerOptions, ConsumerScore, ConsumerType};
 use mediasoup::data_consumer::{DataConsumerOptions, DataConsumerType};
-use mediasoup::data_producer::{DataProducerOptions, DataProducerType};
-use mediasoup::data_structures::{AppData, ListenInfo, Protocol};
+use mediasoup::data_producer::{DataProducer, DataProducerOptions, DataProducerType};
+use mediasoup::data_structures::{AppData, ListenInfo, Protocol, WebRtcMessage};
+use mediasoup::direct_transport::DirectTransportOptions;
 use mediasoup::pipe_transport::{PipeTransportOptions, PipeTransportRemoteParameters};
 use mediasoup::prelude::*;
 use mediasoup::producer::ProducerOptions;
@@ -26,9 +28,12 @@ use mediasoup::worker::{RequestError, Worker, WorkerSettings};
 use mediasoup::worker_manager::WorkerManager;
 use parking_lot::Mutex;
 use portpicker::pick_unused_port;
+use std::borrow::Cow;
 use std::env;
 use std::net::{IpAddr, Ipv4Addr};
 use std::num::{NonZeroU32, NonZeroU8};
+use std::sync::Arc;
+use std::time::Duration;
 
 struct CustomAppData {
     _foo: &'static str,
@@ -494,6 +499,11 @@ fn pipe_to_router_succeeds_with_video() {
                     id: 7,
                     encrypt: false,
                 },
+                RtpHeaderExtensionParameters {
+                    uri: RtpHeaderExtensionUri::DependencyDescriptor,
+                    id: 8,
+                    encrypt: false,
+                },
                 RtpHeaderExtensionParameters {
                     uri: RtpHeaderExtensionUri::VideoOrientation,
                     id: 11,
@@ -556,6 +566,11 @@ fn pipe_to_router_succeeds_with_video() {
                     id: 7,
                     encrypt: false,
                 },
+                RtpHeaderExtensionParameters {
+                    uri: RtpHeaderExtensionUri::DependencyDescriptor,
+                    id: 8,
+                    encrypt: false,
+                },
                 RtpHeaderExtensionParameters {
                     uri: RtpHeaderExtensionUri::VideoOrientation,
                     id: 11,
@@ -758,6 +773,11 @@ fn create_with_enable_rtx_succeeds() {
                     id: 7,
                     encrypt: false,
                 },
+                RtpHeaderExtensionParameters {
+                    uri: RtpHeaderExtensionUri::DependencyDescriptor,
+                    id: 8,
+                    encrypt: false,
+                },
                 RtpHeaderExtensionParameters {
                     uri: RtpHeaderExtensionUri::VideoOrientation,
                     id: 11,
@@ -1253,3 +1273,110 @@ fn pipe_to_router_called_twice_generates_single_pair() {
         }
     });
 }
+
+#[test]
+fn pipe_to_router_delivers_data_between_workers_of_same_process() {
+    future::block_on(async move {
+        let (_worker1, _worker2, router1, router2, _transport1, _transport2) = init().await;
+
+        let direct_transport1 = router1
+            .create_direct_transport(DirectTransportOptions::default())
+            .await
+            .expect("Failed to create direct transport1");
+
+        let direct_transport2 = router2
+            .create_direct_transport(DirectTransportOptions::default())
+            .await
+            .expect("Failed to create direct transport2");
+
+        let data_producer = direct_transport1
+            .produce_data(DataProducerOptions::new_direct())
+            .await
+            .expect("Failed to produce data");
+
+        // Both workers run in this process, so their PipeTransports hand
+        // packets to each other through in-memory rings.
+        router1
+            .pipe_data_producer_to_router(
+                data_producer.id(),
+                PipeToRouterOptions::new(router2.clone()),
+            )
+            .await
+            .expect("Failed to pipe data producer to router");
+
+        let data_consumer = direct_transport2
+            .consume_data(DataConsumerOptions::new_direct(data_producer.id(), None))
+            .await
+            .expect("Failed to consume data");
+
+        let received_messages = Arc::new(Mutex::new(Vec::<String>::new()));
+
+        let _handler = data_consumer.on_message({
+            let received_messages = Arc::clone(&received_messages);
+
+            move |message| {
+                if let WebRtcMessage::String(content) = message {
+                    received_messages
+                        .lock()
+                        .push(String::from_utf8(content.to_vec()).unwrap());
+                }
+            }
+        });
+
+        let direct_data_producer = match &data_producer {
+            DataProducer::Direct(direct_data_producer) => direct_data_producer,
+            _ => {
+                panic!("Expected direct data producer")
+            }
+        };
+
+        // Messages sent before the SCTP association between the PipeTransports
+        // is connected are lost, so send until one arrives.
+        for _ in 0..50 {
+            direct_data_producer
+                .send(
+                    WebRtcMessage::String(Cow::from("ping".as_bytes())),
+                    None,
+                    None,
+                )
+                .expect("Failed to send message");
+
+            Timer::after(Duration::from_millis(100)).await;
+
+            if !received_messages.lock().is_empty() {
+                break;
+            }
+        }
+
+        assert!(!received_messages.lock().is_empty());
+
+        received_messages.lock().clear();
+
+        let num_messages = 100_usize;
+
+        for id in 0..num_messages {
+            direct_data_producer
+                .send(
+                    WebRtcMessage::String(Cow::from(id.to_string().into_bytes())),
+                    None,
+                    None,
+                )
+                .expect("Failed to send message");
+        }
+
+        for _ in 0..50 {
+            if received_messages.lock().len() >= num_messages {
+                break;
+            }
+
+            Timer::after(Duration::from_millis(100)).await;
+        }
+
+        assert_eq!(
+            *received_messages.lock(),
+            (0..num_messages)
+                .map(|id| id.to_string())
+                .collect::<Vec<_>>(),
+        );
+    });
+}
@@ -1,8 +1,8 @@
 use futures_lite::future;
 use mediasoup::data_structures::AppData;
 use mediasoup::worker::{
-    ChannelMessageHandlers, WorkerDtlsFiles, WorkerLogLevel, WorkerLogTag, WorkerSettings,
-    WorkerUpdateSettings,
+    ChannelMessageHandlers, ChannelNotifierDump, RtpPacketBufferPoolDump, SrtpCryptoPoolDump,
+    WorkerDtlsFiles, WorkerLogLevel, WorkerLogTag, WorkerSettings, WorkerUpdateSettings,
 };
 use mediasoup::worker_manager::WorkerManager;
 use std::{env, io};
@@ -49,6 +49,7 @@ fn create_worker_succeeds() {
                 });
                 settings.libwebrtc_field_trials =
                     Some("WebRTC-Bwe-AlrLimitedBackoff/Disabled/".to_string());
+                settings.notification_batch_window = Some(10);
                 settings.app_data = AppData::new(CustomAppData { bar: 456 });
 
                 settings
@@ -105,6 +106,34 @@ fn create_worker_wrong_settings() {
 
             assert!(matches!(worker_result, Err(io::Error { .. })));
         }
+
+        {
+            let worker_result = worker_manager
+                .create_worker({
+                    let mut settings = WorkerSettings::default();
+
+                    settings.notification_batch_window = Some(1001);
+
+                    settings
+                })
+                .await;
+
+            assert!(matches!(worker_result, Err(io::Error { .. })));
+        }
+
+        {
+            let worker_result = worker_manager
+                .create_worker({
+                    let mut settings = WorkerSettings::default();
+
+                    settings.srtp_crypto_threads = 17;
+
+                    settings
+                })
+                .await;
+
+            assert!(matches!(worker_result, Err(io::Error { .. })));
+        }
     });
 }
 
@@ -153,6 +182,36 @@ fn dump_succeeds() {
                 channel_notification_handlers: vec![]
             }
         );
+        assert_eq!(
+            dump.rtp_packet_buffer_pool,
+            RtpPacketBufferPoolDump {
+                capacity: 0,
+                in_use: 0,
+                high_water_mark: 0
+            }
+        );
+        assert_eq!(
+            dump.channel_notifier,
+            ChannelNotifierDump {
+                raw_notifications: 1,
+                batched_notifications: 0,
+                coalesced_notifications: 0,
+                batches: 0
+            }
+        );
+        assert_eq!(
+            dump.srtp_crypto_pool,
+            SrtpCryptoPoolDump {
+                threads: 0,
+                protected_packets: 0,
+                inline_packets: 0,
+                failed_packets: 0,
+                queue_depth: 0,
+                max_queue_depth: 0,
+                avg_latency_ns: 0
+            }
+        );
+        assert!(dump.startup.duration_us >= dump.startup.dtls_setup_duration_us);
     });
 }
 
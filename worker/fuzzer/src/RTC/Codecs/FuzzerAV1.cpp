@@ -0,0 +1,24 @@
+#include "RTC/Codecs/FuzzerAV1.hpp"
+#include "RTC/Codecs/AV1.hpp"
+#include "RTC/Codecs/DependencyDescriptor.hpp"
+#include <algorithm> // std::min()
+
+void Fuzzer::RTC::Codecs::AV1::Fuzz(const uint8_t* data, size_t len)
+{
+	// Keep the template dependency structure across inputs as a stream does.
+	static std::unique_ptr<::RTC::Codecs::DependencyDescriptor::TemplateDependencyStructure>
+	  templateDependencyStructure;
+
+	::RTC::Codecs::DependencyDescriptor dependencyDescriptor;
+
+	// Dependency Descriptor extension values are at most 255 bytes long.
+	if (!::RTC::Codecs::DependencyDescriptor::Parse(
+	      data, std::min<size_t>(len, 255), dependencyDescriptor, templateDependencyStructure))
+	{
+		return;
+	}
+
+	::RTC::Codecs::AV1::PayloadDescriptor payloadDescriptor{};
+
+	::RTC::Codecs::AV1::Parse(data, len, payloadDescriptor, &dependencyDescriptor);
+}
@@ -28,7 +28,7 @@ void Fuzzer::RTC::RtpRetransmissionBuffer::Fuzz(const uint8_t* data, size_t len)
 
 	while (len >= 4u)
 	{
-		std::shared_ptr<::RTC::RtpPacket> sharedPacket;
+		::RTC::SharedRtpPacket sharedPacket;
 
 		// Set 'random' sequence number and timestamp.
 		packet->SetSequenceNumber(Utils::Byte::Get2Bytes(data, offset));
@@ -3,14 +3,21 @@
 
 #include "common.hpp"
 #include "Channel/ChannelSocket.hpp"
+#include "FBS/worker.h"
+#include "handles/TimerHandle.hpp"
+#include <absl/container/flat_hash_map.h>
+#include <uv.h>
 #include <string>
+#include <utility> // std::pair
+#include <vector>
 
 namespace Channel
 {
-	class ChannelNotifier
+	class ChannelNotifier : public TimerHandle::Listener
 	{
 	public:
 		explicit ChannelNotifier(Channel::ChannelSocket* channel);
+		~ChannelNotifier() override;
 
 	public:
 		flatbuffers::FlatBufferBuilder& GetBufferBuilder()
@@ -25,37 +32,63 @@ namespace Channel
 		  FBS::Notification::Body type,
 		  flatbuffers::Offset<Body>& body)
 		{
-			auto& builder     = this->bufferBuilder;
 			auto notification = FBS::Notification::CreateNotificationDirect(
-			  builder, targetId.c_str(), event, type, body.Union());
+			  this->bufferBuilder, targetId.c_str(), event, type, body.Union());
 
-			auto message =
-			  FBS::Message::CreateMessage(builder, FBS::Message::Body::Notification, notification.Union());
-
-			builder.FinishSizePrefixed(message);
-			this->channel->Send(builder.GetBufferPointer(), builder.GetSize());
-			builder.Clear();
+			Send(targetId, event, notification);
 		}
 
 		void Emit(const std::string& targetId, FBS::Notification::Event event)
 		{
-			auto& builder = ChannelNotifier::bufferBuilder;
 			auto notification =
-			  FBS::Notification::CreateNotificationDirect(builder, targetId.c_str(), event);
+			  FBS::Notification::CreateNotificationDirect(this->bufferBuilder, targetId.c_str(), event);
 
-			auto message =
-			  FBS::Message::CreateMessage(builder, FBS::Message::Body::Notification, notification.Union());
+			Send(targetId, event, notification);
+		}
 
-			builder.FinishSizePrefixed(message);
-			this->channel->Send(builder.GetBufferPointer(), builder.GetSize());
-			builder.Clear();
+		void SetBatching(bool enabled, uint64_t windowMs);
+		bool HasPendingNotifications() const
+		{
+			return !this->pendingNotifications.empty();
 		}
+		void Flush();
+		flatbuffers::Offset<FBS::Worker::ChannelNotifierDump> FillBufferDump(
+		  flatbuffers::FlatBufferBuilder& builder) const;
+
+	private:
+		void Send(
+		  const std::string& targetId,
+		  FBS::Notification::Event event,
+		  flatbuffers::Offset<FBS::Notification::Notification> notification);
+		void ScheduleFlush();
+		void CloseFlushHandles();
+
+		/* Pure virtual methods inherited from TimerHandle::Listener. */
+	public:
+		void OnTimer(TimerHandle* timer) override;
 
 	private:
 		// Passed by argument.
 		Channel::ChannelSocket* channel{ nullptr };
+		// Allocated by this.
+		TimerHandle* batchTimer{ nullptr };
+		uv_prepare_t* uvPrepareHandle{ nullptr };
+		uv_check_t* uvCheckHandle{ nullptr };
 		// Others.
 		flatbuffers::FlatBufferBuilder bufferBuilder{};
+		bool batching{ false };
+		uint64_t batchWindowMs{ 0u };
+		// Notifications already built in the buffer builder and not sent yet.
+		// Coalesced ones are null.
+		std::vector<flatbuffers::Offset<FBS::Notification::Notification>> pendingNotifications;
+		// Index of the pending notification of coalescable events by target.
+		absl::flat_hash_map<std::pair<std::string, FBS::Notification::Event>, size_t>
+		  mapCoalescableNotificationIdx;
+		// Stats.
+		uint64_t rawNotifications{ 0u };
+		uint64_t batchedNotifications{ 0u };
+		uint64_t coalescedNotifications{ 0u };
+		uint64_t batches{ 0u };
 	};
 } // namespace Channel
 
@@ -9,6 +9,8 @@
 
 namespace Channel
 {
+	class ChannelNotifier;
+
 	class ConsumerSocket : public ::UnixStreamSocketHandle
 	{
 	public:
@@ -93,6 +95,9 @@ namespace Channel
 	public:
 		void Close();
 		void SetListener(Listener* listener);
+		void SetWriteCoalescing(bool enabled);
+		void Flush();
+		void SetNotifier(ChannelNotifier* notifier);
 		void Send(const uint8_t* data, uint32_t dataLen);
 		void SendLog(const char* data, uint32_t dataLen);
 		bool CallbackRead();
@@ -108,6 +113,7 @@ namespace Channel
 	private:
 		// Passed by argument.
 		Listener* listener{ nullptr };
+		ChannelNotifier* notifier{ nullptr };
 		// Others.
 		bool closed{ false };
 		ConsumerSocket* consumerSocket{ nullptr };
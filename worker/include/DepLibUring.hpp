@@ -3,9 +3,14 @@
 
 #include "DepLibUV.hpp"
 #include "FBS/liburing.h"
+#include "RTC/RateCalculator.hpp"
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <functional>
 #include <liburing.h>
+#include <memory>
 #include <queue>
+#include <vector>
 
 class DepLibUring
 {
@@ -23,15 +28,81 @@ public:
 		struct iovec iov[2];
 		// Send callback.
 		onSendCallback* cb{ nullptr };
-		// Index in userDatas array.
+		// Index in the send buffer pool.
 		size_t idx{ 0 };
+		// Socket file descriptor.
+		int fd{ -1 };
+	};
+
+	/* Struct for data received by a multishot receive request. */
+	struct RecvData
+	{
+		const uint8_t* data{ nullptr };
+		size_t len{ 0u };
+		// Sender address (just for datagram sockets).
+		const struct sockaddr* addr{ nullptr };
+	};
+
+	class RecvListener
+	{
+	public:
+		virtual ~RecvListener() = default;
+
+	public:
+		/**
+		 * Called with consecutive completions of the receive request. Data
+		 * points to provided buffers so it's only valid during the call.
+		 */
+		virtual void OnLibUringRecv(const RecvData* recvs, size_t count) = 0;
+		/**
+		 * Called if the receive request failed (err is a negative errno) or, in
+		 * stream sockets, if the peer closed the connection (err is 0). The
+		 * request has already been released so it must not be stopped.
+		 */
+		virtual void OnLibUringRecvError(int err) = 0;
+	};
+
+	/* Struct for a multishot receive request of a socket. */
+	struct RecvRequest
+	{
+		// Listener (null once stopped).
+		RecvListener* listener{ nullptr };
+		// Socket file descriptor.
+		int fd{ -1 };
+		// Index in the registered files table (-1 if not registered).
+		int fileIdx{ -1 };
+		// Whether it's a datagram socket (recvmsg) or a stream socket (recv).
+		bool datagram{ false };
+		// Whether there is a submitted request in the kernel.
+		bool armed{ false };
+		// msghdr for recvmsg, it describes the layout of the provided buffers.
+		struct msghdr msg
+		{
+		};
 	};
 
 	/* Number of submission queue entries (SQE). */
 	static constexpr size_t QueueDepth{ 1024 * 4 };
+	/* Submit once this number of SQEs are ready instead of waiting for Submit(). */
+	static constexpr size_t SubmitHighWatermark{ QueueDepth * 3 / 4 };
 	static constexpr size_t SendBufferSize{ 1500 };
+	/* The send buffer pool grows in chunks of this number of buffers. */
+	static constexpr size_t SendBufferChunkSize{ 1024 };
+	static constexpr size_t MaxSendBuffers{ QueueDepth * 4 };
+	/* Max number of in-flight sends of a single socket. */
+	static constexpr size_t MaxSocketInflightSends{ MaxSendBuffers / 4 };
+	/* Number of provided buffers for receiving (must be power of 2). */
+	static constexpr size_t RecvBufferCount{ 256 };
+	// NOTE: Datagram buffers also hold the io_uring_recvmsg_out header and the
+	// sender address, so there is room for datagrams of max size (as when
+	// receiving via libuv). Pages of a buffer are only touched (and become
+	// resident) when a datagram as big is received.
+	static constexpr size_t RecvBufferSize{ 65536 + 256 };
+	/* Number of entries in the registered files table. */
+	static constexpr size_t MaxRegisteredFiles{ 1024 };
 
 	using SendBuffer = uint8_t[SendBufferSize];
+	using RecvBuffer = uint8_t[RecvBufferSize];
 
 	static void ClassInit();
 	static void ClassDestroy();
@@ -48,6 +119,13 @@ public:
 	static void Submit();
 	static void SetActive();
 	static bool IsActive();
+	/**
+	 * Start receiving from the given socket with a multishot receive request.
+	 * Returns null if receiving via io_uring is not available, so libuv must
+	 * be used instead.
+	 */
+	static RecvRequest* StartRecv(int sockfd, bool datagram, RecvListener* listener);
+	static void StopRecv(RecvRequest* request);
 
 	class LibUring;
 
@@ -62,7 +140,7 @@ public:
 	public:
 		LibUring();
 		~LibUring();
-		flatbuffers::Offset<FBS::LibUring::Dump> FillBuffer(flatbuffers::FlatBufferBuilder& builder) const;
+		flatbuffers::Offset<FBS::LibUring::Dump> FillBuffer(flatbuffers::FlatBufferBuilder& builder);
 		void StartPollingCQEs();
 		void StopPollingCQEs();
 		uint8_t* GetSendBuffer();
@@ -88,6 +166,19 @@ public:
 		{
 			return this->zeroCopyEnabled;
 		}
+		/**
+		 * Further sends don't use zero copy. Called if registering send buffers
+		 * fails (zero copy sends may be in flight).
+		 */
+		void DisableZeroCopy();
+		size_t GetSendBufferCount() const
+		{
+			return this->sendBufferChunks.size() * SendBufferChunkSize;
+		}
+		size_t GetAvailableSendBufferCount() const
+		{
+			return this->availableUserDataEntries.size();
+		}
 		io_uring* GetRing()
 		{
 			return std::addressof(this->ring);
@@ -96,21 +187,31 @@ public:
 		{
 			return this->efd;
 		}
-		void ReleaseUserDataEntry(size_t idx)
-		{
-			this->availableUserDataEntries.push(idx);
-		}
+		void ReleaseUserDataEntry(size_t idx);
+		RecvRequest* StartRecv(int sockfd, bool datagram, RecvListener* listener);
+		void StopRecv(RecvRequest* request);
+		void OnRecvCompletion(struct io_uring_cqe* cqe);
+		void FlushRecvs();
+		void ArmPendingRecvs();
 
 	private:
 		void SetInactive()
 		{
 			this->active = false;
 		}
-		UserData* GetUserData();
-		bool IsDataInSendBuffers(const uint8_t* data) const
+		UserData* GetUserData(int sockfd);
+		UserData* GetUserDataEntry(size_t idx)
 		{
-			return data >= this->sendBuffers[0] && data <= this->sendBuffers[DepLibUring::QueueDepth - 1];
+			return std::addressof(
+			  this->sendBufferChunks[idx / SendBufferChunkSize]->userDatas[idx % SendBufferChunkSize]);
 		}
+		bool AddSendBufferChunk();
+		void OnSqePrepared();
+		void SetupRecv();
+		io_uring_sqe* GetSqe();
+		bool ArmRecv(RecvRequest* request);
+		void ReleaseRecvRequest(RecvRequest* request);
+		void ReturnRecvBuffer(uint16_t bid);
 
 	private:
 		// io_uring instance.
@@ -123,20 +224,59 @@ public:
 		bool active{ false };
 		// Whether Zero Copy feature is enabled.
 		bool zeroCopyEnabled{ true };
-		// Pre-allocated UserData's.
-		UserData userDatas[QueueDepth]{};
+		/* Chunk of SendBuffer's and their UserData's. */
+		struct SendBufferChunk
+		{
+			UserData userDatas[SendBufferChunkSize]{};
+			SendBuffer sendBuffers[SendBufferChunkSize];
+		};
+
+		// Send buffer pool, it grows on demand up to MaxSendBuffers.
+		std::vector<std::unique_ptr<SendBufferChunk>> sendBufferChunks;
 		// Indexes of available UserData entries.
 		std::queue<size_t> availableUserDataEntries;
-		// Pre-allocated SendBuffer's.
-		SendBuffer sendBuffers[QueueDepth];
-		// iovec structs to be registered for Zero Copy.
-		struct iovec iovecs[QueueDepth];
+		// In-flight sends per socket.
+		absl::flat_hash_map<int, size_t> mapSocketInflightSends;
 		// Submission queue entry process count.
 		uint64_t sqeProcessCount{ 0u };
 		// Submission queue entry miss count.
 		uint64_t sqeMissCount{ 0u };
 		// User data miss count.
 		uint64_t userDataMissCount{ 0u };
+		// Sends refused because the socket has too many in-flight sends.
+		uint64_t socketBackpressureCount{ 0u };
+		// Submissions due to SubmitHighWatermark.
+		uint64_t highWatermarkSubmitCount{ 0u };
+		// Miss rates (per second).
+		RTC::RateCalculator sqeMissRate{ 1000u, 1000.0f };
+		RTC::RateCalculator userDataMissRate{ 1000u, 1000.0f };
+		// Whether receiving via io_uring is enabled.
+		bool recvEnabled{ false };
+		// Ring of provided buffers for receiving.
+		io_uring_buf_ring* recvBufRing{ nullptr };
+		// Pre-allocated RecvBuffer's.
+		RecvBuffer recvBuffers[RecvBufferCount];
+		// Indexes of available entries in the registered files table.
+		std::queue<int> availableFileIndexes;
+		// Active receive requests.
+		absl::flat_hash_set<RecvRequest*> recvRequests;
+		// Request whose received data is being collected.
+		RecvRequest* pendingRecvRequest{ nullptr };
+		// Received data of pendingRecvRequest and the buffers holding it.
+		std::vector<RecvData> pendingRecvs;
+		std::vector<uint16_t> pendingRecvBufferIds;
+		// Requests whose multishot receive ended and must be submitted again.
+		std::vector<RecvRequest*> recvRequestsToArm;
+		// Received data count.
+		uint64_t recvCount{ 0u };
+		// Received bytes.
+		uint64_t recvBytes{ 0u };
+		// Truncated datagrams count.
+		uint64_t recvTruncatedCount{ 0u };
+		// Times that a receive request ran out of provided buffers.
+		uint64_t recvBufferMissCount{ 0u };
+		// Receive requests not using a registered file.
+		uint64_t recvFileMissCount{ 0u };
 	};
 };
 
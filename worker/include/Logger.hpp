@@ -72,11 +72,13 @@
  *
  *   Logs an error if the current log level is satisfied (or if the current
  *   source file defines the MS_LOG_DEV_LEVEL macro with value >= 1). Must just
- *   be used for internal errors that should not happen.
+ *   be used for internal errors that should not happen. Messages kept by
+ *   Channel write coalescing are written right away.
  *
  * MS_ABORT(...)
  *
- *   Logs the given error to stderr and aborts the process.
+ *   Writes messages kept by Channel write coalescing, logs the given error to
+ *   stderr and aborts the process.
  *
  * MS_ASSERT(condition, ...)
  *
@@ -145,6 +147,7 @@ class Logger
 {
 public:
 	static void ClassInit(Channel::ChannelSocket* channel);
+	static void Flush();
 
 public:
 	static const uint64_t Pid;
@@ -415,6 +418,7 @@ public:
 		{ \
 			const int loggerWritten = std::snprintf(Logger::buffer, Logger::BufferSize, "E" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			Logger::channel->Flush(); \
 		} \
 	} \
 	while (false)
@@ -433,6 +437,7 @@ public:
 #define MS_ABORT(desc, ...) \
 	do \
 	{ \
+		Logger::Flush(); \
 		std::fprintf(stderr, "(ABORT) " _MS_LOG_STR_DESC desc _MS_LOG_SEPARATOR_CHAR_STD, _MS_LOG_ARG, ##__VA_ARGS__); \
 		std::fflush(stderr); \
 		std::abort(); \
@@ -0,0 +1,126 @@
+#ifndef MS_RTC_CODECS_AV1_HPP
+#define MS_RTC_CODECS_AV1_HPP
+
+#include "common.hpp"
+#include "RTC/Codecs/DependencyDescriptor.hpp"
+#include "RTC/Codecs/PayloadDescriptorHandler.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/SeqManager.hpp"
+#include <memory>
+
+/* https://aomediacodec.github.io/av1-rtp-spec/#44-av1-aggregation-header
+ * AV1 Aggregation Header
+
+      0 1 2 3 4 5 6 7
+     +-+-+-+-+-+-+-+-+
+     |Z|Y| W |N|-|-|-|
+     +-+-+-+-+-+-+-+-+
+
+ * Spatial and temporal layers, frame boundaries and frame dependencies are
+ * signaled by the Dependency Descriptor RTP header extension. Without it just
+ * the start of a new coded video sequence (N bit) is known.
+ */
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		class AV1
+		{
+		public:
+			struct PayloadDescriptor : public RTC::Codecs::PayloadDescriptor
+			{
+				/* Pure virtual methods inherited from RTC::Codecs::PayloadDescriptor. */
+				~PayloadDescriptor() = default;
+
+				void Dump() const override;
+
+				// Aggregation header.
+				uint8_t z : 1; // Z: First OBU element is a continuation.
+				uint8_t y : 1; // Y: Last OBU element will continue in next packet.
+				uint8_t w : 2; // W: Number of OBU elements.
+				uint8_t n : 1; // N: First packet of a coded video sequence.
+				// Dependency Descriptor header extension.
+				RTC::Codecs::DependencyDescriptor dependencyDescriptor;
+				// Parsed values.
+				bool hasDependencyDescriptor{ false };
+				bool isKeyFrame{ false };
+			};
+
+		public:
+			static bool Parse(
+			  const uint8_t* data,
+			  size_t len,
+			  AV1::PayloadDescriptor& payloadDescriptor,
+			  const RTC::Codecs::DependencyDescriptor* dependencyDescriptor = nullptr);
+			// NOTE: Unlike other codecs, the payload descriptor must be parsed when
+			// the packet is received since the Dependency Descriptor of each packet
+			// depends on the template dependency structure of previous ones.
+			static void ProcessRtpPacket(
+			  RTC::RtpPacket* packet,
+			  std::unique_ptr<RTC::Codecs::DependencyDescriptor::TemplateDependencyStructure>&
+			    templateDependencyStructure);
+
+		public:
+			class EncodingContext : public RTC::Codecs::EncodingContext
+			{
+			public:
+				explicit EncodingContext(RTC::Codecs::EncodingContext::Params& params)
+				  : RTC::Codecs::EncodingContext(params)
+				{
+				}
+				~EncodingContext() = default;
+
+				/* Pure virtual methods inherited from RTC::Codecs::EncodingContext. */
+			public:
+				void SyncRequired() override
+				{
+					this->syncRequired = true;
+				}
+
+			public:
+				// Highest frame number forwarded so far. Packets of older frames are
+				// retransmissions or reordered ones and are not filtered.
+				// NOTE: Frame numbers are not rewritten.
+				uint16_t maxFrameNumber{ 0u };
+				bool syncRequired{ false };
+			};
+
+			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
+			{
+			public:
+				explicit PayloadDescriptorHandler(const PayloadDescriptor& payloadDescriptor);
+				~PayloadDescriptorHandler() = default;
+
+			public:
+				void Dump() const override
+				{
+					this->payloadDescriptor.Dump();
+				}
+				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker) override;
+				void Restore(uint8_t* data) override;
+				uint8_t GetSpatialLayer() const override
+				{
+					return this->payloadDescriptor.hasDependencyDescriptor
+					         ? this->payloadDescriptor.dependencyDescriptor.spatialId
+					         : 0u;
+				}
+				uint8_t GetTemporalLayer() const override
+				{
+					return this->payloadDescriptor.hasDependencyDescriptor
+					         ? this->payloadDescriptor.dependencyDescriptor.temporalId
+					         : 0u;
+				}
+				bool IsKeyFrame() const override
+				{
+					return this->payloadDescriptor.isKeyFrame;
+				}
+
+			private:
+				PayloadDescriptor payloadDescriptor;
+			};
+		};
+	} // namespace Codecs
+} // namespace RTC
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef MS_RTC_CODECS_DEPENDENCY_DESCRIPTOR_HPP
+#define MS_RTC_CODECS_DEPENDENCY_DESCRIPTOR_HPP
+
+#include "common.hpp"
+#include <array>
+#include <memory>
+
+/* https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension
+ * Dependency Descriptor RTP header extension.
+
+   Mandatory Descriptor Fields
+   ===========================
+
+      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3
+     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+     |S|E|template_id|         frame_number          |
+     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   Extended Descriptor Fields (if the extension is longer than 3 bytes)
+   ====================================================================
+
+     template_dependency_structure_present_flag  f(1)
+     active_decode_targets_present_flag          f(1)
+     custom_dtis_flag                            f(1)
+     custom_fdiffs_flag                          f(1)
+     custom_chains_flag                          f(1)
+     template_dependency_structure()             (if present flag)
+     active_decode_targets_bitmask               f(DtCnt) (if present flag)
+     frame_dependency_definition()
+ */
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		class DependencyDescriptor
+		{
+		public:
+			static constexpr size_t MaxTemplates{ 64 };
+			static constexpr size_t MaxDecodeTargets{ 32 };
+			static constexpr size_t MaxSpatialLayers{ 4 };
+			static constexpr size_t MaxTemporalLayers{ 8 };
+
+			// Decode Target Indication values.
+			enum class Dti : uint8_t
+			{
+				NOT_PRESENT = 0,
+				DISCARDABLE = 1,
+				SWITCH      = 2,
+				REQUIRED    = 3
+			};
+
+			// Template Dependency Structure. It's sent (usually along with key
+			// frames) in a few packets and must be kept by the receiver to parse
+			// the following ones, so it's owned by the stream rather than by packets.
+			struct TemplateDependencyStructure
+			{
+				Dti GetTemplateDti(uint8_t templateIndex, uint8_t decodeTarget) const
+				{
+					return static_cast<Dti>(
+					  (this->templateDtis[templateIndex] >> (2 * decodeTarget)) & 0x03);
+				}
+
+				uint8_t templateIdOffset{ 0u };
+				uint8_t templateCount{ 0u };
+				uint8_t decodeTargetCount{ 0u };
+				uint8_t chainCount{ 0u };
+				uint8_t maxSpatialId{ 0u };
+				uint8_t maxTemporalId{ 0u };
+				// Currently active decode targets. It persists across packets until a
+				// new bitmask or a new structure is received.
+				uint32_t activeDecodeTargetsBitmask{ 0u };
+				// Per template values.
+				std::array<uint8_t, MaxTemplates> templateSpatialIds{};
+				std::array<uint8_t, MaxTemplates> templateTemporalIds{};
+				std::array<uint8_t, MaxTemplates> templateFdiffCounts{};
+				// 2 bits per decode target.
+				std::array<uint64_t, MaxTemplates> templateDtis{};
+				// Per decode target values (derived from the templates).
+				std::array<uint8_t, MaxDecodeTargets> decodeTargetSpatialIds{};
+				std::array<uint8_t, MaxDecodeTargets> decodeTargetTemporalIds{};
+			};
+
+		public:
+			// NOTE: If the extension carries a template dependency structure, the
+			// given one is replaced with it. Otherwise the given one is used to
+			// resolve the frame dependency template. Returns false if the extension
+			// cannot be parsed (i.e. when no valid structure has been received yet).
+			static bool Parse(
+			  const uint8_t* data,
+			  size_t len,
+			  DependencyDescriptor& dependencyDescriptor,
+			  std::unique_ptr<TemplateDependencyStructure>& templateDependencyStructure);
+
+		public:
+			void Dump() const;
+
+		public:
+			// Mandatory fields.
+			bool startOfFrame{ false };
+			bool endOfFrame{ false };
+			uint8_t templateId{ 0u };
+			uint16_t frameNumber{ 0u };
+			// Values resolved from the frame dependency template (or custom fields).
+			uint8_t spatialId{ 0u };
+			uint8_t temporalId{ 0u };
+			uint8_t fdiffCount{ 0u };
+			uint32_t activeDecodeTargetsBitmask{ 0u };
+			// Parsed values.
+			bool hasTemplateDependencyStructure{ false };
+			// The frame doesn't reference any other frame.
+			bool independent{ false };
+			// Spatial layers (one bit each) having some decode target the frame is
+			// part of (this is, whose DTI is not NOT_PRESENT).
+			uint8_t presentSpatialLayers{ 0u };
+			// The frame is a switch point for the decode target of its own layers,
+			// so a receiver can start decoding that decode target from this frame.
+			bool switchingUpPoint{ false };
+		};
+	} // namespace Codecs
+} // namespace RTC
+
+#endif
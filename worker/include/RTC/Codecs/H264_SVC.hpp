@@ -47,10 +47,16 @@ namespace RTC
 			  size_t len,
 			  RTC::RtpPacket::FrameMarking* frameMarking = nullptr,
 			  uint8_t frameMarkingLen                    = 0);
-			static std::unique_ptr<H264_SVC::PayloadDescriptor> ParseSingleNalu(
+			static bool Parse(
 			  const uint8_t* data,
 			  size_t len,
-			  std::unique_ptr<H264_SVC::PayloadDescriptor> payloadDescriptor,
+			  H264_SVC::PayloadDescriptor& payloadDescriptor,
+			  RTC::RtpPacket::FrameMarking* frameMarking = nullptr,
+			  uint8_t frameMarkingLen                    = 0);
+			static bool ParseSingleNalu(
+			  const uint8_t* data,
+			  size_t len,
+			  H264_SVC::PayloadDescriptor& payloadDescriptor,
 			  bool isStartBit); // useful in FU packet to indicate first packet. Set to true for other packets
 			static void ProcessRtpPacket(RTC::RtpPacket* packet);
 
@@ -79,33 +85,33 @@ namespace RTC
 			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
 			{
 			public:
-				explicit PayloadDescriptorHandler(PayloadDescriptor* payloadDescriptor);
+				explicit PayloadDescriptorHandler(const PayloadDescriptor& payloadDescriptor);
 				~PayloadDescriptorHandler() = default;
 
 			public:
 				void Dump() const override
 				{
-					this->payloadDescriptor->Dump();
+					this->payloadDescriptor.Dump();
 				}
 				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker) override;
 				void Restore(uint8_t* data) override;
 				uint8_t GetSpatialLayer() const override
 				{
 					// return 0u;
-					return this->payloadDescriptor->hasSlIndex ? this->payloadDescriptor->slIndex : 0u;
+					return this->payloadDescriptor.hasSlIndex ? this->payloadDescriptor.slIndex : 0u;
 				}
 				uint8_t GetTemporalLayer() const override
 				{
-					// return this->payloadDescriptor->tid;
-					return this->payloadDescriptor->hasTlIndex ? this->payloadDescriptor->tlIndex : 0u;
+					// return this->payloadDescriptor.tid;
+					return this->payloadDescriptor.hasTlIndex ? this->payloadDescriptor.tlIndex : 0u;
 				}
 				bool IsKeyFrame() const override
 				{
-					return this->payloadDescriptor->isKeyFrame;
+					return this->payloadDescriptor.isKeyFrame;
 				}
 
 			private:
-				std::unique_ptr<PayloadDescriptor> payloadDescriptor;
+				PayloadDescriptor payloadDescriptor;
 			};
 		};
 	} // namespace Codecs
@@ -2,6 +2,8 @@
 #define MS_RTC_CODECS_TOOLS_HPP
 
 #include "common.hpp"
+#include "RTC/Codecs/AV1.hpp"
+#include "RTC/Codecs/DependencyDescriptor.hpp"
 #include "RTC/Codecs/H264.hpp"
 #include "RTC/Codecs/H264_SVC.hpp"
 #include "RTC/Codecs/Opus.hpp"
@@ -30,6 +32,7 @@ namespace RTC
 							case RTC::RtpCodecMimeType::Subtype::VP9:
 							case RTC::RtpCodecMimeType::Subtype::H264:
 							case RTC::RtpCodecMimeType::Subtype::H264_SVC:
+							case RTC::RtpCodecMimeType::Subtype::AV1:
 								return true;
 							default:
 								return false;
@@ -43,7 +46,14 @@ namespace RTC
 				}
 			}
 
-			static void ProcessRtpPacket(RTC::RtpPacket* packet, const RTC::RtpCodecMimeType& mimeType)
+			// NOTE: The payload descriptor is not parsed here but the first time that
+			// the packet is asked for it. The exception is AV1 whose Dependency
+			// Descriptor depends on the template dependency structure of the stream.
+			static void ProcessRtpPacket(
+			  RTC::RtpPacket* packet,
+			  const RTC::RtpCodecMimeType& mimeType,
+			  std::unique_ptr<RTC::Codecs::DependencyDescriptor::TemplateDependencyStructure>&
+			    templateDependencyStructure)
 			{
 				switch (mimeType.type)
 				{
@@ -53,27 +63,34 @@ namespace RTC
 						{
 							case RTC::RtpCodecMimeType::Subtype::VP8:
 							{
-								RTC::Codecs::VP8::ProcessRtpPacket(packet);
+								packet->SetPayloadDescriptorParser(RTC::Codecs::VP8::ProcessRtpPacket);
 
 								break;
 							}
 
 							case RTC::RtpCodecMimeType::Subtype::VP9:
 							{
-								RTC::Codecs::VP9::ProcessRtpPacket(packet);
+								packet->SetPayloadDescriptorParser(RTC::Codecs::VP9::ProcessRtpPacket);
 
 								break;
 							}
 
 							case RTC::RtpCodecMimeType::Subtype::H264:
 							{
-								RTC::Codecs::H264::ProcessRtpPacket(packet);
+								packet->SetPayloadDescriptorParser(RTC::Codecs::H264::ProcessRtpPacket);
 
 								break;
 							}
 							case RTC::RtpCodecMimeType::Subtype::H264_SVC:
 							{
-								RTC::Codecs::H264_SVC::ProcessRtpPacket(packet);
+								packet->SetPayloadDescriptorParser(RTC::Codecs::H264_SVC::ProcessRtpPacket);
+
+								break;
+							}
+
+							case RTC::RtpCodecMimeType::Subtype::AV1:
+							{
+								RTC::Codecs::AV1::ProcessRtpPacket(packet, templateDependencyStructure);
 
 								break;
 							}
@@ -89,7 +106,7 @@ namespace RTC
 							case RTC::RtpCodecMimeType::Subtype::OPUS:
 							case RTC::RtpCodecMimeType::Subtype::MULTIOPUS:
 							{
-								RTC::Codecs::Opus::ProcessRtpPacket(packet);
+								packet->SetPayloadDescriptorParser(RTC::Codecs::Opus::ProcessRtpPacket);
 
 								break;
 							}
@@ -121,6 +138,7 @@ namespace RTC
 								{
 									case RTC::RtpCodecMimeType::Subtype::VP8:
 									case RTC::RtpCodecMimeType::Subtype::H264:
+									case RTC::RtpCodecMimeType::Subtype::AV1:
 										return true;
 									default:
 										return false;
@@ -144,6 +162,7 @@ namespace RTC
 								{
 									case RTC::RtpCodecMimeType::Subtype::VP9:
 									case RTC::RtpCodecMimeType::Subtype::H264_SVC:
+									case RTC::RtpCodecMimeType::Subtype::AV1:
 										return true;
 									default:
 										return false;
@@ -181,6 +200,8 @@ namespace RTC
 								return new RTC::Codecs::H264::EncodingContext(params);
 							case RTC::RtpCodecMimeType::Subtype::H264_SVC:
 								return new RTC::Codecs::H264_SVC::EncodingContext(params);
+							case RTC::RtpCodecMimeType::Subtype::AV1:
+								return new RTC::Codecs::AV1::EncodingContext(params);
 							default:
 								return nullptr;
 						}
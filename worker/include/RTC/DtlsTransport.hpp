@@ -9,6 +9,7 @@
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 #include <absl/container/flat_hash_map.h>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -58,6 +59,10 @@ namespace RTC
 			const char* name;
 		};
 
+	private:
+		struct HandshakeJob;
+		class HandshakeOffloader;
+
 	public:
 		class Listener
 		{
@@ -116,10 +121,23 @@ namespace RTC
 		{
 			return DtlsTransport::localFingerprints;
 		}
+		// Whether this worker generated its certificate (rather than reading it
+		// from files or the cache file or taking it from another worker).
+		static bool IsCertificateGenerated()
+		{
+			return DtlsTransport::certificateGenerated;
+		}
+		// Time taken by ClassInit() (certificate, SSL context and fingerprints).
+		static uint64_t GetSetupDurationUs()
+		{
+			return DtlsTransport::setupDurationUs;
+		}
 
 	private:
 		static void GenerateCertificateAndPrivateKey();
 		static void ReadCertificateAndPrivateKeyFromFiles();
+		static bool ReadCertificateAndPrivateKeyFromCache();
+		static void WriteCertificateAndPrivateKeyToCache();
 		static void CreateSslCtx();
 		static void GenerateFingerprints();
 
@@ -127,6 +145,10 @@ namespace RTC
 		thread_local static X509* certificate;
 		thread_local static EVP_PKEY* privateKey;
 		thread_local static SSL_CTX* sslCtx;
+		thread_local static bool usingSharedContext;
+		thread_local static bool certificateGenerated;
+		thread_local static uint64_t setupDurationUs;
+		thread_local static HandshakeOffloader* handshakeOffloader;
 		thread_local static uint8_t sslReadBuffer[];
 		static absl::flat_hash_map<std::string, Role> string2Role;
 		static absl::flat_hash_map<std::string, FingerprintAlgorithm> string2FingerprintAlgorithm;
@@ -174,12 +196,16 @@ namespace RTC
 			return false;
 		}
 		void Reset();
+		void CancelHandshakeJob();
+		void OnHandshakeJobDone();
 		bool CheckStatus(int returnCode);
+		bool CheckSslError(int err);
 		bool SetTimeout();
 		bool ProcessHandshake();
 		bool CheckRemoteFingerprint();
 		void ExtractSrtpKeys(RTC::SrtpSession::CryptoSuite srtpCryptoSuite);
 		std::optional<RTC::SrtpSession::CryptoSuite> GetNegotiatedSrtpCryptoSuite();
+		void HandleSslInfo(int where, int ret, const char* state);
 
 		/* Callbacks fired by OpenSSL events. */
 	public:
@@ -204,6 +230,10 @@ namespace RTC
 		bool handshakeDone{ false };
 		bool handshakeDoneNow{ false };
 		std::string remoteCert;
+		// DTLS data being processed in the handshake offload thread (if any).
+		HandshakeJob* handshakeJob{ nullptr };
+		// DTLS data received while a handshake job was in progress.
+		std::deque<std::vector<uint8_t>> pendingHandshakeData;
 	};
 } // namespace RTC
 
@@ -133,6 +133,9 @@ namespace RTC
 		// Others.
 		std::string oldUsernameFragment;
 		std::string oldPassword;
+		// HMAC SHA1 contexts keyed with password and oldPassword.
+		EVP_MAC_CTX* hmacSha1Ctx{ nullptr };
+		EVP_MAC_CTX* oldHmacSha1Ctx{ nullptr };
 		IceState state{ IceState::NEW };
 		uint32_t remoteNomination{ 0u };
 		std::list<RTC::TransportTuple> tuples;
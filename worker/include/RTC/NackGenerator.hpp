@@ -5,8 +5,7 @@
 #include "RTC/RtpPacket.hpp"
 #include "RTC/SeqManager.hpp"
 #include "handles/TimerHandle.hpp"
-#include <map>
-#include <set>
+#include <deque>
 #include <vector>
 
 namespace RTC
@@ -25,17 +24,11 @@ namespace RTC
 		};
 
 	private:
+		// NOTE: The seq of a NACK item is given by its slot in the NACK ring. The
+		// NACK is sent once a packet with that same or higher seq is received.
 		struct NackInfo
 		{
-			NackInfo() = default;
-			explicit NackInfo(uint64_t createdAtMs, uint16_t seq, uint16_t sendAtSeq)
-			  : createdAtMs(createdAtMs), seq(seq), sendAtSeq(sendAtSeq)
-			{
-			}
-
 			uint64_t createdAtMs{ 0u };
-			uint16_t seq{ 0u };
-			uint16_t sendAtSeq{ 0u };
 			uint64_t sentAtMs{ 0u };
 			uint8_t retries{ 0u };
 		};
@@ -53,7 +46,7 @@ namespace RTC
 		bool ReceivePacket(RTC::RtpPacket* packet, bool isRecovered);
 		size_t GetNackListLength() const
 		{
-			return this->nackList.size();
+			return this->nackListLength;
 		}
 		void UpdateRtt(uint32_t rtt)
 		{
@@ -63,6 +56,23 @@ namespace RTC
 
 	private:
 		void AddPacketsToNackList(uint16_t seqStart, uint16_t seqEnd);
+		bool HasNackItem(uint16_t seq) const
+		{
+			const uint16_t offset = seq - this->nackStartSeq;
+			const size_t idx      = seq & this->nackMask;
+
+			return this->nackListLength != 0u && offset <= this->nackMask &&
+			       (this->nackBitmap[idx >> 6] & (uint64_t{ 1u } << (idx & 63u))) != 0u;
+		}
+		NackInfo& GetNackItem(uint16_t seq)
+		{
+			return this->nackSlots[seq & this->nackMask];
+		}
+		size_t FindNextNackItem(uint16_t seq) const;
+		void RemoveNackItem(uint16_t seq);
+		bool RemoveNackItemsLowerThan(uint16_t seq);
+		void ClearNackList();
+		void EnsureNackCapacity(size_t numSlots);
 		bool RemoveNackItemsUntilKeyFrame();
 		std::vector<uint16_t> GetNackBatch(NackFilter filter);
 		void MayRunTimer() const;
@@ -78,9 +88,17 @@ namespace RTC
 		// Allocated by this.
 		TimerHandle* timer{ nullptr };
 		// Others.
-		std::map<uint16_t, NackInfo, RTC::SeqManager<uint16_t>::SeqLowerThan> nackList;
-		std::set<uint16_t, RTC::SeqManager<uint16_t>::SeqLowerThan> keyFrameList;
-		std::set<uint16_t, RTC::SeqManager<uint16_t>::SeqLowerThan> recoveredList;
+		// NACK list: ring of NACK items indexed by `seq & nackMask` plus a bitmap
+		// telling which slots hold an item. Items span from nackStartSeq (the
+		// oldest one) up to lastSeq, which never exceeds the ring capacity.
+		std::vector<NackInfo> nackSlots;
+		std::vector<uint64_t> nackBitmap;
+		size_t nackMask{ 0u };
+		uint16_t nackStartSeq{ 0u };
+		size_t nackListLength{ 0u };
+		// Seqs sorted from oldest to newest.
+		std::deque<uint16_t> keyFrameList;
+		std::deque<uint16_t> recoveredList;
 		bool started{ false };
 		uint16_t lastSeq{ 0u }; // Seq number of last valid packet.
 		uint32_t rtt{ 0u };     // Round trip time (ms).
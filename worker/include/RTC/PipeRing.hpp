@@ -0,0 +1,106 @@
+#ifndef MS_RTC_PIPE_RING_HPP
+#define MS_RTC_PIPE_RING_HPP
+
+#include "common.hpp"
+#include <uv.h>
+#include <atomic>
+#include <memory> // std::unique_ptr, std::enable_shared_from_this
+#include <mutex>
+#include <string>
+
+namespace RTC
+{
+	// Lock-free single producer single consumer queue of packets between two
+	// threads of the same process. The consumer thread owns the ring and is
+	// told about queued packets through an uv_async handle of its loop. Its
+	// buffer is allocated when a producer claims the ring. Must be owned by a
+	// std::shared_ptr.
+	class PipeRing : public std::enable_shared_from_this<PipeRing>
+	{
+	public:
+		class Listener
+		{
+		public:
+			virtual ~Listener() = default;
+
+		public:
+			virtual void OnPipeRingPacket(RTC::PipeRing* ring, const uint8_t* data, size_t len) = 0;
+		};
+
+	public:
+		// Size of the buffer holding queued packets (and their lengths).
+		static constexpr size_t Capacity{ 1024u * 1024u };
+		// Max size of a queued packet.
+		static constexpr size_t MaxPacketSize{ 65536u };
+
+	public:
+		// Must be called in the consumer thread. May throw.
+		explicit PipeRing(Listener* listener);
+		~PipeRing();
+
+	public:
+		/**
+		 * Called by the consumer thread when it goes away. Packets pushed later
+		 * are dropped and queued ones are discarded.
+		 */
+		void Close();
+		bool IsClosed() const
+		{
+			return this->closed.load(std::memory_order_acquire);
+		}
+		/**
+		 * Makes the calling thread the producer of the ring. The given key
+		 * identifies it for the consumer. Returns false if the ring is closed or
+		 * already has a producer.
+		 */
+		bool ClaimProducer(const std::string& producerKey);
+		void ReleaseProducer();
+		/**
+		 * Called by the consumer. Just packets of a producer that claimed the
+		 * ring with the given key are delivered, others are discarded.
+		 */
+		void AcceptProducer(const std::string& producerKey);
+		/**
+		 * Called by the producer. Returns false (and the packet is dropped) if
+		 * the ring is closed or full.
+		 */
+		bool Push(const uint8_t* data, size_t len);
+		size_t GetDroppedCount() const
+		{
+			return this->droppedCount.load(std::memory_order_relaxed);
+		}
+
+		/* Callbacks fired by UV events. */
+	public:
+		void OnUvAsync();
+
+	private:
+		void RingDoorbell();
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Allocated by this.
+		uv_async_t* uvHandle{ nullptr };
+		std::unique_ptr<uint8_t[]> buffer;
+		// Others.
+		// Guards the producer keys and the buffer allocation (not used by Push()).
+		std::mutex mutex;
+		std::string producerKey;
+		std::string acceptedProducerKey;
+		bool hasProducer{ false };
+		std::atomic<bool> closed{ false };
+		// Set by the producer when it rings the doorbell, cleared by the consumer
+		// before draining the ring.
+		std::atomic<bool> signaled{ false };
+		// Producer threads using uvHandle. Close() waits for them before closing
+		// it.
+		std::atomic<size_t> doorbellUsers{ 0u };
+		// Byte counters (not wrapped) of the producer and the consumer.
+		alignas(64) std::atomic<size_t> head{ 0u };
+		alignas(64) std::atomic<size_t> tail{ 0u };
+		std::atomic<size_t> droppedCount{ 0u };
+	};
+} // namespace RTC
+
+#endif
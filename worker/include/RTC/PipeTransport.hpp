@@ -2,20 +2,52 @@
 #define MS_RTC_PIPE_TRANSPORT_HPP
 
 #include "FBS/pipeTransport.h"
+#include "RTC/PipeRing.hpp"
 #include "RTC/Shared.hpp"
 #include "RTC/SrtpSession.hpp"
 #include "RTC/Transport.hpp"
 #include "RTC/TransportTuple.hpp"
 #include "RTC/UdpSocket.hpp"
+#include <uv.h>
+#include <absl/container/flat_hash_map.h>
+#include <deque>
+#include <memory> // std::shared_ptr
+#include <string>
+#include <vector>
 
 namespace RTC
 {
-	class PipeTransport : public RTC::Transport, public RTC::UdpSocket::Listener
+	class PipeTransport : public RTC::Transport,
+	                      public RTC::UdpSocket::Listener,
+	                      public RTC::PipeRing::Listener
 	{
+	private:
+		struct LocalPacket
+		{
+			PipeTransport* destination{ nullptr };
+			// Set for RTP, otherwise data contains a RTCP or SCTP packet.
+			RTC::RtpPacket* rtpPacket{ nullptr };
+			std::vector<uint8_t> data;
+			bool sctp{ false };
+		};
+
 	private:
 		static RTC::SrtpSession::CryptoSuite srtpCryptoSuite;
 		static std::string srtpCryptoSuiteString;
 		static size_t srtpMasterLength;
+		// PipeTransports of this worker indexed by their local "ip:port".
+		thread_local static absl::flat_hash_map<std::string, PipeTransport*>
+		  mapLocalAddressPipeTransport;
+		thread_local static std::deque<LocalPacket> localPacketQueue;
+		// Delivers queued local packets in the next loop iteration.
+		thread_local static uv_idle_t* localPacketsIdleHandle;
+		thread_local static size_t numPipeTransports;
+
+	private:
+		static void SendLocalPacket(LocalPacket&& localPacket);
+
+	public:
+		static void DeliverLocalPackets();
 
 	public:
 		PipeTransport(
@@ -61,12 +93,21 @@ namespace RTC
 		void OnRtpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnRtcpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnSctpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void MayLinkLocalPeer();
+		void MayLinkThreadPeer();
+		void UnlinkThreadPeer();
+		bool SendToThreadPeer(const uint8_t* data, size_t len);
+		void OnLocalPacketReceived(LocalPacket& localPacket);
 
 		/* Pure virtual methods inherited from RTC::UdpSocket::Listener. */
 	public:
 		void OnUdpSocketPacketReceived(
 		  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) override;
 
+		/* Pure virtual methods inherited from RTC::PipeRing::Listener. */
+	public:
+		void OnPipeRingPacket(RTC::PipeRing* ring, const uint8_t* data, size_t len) override;
+
 	private:
 		// Allocated by this.
 		RTC::UdpSocket* udpSocket{ nullptr };
@@ -74,6 +115,17 @@ namespace RTC
 		RTC::SrtpSession* srtpRecvSession{ nullptr };
 		RTC::SrtpSession* srtpSendSession{ nullptr };
 		// Others.
+		// PipeTransport of this worker connected to this one, if any. Packets
+		// are handed to it without going through the UDP socket.
+		PipeTransport* localPeer{ nullptr };
+		// Ring in which PipeTransports of other workers (threads) of this process
+		// connected to this one put their packets.
+		std::shared_ptr<RTC::PipeRing> inboundRing;
+		// Ring of the PipeTransport of another worker (thread) of this process
+		// this one is connected to, if any.
+		std::shared_ptr<RTC::PipeRing> threadPeerRing;
+		std::string localAddressKey;
+		std::string remoteAddressKey;
 		ListenInfo listenInfo;
 		struct sockaddr_storage remoteAddrStorage
 		{
@@ -60,6 +60,27 @@ namespace RTC
 			return reinterpret_cast<uv_tcp_t*>(Bind(Protocol::TCP, ip, minPort, maxPort, flags, hash));
 		}
 		static void Unbind(uint64_t hash, uint16_t port);
+		/**
+		 * Called when the socket of a UDP shard (see SocketFlags) is about to be
+		 * closed.
+		 */
+		static void UnbindUdpShard(const std::string& ip, uint16_t port, uint8_t shardIndex);
+		/**
+		 * Makes the eBPF steering program of the UDP shards bound to the given
+		 * ip:port deliver the packets of the given remote address (ICE tuple) to
+		 * the given shard. Returns false if there is no such program (see
+		 * HasUdpShardingProgram()) or the tuple cannot be added.
+		 */
+		static bool AddUdpShardTuple(
+		  const std::string& ip, uint16_t port, uint8_t shardIndex, const struct sockaddr* remoteAddr);
+		static void RemoveUdpShardTuple(
+		  const std::string& ip, uint16_t port, uint8_t shardIndex, const struct sockaddr* remoteAddr);
+		/**
+		 * Whether UDP shard sockets bound to the given ip:port are steered by the
+		 * eBPF program. Otherwise (it requires CAP_BPF) the classic BPF fallback
+		 * one steers them by their position in the SO_REUSEPORT group.
+		 */
+		static bool HasUdpShardingProgram(const std::string& ip, uint16_t port);
 		static void Dump();
 
 	private:
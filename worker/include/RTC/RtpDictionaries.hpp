@@ -49,6 +49,7 @@ namespace RTC
 			H264_SVC,
 			X_H264UC,
 			H265,
+			AV1,
 			// Complementary codecs:
 			CN = 300,
 			TELEPHONE_EVENT,
@@ -123,6 +124,7 @@ namespace RTC
 			TRANSPORT_WIDE_CC_01   = 5,
 			FRAME_MARKING_07       = 6, // NOTE: Remove once RFC.
 			FRAME_MARKING          = 7,
+			DEPENDENCY_DESCRIPTOR  = 8,
 			SSRC_AUDIO_LEVEL       = 10,
 			VIDEO_ORIENTATION      = 11,
 			TOFFSET                = 12,
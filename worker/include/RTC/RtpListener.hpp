@@ -4,8 +4,8 @@
 #include "common.hpp"
 #include "RTC/Producer.hpp"
 #include "RTC/RtpPacket.hpp"
+#include <absl/container/flat_hash_map.h>
 #include <string>
-#include <unordered_map>
 
 namespace RTC
 {
@@ -21,11 +21,13 @@ namespace RTC
 
 	public:
 		// Table of SSRC / Producer pairs.
-		std::unordered_map<uint32_t, RTC::Producer*> ssrcTable;
-		//  Table of MID / Producer pairs.
-		std::unordered_map<std::string, RTC::Producer*> midTable;
-		//  Table of RID / Producer pairs.
-		std::unordered_map<std::string, RTC::Producer*> ridTable;
+		absl::flat_hash_map<uint32_t, RTC::Producer*> ssrcTable;
+		// Table of MID / Producer pairs.
+		// NOTE: absl string hash and equality are transparent so these tables can
+		// be looked up with a std::string_view without creating a std::string.
+		absl::flat_hash_map<std::string, RTC::Producer*> midTable;
+		// Table of RID / Producer pairs.
+		absl::flat_hash_map<std::string, RTC::Producer*> ridTable;
 	};
 } // namespace RTC
 
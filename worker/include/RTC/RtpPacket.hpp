@@ -11,7 +11,11 @@
 #include <flatbuffers/flatbuffers.h>
 #include <absl/container/flat_hash_map.h>
 #include <array>
+#include <cstddef> // std::max_align_t
+#include <new>     // placement new
 #include <string>
+#include <string_view>
+#include <utility> // std::forward()
 #include <vector>
 
 namespace RTC
@@ -24,6 +28,8 @@ namespace RTC
 
 	class RtpPacket
 	{
+		friend class SharedRtpPacket;
+
 	public:
 		/* Struct for RTP header. */
 		struct Header
@@ -114,8 +120,15 @@ namespace RTC
 			uint8_t tl0picidx;
 		};
 
+	public:
+		using PayloadDescriptorParser = void (*)(RtpPacket* packet);
+		using PayloadDescriptorHandlerCopier = Codecs::PayloadDescriptorHandler* (*)(
+		  const Codecs::PayloadDescriptorHandler* handler, void* storage);
+
 	public:
 		static const size_t HeaderSize{ 12 };
+		// Room for the biggest codec PayloadDescriptorHandler.
+		static const size_t PayloadDescriptorHandlerStorageSize{ 64 };
 		static bool IsRtp(const uint8_t* data, size_t len)
 		{
 			// NOTE: RtcpPacket::IsRtcp() must always be called before this method.
@@ -160,6 +173,12 @@ namespace RTC
 			return this->size;
 		}
 
+		// Length of fixed header, CSRC list and header extension.
+		size_t GetHeaderLength() const
+		{
+			return static_cast<size_t>(this->payload - reinterpret_cast<const uint8_t*>(this->header));
+		}
+
 		uint8_t GetPayloadType() const
 		{
 			return this->header->payloadType;
@@ -314,7 +333,14 @@ namespace RTC
 			this->playoutDelayExtensionId = id;
 		}
 
-		bool ReadMid(std::string& mid) const
+		void SetDependencyDescriptorExtensionId(uint8_t id)
+		{
+			this->dependencyDescriptorExtensionId = id;
+		}
+
+		// NOTE: The returned view points into the packet buffer so it's only valid
+		// as long as the packet is not modified.
+		bool ReadMid(std::string_view& mid) const
 		{
 			uint8_t extenLen;
 			uint8_t* extenValue = GetExtension(this->midExtensionId, extenLen);
@@ -324,14 +350,32 @@ namespace RTC
 				return false;
 			}
 
-			mid.assign(reinterpret_cast<const char*>(extenValue), static_cast<size_t>(extenLen));
+			mid = std::string_view(
+			  reinterpret_cast<const char*>(extenValue), static_cast<size_t>(extenLen));
+
+			return true;
+		}
+
+		bool ReadMid(std::string& mid) const
+		{
+			std::string_view midView;
+
+			if (!ReadMid(midView))
+			{
+				return false;
+			}
+
+			mid.assign(midView);
 
 			return true;
 		}
 
 		void UpdateMid(const std::string& mid);
 
-		bool ReadRid(std::string& rid) const
+		size_t CopyHeader(uint8_t* buffer, const std::string& mid) const;
+
+		// NOTE: The returned view points into the packet buffer.
+		bool ReadRid(std::string_view& rid) const
 		{
 			// First try with the RID id then with the Repaired RID id.
 			uint8_t extenLen;
@@ -339,7 +383,8 @@ namespace RTC
 
 			if (extenValue && extenLen > 0u)
 			{
-				rid.assign(reinterpret_cast<const char*>(extenValue), static_cast<size_t>(extenLen));
+				rid = std::string_view(
+				  reinterpret_cast<const char*>(extenValue), static_cast<size_t>(extenLen));
 
 				return true;
 			}
@@ -348,7 +393,8 @@ namespace RTC
 
 			if (extenValue && extenLen > 0u)
 			{
-				rid.assign(reinterpret_cast<const char*>(extenValue), static_cast<size_t>(extenLen));
+				rid = std::string_view(
+				  reinterpret_cast<const char*>(extenValue), static_cast<size_t>(extenLen));
 
 				return true;
 			}
@@ -356,6 +402,20 @@ namespace RTC
 			return false;
 		}
 
+		bool ReadRid(std::string& rid) const
+		{
+			std::string_view ridView;
+
+			if (!ReadRid(ridView))
+			{
+				return false;
+			}
+
+			rid.assign(ridView);
+
+			return true;
+		}
+
 		bool ReadAbsSendTime(uint32_t& absSendtime) const
 		{
 			uint8_t extenLen;
@@ -510,6 +570,25 @@ namespace RTC
 			return true;
 		}
 
+		// NOTE: The returned pointer points into the packet buffer so it's only
+		// valid as long as the packet is not modified.
+		bool ReadDependencyDescriptor(const uint8_t** data, uint8_t& length) const
+		{
+			uint8_t extenLen;
+			uint8_t* extenValue = GetExtension(this->dependencyDescriptorExtensionId, extenLen);
+
+			// Mandatory fields take 3 bytes.
+			if (!extenValue || extenLen < 3u)
+			{
+				return false;
+			}
+
+			*data  = extenValue;
+			length = extenLen;
+
+			return true;
+		}
+
 		bool HasExtension(uint8_t id) const
 		{
 			if (id == 0u)
@@ -622,6 +701,8 @@ namespace RTC
 
 		uint8_t GetSpatialLayer() const
 		{
+			MayParsePayloadDescriptor();
+
 			if (!this->payloadDescriptorHandler)
 			{
 				return 0u;
@@ -632,6 +713,8 @@ namespace RTC
 
 		uint8_t GetTemporalLayer() const
 		{
+			MayParsePayloadDescriptor();
+
 			if (!this->payloadDescriptorHandler)
 			{
 				return 0u;
@@ -642,6 +725,8 @@ namespace RTC
 
 		bool IsKeyFrame() const
 		{
+			MayParsePayloadDescriptor();
+
 			if (!this->payloadDescriptorHandler)
 			{
 				return false;
@@ -650,15 +735,62 @@ namespace RTC
 			return this->payloadDescriptorHandler->IsKeyFrame();
 		}
 
+		/**
+		 * Copies the packet into a RtpPacketBufferPool buffer. Returns nullptr if
+		 * it does not fit.
+		 */
 		RtpPacket* Clone() const;
 
 		void RtxEncode(uint8_t payloadType, uint32_t ssrc, uint16_t seq);
 
 		bool RtxDecode(uint8_t payloadType, uint32_t ssrc);
 
-		void SetPayloadDescriptorHandler(RTC::Codecs::PayloadDescriptorHandler* payloadDescriptorHandler)
+		/**
+		 * Set the function that parses the codec payload descriptor of this packet.
+		 * It is not called until the descriptor is needed (layers, key frame or
+		 * payload processing), so packets nobody asks about are never parsed.
+		 */
+		void SetPayloadDescriptorParser(PayloadDescriptorParser parser)
+		{
+			ResetPayloadDescriptorHandler();
+
+			this->payloadDescriptorParser = parser;
+		}
+
+		/**
+		 * Construct the payload descriptor handler in place within the packet.
+		 */
+		template<typename T, typename... Args>
+		void EmplacePayloadDescriptorHandler(Args&&... args)
 		{
-			this->payloadDescriptorHandler.reset(payloadDescriptorHandler);
+			static_assert(
+			  sizeof(T) <= PayloadDescriptorHandlerStorageSize,
+			  "payload descriptor handler does not fit into RtpPacket storage");
+			static_assert(
+			  alignof(T) <= alignof(std::max_align_t),
+			  "payload descriptor handler is over-aligned for RtpPacket storage");
+
+			ResetPayloadDescriptorHandler();
+
+			this->payloadDescriptorHandler =
+			  new (this->payloadDescriptorHandlerStorage) T(std::forward<Args>(args)...);
+			this->payloadDescriptorHandlerCopier =
+			  [](const Codecs::PayloadDescriptorHandler* handler,
+			     void* storage) -> Codecs::PayloadDescriptorHandler*
+			{
+				return new (storage) T(*static_cast<const T*>(handler));
+			};
+		}
+
+		void ResetPayloadDescriptorHandler()
+		{
+			this->payloadDescriptorParser = nullptr;
+
+			if (this->payloadDescriptorHandler)
+			{
+				this->payloadDescriptorHandler->~PayloadDescriptorHandler();
+				this->payloadDescriptorHandler = nullptr;
+			}
 		}
 
 		bool ProcessPayload(RTC::Codecs::EncodingContext* context, bool& marker);
@@ -674,6 +806,23 @@ namespace RTC
 
 	private:
 		void ParseExtensions();
+		void MayParsePayloadDescriptor() const
+		{
+			if (!this->payloadDescriptorParser)
+			{
+				return;
+			}
+
+			auto parser = this->payloadDescriptorParser;
+
+			// NOTE: Parsing is an implementation detail of the const getters so it's
+			// fine to drop constness here. Unset the parser first so it runs once.
+			auto* self = const_cast<RtpPacket*>(this);
+
+			self->payloadDescriptorParser = nullptr;
+
+			parser(self);
+		}
 
 	private:
 		// Passed by argument.
@@ -694,15 +843,23 @@ namespace RTC
 		uint8_t ssrcAudioLevelExtensionId{ 0u };
 		uint8_t videoOrientationExtensionId{ 0u };
 		uint8_t playoutDelayExtensionId{ 0u };
+		uint8_t dependencyDescriptorExtensionId{ 0u };
 		uint8_t* payload{ nullptr };
 		size_t payloadLength{ 0u };
 		uint8_t payloadPadding{ 0u };
 		size_t size{ 0u }; // Full size of the packet in bytes.
-		// Codecs
-		std::shared_ptr<Codecs::PayloadDescriptorHandler> payloadDescriptorHandler;
-		// Buffer where this packet is allocated, can be `nullptr` if packet was
-		// parsed from externally provided buffer.
+		// Codecs. The payload descriptor handler lives in the packet itself (no
+		// allocation) and is parsed on demand by payloadDescriptorParser.
+		PayloadDescriptorParser payloadDescriptorParser{ nullptr };
+		Codecs::PayloadDescriptorHandler* payloadDescriptorHandler{ nullptr };
+		PayloadDescriptorHandlerCopier payloadDescriptorHandlerCopier{ nullptr };
+		alignas(std::max_align_t) uint8_t
+		  payloadDescriptorHandlerStorage[PayloadDescriptorHandlerStorageSize];
+		// Buffer (taken from RtpPacketBufferPool) where this packet is allocated,
+		// can be `nullptr` if packet was parsed from externally provided buffer.
 		uint8_t* buffer{ nullptr };
+		// Number of SharedRtpPacket instances holding this packet.
+		uint32_t refCount{ 0u };
 	};
 } // namespace RTC
 
@@ -0,0 +1,52 @@
+#ifndef MS_RTC_RTP_PACKET_BUFFER_POOL_HPP
+#define MS_RTC_RTP_PACKET_BUFFER_POOL_HPP
+
+#include "common.hpp"
+#include "FBS/worker.h"
+#include "RTC/RtpPacket.hpp"
+#include <memory>
+#include <vector>
+
+namespace RTC
+{
+	// Per thread pool of fixed size buffers used to store cloned RTP packets.
+	// Buffers are allocated in slabs and never returned to the system, so the
+	// pool grows up to the high-water mark of stored packets.
+	class RtpPacketBufferPool
+	{
+	public:
+		// Size of each buffer (MTU plus room for RTX encoding and SRTP).
+		static constexpr size_t BufferSize{ RTC::MtuSize + 100u };
+		// Number of buffers allocated at once when the pool is exhausted.
+		static constexpr size_t SlabSize{ 256u };
+
+	public:
+		static uint8_t* Get();
+		static void Release(uint8_t* buffer);
+		static flatbuffers::Offset<FBS::Worker::RtpPacketBufferPoolDump> FillBuffer(
+		  flatbuffers::FlatBufferBuilder& builder);
+		static size_t GetCapacity()
+		{
+			return RtpPacketBufferPool::slabs.size() * RtpPacketBufferPool::SlabSize;
+		}
+		static size_t GetInUse()
+		{
+			return RtpPacketBufferPool::inUse;
+		}
+		static size_t GetHighWaterMark()
+		{
+			return RtpPacketBufferPool::highWaterMark;
+		}
+
+	private:
+		static void AllocateSlab();
+
+	private:
+		thread_local static std::vector<std::unique_ptr<uint8_t[]>> slabs;
+		thread_local static std::vector<uint8_t*> freeBuffers;
+		thread_local static size_t inUse;
+		thread_local static size_t highWaterMark;
+	};
+} // namespace RTC
+
+#endif
@@ -3,14 +3,25 @@
 
 #include "common.hpp"
 #include "RTC/RtpPacket.hpp"
-#include <deque>
+#include "RTC/SharedRtpPacket.hpp"
+#include <vector>
 
 namespace RTC
 {
-	// Special container that stores `Item`* elements addressable by their `uint16_t`
+	// Special container that stores `Item` elements addressable by their `uint16_t`
 	// sequence number, while only taking as little memory as necessary to store
 	// the range covering a maximum of `MaxRetransmissionDelayForVideoMs` or
 	//  `MaxRetransmissionDelayForAudioMs` ms.
+	//
+	// Items are stored inline and they are lightweight views of the RTP packet,
+	// which is cloned once and shared by all the consumers of the same producer,
+	// so they just hold the values rewritten by the consumer (SSRC, seq and
+	// timestamp). A blank slot is an item with no packet.
+	//
+	// Storage is a power-of-two ring indexed directly by `seq & mask`. It grows
+	// (by doubling) up to the power of two covering `maxItems` and never shrinks,
+	// so no item is ever moved or allocated once the stream is in steady state.
+	// Slots out of the [oldest, newest] window are always blank.
 	class RtpRetransmissionBuffer
 	{
 	public:
@@ -18,50 +29,75 @@ namespace RTC
 		{
 			void Reset();
 
-			// Original packet.
-			std::shared_ptr<RTC::RtpPacket> packet{ nullptr };
+			// Original packet (shared by all consumers).
+			RTC::SharedRtpPacket packet;
+			// Last time this packet was resent.
+			uint64_t resentAtMs{ 0u };
 			// Correct SSRC since original packet may not have the same.
 			uint32_t ssrc{ 0u };
-			// Correct sequence number since original packet may not have the same.
-			uint16_t sequenceNumber{ 0u };
 			// Correct timestamp since original packet may not have the same.
 			uint32_t timestamp{ 0u };
-			// Last time this packet was resent.
-			uint64_t resentAtMs{ 0u };
+			// Correct sequence number since original packet may not have the same.
+			uint16_t sequenceNumber{ 0u };
 			// Number of times this packet was resent.
 			uint8_t sentTimes{ 0u };
 		};
 
 	private:
-		static Item* FillItem(
-		  Item* item, RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket);
+		static void FillItem(Item& item, RTC::RtpPacket* packet, RTC::SharedRtpPacket& sharedPacket);
 
 	public:
 		RtpRetransmissionBuffer(uint16_t maxItems, uint32_t maxRetransmissionDelayMs, uint32_t clockRate);
 		~RtpRetransmissionBuffer();
 
-		Item* Get(uint16_t seq) const;
-		void Insert(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket);
+		Item* Get(uint16_t seq);
+		void Insert(RTC::RtpPacket* packet, RTC::SharedRtpPacket& sharedPacket);
 		void Clear();
 		void Dump() const;
 
 	private:
-		Item* GetOldest() const;
-		Item* GetNewest() const;
+		Item& GetSlot(uint16_t seq)
+		{
+			return this->slots[seq & this->mask];
+		}
+		const Item& GetSlot(uint16_t seq) const
+		{
+			return this->slots[seq & this->mask];
+		}
+		Item& EmplaceNewest(uint16_t seq);
+		Item& EmplaceOldest(uint16_t seq);
+		void EnsureCapacity(size_t numItems);
+		const Item* GetOldest() const;
+		const Item* GetNewest() const;
 		void RemoveOldest();
 		void RemoveOldest(uint16_t numItems);
 		bool ClearTooOldByTimestamp(uint32_t newestTimestamp);
 		bool IsTooOldTimestamp(uint32_t timestamp, uint32_t newestTimestamp) const;
 
 	protected:
-		// Make buffer protected for testing purposes.
-		std::deque<Item*> buffer;
+		// Make buffer accessors protected for testing purposes.
+		size_t GetBufferSize() const
+		{
+			return this->size;
+		}
+		const Item& GetBufferItem(size_t idx) const
+		{
+			return GetSlot(static_cast<uint16_t>(this->startSeq + idx));
+		}
 
 	private:
 		// Given as argument.
 		uint16_t maxItems;
 		uint32_t maxRetransmissionDelayMs;
 		uint32_t clockRate;
+		// Others.
+		std::vector<Item> slots;
+		size_t mask{ 0u };
+		size_t maxCapacity{ 0u };
+		// Sequence number of the oldest slot.
+		uint16_t startSeq{ 0u };
+		// Number of slots (including blank ones) from oldest to newest item.
+		size_t size{ 0u };
 	};
 } // namespace RTC
 
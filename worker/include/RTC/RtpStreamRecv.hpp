@@ -1,6 +1,7 @@
 #ifndef MS_RTC_RTP_STREAM_RECV_HPP
 #define MS_RTC_RTP_STREAM_RECV_HPP
 
+#include "RTC/Codecs/DependencyDescriptor.hpp"
 #include "RTC/NackGenerator.hpp"
 #include "RTC/RTCP/XrDelaySinceLastRr.hpp"
 #include "RTC/RateCalculator.hpp"
@@ -131,6 +132,9 @@ namespace RTC
 		TransmissionCounter transmissionCounter;
 		// Just valid media.
 		RTC::RtpDataCounter mediaTransmissionCounter;
+		// AV1 Dependency Descriptor template dependency structure.
+		std::unique_ptr<RTC::Codecs::DependencyDescriptor::TemplateDependencyStructure>
+		  templateDependencyStructure;
 	};
 } // namespace RTC
 
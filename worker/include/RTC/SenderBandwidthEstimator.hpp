@@ -6,7 +6,7 @@
 #include "RTC/RateCalculator.hpp"
 #include "RTC/SeqManager.hpp"
 #include "RTC/TrendCalculator.hpp"
-#include <map>
+#include <vector>
 
 namespace RTC
 {
@@ -95,6 +95,14 @@ namespace RTC
 		uint32_t GetAvailableBitrate() const;
 		void RescheduleNextAvailableBitrateEvent();
 
+	private:
+		void InsertSentInfo(const SentInfo& sentInfo);
+		void ClearSentInfos();
+
+	protected:
+		// Make sent infos accessor protected for testing purposes.
+		const SentInfo* GetSentInfo(uint16_t wideSeq) const;
+
 	private:
 		// Passed by argument.
 		Listener* listener{ nullptr };
@@ -102,7 +110,12 @@ namespace RTC
 		uint32_t initialAvailableBitrate{ 0u };
 		uint32_t availableBitrate{ 0u };
 		uint64_t lastAvailableBitrateEventAtMs{ 0u };
-		std::map<uint16_t, SentInfo, RTC::SeqManager<uint16_t>::SeqLowerThan> sentInfos;
+		// Ring of sent infos indexed by wide seq number. It covers the newest
+		// `MaxSentInfoAge` wide seq numbers, older slots are stale.
+		std::vector<SentInfo> sentInfos;
+		std::vector<bool> sentInfoValids;
+		uint16_t newestSentInfoWideSeq{ 0u };
+		bool hasSentInfos{ false };
 		float rtt{ 0 }; // Round trip time in ms.
 		CummulativeResult cummulativeResult;
 		CummulativeResult probationCummulativeResult;
@@ -0,0 +1,109 @@
+#ifndef MS_RTC_SHARED_RTP_PACKET_HPP
+#define MS_RTC_SHARED_RTP_PACKET_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+
+namespace RTC
+{
+	// Reference counted handle of a RtpPacket. Unlike std::shared_ptr it doesn't
+	// allocate a control block and the counter (stored in the packet) is not
+	// atomic, so a packet must not be shared across threads.
+	class SharedRtpPacket
+	{
+	public:
+		SharedRtpPacket() = default;
+		explicit SharedRtpPacket(RTC::RtpPacket* packet) : packet(packet)
+		{
+			Ref();
+		}
+		SharedRtpPacket(const SharedRtpPacket& other) : packet(other.packet)
+		{
+			Ref();
+		}
+		SharedRtpPacket(SharedRtpPacket&& other) noexcept : packet(other.packet)
+		{
+			other.packet = nullptr;
+		}
+		~SharedRtpPacket()
+		{
+			Unref();
+		}
+		SharedRtpPacket& operator=(const SharedRtpPacket& other)
+		{
+			if (this->packet != other.packet)
+			{
+				Unref();
+
+				this->packet = other.packet;
+
+				Ref();
+			}
+
+			return *this;
+		}
+		SharedRtpPacket& operator=(SharedRtpPacket&& other) noexcept
+		{
+			if (this != std::addressof(other))
+			{
+				Unref();
+
+				this->packet = other.packet;
+				other.packet = nullptr;
+			}
+
+			return *this;
+		}
+
+	public:
+		RTC::RtpPacket* Get() const
+		{
+			return this->packet;
+		}
+		RTC::RtpPacket* operator->() const
+		{
+			return this->packet;
+		}
+		RTC::RtpPacket& operator*() const
+		{
+			return *this->packet;
+		}
+		explicit operator bool() const
+		{
+			return this->packet != nullptr;
+		}
+		void Reset(RTC::RtpPacket* packet = nullptr)
+		{
+			Unref();
+
+			this->packet = packet;
+
+			Ref();
+		}
+		uint32_t GetRefCount() const
+		{
+			return this->packet ? this->packet->refCount : 0u;
+		}
+
+	private:
+		void Ref()
+		{
+			if (this->packet)
+			{
+				++this->packet->refCount;
+			}
+		}
+		void Unref()
+		{
+			if (this->packet && --this->packet->refCount == 0u)
+			{
+				delete this->packet;
+			}
+		}
+
+	private:
+		RTC::RtpPacket* packet{ nullptr };
+	};
+} // namespace RTC
+
+#endif
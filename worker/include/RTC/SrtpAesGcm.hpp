@@ -0,0 +1,89 @@
+#ifndef MS_RTC_SRTP_AES_GCM_HPP
+#define MS_RTC_SRTP_AES_GCM_HPP
+
+#include "common.hpp"
+#include <absl/container/flat_hash_map.h>
+#include <openssl/evp.h>
+
+namespace RTC
+{
+	/**
+	 * Sending side of the SRTP/SRTCP AEAD_AES_128_GCM and AEAD_AES_256_GCM
+	 * crypto suites (RFC 7714) built directly on top of OpenSSL EVP. Session keys
+	 * are derived and the AES key schedule is computed once, so protecting a
+	 * packet just sets the IV into the already initialized cipher context. Its
+	 * output is the same as the one of libsrtp.
+	 */
+	class SrtpAesGcm
+	{
+	public:
+		// Length of the GCM authentication tag.
+		static constexpr size_t TagLength{ 16u };
+		// Length of the master and session salt.
+		static constexpr size_t SaltLength{ 12u };
+		// Length of the SRTCP trailer (E flag and SRTCP index).
+		static constexpr size_t SrtcpTrailerLength{ 4u };
+
+	public:
+		/* Struct for a RTP packet to be protected in place within a batch. */
+		struct RtpBuffer
+		{
+			uint8_t* data{ nullptr };
+			size_t len{ 0u };
+			bool ok{ false };
+		};
+
+	private:
+		/* Struct holding the sending state of a SSRC. */
+		struct Stream
+		{
+			// Highest sent RTP packet index (ROC << 16 | seq).
+			uint64_t rtpIndex{ 0u };
+			// Last sent SRTCP index.
+			uint32_t rtcpIndex{ 0u };
+		};
+
+	public:
+		/**
+		 * keyLen must be 16 (AEAD_AES_128_GCM) or 32 (AEAD_AES_256_GCM) and
+		 * masterKey must contain the master key followed by the master salt.
+		 */
+		SrtpAesGcm(size_t keyLen, const uint8_t* masterKey);
+		~SrtpAesGcm();
+
+	public:
+		/**
+		 * Protect the given RTP packet in place. The buffer must have room for
+		 * TagLength more bytes.
+		 */
+		bool ProtectRtp(uint8_t* data, size_t* len);
+		/**
+		 * Protect the given RTP packets in order.
+		 */
+		void ProtectRtp(RtpBuffer* buffers, size_t count);
+		/**
+		 * Protect the given RTCP packet in place. The buffer must have room for
+		 * TagLength + SrtcpTrailerLength more bytes.
+		 */
+		bool ProtectRtcp(uint8_t* data, size_t* len);
+		void RemoveStream(uint32_t ssrc);
+
+	private:
+		Stream& GetStream(uint32_t ssrc);
+
+	private:
+		// Allocated by this.
+		EVP_CIPHER_CTX* rtpCtx{ nullptr };
+		EVP_CIPHER_CTX* rtcpCtx{ nullptr };
+		// Others.
+		uint8_t rtpSalt[SaltLength];
+		uint8_t rtcpSalt[SaltLength];
+		absl::flat_hash_map<uint32_t, Stream> mapSsrcStream;
+		// Last used stream, to avoid a lookup for consecutive packets of the same
+		// SSRC.
+		uint32_t lastSsrc{ 0u };
+		Stream* lastStream{ nullptr };
+	};
+} // namespace RTC
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef MS_RTC_SRTP_CRYPTO_POOL_HPP
+#define MS_RTC_SRTP_CRYPTO_POOL_HPP
+
+#include "common.hpp"
+#include "FBS/worker.h"
+#include "handles/UdpSocketHandle.hpp"
+
+namespace RTC
+{
+	// Avoid cyclic #include problem by declaring classes instead of including
+	// the corresponding header files.
+	class SrtpSession;
+	class UdpSocket;
+
+	// Per worker pool of threads that SRTP protect outgoing RTP packets. The
+	// event loop hands packets to the pool and goes on. Once protected, they
+	// are sent by the event loop (via io_uring, sendmmsg() or libuv) in the
+	// order in which they were given for each SRTP session.
+	class SrtpCryptoPool
+	{
+	public:
+		// Max size of a RTP packet protected by the pool (SRTP trailer included).
+		static constexpr size_t MaxPacketSize{ 1500u };
+
+	public:
+		static void ClassInit();
+		static void ClassDestroy();
+		static bool IsEnabled();
+		/**
+		 * Protects the RTP packet made of the given header and payload in a pool
+		 * thread and then sends it to the given address. If true is returned the
+		 * pool owns cb, otherwise (i.e. packet too big) the packet must be
+		 * encrypted inline.
+		 */
+		static bool ProtectAndSend(
+		  RTC::SrtpSession* session,
+		  RTC::UdpSocket* socket,
+		  const struct sockaddr* addr,
+		  const uint8_t* header,
+		  size_t headerLen,
+		  const uint8_t* payload,
+		  size_t payloadLen,
+		  ::UdpSocketHandle::onSendCallback* cb);
+		/**
+		 * Called before protecting a packet of the given session inline. Waits
+		 * for its queued packets to be protected and sends them, so the inline
+		 * packet does not overtake them.
+		 */
+		static void SendPending(const RTC::SrtpSession* session);
+		/**
+		 * Drops the packets to be sent through the given socket, which is being
+		 * closed.
+		 */
+		static void RemoveSocket(const RTC::UdpSocket* socket);
+		/**
+		 * Waits for the packets of the given session, which is being destroyed,
+		 * to be protected.
+		 */
+		static void RemoveSession(const RTC::SrtpSession* session);
+		/**
+		 * Called by the libsrtp event handler. If in a pool thread, the event is
+		 * stored so the event loop logs it later, and true is returned.
+		 */
+		static bool DeferSrtpEvent(int event);
+		// Thread that protects the packets of the given session.
+		static size_t GetPartition(const RTC::SrtpSession* session);
+		static flatbuffers::Offset<FBS::Worker::SrtpCryptoPoolDump> FillBuffer(
+		  flatbuffers::FlatBufferBuilder& builder);
+
+	public:
+		static void OnUvAsync();
+	};
+} // namespace RTC
+
+#endif
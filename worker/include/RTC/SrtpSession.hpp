@@ -3,7 +3,10 @@
 
 #include "common.hpp"
 #include "FBS/srtpParameters.h"
+#include "RTC/SrtpAesGcm.hpp"
 #include <srtp.h>
+#include <atomic>
+#include <mutex>
 
 namespace RTC
 {
@@ -25,10 +28,14 @@ namespace RTC
 			OUTBOUND
 		};
 
+	public:
+		using RtpBuffer = SrtpAesGcm::RtpBuffer;
+
 	public:
 		static void ClassInit();
 		static FBS::SrtpParameters::SrtpCryptoSuite CryptoSuiteToFbs(CryptoSuite cryptoSuite);
 		static CryptoSuite CryptoSuiteFromFbs(FBS::SrtpParameters::SrtpCryptoSuite cryptoSuite);
+		static void LogSrtpEvent(int event);
 
 	private:
 		static void OnSrtpEvent(srtp_event_data_t* data);
@@ -39,17 +46,48 @@ namespace RTC
 
 	public:
 		bool EncryptRtp(const uint8_t** data, size_t* len);
+		bool EncryptRtp(
+		  const uint8_t* header,
+		  size_t headerLen,
+		  const uint8_t* payload,
+		  size_t payloadLen,
+		  const uint8_t** data,
+		  size_t* len);
+		bool ProtectRtp(uint8_t* data, size_t* len);
+		void ProtectRtp(RtpBuffer* buffers, size_t count);
 		bool DecryptSrtp(uint8_t* data, size_t* len);
 		bool EncryptRtcp(const uint8_t** data, size_t* len);
 		bool DecryptSrtcp(uint8_t* data, size_t* len);
-		void RemoveStream(uint32_t ssrc)
+		void RemoveStream(uint32_t ssrc);
+		size_t GetRtpTrailerLength() const
+		{
+			return this->rtpTrailerLength;
+		}
+		// Number of packets of this session queued in the SrtpCryptoPool.
+		size_t GetPoolJobs() const
+		{
+			return this->poolJobs.load();
+		}
+		void IncreasePoolJobs()
+		{
+			this->poolJobs++;
+		}
+		void DecreasePoolJobs()
 		{
-			srtp_stream_remove(this->session, uint32_t{ htonl(ssrc) });
+			this->poolJobs--;
 		}
 
 	private:
 		// Allocated by this.
 		srtp_t session{ nullptr };
+		// Used instead of libsrtp to protect outgoing packets with AEAD suites.
+		SrtpAesGcm* aesGcm{ nullptr };
+		// Length of the trailer added to protected RTP packets.
+		size_t rtpTrailerLength{ 0u };
+		// Serializes the usage of the session by the event loop and the
+		// SrtpCryptoPool threads.
+		std::mutex mutex;
+		std::atomic<size_t> poolJobs{ 0u };
 	};
 } // namespace RTC
 
@@ -2,6 +2,7 @@
 #define MS_RTC_STUN_PACKET_HPP
 
 #include "common.hpp"
+#include <openssl/evp.h>
 #include <string>
 
 namespace RTC
@@ -148,6 +149,9 @@ namespace RTC
 			return this->username;
 		}
 		void SetPassword(const std::string& password);
+		// Same as SetPassword() but with a HMAC SHA1 context already keyed with
+		// the password (see Utils::Crypto::CreateHmacSha1Ctx()).
+		void SetHmacSha1Ctx(EVP_MAC_CTX* hmacSha1Ctx);
 		uint32_t GetPriority() const
 		{
 			return this->priority;
@@ -196,10 +200,20 @@ namespace RTC
 		  // The first username fragment in the USERNAME attribute.
 		  const std::string& usernameFragment1,
 		  const std::string& password);
+		Authentication CheckAuthentication(
+		  // The first username fragment in the USERNAME attribute.
+		  const std::string& usernameFragment1,
+		  // HMAC SHA1 context keyed with the password.
+		  EVP_MAC_CTX* hmacSha1Ctx);
 		StunPacket* CreateSuccessResponse();
 		StunPacket* CreateErrorResponse(uint16_t errorCode);
 		void Serialize(uint8_t* buffer);
 
+	private:
+		Authentication CheckAuthentication(
+		  const std::string& usernameFragment1, const std::string* password, EVP_MAC_CTX* hmacSha1Ctx);
+		const uint8_t* GetHmacSha1(const uint8_t* data, size_t len) const;
+
 	private:
 		// Passed by argument.
 		Class klass;                             // 2 bytes.
@@ -210,6 +224,7 @@ namespace RTC
 		// STUN attributes.
 		std::string username; // Less than 513 bytes.
 		std::string password;
+		EVP_MAC_CTX* hmacSha1Ctx{ nullptr };
 		uint32_t priority{ 0u };       // 4 bytes unsigned integer.
 		uint64_t iceControlling{ 0u }; // 8 bytes unsigned integer.
 		uint64_t iceControlled{ 0u };  // 8 bytes unsigned integer.
@@ -22,11 +22,13 @@
 #include "RTC/SctpAssociation.hpp"
 #include "RTC/SctpListener.hpp"
 #include "RTC/Shared.hpp"
+#include "RTC/SrtpSession.hpp"
 #ifdef ENABLE_RTC_SENDER_BANDWIDTH_ESTIMATOR
 #include "RTC/SenderBandwidthEstimator.hpp"
 #endif
 #include "RTC/TransportCongestionControlClient.hpp"
 #include "RTC/TransportCongestionControlServer.hpp"
+#include "RTC/TransportTuple.hpp"
 #include "handles/TimerHandle.hpp"
 #include <absl/container/flat_hash_map.h>
 #include <string>
@@ -123,6 +125,14 @@ namespace RTC
 		{
 			bool ipv6Only{ false };
 			bool udpReusePort{ false };
+			// NOTE: Not exposed to the user. Used by sharded WebRtcServers (Linux
+			// only). The UDP socket joins a SO_REUSEPORT group and, if
+			// udpShardingSteering is set, attaches the group steering program and
+			// becomes the socket of shard udpShardIndex. Otherwise it's meant to be
+			// connected and drops every datagram until then.
+			bool udpShardingReusePort{ false };
+			bool udpShardingSteering{ false };
+			uint8_t udpShardIndex{ 0u };
 		};
 
 		struct PortRange
@@ -194,6 +204,15 @@ namespace RTC
 		RTC::Consumer* GetConsumerByRtxSsrc(uint32_t ssrc) const;
 		RTC::DataProducer* GetDataProducerById(const std::string& dataProducerId) const;
 		RTC::DataConsumer* GetDataConsumerById(const std::string& dataConsumerId) const;
+		bool EncryptRtpPacket(
+		  RTC::SrtpSession* srtpSession,
+		  const RTC::Consumer* consumer,
+		  RTC::RtpPacket* packet,
+		  const RTC::TransportTuple* tuple,
+		  const uint8_t** data,
+		  size_t* len,
+		  onSendCallback* cb) const;
+		void UpdateRtpPacketMid(const RTC::Consumer* consumer, RTC::RtpPacket* packet) const;
 
 	private:
 		virtual bool IsConnected() const = 0;
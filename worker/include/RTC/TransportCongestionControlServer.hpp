@@ -10,6 +10,7 @@
 #include "handles/TimerHandle.hpp"
 #include <libwebrtc/modules/remote_bitrate_estimator/remote_bitrate_estimator_abs_send_time.h>
 #include <deque>
+#include <vector>
 
 namespace RTC
 {
@@ -60,6 +61,12 @@ namespace RTC
 	private:
 		// Returns true if a feedback packet was sent.
 		bool SendTransportCcFeedback();
+		bool InsertPacketArrivalTime(uint16_t seqNum, uint64_t nowMs);
+		uint64_t& GetPacketArrivalTime(uint16_t seqNum)
+		{
+			return this->packetArrivalTimes[seqNum & (this->packetArrivalTimes.size() - 1)];
+		}
+		void RemoveOldestPacketArrivalTime();
 		void MayDropOldPacketArrivalTimes(uint16_t seqNum, uint64_t nowMs);
 		void MaySendLimitationRembFeedback(uint64_t nowMs);
 		void UpdatePacketLoss(double packetLoss);
@@ -97,8 +104,11 @@ namespace RTC
 		// Whether any packet with transport wide sequence number was received.
 		bool transportWideSeqNumberReceived{ false };
 		uint16_t transportCcFeedbackWideSeqNumStart{ 0u };
-		// Map of arrival timestamp (ms) indexed by wide seq number.
-		std::map<uint16_t, uint64_t, RTC::SeqManager<uint16_t>::SeqLowerThan> mapPacketArrivalTimes;
+		// Ring of arrival timestamps (ms) indexed by wide seq number. Once a packet
+		// has been received it always holds, at least, the newest one.
+		std::vector<uint64_t> packetArrivalTimes;
+		uint16_t oldestPacketArrivalSeqNum{ 0u };
+		uint16_t newestPacketArrivalSeqNum{ 0u };
 	};
 } // namespace RTC
 
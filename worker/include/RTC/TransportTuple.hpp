@@ -92,6 +92,11 @@ namespace RTC
 			return this->protocol;
 		}
 
+		RTC::UdpSocket* GetUdpSocket() const
+		{
+			return this->udpSocket;
+		}
+
 		const struct sockaddr* GetLocalAddress() const
 		{
 			if (this->protocol == Protocol::UDP)
@@ -5,6 +5,7 @@
 #include "RTC/Transport.hpp"
 #include "handles/UdpSocketHandle.hpp"
 #include <string>
+#include <vector>
 
 namespace RTC
 {
@@ -34,13 +35,19 @@ namespace RTC
 
 		/* Pure virtual methods inherited from ::UdpSocketHandle. */
 	public:
-		void UserOnUdpDatagramReceived(const uint8_t* data, size_t len, const struct sockaddr* addr) override;
+		void UserOnUdpDatagramsReceived(
+		  const std::vector<::UdpSocketHandle::RecvDatagram>& datagrams) override;
 
 	private:
 		// Passed by argument.
 		Listener* listener{ nullptr };
 		bool fixedPort{ false };
 		uint64_t portRangeHash{ 0u };
+		// Whether this is the socket of a UDP shard (and its index).
+		bool udpShard{ false };
+		uint8_t udpShardIndex{ 0u };
+		// Set while delivering a batch so the destructor can flag it.
+		bool* deletedWhileDelivering{ nullptr };
 	};
 } // namespace RTC
 
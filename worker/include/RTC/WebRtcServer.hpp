@@ -2,6 +2,7 @@
 #define MS_RTC_WEBRTC_SERVER_HPP
 
 #include "Channel/ChannelRequest.hpp"
+#include "FBS/worker.h"
 #include "RTC/IceCandidate.hpp"
 #include "RTC/Shared.hpp"
 #include "RTC/StunPacket.hpp"
@@ -29,14 +30,19 @@ namespace RTC
 		{
 			// Expose a constructor to use vector.emplace_back().
 			UdpSocketOrTcpServer(
-			  RTC::UdpSocket* udpSocket, RTC::TcpServer* tcpServer, std::string& announcedAddress)
-			  : udpSocket(udpSocket), tcpServer(tcpServer), announcedAddress(announcedAddress)
+			  RTC::UdpSocket* udpSocket,
+			  RTC::TcpServer* tcpServer,
+			  std::string& announcedAddress,
+			  RTC::Transport::SocketFlags& flags)
+			  : udpSocket(udpSocket), tcpServer(tcpServer), announcedAddress(announcedAddress),
+			    flags(flags)
 			{
 			}
 
 			RTC::UdpSocket* udpSocket;
 			RTC::TcpServer* tcpServer;
 			std::string announcedAddress;
+			RTC::Transport::SocketFlags flags;
 		};
 
 	private:
@@ -46,7 +52,8 @@ namespace RTC
 		WebRtcServer(
 		  RTC::Shared* shared,
 		  const std::string& id,
-		  const flatbuffers::Vector<flatbuffers::Offset<FBS::Transport::ListenInfo>>* listenInfos);
+		  const flatbuffers::Vector<flatbuffers::Offset<FBS::Transport::ListenInfo>>* listenInfos,
+		  const FBS::Worker::WebRtcServerShard* shard);
 		~WebRtcServer() override;
 
 	public:
@@ -63,11 +70,15 @@ namespace RTC
 		void OnPacketReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnStunDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnNonStunDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void CreateConnectedUdpSocket(RTC::TransportTuple* tuple);
+		void DeleteConnectedUdpSocket(RTC::TransportTuple* tuple);
 
 		/* Pure virtual methods inherited from RTC::WebRtcTransport::WebRtcTransportListener. */
 	public:
 		void OnWebRtcTransportCreated(RTC::WebRtcTransport* webRtcTransport) override;
 		void OnWebRtcTransportClosed(RTC::WebRtcTransport* webRtcTransport) override;
+		void OnWebRtcTransportNeedLocalIceUsernameFragment(
+		  RTC::WebRtcTransport* webRtcTransport, std::string& usernameFragment) override;
 		void OnWebRtcTransportLocalIceUsernameFragmentAdded(
 		  RTC::WebRtcTransport* webRtcTransport, const std::string& usernameFragment) override;
 		void OnWebRtcTransportLocalIceUsernameFragmentRemoved(
@@ -106,6 +117,13 @@ namespace RTC
 		absl::flat_hash_map<std::string, RTC::WebRtcTransport*> mapLocalIceUsernameFragmentWebRtcTransport;
 		// Map of WebRtcTransports indexed by TransportTuple.hash.
 		absl::flat_hash_map<uint64_t, RTC::WebRtcTransport*> mapTupleWebRtcTransport;
+		// Shard index and number of shards (0 if not sharded).
+		uint8_t shardIndex{ 0u };
+		uint8_t shardCount{ 0u };
+		// Map of connected UdpSockets indexed by TransportTuple.hash.
+		absl::flat_hash_map<uint64_t, RTC::UdpSocket*> mapTupleConnectedUdpSocket;
+		// Map of listening UdpSockets indexed by connected UdpSocket.
+		absl::flat_hash_map<RTC::UdpSocket*, RTC::UdpSocket*> mapConnectedUdpSocketUdpSocket;
 		// Whether the destructor has been called.
 		bool closing{ false };
 	};
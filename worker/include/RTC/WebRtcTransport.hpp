@@ -32,6 +32,8 @@ namespace RTC
 		public:
 			virtual void OnWebRtcTransportCreated(RTC::WebRtcTransport* webRtcTransport) = 0;
 			virtual void OnWebRtcTransportClosed(RTC::WebRtcTransport* webRtcTransport)  = 0;
+			virtual void OnWebRtcTransportNeedLocalIceUsernameFragment(
+			  RTC::WebRtcTransport* webRtcTransport, std::string& usernameFragment) = 0;
 			virtual void OnWebRtcTransportLocalIceUsernameFragmentAdded(
 			  RTC::WebRtcTransport* webRtcTransport, const std::string& usernameFragment) = 0;
 			virtual void OnWebRtcTransportLocalIceUsernameFragmentRemoved(
@@ -40,6 +40,13 @@ public:
 		std::string dtlsPrivateKeyFile;
 		std::string libwebrtcFieldTrials{ "WebRTC-Bwe-AlrLimitedBackoff/Enabled/" };
 		bool liburingDisabled{ false };
+		bool channelWriteCoalescing{ false };
+		bool notificationBatching{ false };
+		uint32_t notificationBatchWindow{ 0u };
+		uint8_t srtpCryptoThreads{ 0u };
+		bool dtlsHandshakeOffload{ false };
+		std::string dtlsCertificateCacheFile;
+		uint32_t dtlsCertificateCacheMaxAge{ 2592000u };
 	};
 
 public:
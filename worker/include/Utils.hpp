@@ -224,6 +224,20 @@ namespace Utils
 		{
 			return static_cast<size_t>(__builtin_popcount(mask));
 		}
+
+		// NOTE: Given value must not be 0.
+		static size_t CountTrailingZeros(const uint64_t value)
+		{
+#ifdef _WIN32
+			unsigned long idx;
+
+			_BitScanForward64(&idx, value);
+
+			return static_cast<size_t>(idx);
+#else
+			return static_cast<size_t>(__builtin_ctzll(value));
+#endif
+		}
 	};
 
 	class Crypto
@@ -275,27 +289,21 @@ namespace Utils
 			return { buffer, len };
 		}
 
-		static uint32_t GetCRC32(const uint8_t* data, size_t size)
-		{
-			uint32_t crc{ 0xFFFFFFFF };
-			const uint8_t* p = data;
+		static uint32_t GetCRC32(const uint8_t* data, size_t size);
 
-			while (size--)
-			{
-				crc = Crypto::Crc32Table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
-			}
+		static const uint8_t* GetHmacSha1(const std::string& key, const uint8_t* data, size_t len);
 
-			return crc ^ ~0U;
-		}
+		static EVP_MAC_CTX* CreateHmacSha1Ctx(const std::string& key);
 
-		static const uint8_t* GetHmacSha1(const std::string& key, const uint8_t* data, size_t len);
+		static void FreeHmacSha1Ctx(EVP_MAC_CTX* ctx);
+
+		static const uint8_t* GetHmacSha1(EVP_MAC_CTX* ctx, const uint8_t* data, size_t len);
 
 	private:
 		thread_local static uint32_t seed;
 		thread_local static EVP_MAC* mac;
 		thread_local static EVP_MAC_CTX* hmacSha1Ctx;
 		thread_local static uint8_t hmacSha1Buffer[];
-		static const uint32_t Crc32Table[256];
 	};
 
 	class String
@@ -18,7 +18,7 @@ class Worker : public Channel::ChannelSocket::Listener,
                public RTC::Router::Listener
 {
 public:
-	explicit Worker(Channel::ChannelSocket* channel);
+	Worker(Channel::ChannelSocket* channel, uint64_t startedAtUs);
 	~Worker();
 
 private:
@@ -59,6 +59,8 @@ private:
 	absl::flat_hash_map<std::string, RTC::Router*> mapRouters;
 	// Others.
 	bool closed{ false };
+	// Time taken from the start of mediasoup_worker_run() until running.
+	uint64_t startupDurationUs{ 0u };
 };
 
 #endif
@@ -2,10 +2,16 @@
 #define MS_TCP_CONNECTION_HANDLE_HPP
 
 #include "common.hpp"
+#ifdef MS_LIBURING_SUPPORTED
+#include "DepLibUring.hpp"
+#endif
 #include <uv.h>
 #include <string>
 
 class TcpConnectionHandle
+#ifdef MS_LIBURING_SUPPORTED
+  : public DepLibUring::RecvListener
+#endif
 {
 protected:
 	using onSendCallback = const std::function<void(bool sent)>;
@@ -119,6 +125,13 @@ public:
 	void OnUvRead(ssize_t nread, const uv_buf_t* buf);
 	void OnUvWrite(int status, onSendCallback* cb);
 
+#ifdef MS_LIBURING_SUPPORTED
+	/* Pure virtual methods inherited from DepLibUring::RecvListener. */
+public:
+	void OnLibUringRecv(const DepLibUring::RecvData* recvs, size_t count) override;
+	void OnLibUringRecvError(int err) override;
+#endif
+
 	/* Pure virtual methods that must be implemented by the subclass. */
 protected:
 	virtual void UserOnTcpConnectionRead() = 0;
@@ -148,6 +161,8 @@ private:
 #ifdef MS_LIBURING_SUPPORTED
 	// Local file descriptor for io_uring.
 	uv_os_fd_t fd{ 0u };
+	// Multishot receive request (if receiving via io_uring).
+	DepLibUring::RecvRequest* recvRequest{ nullptr };
 #endif
 	bool closed{ false };
 	size_t recvBytes{ 0u };
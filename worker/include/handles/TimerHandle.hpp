@@ -2,10 +2,15 @@
 #define MS_TIMER_HANDLE_HPP
 
 #include "common.hpp"
-#include <uv.h>
 
+class TimerWheel;
+
+// Timer managed by the TimerWheel of the Worker instead of having its own uv
+// timer.
 class TimerHandle
 {
+	friend class TimerWheel;
+
 public:
 	class Listener
 	{
@@ -37,25 +42,25 @@ public:
 	}
 	bool IsActive() const
 	{
-		return uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvHandle)) != 0;
+		return this->active;
 	}
 
+	/* Callbacks fired by the TimerWheel. */
 private:
-	void InternalClose();
-
-	/* Callbacks fired by UV events. */
-public:
-	void OnUvTimer();
+	void OnTimerWheelTimer();
 
 private:
 	// Passed by argument.
 	Listener* listener{ nullptr };
-	// Allocated by this.
-	uv_timer_t* uvHandle{ nullptr };
 	// Others.
-	bool closed{ false };
 	uint64_t timeout{ 0u };
 	uint64_t repeat{ 0u };
+	bool active{ false };
+	// Managed by the TimerWheel.
+	uint64_t expiresAtMs{ 0u };
+	TimerHandle* prev{ nullptr };
+	TimerHandle* next{ nullptr };
+	uint16_t slotIdx{ 0u };
 };
 
 #endif
@@ -0,0 +1,79 @@
+#ifndef MS_TIMER_WHEEL_HPP
+#define MS_TIMER_WHEEL_HPP
+
+#include "common.hpp"
+#include <uv.h>
+
+class TimerHandle;
+
+// Hierarchical timer wheel (one per thread, so one per Worker) holding all the
+// active TimerHandle instances. It has a 1 ms tick: level 0 has 256 slots of
+// 1 ms and levels 1 to 4 have 64 slots each covering 256 ms, 16 s, 17 min and
+// 18 h, so the whole wheel covers 2^32 ms. Timers are linked into the slot of
+// their expiration so starting and stopping a timer is O(1), and entries of
+// upper levels are moved down ("cascaded") when level 0 wraps around.
+//
+// The wheel is driven by a single uv timer which is armed to the next slot
+// with timers (or the next cascade).
+class TimerWheel
+{
+public:
+	static TimerWheel* GetInstance();
+
+private:
+	static void OnUvTimer(uv_timer_t* handle);
+	static void OnCloseUvTimer(uv_handle_t* handle);
+
+public:
+	TimerWheel() = default;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+	TimerWheel(const TimerWheel&)            = delete;
+	~TimerWheel() = default;
+
+public:
+	void Add(TimerHandle* timer);
+	void Remove(TimerHandle* timer);
+	uint64_t GetNowMs() const;
+	size_t GetNumTimers() const
+	{
+		return this->numTimers;
+	}
+
+private:
+	void Link(TimerHandle* timer, bool fromCascade);
+	void Unlink(TimerHandle* timer);
+	void Advance(uint64_t nowMs);
+	void Cascade(uint64_t tickMs);
+	void Expire(size_t slotIdx, uint64_t nowMs);
+	uint64_t GetNextTickMs() const;
+	void ArmUvTimer(uint64_t wakeUpMs);
+	void CloseUvTimer();
+
+public:
+	static constexpr size_t Level0Bits{ 8u };
+	static constexpr size_t Level0Slots{ 1u << Level0Bits };
+	static constexpr size_t LevelBits{ 6u };
+	static constexpr size_t LevelSlots{ 1u << LevelBits };
+	static constexpr size_t NumUpperLevels{ 4u };
+	static constexpr size_t NumSlots{ Level0Slots + (NumUpperLevels * LevelSlots) };
+	// 2^(Level0Bits + NumUpperLevels * LevelBits) - 1.
+	static constexpr uint64_t MaxDelayMs{ 0xFFFFFFFFu };
+
+private:
+	// Intrusive lists of timers, indexed by slot (level 0 slots first).
+	TimerHandle* slots[NumSlots]{};
+	// Occupancy bitmaps of level 0 and of upper levels.
+	uint64_t level0Bitmap[Level0Slots / 64u]{};
+	uint64_t levelBitmaps[NumUpperLevels]{};
+	// Last processed tick.
+	uint64_t currentMs{ 0u };
+	size_t numTimers{ 0u };
+	// Driving uv timer (only open while there are active timers).
+	uv_timer_t* uvHandle{ nullptr };
+	// Absolute time the uv timer is armed to, if any.
+	uint64_t armedAtMs{ 0u };
+	bool armed{ false };
+	bool advancing{ false };
+};
+
+#endif
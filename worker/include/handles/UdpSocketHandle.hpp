@@ -2,12 +2,19 @@
 #define MS_UDP_SOCKET_HANDLE_HPP
 
 #include "common.hpp"
+#ifdef MS_LIBURING_SUPPORTED
+#include "DepLibUring.hpp"
+#endif
 #include <uv.h>
 #include <string>
+#include <vector>
 
 class UdpSocketHandle
+#ifdef MS_LIBURING_SUPPORTED
+  : public DepLibUring::RecvListener
+#endif
 {
-protected:
+public:
 	using onSendCallback = const std::function<void(bool sent)>;
 
 public:
@@ -32,6 +39,42 @@ public:
 		UdpSocketHandle::onSendCallback* cb{ nullptr };
 	};
 
+	/* Struct for a datagram received within a recvmmsg() batch. */
+	struct RecvDatagram
+	{
+		const uint8_t* data{ nullptr };
+		size_t len{ 0u };
+		struct sockaddr_storage addr
+		{
+		};
+	};
+
+public:
+	// Max size of a UDP datagram (it must match UV__UDP_DGRAM_MAXSIZE in libuv).
+	static constexpr size_t DatagramMaxSize{ 65536 };
+	// Max number of datagrams read by libuv in a single recvmmsg() call.
+	static constexpr size_t RecvBatchSize{ 16 };
+#ifdef MS_SENDMMSG_SUPPORTED
+	// Max number of datagrams queued between StartSendBatch() and FlushSendBatch().
+	static constexpr size_t SendBatchSize{ 64 };
+	// Max size of a datagram to be queued (bigger ones are directly sent).
+	static constexpr size_t SendBatchBufferSize{ 1500 };
+	// Max total size of a UDP GSO (UDP_SEGMENT) datagram.
+	static constexpr size_t GsoMaxSize{ 65000 };
+	// Max number of segments in a UDP GSO (UDP_SEGMENT) datagram.
+	static constexpr size_t GsoMaxSegments{ 64 };
+
+public:
+	/**
+	 * Datagrams sent between StartSendBatch() and FlushSendBatch() are queued
+	 * and then sent with a single sendmmsg() call per socket. Consecutive
+	 * datagrams with same destination are coalesced using UDP GSO if possible.
+	 * Calls can be nested, the queue is flushed by the outermost FlushSendBatch().
+	 */
+	static void StartSendBatch();
+	static void FlushSendBatch();
+#endif
+
 public:
 	/**
 	 * uvHandle must be an already initialized and binded uv_udp_t pointer.
@@ -49,6 +92,11 @@ public:
 	void Dump() const;
 	void Send(
 	  const uint8_t* data, size_t len, const struct sockaddr* addr, UdpSocketHandle::onSendCallback* cb);
+	/**
+	 * Connect the socket to the given remote address so it just receives
+	 * datagrams from it. A connected socket cannot send to other addresses.
+	 */
+	void Connect(const struct sockaddr* addr);
 	const struct sockaddr* GetLocalAddress() const
 	{
 		return reinterpret_cast<const struct sockaddr*>(&this->localAddr);
@@ -69,6 +117,10 @@ public:
 	{
 		return this->recvBytes;
 	}
+	size_t GetRecvBatches() const
+	{
+		return this->recvBatches;
+	}
 	size_t GetSentBytes() const
 	{
 		return this->sentBytes;
@@ -81,6 +133,15 @@ public:
 private:
 	void InternalClose();
 	bool SetLocalAddress();
+	void DeliverRecvBatch();
+	void InternalSend(
+	  const uint8_t* data, size_t len, const struct sockaddr* addr, UdpSocketHandle::onSendCallback* cb);
+#ifdef MS_SENDMMSG_SUPPORTED
+	bool QueueSend(
+	  const uint8_t* data, size_t len, const struct sockaddr* addr, UdpSocketHandle::onSendCallback* cb);
+	void DropQueuedSends();
+	static void SendQueuedBatch();
+#endif
 
 	/* Callbacks fired by UV events. */
 public:
@@ -88,10 +149,20 @@ public:
 	void OnUvRecv(ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned int flags);
 	void OnUvSend(int status, UdpSocketHandle::onSendCallback* cb);
 
+#ifdef MS_LIBURING_SUPPORTED
+	/* Pure virtual methods inherited from DepLibUring::RecvListener. */
+public:
+	void OnLibUringRecv(const DepLibUring::RecvData* recvs, size_t count) override;
+	void OnLibUringRecvError(int err) override;
+#endif
+
 	/* Pure virtual methods that must be implemented by the subclass. */
 protected:
-	virtual void UserOnUdpDatagramReceived(
-	  const uint8_t* data, size_t len, const struct sockaddr* addr) = 0;
+	/**
+	 * Called once per read batch. Datagrams point to a shared receive buffer so
+	 * they are only valid during the call.
+	 */
+	virtual void UserOnUdpDatagramsReceived(const std::vector<RecvDatagram>& datagrams) = 0;
 
 protected:
 	struct sockaddr_storage localAddr
@@ -104,12 +175,17 @@ private:
 	// Allocated by this (may be passed by argument).
 	uv_udp_t* uvHandle{ nullptr };
 	// Others.
-#ifdef MS_LIBURING_SUPPORTED
-	// Local file descriptor for io_uring.
+#if defined(MS_LIBURING_SUPPORTED) || defined(MS_SENDMMSG_SUPPORTED)
+	// Local file descriptor for io_uring and sendmmsg().
 	uv_os_fd_t fd{ 0u };
+#endif
+#ifdef MS_LIBURING_SUPPORTED
+	// Multishot receive request (if receiving via io_uring).
+	DepLibUring::RecvRequest* recvRequest{ nullptr };
 #endif
 	bool closed{ false };
 	size_t recvBytes{ 0u };
+	size_t recvBatches{ 0u };
 	size_t sentBytes{ 0u };
 };
 
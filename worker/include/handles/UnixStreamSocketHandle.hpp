@@ -4,6 +4,7 @@
 #include "common.hpp"
 #include <uv.h>
 #include <string>
+#include <vector>
 
 class UnixStreamSocketHandle
 {
@@ -46,6 +47,8 @@ public:
 		return this->closed;
 	}
 	void Write(const uint8_t* data, size_t len);
+	void SetWriteCoalescing(bool enabled);
+	void Flush();
 	uint32_t GetSendBufferSize() const;
 	void SetSendBufferSize(uint32_t size);
 	uint32_t GetRecvBufferSize() const;
@@ -56,15 +59,24 @@ public:
 	void OnUvReadAlloc(size_t suggestedSize, uv_buf_t* buf);
 	void OnUvRead(ssize_t nread, const uv_buf_t* buf);
 	void OnUvWriteError(int error);
+	void OnUvFlush();
 
 	/* Pure virtual methods that must be implemented by the subclass. */
 protected:
 	virtual void UserOnUnixStreamRead()         = 0;
 	virtual void UserOnUnixStreamSocketClosed() = 0;
 
+private:
+	void WriteImpl(const uint8_t* data, size_t len);
+
 private:
 	// Allocated by this.
 	uv_pipe_t* uvHandle{ nullptr };
+	// Handles to flush coalesced writes before and after polling for I/O.
+	uv_prepare_t* uvPrepareHandle{ nullptr };
+	uv_check_t* uvCheckHandle{ nullptr };
+	// Data written while coalescing and not yet flushed.
+	std::vector<uint8_t> pendingWriteData;
 	// Others.
 	bool closed{ false };
 	bool isClosedByPeer{ false };
@@ -2,12 +2,315 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "Channel/ChannelNotifier.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
 
 namespace Channel
 {
+	/* Static. */
+
+	// Pending notifications are sent once the batch reaches this size.
+	static constexpr size_t MaxBatchSize{ 262144 };
+
+	// Events whose last notification replaces previous ones of the same target
+	// within a batch.
+	static bool isCoalescable(FBS::Notification::Event event)
+	{
+		switch (event)
+		{
+			case FBS::Notification::Event::PRODUCER_SCORE:
+			case FBS::Notification::Event::CONSUMER_SCORE:
+			{
+				return true;
+			}
+
+			default:
+			{
+				return false;
+			}
+		}
+	}
+
+	/* Static methods for UV callbacks. */
+
+	inline static void onPrepare(uv_prepare_t* handle)
+	{
+		static_cast<ChannelNotifier*>(handle->data)->Flush();
+	}
+
+	inline static void onCheck(uv_check_t* handle)
+	{
+		static_cast<ChannelNotifier*>(handle->data)->Flush();
+	}
+
+	inline static void onClosePrepare(uv_handle_t* handle)
+	{
+		delete reinterpret_cast<uv_prepare_t*>(handle);
+	}
+
+	inline static void onCloseCheck(uv_handle_t* handle)
+	{
+		delete reinterpret_cast<uv_check_t*>(handle);
+	}
+
+	/* Instance methods. */
+
 	ChannelNotifier::ChannelNotifier(Channel::ChannelSocket* channel) : channel(channel)
 	{
 		MS_TRACE();
+
+		this->channel->SetNotifier(this);
+	}
+
+	ChannelNotifier::~ChannelNotifier()
+	{
+		MS_TRACE();
+
+		Flush();
+
+		this->channel->SetNotifier(nullptr);
+
+		CloseFlushHandles();
+	}
+
+	/**
+	 * When enabled, notifications are sent in a single message at the end of
+	 * the current loop iteration (if windowMs is 0) or once windowMs have
+	 * elapsed since the first pending one. Pending notifications are always
+	 * sent before any other message (such as a response) to keep the order.
+	 */
+	void ChannelNotifier::SetBatching(bool enabled, uint64_t windowMs)
+	{
+		MS_TRACE();
+
+		Flush();
+		CloseFlushHandles();
+
+		this->batching      = enabled;
+		this->batchWindowMs = windowMs;
+
+		if (!this->batching)
+		{
+			return;
+		}
+
+		if (this->batchWindowMs != 0u)
+		{
+			this->batchTimer = new TimerHandle(this);
+
+			return;
+		}
+
+		int err;
+
+		this->uvPrepareHandle       = new uv_prepare_t;
+		this->uvPrepareHandle->data = static_cast<void*>(this);
+
+		err = uv_prepare_init(DepLibUV::GetLoop(), this->uvPrepareHandle);
+
+		if (err != 0)
+		{
+			delete this->uvPrepareHandle;
+			this->uvPrepareHandle = nullptr;
+			this->batching        = false;
+
+			MS_THROW_ERROR("uv_prepare_init() failed: %s", uv_strerror(err));
+		}
+
+		this->uvCheckHandle       = new uv_check_t;
+		this->uvCheckHandle->data = static_cast<void*>(this);
+
+		err = uv_check_init(DepLibUV::GetLoop(), this->uvCheckHandle);
+
+		if (err != 0)
+		{
+			delete this->uvCheckHandle;
+			this->uvCheckHandle = nullptr;
+			this->batching      = false;
+
+			CloseFlushHandles();
+
+			MS_THROW_ERROR("uv_check_init() failed: %s", uv_strerror(err));
+		}
+
+		// These handles must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvPrepareHandle));
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvCheckHandle));
+	}
+
+	void ChannelNotifier::Flush()
+	{
+		MS_TRACE();
+
+		if (this->pendingNotifications.empty())
+		{
+			return;
+		}
+
+		if (this->batchTimer)
+		{
+			this->batchTimer->Stop();
+		}
+		else
+		{
+			uv_prepare_stop(this->uvPrepareHandle);
+			uv_check_stop(this->uvCheckHandle);
+		}
+
+		auto& builder = this->bufferBuilder;
+		std::vector<flatbuffers::Offset<FBS::Notification::Notification>> notifications;
+
+		notifications.reserve(this->pendingNotifications.size());
+
+		for (const auto& notification : this->pendingNotifications)
+		{
+			if (!notification.IsNull())
+			{
+				notifications.push_back(notification);
+			}
+		}
+
+		// NOTE: Clear pending notifications before sending since the Channel
+		// checks them before sending anything.
+		this->pendingNotifications.clear();
+		this->mapCoalescableNotificationIdx.clear();
+
+		flatbuffers::Offset<FBS::Message::Message> message;
+
+		// Not worth a batch.
+		if (notifications.size() == 1u)
+		{
+			message = FBS::Message::CreateMessage(
+			  builder, FBS::Message::Body::Notification, notifications[0].Union());
+
+			this->rawNotifications++;
+		}
+		else
+		{
+			auto batch = FBS::Notification::CreateNotificationBatchDirect(builder, &notifications);
+
+			message =
+			  FBS::Message::CreateMessage(builder, FBS::Message::Body::NotificationBatch, batch.Union());
+
+			this->batchedNotifications += notifications.size();
+			this->batches++;
+		}
+
+		builder.FinishSizePrefixed(message);
+		this->channel->Send(builder.GetBufferPointer(), builder.GetSize());
+		builder.Clear();
+	}
+
+	flatbuffers::Offset<FBS::Worker::ChannelNotifierDump> ChannelNotifier::FillBufferDump(
+	  flatbuffers::FlatBufferBuilder& builder) const
+	{
+		MS_TRACE();
+
+		return FBS::Worker::CreateChannelNotifierDump(
+		  builder,
+		  this->rawNotifications,
+		  this->batchedNotifications,
+		  this->coalescedNotifications,
+		  this->batches);
+	}
+
+	void ChannelNotifier::Send(
+	  const std::string& targetId,
+	  FBS::Notification::Event event,
+	  flatbuffers::Offset<FBS::Notification::Notification> notification)
+	{
+		MS_TRACE();
+
+		auto& builder = this->bufferBuilder;
+
+		if (!this->batching)
+		{
+			auto message =
+			  FBS::Message::CreateMessage(builder, FBS::Message::Body::Notification, notification.Union());
+
+			builder.FinishSizePrefixed(message);
+			this->channel->Send(builder.GetBufferPointer(), builder.GetSize());
+			builder.Clear();
+
+			this->rawNotifications++;
+
+			return;
+		}
+
+		if (this->pendingNotifications.empty())
+		{
+			ScheduleFlush();
+		}
+
+		if (isCoalescable(event))
+		{
+			auto result = this->mapCoalescableNotificationIdx.try_emplace(
+			  std::make_pair(targetId, event), this->pendingNotifications.size());
+
+			// Drop the previous one (its bytes remain in the builder until sent).
+			if (!result.second)
+			{
+				this->pendingNotifications[result.first->second] =
+				  flatbuffers::Offset<FBS::Notification::Notification>();
+				result.first->second = this->pendingNotifications.size();
+
+				this->coalescedNotifications++;
+			}
+		}
+
+		this->pendingNotifications.push_back(notification);
+
+		if (builder.GetSize() >= MaxBatchSize)
+		{
+			Flush();
+		}
+	}
+
+	void ChannelNotifier::ScheduleFlush()
+	{
+		MS_TRACE();
+
+		if (this->batchTimer)
+		{
+			this->batchTimer->Start(this->batchWindowMs);
+		}
+		else
+		{
+			uv_prepare_start(this->uvPrepareHandle, static_cast<uv_prepare_cb>(onPrepare));
+			uv_check_start(this->uvCheckHandle, static_cast<uv_check_cb>(onCheck));
+		}
+	}
+
+	void ChannelNotifier::CloseFlushHandles()
+	{
+		MS_TRACE();
+
+		delete this->batchTimer;
+		this->batchTimer = nullptr;
+
+		if (this->uvPrepareHandle)
+		{
+			uv_close(
+			  reinterpret_cast<uv_handle_t*>(this->uvPrepareHandle),
+			  static_cast<uv_close_cb>(onClosePrepare));
+
+			this->uvPrepareHandle = nullptr;
+		}
+
+		if (this->uvCheckHandle)
+		{
+			uv_close(
+			  reinterpret_cast<uv_handle_t*>(this->uvCheckHandle), static_cast<uv_close_cb>(onCloseCheck));
+
+			this->uvCheckHandle = nullptr;
+		}
+	}
+
+	void ChannelNotifier::OnTimer(TimerHandle* /*timer*/)
+	{
+		MS_TRACE();
+
+		Flush();
 	}
 } // namespace Channel
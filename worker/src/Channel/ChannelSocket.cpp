@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "Channel/ChannelSocket.hpp"
+#include "Channel/ChannelNotifier.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
@@ -121,6 +122,44 @@ namespace Channel
 		this->listener = listener;
 	}
 
+	/**
+	 * Messages written within the same phase of the loop are sent to the peer
+	 * with a single write. No effect if the Channel uses function calls.
+	 */
+	void ChannelSocket::SetWriteCoalescing(bool enabled)
+	{
+		MS_TRACE_STD();
+
+		if (this->producerSocket)
+		{
+			this->producerSocket->SetWriteCoalescing(enabled);
+		}
+	}
+
+	/**
+	 * Notifications batched by the given ChannelNotifier are sent before any
+	 * other message (logs excluded).
+	 */
+	void ChannelSocket::SetNotifier(ChannelNotifier* notifier)
+	{
+		MS_TRACE_STD();
+
+		this->notifier = notifier;
+	}
+
+	/**
+	 * Writes messages kept by write coalescing now.
+	 */
+	void ChannelSocket::Flush()
+	{
+		MS_TRACE_STD();
+
+		if (this->producerSocket)
+		{
+			this->producerSocket->Flush();
+		}
+	}
+
 	void ChannelSocket::Send(const uint8_t* data, uint32_t dataLen)
 	{
 		MS_TRACE_STD();
@@ -137,6 +176,12 @@ namespace Channel
 			return;
 		}
 
+		// Keep the order of notifications and responses.
+		if (this->notifier && this->notifier->HasPendingNotifications())
+		{
+			this->notifier->Flush();
+		}
+
 		SendImpl(data, dataLen);
 	}
 
@@ -161,7 +206,9 @@ namespace Channel
 		  FBS::Message::CreateMessage(this->bufferBuilder, FBS::Message::Body::Log, log.Union());
 
 		this->bufferBuilder.FinishSizePrefixed(message);
-		this->Send(this->bufferBuilder.GetBufferPointer(), this->bufferBuilder.GetSize());
+		// NOTE: Don't use Send() since pending notifications cannot be flushed
+		// while being built.
+		SendImpl(this->bufferBuilder.GetBufferPointer(), this->bufferBuilder.GetSize());
 		this->bufferBuilder.Clear();
 	}
 
@@ -7,6 +7,7 @@
 #include "Settings.hpp"
 #include "Utils.hpp"
 #include <sys/eventfd.h>
+#include <sys/socket.h>
 #include <sys/resource.h>
 #include <sys/utsname.h>
 
@@ -17,6 +18,12 @@ thread_local DepLibUring::LibUring* DepLibUring::liburing{ nullptr };
 // Completion queue entry array used to retrieve processes tasks.
 thread_local struct io_uring_cqe* cqes[DepLibUring::QueueDepth];
 
+// Buffer group id of the provided buffers for receiving.
+static constexpr uint16_t RecvBufferGroupId{ 0u };
+// Set in the user data of receive requests to tell them from send ones (whose
+// UserData pointers are aligned).
+static constexpr uint64_t RecvRequestTag{ 1u };
+
 /* Static methods for UV callbacks. */
 
 inline static void onCloseFd(uv_handle_t* handle)
@@ -24,67 +31,70 @@ inline static void onCloseFd(uv_handle_t* handle)
 	delete reinterpret_cast<uv_poll_t*>(handle);
 }
 
-inline static void onFdEvent(uv_poll_t* handle, int status, int events)
+inline static void processCQEs(DepLibUring::LibUring* liburing, unsigned int count)
 {
-	auto* liburing = static_cast<DepLibUring::LibUring*>(handle->data);
-	auto count     = io_uring_peek_batch_cqe(liburing->GetRing(), cqes, DepLibUring::QueueDepth);
+	for (unsigned int i{ 0 }; i < count; ++i)
+	{
+		struct io_uring_cqe* cqe = cqes[i];
+		const auto data          = io_uring_cqe_get_data64(cqe);
 
-	// libuv uses level triggering, so we need to read from the socket to reset
-	// the counter in order to avoid libuv calling this callback indefinitely.
-	eventfd_t v;
-	int err = eventfd_read(liburing->GetEventFd(), std::addressof(v));
+		// CQE of a cancelation request.
+		if (data == 0u)
+		{
+			io_uring_cqe_seen(liburing->GetRing(), cqe);
 
-	if (err < 0)
-	{
-		// Get positive errno.
-		int error = -err;
+			continue;
+		}
 
-		MS_ABORT("eventfd_read() failed: %s", std::strerror(error));
-	};
+		// CQE of a multishot receive request.
+		if ((data & RecvRequestTag) != 0u)
+		{
+			liburing->OnRecvCompletion(cqe);
+			io_uring_cqe_seen(liburing->GetRing(), cqe);
 
-	for (unsigned int i{ 0 }; i < count; ++i)
-	{
-		struct io_uring_cqe* cqe = cqes[i];
-		auto* userData           = static_cast<DepLibUring::UserData*>(io_uring_cqe_get_data(cqe));
+			continue;
+		}
 
-		if (liburing->IsZeroCopyEnabled())
+		auto* userData = reinterpret_cast<DepLibUring::UserData*>(data);
+
+		// NOTE: Zero copy may have been disabled while zero copy sends were in
+		// flight, so rely on the CQE flags rather than on IsZeroCopyEnabled().
+
+		// CQE notification for a zero-copy submission.
+		if (cqe->flags & IORING_CQE_F_NOTIF)
 		{
-			// CQE notification for a zero-copy submission.
-			if (cqe->flags & IORING_CQE_F_NOTIF)
+			// The send buffer is now in the network card, run the send callback.
+			if (userData->cb)
 			{
-				// The send buffer is now in the network card, run the send callback.
-				if (userData->cb)
-				{
-					(*userData->cb)(true);
-					delete userData->cb;
-					userData->cb = nullptr;
-				}
+				(*userData->cb)(true);
+				delete userData->cb;
+				userData->cb = nullptr;
+			}
 
-				liburing->ReleaseUserDataEntry(userData->idx);
-				io_uring_cqe_seen(liburing->GetRing(), cqe);
+			liburing->ReleaseUserDataEntry(userData->idx);
+			io_uring_cqe_seen(liburing->GetRing(), cqe);
 
-				continue;
-			}
+			continue;
+		}
 
-			// CQE for a zero-copy submission, a CQE notification will follow.
-			if (cqe->flags & IORING_CQE_F_MORE)
+		// CQE for a zero-copy submission, a CQE notification will follow.
+		if (cqe->flags & IORING_CQE_F_MORE)
+		{
+			if (cqe->res < 0)
 			{
-				if (cqe->res < 0)
+				if (userData->cb)
 				{
-					if (userData->cb)
-					{
-						(*userData->cb)(false);
-						delete userData->cb;
-						userData->cb = nullptr;
-					}
+					(*userData->cb)(false);
+					delete userData->cb;
+					userData->cb = nullptr;
 				}
+			}
 
-				// NOTE: Do not release the user data as it will be done upon reception
-				// of CQE notification.
-				io_uring_cqe_seen(liburing->GetRing(), cqe);
+			// NOTE: Do not release the user data as it will be done upon reception
+			// of CQE notification.
+			io_uring_cqe_seen(liburing->GetRing(), cqe);
 
-				continue;
-			}
+			continue;
 		}
 
 		// Successfull SQE.
@@ -113,6 +123,44 @@ inline static void onFdEvent(uv_poll_t* handle, int status, int events)
 	}
 }
 
+inline static void onFdEvent(uv_poll_t* handle, int status, int events)
+{
+	auto* liburing = static_cast<DepLibUring::LibUring*>(handle->data);
+	auto count     = io_uring_peek_batch_cqe(liburing->GetRing(), cqes, DepLibUring::QueueDepth);
+
+	// libuv uses level triggering, so we need to read from the socket to reset
+	// the counter in order to avoid libuv calling this callback indefinitely.
+	eventfd_t v;
+	int err = eventfd_read(liburing->GetEventFd(), std::addressof(v));
+
+	if (err < 0)
+	{
+		// Get positive errno.
+		int error = -err;
+
+		MS_ABORT("eventfd_read() failed: %s", std::strerror(error));
+	};
+
+	// NOTE: Multishot receive requests may complete many more times than the
+	// number of CQEs retrieved at once, so keep processing while the batch is
+	// full.
+	while (true)
+	{
+		processCQEs(liburing, count);
+
+		if (count < DepLibUring::QueueDepth)
+		{
+			break;
+		}
+
+		count = io_uring_peek_batch_cqe(liburing->GetRing(), cqes, DepLibUring::QueueDepth);
+	}
+
+	// Deliver pending received data and submit again ended receive requests.
+	liburing->FlushRecvs();
+	liburing->ArmPendingRecvs();
+}
+
 /* Static class methods */
 
 void DepLibUring::ClassInit()
@@ -276,6 +324,24 @@ bool DepLibUring::IsActive()
 	return DepLibUring::liburing->IsActive();
 }
 
+DepLibUring::RecvRequest* DepLibUring::StartRecv(int sockfd, bool datagram, RecvListener* listener)
+{
+	MS_TRACE();
+
+	MS_ASSERT(DepLibUring::enabled, "io_uring not enabled");
+
+	return DepLibUring::liburing->StartRecv(sockfd, datagram, listener);
+}
+
+void DepLibUring::StopRecv(RecvRequest* request)
+{
+	MS_TRACE();
+
+	MS_ASSERT(DepLibUring::enabled, "io_uring not enabled");
+
+	DepLibUring::liburing->StopRecv(request);
+}
+
 /* Instance methods. */
 
 DepLibUring::LibUring::LibUring()
@@ -285,12 +351,21 @@ DepLibUring::LibUring::LibUring()
 	/**
 	 * IORING_SETUP_SINGLE_ISSUER: A hint to the kernel that only a single task
 	 * (or thread) will submit requests, which is used for internal optimisations.
+	 *
+	 * IORING_SETUP_CQSIZE: There may be more in-flight sends than SQEs, and zero
+	 * copy sends complete twice.
 	 */
 
-	unsigned int flags = IORING_SETUP_SINGLE_ISSUER;
+	struct io_uring_params params
+	{
+	};
+
+	params.flags      = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_CQSIZE;
+	params.cq_entries = DepLibUring::MaxSendBuffers * 2;
 
 	// Initialize io_uring.
-	auto err = io_uring_queue_init(DepLibUring::QueueDepth, std::addressof(this->ring), flags);
+	auto err = io_uring_queue_init_params(
+	  DepLibUring::QueueDepth, std::addressof(this->ring), std::addressof(params));
 
 	if (err < 0)
 	{
@@ -318,62 +393,48 @@ DepLibUring::LibUring::LibUring()
 		MS_THROW_ERROR("io_uring_register_eventfd() failed: %s", std::strerror(error));
 	}
 
-	// Initialize available UserData entries.
-	for (size_t i{ 0 }; i < DepLibUring::QueueDepth; ++i)
-	{
-		this->userDatas[i].store = this->sendBuffers[i];
-		this->availableUserDataEntries.push(i);
-	}
-
-	// Initialize iovecs.
-	for (size_t i{ 0 }; i < DepLibUring::QueueDepth; ++i)
-	{
-		this->iovecs[i].iov_base = this->sendBuffers[i];
-		this->iovecs[i].iov_len  = DepLibUring::SendBufferSize;
-	}
-
-	err = io_uring_register_buffers(std::addressof(this->ring), this->iovecs, DepLibUring::QueueDepth);
+	// NOTE: Send buffers are registered on demand as the pool grows, so just
+	// reserve room for them.
+	err = io_uring_register_buffers_sparse(std::addressof(this->ring), DepLibUring::MaxSendBuffers);
 
 	if (err < 0)
 	{
 		// Get positive errno.
 		int error = -err;
 
-		if (error == ENOMEM)
-		{
-			this->zeroCopyEnabled = false;
-
-			struct rlimit l = {};
+		DisableZeroCopy();
 
-			if (getrlimit(RLIMIT_MEMLOCK, std::addressof(l)) == -1)
-			{
-				MS_WARN_TAG(info, "getrlimit() failed: %s", std::strerror(errno));
-				MS_WARN_TAG(
-				  info,
-				  "io_uring_register_buffers() failed due to low RLIMIT_MEMLOCK, disabling zero copy: %s",
-				  std::strerror(error));
-			}
-			else
-			{
-				MS_WARN_TAG(
-				  info,
-				  "io_uring_register_buffers() failed due to low RLIMIT_MEMLOCK (soft:%lu, hard:%lu), disabling zero copy: %s",
-				  l.rlim_cur,
-				  l.rlim_max,
-				  std::strerror(error));
-			}
-		}
-		else
-		{
-			MS_THROW_ERROR("io_uring_register_buffers() failed: %s", std::strerror(error));
-		}
+		MS_WARN_TAG(
+		  info,
+		  "io_uring_register_buffers_sparse() failed, disabling zero copy: %s",
+		  std::strerror(error));
 	}
+
+	AddSendBufferChunk();
+
+	SetupRecv();
 }
 
 DepLibUring::LibUring::~LibUring()
 {
 	MS_TRACE();
 
+	// NOTE: Receive requests still in the kernel are canceled when closing the
+	// ring.
+	for (auto* request : this->recvRequests)
+	{
+		delete request;
+	}
+
+	if (this->recvBufRing)
+	{
+		io_uring_free_buf_ring(
+		  std::addressof(this->ring),
+		  this->recvBufRing,
+		  DepLibUring::RecvBufferCount,
+		  RecvBufferGroupId);
+	}
+
 	// Close the event file descriptor.
 	const auto err = close(this->efd);
 
@@ -390,12 +451,28 @@ DepLibUring::LibUring::~LibUring()
 }
 
 flatbuffers::Offset<FBS::LibUring::Dump> DepLibUring::LibUring::FillBuffer(
-  flatbuffers::FlatBufferBuilder& builder) const
+  flatbuffers::FlatBufferBuilder& builder)
 {
 	MS_TRACE();
 
+	const auto nowMs = DepLibUV::GetTimeMs();
+
 	return FBS::LibUring::CreateDump(
-	  builder, this->sqeProcessCount, this->sqeMissCount, this->userDataMissCount);
+	  builder,
+	  this->sqeProcessCount,
+	  this->sqeMissCount,
+	  this->userDataMissCount,
+	  this->recvEnabled,
+	  this->recvCount,
+	  this->recvBytes,
+	  this->recvTruncatedCount,
+	  this->recvBufferMissCount,
+	  this->recvFileMissCount,
+	  this->sqeMissRate.GetRate(nowMs),
+	  this->userDataMissRate.GetRate(nowMs),
+	  this->sendBufferChunks.size() * DepLibUring::SendBufferChunkSize,
+	  this->socketBackpressureCount,
+	  this->highWatermarkSubmitCount);
 }
 
 void DepLibUring::LibUring::StartPollingCQEs()
@@ -446,7 +523,7 @@ uint8_t* DepLibUring::LibUring::GetSendBuffer()
 {
 	MS_TRACE();
 
-	if (this->availableUserDataEntries.empty())
+	if (this->availableUserDataEntries.empty() && !AddSendBufferChunk())
 	{
 		MS_DEBUG_DEV("no user data entry available");
 
@@ -455,7 +532,7 @@ uint8_t* DepLibUring::LibUring::GetSendBuffer()
 
 	auto idx = this->availableUserDataEntries.front();
 
-	return this->userDatas[idx].store;
+	return GetUserDataEntry(idx)->store;
 }
 
 bool DepLibUring::LibUring::PrepareSend(
@@ -463,14 +540,10 @@ bool DepLibUring::LibUring::PrepareSend(
 {
 	MS_TRACE();
 
-	auto* userData = this->GetUserData();
+	auto* userData = this->GetUserData(sockfd);
 
 	if (!userData)
 	{
-		MS_DEBUG_DEV("no user data entry available");
-
-		this->userDataMissCount++;
-
 		return false;
 	}
 
@@ -481,16 +554,16 @@ bool DepLibUring::LibUring::PrepareSend(
 		MS_DEBUG_DEV("no sqe available");
 
 		this->sqeMissCount++;
+		this->sqeMissRate.Update(1u, DepLibUV::GetTimeMs());
+
+		ReleaseUserDataEntry(userData->idx);
 
 		return false;
 	}
 
-	// The send data buffer belongs to us, no need to memcpy.
-	if (this->IsDataInSendBuffers(data))
-	{
-		MS_ASSERT(data == userData->store, "send buffer does not match userData store");
-	}
-	else
+	// The send data buffer belongs to us (given by GetSendBuffer()), no need to
+	// memcpy.
+	if (data != userData->store)
 	{
 		std::memcpy(userData->store, data, len);
 	}
@@ -503,10 +576,7 @@ bool DepLibUring::LibUring::PrepareSend(
 
 	if (this->zeroCopyEnabled)
 	{
-		auto iovec    = this->iovecs[userData->idx];
-		iovec.iov_len = len;
-
-		io_uring_prep_send_zc(sqe, sockfd, iovec.iov_base, iovec.iov_len, 0, 0);
+		io_uring_prep_send_zc(sqe, sockfd, userData->store, len, 0, 0);
 		io_uring_prep_send_set_addr(sqe, addr, addrlen);
 
 		// Tell io_uring that we are providing the already registered send buffer
@@ -519,7 +589,7 @@ bool DepLibUring::LibUring::PrepareSend(
 		io_uring_prep_sendto(sqe, sockfd, userData->store, len, 0, addr, addrlen);
 	}
 
-	this->sqeProcessCount++;
+	OnSqePrepared();
 
 	return true;
 }
@@ -529,14 +599,10 @@ bool DepLibUring::LibUring::PrepareWrite(
 {
 	MS_TRACE();
 
-	auto* userData = this->GetUserData();
+	auto* userData = this->GetUserData(sockfd);
 
 	if (!userData)
 	{
-		MS_DEBUG_DEV("no user data entry available");
-
-		this->userDataMissCount++;
-
 		return false;
 	}
 
@@ -547,16 +613,18 @@ bool DepLibUring::LibUring::PrepareWrite(
 		MS_DEBUG_DEV("no sqe available");
 
 		this->sqeMissCount++;
+		this->sqeMissRate.Update(1u, DepLibUV::GetTimeMs());
+
+		ReleaseUserDataEntry(userData->idx);
 
 		return false;
 	}
 
-	// The send data buffer belongs to us, no need to memcpy.
+	// The send data buffer belongs to us (given by GetSendBuffer()), no need to
+	// memcpy.
 	// NOTE: data1 contains the TCP framing buffer and data2 the actual payload.
-	if (this->IsDataInSendBuffers(data2))
+	if (data2 == userData->store)
 	{
-		MS_ASSERT(data2 == userData->store, "send buffer does not match userData store");
-
 		// Always memcpy the frame len as it resides in the stack memory.
 		std::memcpy(userData->frameLen, data1, len1);
 
@@ -582,7 +650,7 @@ bool DepLibUring::LibUring::PrepareWrite(
 
 	io_uring_prep_writev(sqe, sockfd, userData->iov, 2, 0);
 
-	this->sqeProcessCount++;
+	OnSqePrepared();
 
 	return true;
 }
@@ -609,12 +677,508 @@ void DepLibUring::LibUring::Submit()
 	}
 }
 
-DepLibUring::UserData* DepLibUring::LibUring::GetUserData()
+DepLibUring::RecvRequest* DepLibUring::LibUring::StartRecv(
+  int sockfd, bool datagram, RecvListener* listener)
 {
 	MS_TRACE();
 
-	if (this->availableUserDataEntries.empty())
+	if (!this->recvEnabled)
+	{
+		return nullptr;
+	}
+
+	auto* request = new RecvRequest();
+
+	request->listener = listener;
+	request->fd       = sockfd;
+	request->datagram = datagram;
+
+	if (datagram)
+	{
+		request->msg.msg_namelen = sizeof(struct sockaddr_storage);
+	}
+
+	// Use a registered file so the kernel doesn't need to lookup the file
+	// descriptor on every completion.
+	if (!this->availableFileIndexes.empty())
+	{
+		const int fileIdx = this->availableFileIndexes.front();
+		const auto err = io_uring_register_files_update(
+		  std::addressof(this->ring), fileIdx, std::addressof(sockfd), 1);
+
+		if (err == 1)
+		{
+			this->availableFileIndexes.pop();
+
+			request->fileIdx = fileIdx;
+		}
+		else
+		{
+			MS_DEBUG_DEV("io_uring_register_files_update() failed: %s", std::strerror(-err));
+
+			this->recvFileMissCount++;
+		}
+	}
+	else
+	{
+		this->recvFileMissCount++;
+	}
+
+	if (!ArmRecv(request))
 	{
+		ReleaseRecvRequest(request);
+
+		return nullptr;
+	}
+
+	this->recvRequests.insert(request);
+
+	auto err = io_uring_submit(std::addressof(this->ring));
+
+	if (err < 0)
+	{
+		// Get positive errno.
+		int error = -err;
+
+		MS_ERROR("io_uring_submit() failed: %s", std::strerror(error));
+	}
+
+	return request;
+}
+
+void DepLibUring::LibUring::StopRecv(RecvRequest* request)
+{
+	MS_TRACE();
+
+	request->listener = nullptr;
+
+	// Unregister the file so the socket is closed once the request completes.
+	if (request->fileIdx != -1)
+	{
+		const int fd = -1;
+
+		io_uring_register_files_update(
+		  std::addressof(this->ring), request->fileIdx, std::addressof(fd), 1);
+
+		this->availableFileIndexes.push(request->fileIdx);
+
+		request->fileIdx = -1;
+	}
+
+	// NOTE: If not armed, the request is being processed and it will be
+	// released afterwards.
+	if (!request->armed)
+	{
+		return;
+	}
+
+	auto* sqe = GetSqe();
+
+	if (!sqe)
+	{
+		MS_ERROR("no sqe available to cancel the receive request");
+
+		return;
+	}
+
+	// The request is released upon its last completion.
+	io_uring_prep_cancel64(sqe, reinterpret_cast<uint64_t>(request) | RecvRequestTag, 0);
+	io_uring_sqe_set_data64(sqe, 0u);
+	io_uring_sqe_set_flags(sqe, IOSQE_CQE_SKIP_SUCCESS);
+
+	auto err = io_uring_submit(std::addressof(this->ring));
+
+	if (err < 0)
+	{
+		// Get positive errno.
+		int error = -err;
+
+		MS_ERROR("io_uring_submit() failed: %s", std::strerror(error));
+	}
+}
+
+void DepLibUring::LibUring::OnRecvCompletion(struct io_uring_cqe* cqe)
+{
+	MS_TRACE();
+
+	auto* request = reinterpret_cast<RecvRequest*>(io_uring_cqe_get_data64(cqe) & ~RecvRequestTag);
+
+	// Deliver collected data of another request first.
+	if (this->pendingRecvRequest && this->pendingRecvRequest != request)
+	{
+		FlushRecvs();
+	}
+
+	if ((cqe->flags & IORING_CQE_F_BUFFER) != 0u)
+	{
+		const uint16_t bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+		auto* buffer       = this->recvBuffers[bid];
+
+		if (!request->listener || cqe->res <= 0)
+		{
+			ReturnRecvBuffer(bid);
+		}
+		else if (request->datagram)
+		{
+			auto* out = io_uring_recvmsg_validate(buffer, cqe->res, std::addressof(request->msg));
+
+			if (!out || out->payloadlen == 0u)
+			{
+				ReturnRecvBuffer(bid);
+			}
+			else if ((out->flags & MSG_TRUNC) != 0u)
+			{
+				MS_DEBUG_DEV("received datagram was truncated due to insufficient buffer, ignoring it");
+
+				this->recvTruncatedCount++;
+
+				ReturnRecvBuffer(bid);
+			}
+			else
+			{
+				RecvData recv;
+
+				recv.data =
+				  static_cast<uint8_t*>(io_uring_recvmsg_payload(out, std::addressof(request->msg)));
+				recv.len = io_uring_recvmsg_payload_length(out, cqe->res, std::addressof(request->msg));
+				recv.addr = static_cast<const struct sockaddr*>(io_uring_recvmsg_name(out));
+
+				this->pendingRecvRequest = request;
+				this->pendingRecvs.push_back(recv);
+				this->pendingRecvBufferIds.push_back(bid);
+			}
+		}
+		else
+		{
+			RecvData recv;
+
+			recv.data = buffer;
+			recv.len  = cqe->res;
+
+			this->pendingRecvRequest = request;
+			this->pendingRecvs.push_back(recv);
+			this->pendingRecvBufferIds.push_back(bid);
+		}
+	}
+
+	// The multishot request will complete again.
+	if ((cqe->flags & IORING_CQE_F_MORE) != 0u)
+	{
+		return;
+	}
+
+	request->armed = false;
+
+	// NOTE: The listener may stop the request while delivering its data.
+	FlushRecvs();
+
+	if (!request->listener)
+	{
+		ReleaseRecvRequest(request);
+
+		return;
+	}
+
+	// Multishot receive ends if there are no provided buffers left or in some
+	// other non error cases. Submit it again once buffers have been returned.
+	if (cqe->res == -ENOBUFS || (cqe->res > 0) || (cqe->res == 0 && request->datagram))
+	{
+		if (cqe->res == -ENOBUFS)
+		{
+			this->recvBufferMissCount++;
+		}
+
+		this->recvRequestsToArm.push_back(request);
+
+		return;
+	}
+
+	auto* listener = request->listener;
+
+	ReleaseRecvRequest(request);
+
+	listener->OnLibUringRecvError(cqe->res);
+}
+
+void DepLibUring::LibUring::FlushRecvs()
+{
+	MS_TRACE();
+
+	if (!this->pendingRecvRequest)
+	{
+		return;
+	}
+
+	auto* request = this->pendingRecvRequest;
+
+	this->pendingRecvRequest = nullptr;
+
+	if (request->listener)
+	{
+		this->recvCount += this->pendingRecvs.size();
+
+		for (const auto& recv : this->pendingRecvs)
+		{
+			this->recvBytes += recv.len;
+		}
+
+		// NOTE: The listener may stop other requests but their collected data
+		// has already been delivered.
+		request->listener->OnLibUringRecv(this->pendingRecvs.data(), this->pendingRecvs.size());
+	}
+
+	for (auto bid : this->pendingRecvBufferIds)
+	{
+		ReturnRecvBuffer(bid);
+	}
+
+	this->pendingRecvs.clear();
+	this->pendingRecvBufferIds.clear();
+}
+
+void DepLibUring::LibUring::ArmPendingRecvs()
+{
+	MS_TRACE();
+
+	if (this->recvRequestsToArm.empty())
+	{
+		return;
+	}
+
+	// NOTE: Iterate a copy since listeners may be called.
+	std::vector<RecvRequest*> requests;
+
+	requests.swap(this->recvRequestsToArm);
+
+	for (auto* request : requests)
+	{
+		// Stopped meanwhile.
+		if (!request->listener)
+		{
+			ReleaseRecvRequest(request);
+
+			continue;
+		}
+
+		if (!ArmRecv(request))
+		{
+			auto* listener = request->listener;
+
+			ReleaseRecvRequest(request);
+
+			listener->OnLibUringRecvError(-EBUSY);
+		}
+	}
+
+	auto err = io_uring_submit(std::addressof(this->ring));
+
+	if (err < 0)
+	{
+		// Get positive errno.
+		int error = -err;
+
+		MS_ERROR("io_uring_submit() failed: %s", std::strerror(error));
+	}
+}
+
+void DepLibUring::LibUring::SetupRecv()
+{
+	MS_TRACE();
+
+	int err;
+
+	this->recvBufRing = io_uring_setup_buf_ring(
+	  std::addressof(this->ring),
+	  DepLibUring::RecvBufferCount,
+	  RecvBufferGroupId,
+	  0,
+	  std::addressof(err));
+
+	if (!this->recvBufRing)
+	{
+		// Get positive errno.
+		int error = -err;
+
+		MS_WARN_TAG(
+		  info, "io_uring_setup_buf_ring() failed, receiving via libuv: %s", std::strerror(error));
+
+		return;
+	}
+
+	for (size_t i{ 0 }; i < DepLibUring::RecvBufferCount; ++i)
+	{
+		io_uring_buf_ring_add(
+		  this->recvBufRing,
+		  this->recvBuffers[i],
+		  DepLibUring::RecvBufferSize,
+		  i,
+		  io_uring_buf_ring_mask(DepLibUring::RecvBufferCount),
+		  i);
+	}
+
+	io_uring_buf_ring_advance(this->recvBufRing, DepLibUring::RecvBufferCount);
+
+	// Registered files are optional.
+	err = io_uring_register_files_sparse(std::addressof(this->ring), DepLibUring::MaxRegisteredFiles);
+
+	if (err < 0)
+	{
+		// Get positive errno.
+		int error = -err;
+
+		MS_WARN_TAG(info, "io_uring_register_files_sparse() failed: %s", std::strerror(error));
+	}
+	else
+	{
+		for (size_t i{ 0 }; i < DepLibUring::MaxRegisteredFiles; ++i)
+		{
+			this->availableFileIndexes.push(static_cast<int>(i));
+		}
+	}
+
+	this->recvEnabled = true;
+}
+
+io_uring_sqe* DepLibUring::LibUring::GetSqe()
+{
+	MS_TRACE();
+
+	auto* sqe = io_uring_get_sqe(std::addressof(this->ring));
+
+	if (sqe)
+	{
+		return sqe;
+	}
+
+	// Submission queue is full, submit it and try again.
+	io_uring_submit(std::addressof(this->ring));
+
+	return io_uring_get_sqe(std::addressof(this->ring));
+}
+
+bool DepLibUring::LibUring::ArmRecv(RecvRequest* request)
+{
+	MS_TRACE();
+
+	auto* sqe = GetSqe();
+
+	if (!sqe)
+	{
+		MS_DEBUG_DEV("no sqe available");
+
+		this->sqeMissCount++;
+
+		return false;
+	}
+
+	const int fd = request->fileIdx != -1 ? request->fileIdx : request->fd;
+
+	if (request->datagram)
+	{
+		io_uring_prep_recvmsg_multishot(sqe, fd, std::addressof(request->msg), 0);
+	}
+	else
+	{
+		io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+	}
+
+	// Let the kernel pick a provided buffer for each completion.
+	sqe->flags |= IOSQE_BUFFER_SELECT;
+	sqe->buf_group = RecvBufferGroupId;
+
+	if (request->fileIdx != -1)
+	{
+		sqe->flags |= IOSQE_FIXED_FILE;
+	}
+
+	io_uring_sqe_set_data64(sqe, reinterpret_cast<uint64_t>(request) | RecvRequestTag);
+
+	request->armed = true;
+
+	return true;
+}
+
+void DepLibUring::LibUring::ReleaseRecvRequest(RecvRequest* request)
+{
+	MS_TRACE();
+
+	if (request->fileIdx != -1)
+	{
+		const int fd = -1;
+
+		io_uring_register_files_update(
+		  std::addressof(this->ring), request->fileIdx, std::addressof(fd), 1);
+
+		this->availableFileIndexes.push(request->fileIdx);
+	}
+
+	this->recvRequests.erase(request);
+
+	delete request;
+}
+
+void DepLibUring::LibUring::ReturnRecvBuffer(uint16_t bid)
+{
+	MS_TRACE();
+
+	io_uring_buf_ring_add(
+	  this->recvBufRing,
+	  this->recvBuffers[bid],
+	  DepLibUring::RecvBufferSize,
+	  bid,
+	  io_uring_buf_ring_mask(DepLibUring::RecvBufferCount),
+	  0);
+
+	io_uring_buf_ring_advance(this->recvBufRing, 1);
+}
+
+void DepLibUring::LibUring::ReleaseUserDataEntry(size_t idx)
+{
+	MS_TRACE();
+
+	auto* userData = GetUserDataEntry(idx);
+	auto it        = this->mapSocketInflightSends.find(userData->fd);
+
+	if (it != this->mapSocketInflightSends.end() && --it->second == 0u)
+	{
+		this->mapSocketInflightSends.erase(it);
+	}
+
+	userData->fd = -1;
+
+	this->availableUserDataEntries.push(idx);
+}
+
+DepLibUring::UserData* DepLibUring::LibUring::GetUserData(int sockfd)
+{
+	MS_TRACE();
+
+	auto& inflightSends = this->mapSocketInflightSends[sockfd];
+
+	// Do not let a single socket (whose sends are not completing fast enough)
+	// take the whole pool.
+	if (inflightSends >= DepLibUring::MaxSocketInflightSends)
+	{
+		MS_DEBUG_DEV("too many in-flight sends in socket");
+
+		this->socketBackpressureCount++;
+
+		return nullptr;
+	}
+
+	if (this->availableUserDataEntries.empty() && !AddSendBufferChunk())
+	{
+		MS_DEBUG_DEV("no user data entry available");
+
+		this->userDataMissCount++;
+		this->userDataMissRate.Update(1u, DepLibUV::GetTimeMs());
+
+		// NOTE: Do not leave an empty entry in the map.
+		if (inflightSends == 0u)
+		{
+			this->mapSocketInflightSends.erase(sockfd);
+		}
+
 		return nullptr;
 	}
 
@@ -622,8 +1186,124 @@ DepLibUring::UserData* DepLibUring::LibUring::GetUserData()
 
 	this->availableUserDataEntries.pop();
 
-	auto* userData = std::addressof(this->userDatas[idx]);
+	auto* userData = GetUserDataEntry(idx);
 	userData->idx  = idx;
+	userData->fd   = sockfd;
+
+	inflightSends++;
 
 	return userData;
 }
+
+bool DepLibUring::LibUring::AddSendBufferChunk()
+{
+	MS_TRACE();
+
+	const size_t firstIdx = this->sendBufferChunks.size() * DepLibUring::SendBufferChunkSize;
+
+	if (firstIdx >= DepLibUring::MaxSendBuffers)
+	{
+		return false;
+	}
+
+	auto* chunk = new SendBufferChunk();
+
+	this->sendBufferChunks.emplace_back(chunk);
+
+	// Register the new send buffers for zero copy.
+	if (this->zeroCopyEnabled)
+	{
+		std::vector<struct iovec> iovecs(DepLibUring::SendBufferChunkSize);
+
+		for (size_t i{ 0 }; i < DepLibUring::SendBufferChunkSize; ++i)
+		{
+			iovecs[i].iov_base = chunk->sendBuffers[i];
+			iovecs[i].iov_len  = DepLibUring::SendBufferSize;
+		}
+
+		auto err = io_uring_register_buffers_update_tag(
+		  std::addressof(this->ring), firstIdx, iovecs.data(), nullptr, iovecs.size());
+
+		if (err < 0)
+		{
+			// Get positive errno.
+			int error = -err;
+
+			DisableZeroCopy();
+
+			if (error == ENOMEM)
+			{
+				struct rlimit l = {};
+
+				if (getrlimit(RLIMIT_MEMLOCK, std::addressof(l)) == -1)
+				{
+					MS_WARN_TAG(info, "getrlimit() failed: %s", std::strerror(errno));
+					MS_WARN_TAG(
+					  info,
+					  "io_uring_register_buffers_update_tag() failed due to low RLIMIT_MEMLOCK, disabling zero copy: %s",
+					  std::strerror(error));
+				}
+				else
+				{
+					MS_WARN_TAG(
+					  info,
+					  "io_uring_register_buffers_update_tag() failed due to low RLIMIT_MEMLOCK (soft:%lu, hard:%lu), disabling zero copy: %s",
+					  l.rlim_cur,
+					  l.rlim_max,
+					  std::strerror(error));
+				}
+			}
+			else
+			{
+				MS_WARN_TAG(
+				  info,
+				  "io_uring_register_buffers_update_tag() failed, disabling zero copy: %s",
+				  std::strerror(error));
+			}
+		}
+	}
+
+	for (size_t i{ 0 }; i < DepLibUring::SendBufferChunkSize; ++i)
+	{
+		chunk->userDatas[i].store = chunk->sendBuffers[i];
+		this->availableUserDataEntries.push(firstIdx + i);
+	}
+
+	MS_DEBUG_DEV(
+	  "send buffer pool grown to %zu buffers", firstIdx + DepLibUring::SendBufferChunkSize);
+
+	return true;
+}
+
+void DepLibUring::LibUring::DisableZeroCopy()
+{
+	MS_TRACE();
+
+	// NOTE: Zero copy sends already submitted use registered buffers that
+	// remain valid, and their completions are told apart by their CQE flags.
+	this->zeroCopyEnabled = false;
+}
+
+void DepLibUring::LibUring::OnSqePrepared()
+{
+	MS_TRACE();
+
+	this->sqeProcessCount++;
+
+	// Do not wait for Submit() if many SQEs are ready, so the submission queue
+	// doesn't run out of entries in the middle of a big fanout.
+	if (io_uring_sq_ready(std::addressof(this->ring)) >= DepLibUring::SubmitHighWatermark)
+	{
+		auto err = io_uring_submit(std::addressof(this->ring));
+
+		if (err < 0)
+		{
+			// Get positive errno.
+			int error = -err;
+
+			MS_ERROR("io_uring_submit() failed: %s", std::strerror(error));
+		}
+
+		this->highWatermarkSubmitCount++;
+	}
+}
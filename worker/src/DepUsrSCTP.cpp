@@ -5,6 +5,9 @@
 #ifdef MS_LIBURING_SUPPORTED
 #include "DepLibUring.hpp"
 #endif
+#ifdef MS_SENDMMSG_SUPPORTED
+#include "handles/UdpSocketHandle.hpp"
+#endif
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include <usrsctp.h>
@@ -262,8 +265,18 @@ void DepUsrSCTP::Checker::OnTimer(TimerHandle* /*timer*/)
 	}
 #endif
 
+#ifdef MS_SENDMMSG_SUPPORTED
+	// Queue UDP datagrams to send them in a single sendmmsg() call.
+	UdpSocketHandle::StartSendBatch();
+#endif
+
 	usrsctp_handle_timers(elapsedMs);
 
+#ifdef MS_SENDMMSG_SUPPORTED
+	// Send all queued UDP datagrams.
+	UdpSocketHandle::FlushSendBatch();
+#endif
+
 #ifdef MS_LIBURING_SUPPORTED
 	if (DepLibUring::IsEnabled())
 	{
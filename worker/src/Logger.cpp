@@ -18,3 +18,15 @@ void Logger::ClassInit(Channel::ChannelSocket* channel)
 
 	MS_TRACE();
 }
+
+/**
+ * Writes logs (and any other message) kept by Channel write coalescing so
+ * they are not lost if the worker is about to crash.
+ */
+void Logger::Flush()
+{
+	if (Logger::channel)
+	{
+		Logger::channel->Flush();
+	}
+}
@@ -0,0 +1,374 @@
+#define MS_CLASS "RTC::Codecs::AV1"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/Codecs/AV1.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		/* Class methods. */
+
+		bool AV1::Parse(
+		  const uint8_t* data,
+		  size_t len,
+		  AV1::PayloadDescriptor& payloadDescriptor,
+		  const RTC::Codecs::DependencyDescriptor* dependencyDescriptor)
+		{
+			MS_TRACE();
+
+			if (len < 1)
+			{
+				MS_WARN_DEV("ignoring empty payload");
+
+				return false;
+			}
+
+			const uint8_t byte = data[0];
+
+			payloadDescriptor.z = (byte >> 7) & 0x01;
+			payloadDescriptor.y = (byte >> 6) & 0x01;
+			payloadDescriptor.w = (byte >> 4) & 0x03;
+			payloadDescriptor.n = (byte >> 3) & 0x01;
+
+			if (dependencyDescriptor)
+			{
+				payloadDescriptor.dependencyDescriptor    = *dependencyDescriptor;
+				payloadDescriptor.hasDependencyDescriptor = true;
+
+				// clang-format off
+				if (
+					dependencyDescriptor->startOfFrame &&
+					dependencyDescriptor->independent &&
+					dependencyDescriptor->spatialId == 0
+				)
+				// clang-format on
+				{
+					payloadDescriptor.isKeyFrame = true;
+				}
+			}
+			else if (payloadDescriptor.n && !payloadDescriptor.z)
+			{
+				payloadDescriptor.isKeyFrame = true;
+			}
+
+			return true;
+		}
+
+		void AV1::ProcessRtpPacket(
+		  RTC::RtpPacket* packet,
+		  std::unique_ptr<RTC::Codecs::DependencyDescriptor::TemplateDependencyStructure>&
+		    templateDependencyStructure)
+		{
+			MS_TRACE();
+
+			auto* data = packet->GetPayload();
+			auto len   = packet->GetPayloadLength();
+			const uint8_t* extenValue{ nullptr };
+			uint8_t extenLen{ 0 };
+			RTC::Codecs::DependencyDescriptor dependencyDescriptor;
+
+			// Read and parse the Dependency Descriptor (it may update the template
+			// dependency structure of the stream).
+			// clang-format off
+			const bool hasDependencyDescriptor = (
+				packet->ReadDependencyDescriptor(&extenValue, extenLen) &&
+				RTC::Codecs::DependencyDescriptor::Parse(
+					extenValue, extenLen, dependencyDescriptor, templateDependencyStructure)
+			);
+			// clang-format on
+
+			PayloadDescriptor payloadDescriptor{};
+			const auto* parsedDependencyDescriptor =
+			  hasDependencyDescriptor ? &dependencyDescriptor : nullptr;
+
+			if (!AV1::Parse(data, len, payloadDescriptor, parsedDependencyDescriptor))
+			{
+				return;
+			}
+
+			if (payloadDescriptor.isKeyFrame)
+			{
+				MS_DEBUG_DEV(
+				  "key frame [spatialLayer:%" PRIu8 ", temporalLayer:%" PRIu8 "]",
+				  payloadDescriptor.dependencyDescriptor.spatialId,
+				  payloadDescriptor.dependencyDescriptor.temporalId);
+			}
+
+			packet->EmplacePayloadDescriptorHandler<PayloadDescriptorHandler>(payloadDescriptor);
+		}
+
+		/* Instance methods. */
+
+		void AV1::PayloadDescriptor::Dump() const
+		{
+			MS_TRACE();
+
+			MS_DUMP("<AV1::PayloadDescriptor>");
+			MS_DUMP(
+			  "  z:%" PRIu8 "|y:%" PRIu8 "|w:%" PRIu8 "|n:%" PRIu8,
+			  this->z,
+			  this->y,
+			  this->w,
+			  this->n);
+			MS_DUMP("  isKeyFrame: %s", this->isKeyFrame ? "true" : "false");
+			MS_DUMP("  hasDependencyDescriptor: %s", this->hasDependencyDescriptor ? "true" : "false");
+			if (this->hasDependencyDescriptor)
+			{
+				this->dependencyDescriptor.Dump();
+			}
+			MS_DUMP("</AV1::PayloadDescriptor>");
+		}
+
+		AV1::PayloadDescriptorHandler::PayloadDescriptorHandler(
+		  const AV1::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor)
+		{
+			MS_TRACE();
+		}
+
+		bool AV1::PayloadDescriptorHandler::Process(
+		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* /*data*/, bool& marker)
+		{
+			MS_TRACE();
+
+			auto* context = static_cast<RTC::Codecs::AV1::EncodingContext*>(encodingContext);
+
+			MS_ASSERT(context->GetTargetTemporalLayer() >= 0, "target temporal layer cannot be -1");
+
+			// NOTE: SvcConsumer sets a target spatial layer while SimulcastConsumer
+			// (in which each stream is a different spatial layer) does not.
+			const bool hasSpatialLayers = context->GetTargetSpatialLayer() >= 0;
+
+			// Without Dependency Descriptor layers are unknown so nothing can be
+			// filtered.
+			if (!this->payloadDescriptor.hasDependencyDescriptor)
+			{
+				if (context->GetTemporalLayers() > 1)
+				{
+					MS_WARN_DEV(
+					  "stream is supposed to have >1 temporal layers but has no dependency descriptor");
+				}
+
+				if (hasSpatialLayers)
+				{
+					context->SetCurrentSpatialLayer(0);
+				}
+
+				context->SetCurrentTemporalLayer(0);
+
+				return true;
+			}
+
+			const auto& dependencyDescriptor = this->payloadDescriptor.dependencyDescriptor;
+			auto packetSpatialLayer          = GetSpatialLayer();
+			auto packetTemporalLayer         = GetTemporalLayer();
+			auto tmpSpatialLayer             = context->GetCurrentSpatialLayer();
+			auto tmpTemporalLayer            = context->GetCurrentTemporalLayer();
+
+			// If packet spatial or temporal layer is higher than maximum announced
+			// one, drop the packet.
+			// clang-format off
+			if (
+				(hasSpatialLayers && packetSpatialLayer >= context->GetSpatialLayers()) ||
+				packetTemporalLayer >= context->GetTemporalLayers()
+			)
+			// clang-format on
+			{
+				MS_WARN_TAG(
+				  rtp, "too high packet layers %" PRIu8 ":%" PRIu8, packetSpatialLayer, packetTemporalLayer);
+
+				return false;
+			}
+
+			// Check whether frame number sync is required.
+			if (context->syncRequired)
+			{
+				context->maxFrameNumber = dependencyDescriptor.frameNumber - 1;
+
+				context->syncRequired = false;
+			}
+
+			const bool isOldPacket = RTC::SeqManager<uint16_t>::IsSeqLowerThan(
+			  dependencyDescriptor.frameNumber, context->maxFrameNumber);
+
+			if (hasSpatialLayers)
+			{
+				// Upgrade current spatial layer if needed.
+				if (context->GetTargetSpatialLayer() > context->GetCurrentSpatialLayer())
+				{
+					if (this->payloadDescriptor.isKeyFrame)
+					{
+						MS_DEBUG_DEV(
+						  "upgrading tmpSpatialLayer from %" PRIu16 " to %" PRIu16 " (packet:%" PRIu8
+						  ":%" PRIu8 ")",
+						  context->GetCurrentSpatialLayer(),
+						  context->GetTargetSpatialLayer(),
+						  packetSpatialLayer,
+						  packetTemporalLayer);
+
+						tmpSpatialLayer  = context->GetTargetSpatialLayer();
+						tmpTemporalLayer = 0; // Just in case.
+					}
+				}
+				// Downgrade current spatial layer if needed.
+				else if (context->GetTargetSpatialLayer() < context->GetCurrentSpatialLayer())
+				{
+					// In K-SVC we must wait for a keyframe.
+					if (context->IsKSvc())
+					{
+						if (this->payloadDescriptor.isKeyFrame)
+						{
+							MS_DEBUG_DEV(
+							  "downgrading tmpSpatialLayer from %" PRIu16 " to %" PRIu16 " (packet:%" PRIu8
+							  ":%" PRIu8 ") after keyframe (K-SVC)",
+							  context->GetCurrentSpatialLayer(),
+							  context->GetTargetSpatialLayer(),
+							  packetSpatialLayer,
+							  packetTemporalLayer);
+
+							tmpSpatialLayer  = context->GetTargetSpatialLayer();
+							tmpTemporalLayer = 0; // Just in case.
+						}
+					}
+					// In full SVC we do not need a keyframe.
+					else
+					{
+						// clang-format off
+						if (
+							packetSpatialLayer == context->GetTargetSpatialLayer() &&
+							dependencyDescriptor.endOfFrame
+						)
+						// clang-format on
+						{
+							MS_DEBUG_DEV(
+							  "downgrading tmpSpatialLayer from %" PRIu16 " to %" PRIu16 " (packet:%" PRIu8
+							  ":%" PRIu8 ") without keyframe (full SVC)",
+							  context->GetCurrentSpatialLayer(),
+							  context->GetTargetSpatialLayer(),
+							  packetSpatialLayer,
+							  packetTemporalLayer);
+
+							tmpSpatialLayer  = context->GetTargetSpatialLayer();
+							tmpTemporalLayer = 0; // Just in case.
+						}
+					}
+				}
+
+				// Unless old packet filter spatial layers that are either
+				// * higher than current one
+				// * not part of the decode targets of the current one (i.e. lower
+				//   spatial layers of delta frames in K-SVC, while every frame of a
+				//   key picture is part of them)
+				// clang-format off
+				if (
+					!isOldPacket &&
+					(
+						packetSpatialLayer > tmpSpatialLayer ||
+						!(dependencyDescriptor.presentSpatialLayers & (1u << tmpSpatialLayer))
+					)
+				)
+				// clang-format on
+				{
+					return false;
+				}
+			}
+
+			// Check and handle temporal layer (unless old packet).
+			if (!isOldPacket)
+			{
+				// Upgrade current temporal layer if needed.
+				if (context->GetTargetTemporalLayer() > context->GetCurrentTemporalLayer())
+				{
+					// clang-format off
+					if (
+						packetTemporalLayer >= context->GetCurrentTemporalLayer() + 1 &&
+						(
+							context->GetCurrentTemporalLayer() == -1 ||
+							dependencyDescriptor.switchingUpPoint
+						) &&
+						dependencyDescriptor.startOfFrame
+					)
+					// clang-format on
+					{
+						MS_DEBUG_DEV(
+						  "upgrading tmpTemporalLayer from %" PRIu16 " to %" PRIu8 " (packet:%" PRIu8 ":%" PRIu8
+						  ")",
+						  context->GetCurrentTemporalLayer(),
+						  packetTemporalLayer,
+						  packetSpatialLayer,
+						  packetTemporalLayer);
+
+						tmpTemporalLayer = packetTemporalLayer;
+					}
+				}
+				// Downgrade current temporal layer if needed.
+				else if (context->GetTargetTemporalLayer() < context->GetCurrentTemporalLayer())
+				{
+					// clang-format off
+					if (
+						packetTemporalLayer == context->GetTargetTemporalLayer() &&
+						dependencyDescriptor.endOfFrame
+					)
+					// clang-format on
+					{
+						MS_DEBUG_DEV(
+						  "downgrading tmpTemporalLayer from %" PRIu16 " to %" PRIu16 " (packet:%" PRIu8
+						  ":%" PRIu8 ")",
+						  context->GetCurrentTemporalLayer(),
+						  context->GetTargetTemporalLayer(),
+						  packetSpatialLayer,
+						  packetTemporalLayer);
+
+						tmpTemporalLayer = context->GetTargetTemporalLayer();
+					}
+				}
+
+				// Filter temporal layers higher than current one.
+				if (packetTemporalLayer > tmpTemporalLayer)
+				{
+					return false;
+				}
+			}
+
+			// Set marker bit if needed (the original one is set in the last packet of
+			// the highest spatial layer, which may have been dropped).
+			// clang-format off
+			if (
+				hasSpatialLayers &&
+				packetSpatialLayer == tmpSpatialLayer &&
+				dependencyDescriptor.endOfFrame
+			)
+			// clang-format on
+			{
+				marker = true;
+			}
+
+			// Update the highest forwarded frame number.
+			if (!isOldPacket)
+			{
+				context->maxFrameNumber = dependencyDescriptor.frameNumber;
+			}
+
+			// Update current spatial layer if needed.
+			if (hasSpatialLayers && tmpSpatialLayer != context->GetCurrentSpatialLayer())
+			{
+				context->SetCurrentSpatialLayer(tmpSpatialLayer);
+			}
+
+			// Update current temporal layer if needed.
+			if (tmpTemporalLayer != context->GetCurrentTemporalLayer())
+			{
+				context->SetCurrentTemporalLayer(tmpTemporalLayer);
+			}
+
+			return true;
+		}
+
+		void AV1::PayloadDescriptorHandler::Restore(uint8_t* /*data*/)
+		{
+			MS_TRACE();
+		}
+	} // namespace Codecs
+} // namespace RTC
@@ -0,0 +1,489 @@
+#define MS_CLASS "RTC::Codecs::DependencyDescriptor"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/Codecs/DependencyDescriptor.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include <algorithm> // std::max()
+
+/* Static methods. */
+
+// Reads `count` (up to 32) bits in MSB first order. Returns false if there are
+// not enough bits.
+static inline bool readBits(
+  const uint8_t* data, size_t len, size_t& bitOffset, uint8_t count, uint32_t& value)
+{
+	if (bitOffset + count > len * 8)
+	{
+		return false;
+	}
+
+	value = 0u;
+
+	for (uint8_t i{ 0u }; i < count; ++i, ++bitOffset)
+	{
+		value = (value << 1) | ((data[bitOffset >> 3] >> (7 - (bitOffset & 0x07))) & 0x01);
+	}
+
+	return true;
+}
+
+// Reads a non-symmetric unsigned encoded integer with maximum number of values
+// `n` (ns(n) in the spec).
+static inline bool readNonSymmetric(
+  const uint8_t* data, size_t len, size_t& bitOffset, uint32_t n, uint32_t& value)
+{
+	uint8_t w{ 0u };
+
+	for (uint32_t x{ n }; x != 0u; x >>= 1)
+	{
+		++w;
+	}
+
+	const uint32_t m = (1u << w) - n;
+
+	if (!readBits(data, len, bitOffset, w - 1, value))
+	{
+		return false;
+	}
+
+	if (value < m)
+	{
+		return true;
+	}
+
+	uint32_t extraBit;
+
+	if (!readBits(data, len, bitOffset, 1, extraBit))
+	{
+		return false;
+	}
+
+	value = (value << 1) - m + extraBit;
+
+	return true;
+}
+
+static bool parseTemplateDependencyStructure(
+  const uint8_t* data,
+  size_t len,
+  size_t& bitOffset,
+  RTC::Codecs::DependencyDescriptor::TemplateDependencyStructure& structure)
+{
+	using DependencyDescriptor = RTC::Codecs::DependencyDescriptor;
+
+	uint32_t value;
+
+	// template_id_offset and dt_cnt_minus_one.
+	if (!readBits(data, len, bitOffset, 6, value))
+	{
+		return false;
+	}
+
+	structure.templateIdOffset = static_cast<uint8_t>(value);
+
+	if (!readBits(data, len, bitOffset, 5, value))
+	{
+		return false;
+	}
+
+	structure.decodeTargetCount = static_cast<uint8_t>(value + 1);
+
+	// template_layers().
+	uint8_t spatialId{ 0u };
+	uint8_t temporalId{ 0u };
+	uint32_t nextLayerIdc;
+
+	do
+	{
+		if (structure.templateCount == DependencyDescriptor::MaxTemplates)
+		{
+			MS_WARN_DEV("too many templates");
+
+			return false;
+		}
+
+		structure.templateSpatialIds[structure.templateCount]  = spatialId;
+		structure.templateTemporalIds[structure.templateCount] = temporalId;
+		structure.templateCount++;
+
+		if (!readBits(data, len, bitOffset, 2, nextLayerIdc))
+		{
+			return false;
+		}
+
+		if (nextLayerIdc == 1u)
+		{
+			if (++temporalId == DependencyDescriptor::MaxTemporalLayers)
+			{
+				MS_WARN_DEV("too many temporal layers");
+
+				return false;
+			}
+
+			structure.maxTemporalId = std::max(structure.maxTemporalId, temporalId);
+		}
+		else if (nextLayerIdc == 2u)
+		{
+			if (++spatialId == DependencyDescriptor::MaxSpatialLayers)
+			{
+				MS_WARN_DEV("too many spatial layers");
+
+				return false;
+			}
+
+			temporalId = 0u;
+		}
+	} while (nextLayerIdc != 3u);
+
+	structure.maxSpatialId = spatialId;
+
+	// template_dtis().
+	for (uint8_t templateIndex{ 0u }; templateIndex < structure.templateCount; ++templateIndex)
+	{
+		uint64_t dtis{ 0u };
+
+		for (uint8_t dt{ 0u }; dt < structure.decodeTargetCount; ++dt)
+		{
+			if (!readBits(data, len, bitOffset, 2, value))
+			{
+				return false;
+			}
+
+			dtis |= static_cast<uint64_t>(value) << (2 * dt);
+		}
+
+		structure.templateDtis[templateIndex] = dtis;
+	}
+
+	// template_fdiffs(). Just the number of references is kept.
+	for (uint8_t templateIndex{ 0u }; templateIndex < structure.templateCount; ++templateIndex)
+	{
+		uint8_t fdiffCount{ 0u };
+		uint32_t fdiffFollows;
+
+		if (!readBits(data, len, bitOffset, 1, fdiffFollows))
+		{
+			return false;
+		}
+
+		while (fdiffFollows)
+		{
+			// fdiff_minus_one and fdiff_follows_flag.
+			if (fdiffCount == 255u || !readBits(data, len, bitOffset, 5, value))
+			{
+				return false;
+			}
+
+			fdiffCount++;
+			fdiffFollows = value & 0x01;
+		}
+
+		structure.templateFdiffCounts[templateIndex] = fdiffCount;
+	}
+
+	// template_chains(). Chains are skipped.
+	if (!readNonSymmetric(data, len, bitOffset, structure.decodeTargetCount + 1, value))
+	{
+		return false;
+	}
+
+	structure.chainCount = static_cast<uint8_t>(value);
+
+	if (structure.chainCount > 0u)
+	{
+		// decode_target_protected_by.
+		for (uint8_t dt{ 0u }; dt < structure.decodeTargetCount; ++dt)
+		{
+			if (!readNonSymmetric(data, len, bitOffset, structure.chainCount, value))
+			{
+				return false;
+			}
+		}
+
+		// template_chain_fdiff.
+		const size_t bits = 4u * structure.templateCount * structure.chainCount;
+
+		if (bitOffset + bits > len * 8)
+		{
+			return false;
+		}
+
+		bitOffset += bits;
+	}
+
+	// resolutions_present_flag and render_resolutions(). Resolutions are skipped.
+	if (!readBits(data, len, bitOffset, 1, value))
+	{
+		return false;
+	}
+
+	if (value)
+	{
+		const size_t bits = 32u * (structure.maxSpatialId + 1);
+
+		if (bitOffset + bits > len * 8)
+		{
+			return false;
+		}
+
+		bitOffset += bits;
+	}
+
+	// Spatial and temporal layers of each decode target are the highest ones of
+	// the templates that are part of it.
+	for (uint8_t dt{ 0u }; dt < structure.decodeTargetCount; ++dt)
+	{
+		for (uint8_t templateIndex{ 0u }; templateIndex < structure.templateCount; ++templateIndex)
+		{
+			if (structure.GetTemplateDti(templateIndex, dt) == DependencyDescriptor::Dti::NOT_PRESENT)
+			{
+				continue;
+			}
+
+			structure.decodeTargetSpatialIds[dt] =
+			  std::max(structure.decodeTargetSpatialIds[dt], structure.templateSpatialIds[templateIndex]);
+			structure.decodeTargetTemporalIds[dt] = std::max(
+			  structure.decodeTargetTemporalIds[dt], structure.templateTemporalIds[templateIndex]);
+		}
+	}
+
+	// All decode targets are active after a new structure.
+	structure.activeDecodeTargetsBitmask =
+	  static_cast<uint32_t>((uint64_t{ 1u } << structure.decodeTargetCount) - 1);
+
+	return true;
+}
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		/* Class methods. */
+
+		bool DependencyDescriptor::Parse(
+		  const uint8_t* data,
+		  size_t len,
+		  DependencyDescriptor& dependencyDescriptor,
+		  std::unique_ptr<TemplateDependencyStructure>& templateDependencyStructure)
+		{
+			MS_TRACE();
+
+			if (len < 3)
+			{
+				MS_WARN_DEV("ignoring too short dependency descriptor");
+
+				return false;
+			}
+
+			dependencyDescriptor.startOfFrame = (data[0] >> 7) & 0x01;
+			dependencyDescriptor.endOfFrame   = (data[0] >> 6) & 0x01;
+			dependencyDescriptor.templateId   = data[0] & 0x3F;
+			dependencyDescriptor.frameNumber  = Utils::Byte::Get2Bytes(data, 1);
+
+			size_t bitOffset{ 24u };
+			uint32_t structurePresent{ 0u };
+			uint32_t activeDecodeTargetsPresent{ 0u };
+			uint32_t customDtis{ 0u };
+			uint32_t customFdiffs{ 0u };
+			uint32_t customChains{ 0u };
+
+			// Extended descriptor fields.
+			if (len > 3)
+			{
+				// clang-format off
+				if (
+					!readBits(data, len, bitOffset, 1, structurePresent) ||
+					!readBits(data, len, bitOffset, 1, activeDecodeTargetsPresent) ||
+					!readBits(data, len, bitOffset, 1, customDtis) ||
+					!readBits(data, len, bitOffset, 1, customFdiffs) ||
+					!readBits(data, len, bitOffset, 1, customChains)
+				)
+				// clang-format on
+				{
+					return false;
+				}
+			}
+
+			// NOTE: A new structure only replaces the current one once the whole
+			// descriptor has been successfully parsed.
+			std::unique_ptr<TemplateDependencyStructure> newStructure;
+			const TemplateDependencyStructure* structure = templateDependencyStructure.get();
+
+			if (structurePresent)
+			{
+				newStructure.reset(new TemplateDependencyStructure());
+
+				if (!parseTemplateDependencyStructure(data, len, bitOffset, *newStructure))
+				{
+					MS_WARN_DEV("ignoring invalid template dependency structure");
+
+					return false;
+				}
+
+				structure = newStructure.get();
+			}
+
+			if (!structure)
+			{
+				MS_WARN_DEV("ignoring dependency descriptor without template dependency structure");
+
+				return false;
+			}
+
+			uint32_t activeDecodeTargetsBitmask = structure->activeDecodeTargetsBitmask;
+
+			// clang-format off
+			if (
+				activeDecodeTargetsPresent &&
+				!readBits(data, len, bitOffset, structure->decodeTargetCount, activeDecodeTargetsBitmask)
+			)
+			// clang-format on
+			{
+				return false;
+			}
+
+			// frame_dependency_definition().
+			const uint8_t templateIndex =
+			  (dependencyDescriptor.templateId + MaxTemplates - structure->templateIdOffset) %
+			  MaxTemplates;
+
+			if (templateIndex >= structure->templateCount)
+			{
+				MS_WARN_DEV("ignoring dependency descriptor with unknown template");
+
+				return false;
+			}
+
+			uint32_t value;
+			uint64_t dtis      = structure->templateDtis[templateIndex];
+			uint8_t fdiffCount = structure->templateFdiffCounts[templateIndex];
+
+			if (customDtis)
+			{
+				dtis = 0u;
+
+				for (uint8_t dt{ 0u }; dt < structure->decodeTargetCount; ++dt)
+				{
+					if (!readBits(data, len, bitOffset, 2, value))
+					{
+						return false;
+					}
+
+					dtis |= static_cast<uint64_t>(value) << (2 * dt);
+				}
+			}
+
+			if (customFdiffs)
+			{
+				uint32_t nextFdiffSize;
+
+				fdiffCount = 0u;
+
+				if (!readBits(data, len, bitOffset, 2, nextFdiffSize))
+				{
+					return false;
+				}
+
+				while (nextFdiffSize)
+				{
+					// fdiff_minus_one.
+					if (fdiffCount == 255u || !readBits(data, len, bitOffset, 4 * nextFdiffSize, value))
+					{
+						return false;
+					}
+
+					fdiffCount++;
+
+					if (!readBits(data, len, bitOffset, 2, nextFdiffSize))
+					{
+						return false;
+					}
+				}
+			}
+
+			// frame_chain_fdiff. Chains are skipped.
+			if (customChains)
+			{
+				const size_t bits = 8u * structure->chainCount;
+
+				if (bitOffset + bits > len * 8)
+				{
+					return false;
+				}
+
+				bitOffset += bits;
+			}
+
+			dependencyDescriptor.spatialId   = structure->templateSpatialIds[templateIndex];
+			dependencyDescriptor.temporalId  = structure->templateTemporalIds[templateIndex];
+			dependencyDescriptor.fdiffCount  = fdiffCount;
+			dependencyDescriptor.independent = fdiffCount == 0u;
+
+			dependencyDescriptor.activeDecodeTargetsBitmask     = activeDecodeTargetsBitmask;
+			dependencyDescriptor.hasTemplateDependencyStructure = structurePresent;
+			dependencyDescriptor.switchingUpPoint               = false;
+			dependencyDescriptor.presentSpatialLayers           = 0u;
+
+			for (uint8_t dt{ 0u }; dt < structure->decodeTargetCount; ++dt)
+			{
+				if (static_cast<Dti>((dtis >> (2 * dt)) & 0x03) != Dti::NOT_PRESENT)
+				{
+					dependencyDescriptor.presentSpatialLayers |=
+					  static_cast<uint8_t>(1u << structure->decodeTargetSpatialIds[dt]);
+				}
+			}
+
+			for (uint8_t dt{ 0u }; dt < structure->decodeTargetCount; ++dt)
+			{
+				// clang-format off
+				if (
+					structure->decodeTargetSpatialIds[dt] == dependencyDescriptor.spatialId &&
+					structure->decodeTargetTemporalIds[dt] == dependencyDescriptor.temporalId &&
+					static_cast<Dti>((dtis >> (2 * dt)) & 0x03) == Dti::SWITCH
+				)
+				// clang-format on
+				{
+					dependencyDescriptor.switchingUpPoint = true;
+
+					break;
+				}
+			}
+
+			// Everything is fine, so keep the new structure and the active decode
+			// targets for next packets.
+			if (newStructure)
+			{
+				templateDependencyStructure = std::move(newStructure);
+			}
+
+			templateDependencyStructure->activeDecodeTargetsBitmask = activeDecodeTargetsBitmask;
+
+			return true;
+		}
+
+		/* Instance methods. */
+
+		void DependencyDescriptor::Dump() const
+		{
+			MS_TRACE();
+
+			MS_DUMP("<DependencyDescriptor>");
+			MS_DUMP("  startOfFrame: %s", this->startOfFrame ? "true" : "false");
+			MS_DUMP("  endOfFrame: %s", this->endOfFrame ? "true" : "false");
+			MS_DUMP("  templateId: %" PRIu8, this->templateId);
+			MS_DUMP("  frameNumber: %" PRIu16, this->frameNumber);
+			MS_DUMP("  spatialId: %" PRIu8, this->spatialId);
+			MS_DUMP("  temporalId: %" PRIu8, this->temporalId);
+			MS_DUMP("  fdiffCount: %" PRIu8, this->fdiffCount);
+			MS_DUMP("  activeDecodeTargetsBitmask: %" PRIu32, this->activeDecodeTargetsBitmask);
+			MS_DUMP(
+			  "  hasTemplateDependencyStructure: %s",
+			  this->hasTemplateDependencyStructure ? "true" : "false");
+			MS_DUMP("  independent: %s", this->independent ? "true" : "false");
+			MS_DUMP("  presentSpatialLayers: %" PRIu8, this->presentSpatialLayers);
+			MS_DUMP("  switchingUpPoint: %s", this->switchingUpPoint ? "true" : "false");
+			MS_DUMP("</DependencyDescriptor>");
+		}
+	} // namespace Codecs
+} // namespace RTC
@@ -12,7 +12,29 @@ namespace RTC
 		/* Class methods. */
 
 		H264::PayloadDescriptor* H264::Parse(
-		  const uint8_t* data, size_t len, RTC::RtpPacket::FrameMarking* frameMarking, uint8_t frameMarkingLen)
+		  const uint8_t* data,
+		  size_t len,
+		  RTC::RtpPacket::FrameMarking* frameMarking,
+		  uint8_t frameMarkingLen)
+		{
+			MS_TRACE();
+
+			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+
+			if (!H264::Parse(data, len, *payloadDescriptor, frameMarking, frameMarkingLen))
+			{
+				return nullptr;
+			}
+
+			return payloadDescriptor.release();
+		}
+
+		bool H264::Parse(
+		  const uint8_t* data,
+		  size_t len,
+		  H264::PayloadDescriptor& payloadDescriptor,
+		  RTC::RtpPacket::FrameMarking* frameMarking,
+		  uint8_t frameMarkingLen)
 		{
 			MS_TRACE();
 
@@ -20,40 +42,38 @@ namespace RTC
 			{
 				MS_WARN_DEV("ignoring payload with length < 2");
 
-				return nullptr;
+				return false;
 			}
 
-			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
-
 			// Use frame-marking.
 			if (frameMarking)
 			{
 				// Read fields.
-				payloadDescriptor->s   = frameMarking->start;
-				payloadDescriptor->e   = frameMarking->end;
-				payloadDescriptor->i   = frameMarking->independent;
-				payloadDescriptor->d   = frameMarking->discardable;
-				payloadDescriptor->b   = frameMarking->base;
-				payloadDescriptor->tid = frameMarking->tid;
+				payloadDescriptor.s   = frameMarking->start;
+				payloadDescriptor.e   = frameMarking->end;
+				payloadDescriptor.i   = frameMarking->independent;
+				payloadDescriptor.d   = frameMarking->discardable;
+				payloadDescriptor.b   = frameMarking->base;
+				payloadDescriptor.tid = frameMarking->tid;
 
-				payloadDescriptor->hasTid = true;
+				payloadDescriptor.hasTid = true;
 
 				if (frameMarkingLen >= 2)
 				{
-					payloadDescriptor->hasLid = true;
-					payloadDescriptor->lid    = frameMarking->lid;
+					payloadDescriptor.hasLid = true;
+					payloadDescriptor.lid    = frameMarking->lid;
 				}
 
 				if (frameMarkingLen == 3)
 				{
-					payloadDescriptor->hasTl0picidx = true;
-					payloadDescriptor->tl0picidx    = frameMarking->tl0picidx;
+					payloadDescriptor.hasTl0picidx = true;
+					payloadDescriptor.tl0picidx    = frameMarking->tl0picidx;
 				}
 
 				// Detect key frame.
 				if (frameMarking->start && frameMarking->independent)
 				{
-					payloadDescriptor->isKeyFrame = true;
+					payloadDescriptor.isKeyFrame = true;
 				}
 			}
 
@@ -63,7 +83,7 @@ namespace RTC
 			//
 			// As a temporal workaround, always do payload parsing to detect keyframes if
 			// there is no frame-marking or if there is but keyframe was not detected above.
-			if (!frameMarking || !payloadDescriptor->isKeyFrame)
+			if (!frameMarking || !payloadDescriptor.isKeyFrame)
 			{
 				const uint8_t nal = *data & 0x1F;
 
@@ -73,7 +93,7 @@ namespace RTC
 					// IDR (instantaneous decoding picture).
 					case 7:
 					{
-						payloadDescriptor->isKeyFrame = true;
+						payloadDescriptor.isKeyFrame = true;
 
 						break;
 					}
@@ -94,7 +114,7 @@ namespace RTC
 
 							if (subnal == 7)
 							{
-								payloadDescriptor->isKeyFrame = true;
+								payloadDescriptor.isKeyFrame = true;
 
 								break;
 							}
@@ -122,7 +142,7 @@ namespace RTC
 
 						if (subnal == 7 && startBit == 128)
 						{
-							payloadDescriptor->isKeyFrame = true;
+							payloadDescriptor.isKeyFrame = true;
 						}
 
 						break;
@@ -130,7 +150,7 @@ namespace RTC
 				}
 			}
 
-			return payloadDescriptor.release();
+			return true;
 		}
 
 		void H264::ProcessRtpPacket(RTC::RtpPacket* packet)
@@ -145,16 +165,14 @@ namespace RTC
 			// Read frame-marking.
 			packet->ReadFrameMarking(&frameMarking, frameMarkingLen);
 
-			PayloadDescriptor* payloadDescriptor = H264::Parse(data, len, frameMarking, frameMarkingLen);
+			PayloadDescriptor payloadDescriptor{};
 
-			if (!payloadDescriptor)
+			if (!H264::Parse(data, len, payloadDescriptor, frameMarking, frameMarkingLen))
 			{
 				return;
 			}
 
-			auto* payloadDescriptorHandler = new PayloadDescriptorHandler(payloadDescriptor);
-
-			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
+			packet->EmplacePayloadDescriptorHandler<PayloadDescriptorHandler>(payloadDescriptor);
 		}
 
 		/* Instance methods. */
@@ -187,11 +205,11 @@ namespace RTC
 			MS_DUMP("</H264::PayloadDescriptor>");
 		}
 
-		H264::PayloadDescriptorHandler::PayloadDescriptorHandler(H264::PayloadDescriptor* payloadDescriptor)
+		H264::PayloadDescriptorHandler::PayloadDescriptorHandler(
+		  const H264::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor)
 		{
 			MS_TRACE();
-
-			this->payloadDescriptor.reset(payloadDescriptor);
 		}
 
 		bool H264::PayloadDescriptorHandler::Process(
@@ -204,15 +222,15 @@ namespace RTC
 			MS_ASSERT(context->GetTargetTemporalLayer() >= 0, "target temporal layer cannot be -1");
 
 			// Check if the payload should contain temporal layer info.
-			if (context->GetTemporalLayers() > 1 && !this->payloadDescriptor->hasTid)
+			if (context->GetTemporalLayers() > 1 && !this->payloadDescriptor.hasTid)
 			{
 				MS_WARN_DEV("stream is supposed to have >1 temporal layers but does not have tid field");
 			}
 
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasTid &&
-				this->payloadDescriptor->tid > context->GetTargetTemporalLayer()
+				this->payloadDescriptor.hasTid &&
+				this->payloadDescriptor.tid > context->GetTargetTemporalLayer()
 			)
 			// clang-format on
 			{
@@ -224,9 +242,9 @@ namespace RTC
 			//
 			// clang-format off
 			else if (
-				this->payloadDescriptor->hasTid &&
-				this->payloadDescriptor->tid > context->GetCurrentTemporalLayer() &&
-				!this->payloadDescriptor->b
+				this->payloadDescriptor.hasTid &&
+				this->payloadDescriptor.tid > context->GetCurrentTemporalLayer() &&
+				!this->payloadDescriptor.b
 			)
 			// clang-format on
 			{
@@ -236,14 +254,14 @@ namespace RTC
 			// Update/fix current temporal layer.
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasTid &&
-				this->payloadDescriptor->tid > context->GetCurrentTemporalLayer()
+				this->payloadDescriptor.hasTid &&
+				this->payloadDescriptor.tid > context->GetCurrentTemporalLayer()
 			)
 			// clang-format on
 			{
-				context->SetCurrentTemporalLayer(this->payloadDescriptor->tid);
+				context->SetCurrentTemporalLayer(this->payloadDescriptor.tid);
 			}
-			else if (!this->payloadDescriptor->hasTid)
+			else if (!this->payloadDescriptor.hasTid)
 			{
 				context->SetCurrentTemporalLayer(0);
 			}
@@ -15,44 +15,61 @@ namespace RTC
 		{
 			MS_TRACE();
 
+			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+
+			if (!H264_SVC::Parse(data, len, *payloadDescriptor, frameMarking, frameMarkingLen))
+			{
+				return nullptr;
+			}
+
+			return payloadDescriptor.release();
+		}
+
+		bool H264_SVC::Parse(
+		  const uint8_t* data,
+		  size_t len,
+		  H264_SVC::PayloadDescriptor& payloadDescriptor,
+		  RTC::RtpPacket::FrameMarking* frameMarking,
+		  uint8_t frameMarkingLen)
+		{
+			MS_TRACE();
+
 			if (len < 2)
 			{
 				MS_WARN_DEV("ignoring payload with length < 2");
 
-				return nullptr;
+				return false;
 			}
 
-			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
-
 			// Use frame-marking.
 			if (frameMarking)
 			{
 				// Read fields.
-				payloadDescriptor->s       = frameMarking->start;
-				payloadDescriptor->e       = frameMarking->end;
-				payloadDescriptor->i       = frameMarking->independent;
-				payloadDescriptor->d       = frameMarking->discardable;
-				payloadDescriptor->b       = frameMarking->base;
-				payloadDescriptor->tlIndex = frameMarking->tid;
+				payloadDescriptor.s       = frameMarking->start;
+				payloadDescriptor.e       = frameMarking->end;
+				payloadDescriptor.i       = frameMarking->independent;
+				payloadDescriptor.d       = frameMarking->discardable;
+				payloadDescriptor.b       = frameMarking->base;
+				payloadDescriptor.tlIndex = frameMarking->tid;
 
-				payloadDescriptor->hasTlIndex = true;
+				payloadDescriptor.hasTlIndex = true;
 
 				if (frameMarkingLen >= 2)
 				{
-					payloadDescriptor->hasSlIndex = true;
-					payloadDescriptor->slIndex    = frameMarking->lid >> 4 & 0x07;
+					payloadDescriptor.hasSlIndex = true;
+					payloadDescriptor.slIndex    = frameMarking->lid >> 4 & 0x07;
 				}
 
 				if (frameMarkingLen == 3)
 				{
-					payloadDescriptor->hasTl0picidx = true;
-					payloadDescriptor->tl0picidx    = frameMarking->tl0picidx;
+					payloadDescriptor.hasTl0picidx = true;
+					payloadDescriptor.tl0picidx    = frameMarking->tl0picidx;
 				}
 
 				// Detect key frame.
 				if (frameMarking->start && frameMarking->independent)
 				{
-					payloadDescriptor->isKeyFrame = true;
+					payloadDescriptor.isKeyFrame = true;
 				}
 			}
 
@@ -63,7 +80,7 @@ namespace RTC
 			// As a temporal workaround, always do payload parsing to detect keyframes
 			// if there is no frame-marking or if there is but keyframe was not
 			// detected above.
-			if (!frameMarking || !payloadDescriptor->isKeyFrame)
+			if (!frameMarking || !payloadDescriptor.isKeyFrame)
 			{
 				const uint8_t nal = *data & 0x1F;
 
@@ -77,14 +94,11 @@ namespace RTC
 					case 14:
 					case 20:
 					{
-						payloadDescriptor =
-						  H264_SVC::ParseSingleNalu(data, len, std::move(payloadDescriptor), true);
-
-						if (payloadDescriptor == nullptr)
+						if (!H264_SVC::ParseSingleNalu(data, len, payloadDescriptor, true))
 						{
 							MS_WARN_DEV("ignoring invalid payload (1)");
 
-							return nullptr;
+							return false;
 						}
 
 						break;
@@ -103,20 +117,23 @@ namespace RTC
 						{
 							auto naluSize = Utils::Byte::Get2Bytes(data, offset);
 
-							payloadDescriptor = H264_SVC::ParseSingleNalu(
-							  (data + offset + sizeof(naluSize)),
-							  (len - sizeof(naluSize)),
-							  std::move(payloadDescriptor),
-							  true);
-
-							if (payloadDescriptor == nullptr)
+							// clang-format off
+							if (
+								!H264_SVC::ParseSingleNalu(
+									(data + offset + sizeof(naluSize)),
+									(len - sizeof(naluSize)),
+									payloadDescriptor,
+									true
+								)
+							)
+							// clang-format on
 							{
 								MS_WARN_DEV("ignoring invalid payload (2)");
 
-								return nullptr;
+								return false;
 							}
 
-							if (payloadDescriptor->isKeyFrame)
+							if (payloadDescriptor.isKeyFrame)
 							{
 								break;
 							}
@@ -141,17 +158,18 @@ namespace RTC
 					{
 						const uint8_t startBit = *(data + 1) & 0x80;
 
-						if (startBit == 128)
-						{
-							payloadDescriptor = H264_SVC::ParseSingleNalu(
-							  (data + 1), (len - 1), std::move(payloadDescriptor), (startBit == 128 ? true : false));
-						}
-
-						if (payloadDescriptor == nullptr)
+						// clang-format off
+						if (
+							startBit == 128 &&
+							!H264_SVC::ParseSingleNalu(
+								(data + 1), (len - 1), payloadDescriptor, (startBit == 128 ? true : false)
+							)
+						)
+						// clang-format on
 						{
 							MS_WARN_DEV("ignoring invalid payload (3)");
 
-							return nullptr;
+							return false;
 						}
 
 						break;
@@ -159,13 +177,13 @@ namespace RTC
 				}
 			}
 
-			return payloadDescriptor.release();
+			return true;
 		}
 
-		std::unique_ptr<H264_SVC::PayloadDescriptor> H264_SVC::ParseSingleNalu(
+		bool H264_SVC::ParseSingleNalu(
 		  const uint8_t* data,
 		  size_t len,
-		  std::unique_ptr<H264_SVC::PayloadDescriptor> payloadDescriptor,
+		  H264_SVC::PayloadDescriptor& payloadDescriptor,
 		  bool isStartBit)
 		{
 			const uint8_t nal = *data & 0x1F;
@@ -176,16 +194,16 @@ namespace RTC
 				// IDR (instantaneous decoding picture).
 				case 5:
 				{
-					payloadDescriptor->isKeyFrame = true;
+					payloadDescriptor.isKeyFrame = true;
 				}
 
 				case 1:
 				{
-					payloadDescriptor->slIndex = 0;
-					payloadDescriptor->tlIndex = 0;
+					payloadDescriptor.slIndex = 0;
+					payloadDescriptor.tlIndex = 0;
 
-					payloadDescriptor->hasSlIndex = false;
-					payloadDescriptor->hasTlIndex = false;
+					payloadDescriptor.hasSlIndex = false;
+					payloadDescriptor.hasTlIndex = false;
 
 					break;
 				}
@@ -195,49 +213,49 @@ namespace RTC
 				{
 					if (len <= 1)
 					{
-						return nullptr;
+						return false;
 					}
 
 					size_t offset{ 1 };
 					uint8_t byte = data[offset];
 
-					payloadDescriptor->idr        = byte >> 6 & 0x01;
-					payloadDescriptor->priorityId = byte & 0x06;
-					payloadDescriptor->isKeyFrame = (isStartBit && payloadDescriptor->idr) ? true : false;
+					payloadDescriptor.idr        = byte >> 6 & 0x01;
+					payloadDescriptor.priorityId = byte & 0x06;
+					payloadDescriptor.isKeyFrame = (isStartBit && payloadDescriptor.idr) ? true : false;
 
 					if (len < ++offset + 1)
 					{
-						return nullptr;
+						return false;
 					}
 
 					byte                                  = data[offset];
-					payloadDescriptor->noIntLayerPredFlag = byte >> 7 & 0x01;
-					payloadDescriptor->slIndex            = byte >> 4 & 0x03;
+					payloadDescriptor.noIntLayerPredFlag = byte >> 7 & 0x01;
+					payloadDescriptor.slIndex            = byte >> 4 & 0x03;
 
 					if (len < ++offset + 1)
 					{
-						return nullptr;
+						return false;
 					}
 
 					byte = data[offset];
 
-					payloadDescriptor->tlIndex = byte >> 5 & 0x03;
+					payloadDescriptor.tlIndex = byte >> 5 & 0x03;
 
-					payloadDescriptor->hasSlIndex = payloadDescriptor->slIndex ? true : false;
-					payloadDescriptor->hasTlIndex = payloadDescriptor->tlIndex ? true : false;
+					payloadDescriptor.hasSlIndex = payloadDescriptor.slIndex ? true : false;
+					payloadDescriptor.hasTlIndex = payloadDescriptor.tlIndex ? true : false;
 
 					break;
 				}
 
 				case 7:
 				{
-					payloadDescriptor->isKeyFrame = isStartBit ? true : false;
+					payloadDescriptor.isKeyFrame = isStartBit ? true : false;
 
 					break;
 				}
 			}
 
-			return payloadDescriptor;
+			return true;
 		}
 
 		void H264_SVC::ProcessRtpPacket(RTC::RtpPacket* packet)
@@ -252,17 +270,14 @@ namespace RTC
 			// Read frame-marking.
 			packet->ReadFrameMarking(&frameMarking, frameMarkingLen);
 
-			PayloadDescriptor* payloadDescriptor =
-			  H264_SVC::Parse(data, len, frameMarking, frameMarkingLen);
+			PayloadDescriptor payloadDescriptor{};
 
-			if (!payloadDescriptor)
+			if (!H264_SVC::Parse(data, len, payloadDescriptor, frameMarking, frameMarkingLen))
 			{
 				return;
 			}
 
-			auto* payloadDescriptorHandler = new PayloadDescriptorHandler(payloadDescriptor);
-
-			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
+			packet->EmplacePayloadDescriptorHandler<PayloadDescriptorHandler>(payloadDescriptor);
 		}
 
 		/* Instance methods. */
@@ -288,11 +303,10 @@ namespace RTC
 		}
 
 		H264_SVC::PayloadDescriptorHandler::PayloadDescriptorHandler(
-		  H264_SVC::PayloadDescriptor* payloadDescriptor)
+		  const H264_SVC::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor)
 		{
 			MS_TRACE();
-
-			this->payloadDescriptor.reset(payloadDescriptor);
 		}
 
 		bool H264_SVC::PayloadDescriptorHandler::Process(
@@ -331,7 +345,7 @@ namespace RTC
 			// Upgrade current spatial layer if needed.
 			if (context->GetTargetSpatialLayer() > context->GetCurrentSpatialLayer())
 			{
-				if (this->payloadDescriptor->isKeyFrame)
+				if (this->payloadDescriptor.isKeyFrame)
 				{
 					MS_DEBUG_DEV(
 					  "upgrading tmpSpatialLayer from %" PRIu16 " to %" PRIu16 " (packet:%" PRIu8 ":%" PRIu8
@@ -351,7 +365,7 @@ namespace RTC
 				// In K-SVC we must wait for a keyframe.
 				if (context->IsKSvc())
 				{
-					if (this->payloadDescriptor->isKeyFrame)
+					if (this->payloadDescriptor.isKeyFrame)
 					// clang-format on
 					{
 						MS_DEBUG_DEV(
@@ -372,7 +386,7 @@ namespace RTC
 					// clang-format off
 					if (
 						packetSpatialLayer == context->GetTargetSpatialLayer() &&
-						this->payloadDescriptor->e
+						this->payloadDescriptor.e
 					)
 					// clang-format on
 					{
@@ -405,7 +419,7 @@ namespace RTC
 					// clang-format off
 					if (
 						packetTemporalLayer >= context->GetCurrentTemporalLayer() + 1 &&
-						this->payloadDescriptor->s
+						this->payloadDescriptor.s
 					)
 					// clang-format on
 					{
@@ -426,7 +440,7 @@ namespace RTC
 					// clang-format off
 					if (
 						packetTemporalLayer == context->GetTargetTemporalLayer() &&
-						this->payloadDescriptor->e
+						this->payloadDescriptor.e
 					)
 					// clang-format on
 					{
@@ -450,7 +464,7 @@ namespace RTC
 			}
 
 			// Set marker bit if needed.
-			if (packetSpatialLayer == tmpSpatialLayer && this->payloadDescriptor->e)
+			if (packetSpatialLayer == tmpSpatialLayer && this->payloadDescriptor.e)
 			{
 				marker = true;
 			}
@@ -14,21 +14,33 @@ namespace RTC
 		{
 			MS_TRACE();
 
+			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+
+			if (!Opus::Parse(data, len, *payloadDescriptor))
+			{
+				return nullptr;
+			}
+
+			return payloadDescriptor.release();
+		}
+
+		bool Opus::Parse(const uint8_t* data, size_t len, Opus::PayloadDescriptor& payloadDescriptor)
+		{
+			MS_TRACE();
+
 			if (len < 1)
 			{
 				MS_WARN_DEV("ignoring empty payload");
 
-				return nullptr;
+				return false;
 			}
 
-			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
-
 			uint8_t byte = data[0];
 
-			payloadDescriptor->stereo = (byte >> 2) & 0x01;
-			payloadDescriptor->code   = byte & 0x03;
+			payloadDescriptor.stereo = (byte >> 2) & 0x01;
+			payloadDescriptor.code   = byte & 0x03;
 
-			switch (payloadDescriptor->code)
+			switch (payloadDescriptor.code)
 			{
 				case 0:
 				case 1:
@@ -37,7 +49,7 @@ namespace RTC
 					// byte only).
 					if (len == 1)
 					{
-						payloadDescriptor->isDtx = true;
+						payloadDescriptor.isDtx = true;
 					}
 
 					break;
@@ -50,7 +62,7 @@ namespace RTC
 					{
 						MS_WARN_DEV("ignoring invalid payload (1)");
 
-						return nullptr;
+						return false;
 					}
 
 					// In code 2 packets, DTX is determined by total length = 2 (TOC byte
@@ -58,7 +70,7 @@ namespace RTC
 					// the length of both frames is zero.
 					if (len == 2)
 					{
-						payloadDescriptor->isDtx = true;
+						payloadDescriptor.isDtx = true;
 					}
 
 					break;
@@ -71,7 +83,7 @@ namespace RTC
 					{
 						MS_WARN_DEV("ignoring invalid payload (2)");
 
-						return nullptr;
+						return false;
 					}
 
 					// A code 3 packet can never be DTX.
@@ -82,7 +94,7 @@ namespace RTC
 				default:;
 			}
 
-			return payloadDescriptor.release();
+			return true;
 		}
 
 		void Opus::ProcessRtpPacket(RTC::RtpPacket* packet)
@@ -92,16 +104,14 @@ namespace RTC
 			auto* data = packet->GetPayload();
 			auto len   = packet->GetPayloadLength();
 
-			PayloadDescriptor* payloadDescriptor = Opus::Parse(data, len);
+			PayloadDescriptor payloadDescriptor{};
 
-			if (!payloadDescriptor)
+			if (!Opus::Parse(data, len, payloadDescriptor))
 			{
 				return;
 			}
 
-			auto* payloadDescriptorHandler = new PayloadDescriptorHandler(payloadDescriptor);
-
-			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
+			packet->EmplacePayloadDescriptorHandler<PayloadDescriptorHandler>(payloadDescriptor);
 		}
 
 		/* Instance methods. */
@@ -117,11 +127,11 @@ namespace RTC
 			MS_DUMP("</Opus::PayloadDescriptor>");
 		}
 
-		Opus::PayloadDescriptorHandler::PayloadDescriptorHandler(Opus::PayloadDescriptor* payloadDescriptor)
+		Opus::PayloadDescriptorHandler::PayloadDescriptorHandler(
+		  const Opus::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor)
 		{
 			MS_TRACE();
-
-			this->payloadDescriptor.reset(payloadDescriptor);
 		}
 
 		bool Opus::PayloadDescriptorHandler::Process(
@@ -131,7 +141,7 @@ namespace RTC
 
 			auto* context = static_cast<RTC::Codecs::Opus::EncodingContext*>(encodingContext);
 
-			if (this->payloadDescriptor->isDtx && context->GetIgnoreDtx())
+			if (this->payloadDescriptor.isDtx && context->GetIgnoreDtx())
 			{
 				return false;
 			}
@@ -13,6 +13,25 @@ namespace RTC
 		VP9::PayloadDescriptor* VP9::Parse(
 		  const uint8_t* data,
 		  size_t len,
+		  RTC::RtpPacket::FrameMarking* frameMarking,
+		  uint8_t frameMarkingLen)
+		{
+			MS_TRACE();
+
+			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+
+			if (!VP9::Parse(data, len, *payloadDescriptor, frameMarking, frameMarkingLen))
+			{
+				return nullptr;
+			}
+
+			return payloadDescriptor.release();
+		}
+
+		bool VP9::Parse(
+		  const uint8_t* data,
+		  size_t len,
+		  VP9::PayloadDescriptor& payloadDescriptor,
 		  RTC::RtpPacket::FrameMarking* /*frameMarking*/,
 		  uint8_t /*frameMarkingLen*/)
 		{
@@ -22,29 +41,27 @@ namespace RTC
 			{
 				MS_WARN_DEV("ignoring empty payload");
 
-				return nullptr;
+				return false;
 			}
 
-			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
-
 			size_t offset{ 0 };
 			uint8_t byte = data[offset];
 
-			payloadDescriptor->i = (byte >> 7) & 0x01;
-			payloadDescriptor->p = (byte >> 6) & 0x01;
-			payloadDescriptor->l = (byte >> 5) & 0x01;
-			payloadDescriptor->f = (byte >> 4) & 0x01;
-			payloadDescriptor->b = (byte >> 3) & 0x01;
-			payloadDescriptor->e = (byte >> 2) & 0x01;
-			payloadDescriptor->v = (byte >> 1) & 0x01;
+			payloadDescriptor.i = (byte >> 7) & 0x01;
+			payloadDescriptor.p = (byte >> 6) & 0x01;
+			payloadDescriptor.l = (byte >> 5) & 0x01;
+			payloadDescriptor.f = (byte >> 4) & 0x01;
+			payloadDescriptor.b = (byte >> 3) & 0x01;
+			payloadDescriptor.e = (byte >> 2) & 0x01;
+			payloadDescriptor.v = (byte >> 1) & 0x01;
 
-			if (payloadDescriptor->i)
+			if (payloadDescriptor.i)
 			{
 				if (len < ++offset + 1)
 				{
 					MS_WARN_DEV("ignoring invalid payload (1)");
 
-					return nullptr;
+					return false;
 				}
 
 				byte = data[offset];
@@ -55,67 +72,67 @@ namespace RTC
 					{
 						MS_WARN_DEV("ignoring invalid payload (2)");
 
-						return nullptr;
+						return false;
 					}
 
-					payloadDescriptor->pictureId = (byte & 0x7F) << 8;
-					payloadDescriptor->pictureId += data[offset];
-					payloadDescriptor->hasTwoBytesPictureId = true;
+					payloadDescriptor.pictureId = (byte & 0x7F) << 8;
+					payloadDescriptor.pictureId += data[offset];
+					payloadDescriptor.hasTwoBytesPictureId = true;
 				}
 				else
 				{
-					payloadDescriptor->pictureId           = byte & 0x7F;
-					payloadDescriptor->hasOneBytePictureId = true;
+					payloadDescriptor.pictureId           = byte & 0x7F;
+					payloadDescriptor.hasOneBytePictureId = true;
 				}
 
-				payloadDescriptor->hasPictureId = true;
+				payloadDescriptor.hasPictureId = true;
 			}
 
-			if (payloadDescriptor->l)
+			if (payloadDescriptor.l)
 			{
 				if (len < ++offset + 1)
 				{
 					MS_WARN_DEV("ignoring invalid payload (3)");
 
-					return nullptr;
+					return false;
 				}
 
 				byte = data[offset];
 
-				payloadDescriptor->interLayerDependency = byte & 0x01;
-				payloadDescriptor->switchingUpPoint     = byte >> 4 & 0x01;
-				payloadDescriptor->slIndex              = byte >> 1 & 0x07;
-				payloadDescriptor->tlIndex              = byte >> 5 & 0x07;
-				payloadDescriptor->hasSlIndex           = true;
-				payloadDescriptor->hasTlIndex           = true;
+				payloadDescriptor.interLayerDependency = byte & 0x01;
+				payloadDescriptor.switchingUpPoint     = byte >> 4 & 0x01;
+				payloadDescriptor.slIndex              = byte >> 1 & 0x07;
+				payloadDescriptor.tlIndex              = byte >> 5 & 0x07;
+				payloadDescriptor.hasSlIndex           = true;
+				payloadDescriptor.hasTlIndex           = true;
 
 				if (len < ++offset + 1)
 				{
 					MS_WARN_DEV("ignoring invalid payload (4)");
 
-					return nullptr;
+					return false;
 				}
 
 				// Read TL0PICIDX if flexible mode is unset.
-				if (!payloadDescriptor->f)
+				if (!payloadDescriptor.f)
 				{
-					payloadDescriptor->tl0PictureIndex    = data[offset];
-					payloadDescriptor->hasTl0PictureIndex = true;
+					payloadDescriptor.tl0PictureIndex    = data[offset];
+					payloadDescriptor.hasTl0PictureIndex = true;
 				}
 			}
 
 			// clang-format off
 			if (
-				!payloadDescriptor->p &&
-				payloadDescriptor->b &&
-				payloadDescriptor->slIndex == 0
+				!payloadDescriptor.p &&
+				payloadDescriptor.b &&
+				payloadDescriptor.slIndex == 0
 			)
 			// clang-format on
 			{
-				payloadDescriptor->isKeyFrame = true;
+				payloadDescriptor.isKeyFrame = true;
 			}
 
-			return payloadDescriptor.release();
+			return true;
 		}
 
 		void VP9::ProcessRtpPacket(RTC::RtpPacket* packet)
@@ -130,24 +147,22 @@ namespace RTC
 			// Read frame-marking.
 			packet->ReadFrameMarking(&frameMarking, frameMarkingLen);
 
-			PayloadDescriptor* payloadDescriptor = VP9::Parse(data, len, frameMarking, frameMarkingLen);
+			PayloadDescriptor payloadDescriptor{};
 
-			if (!payloadDescriptor)
+			if (!VP9::Parse(data, len, payloadDescriptor, frameMarking, frameMarkingLen))
 			{
 				return;
 			}
 
-			if (payloadDescriptor->isKeyFrame)
+			if (payloadDescriptor.isKeyFrame)
 			{
 				MS_DEBUG_DEV(
 				  "key frame [spatialLayer:%" PRIu8 ", temporalLayer:%" PRIu8 "]",
-				  packet->GetSpatialLayer(),
-				  packet->GetTemporalLayer());
+				  payloadDescriptor.slIndex,
+				  payloadDescriptor.tlIndex);
 			}
 
-			auto* payloadDescriptorHandler = new PayloadDescriptorHandler(payloadDescriptor);
-
-			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
+			packet->EmplacePayloadDescriptorHandler<PayloadDescriptorHandler>(payloadDescriptor);
 		}
 
 		/* Instance methods. */
@@ -182,11 +197,11 @@ namespace RTC
 			MS_DUMP("</VP9::PayloadDescriptor>");
 		}
 
-		VP9::PayloadDescriptorHandler::PayloadDescriptorHandler(VP9::PayloadDescriptor* payloadDescriptor)
+		VP9::PayloadDescriptorHandler::PayloadDescriptorHandler(
+		  const VP9::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor)
 		{
 			MS_TRACE();
-
-			this->payloadDescriptor.reset(payloadDescriptor);
 		}
 
 		bool VP9::PayloadDescriptorHandler::Process(
@@ -223,20 +238,20 @@ namespace RTC
 			// clang-format off
 			if (
 				context->syncRequired &&
-				this->payloadDescriptor->hasPictureId
+				this->payloadDescriptor.hasPictureId
 			)
 			// clang-format on
 			{
-				context->pictureIdManager.Sync(this->payloadDescriptor->pictureId - 1);
+				context->pictureIdManager.Sync(this->payloadDescriptor.pictureId - 1);
 
 				context->syncRequired = false;
 			}
 
 			// clang-format off
 			const bool isOldPacket = (
-				this->payloadDescriptor->hasPictureId &&
+				this->payloadDescriptor.hasPictureId &&
 				RTC::SeqManager<uint16_t, 15>::IsSeqLowerThan(
-					this->payloadDescriptor->pictureId,
+					this->payloadDescriptor.pictureId,
 					context->pictureIdManager.GetMaxInput())
 			);
 			// clang-format on
@@ -244,7 +259,7 @@ namespace RTC
 			// Upgrade current spatial layer if needed.
 			if (context->GetTargetSpatialLayer() > context->GetCurrentSpatialLayer())
 			{
-				if (this->payloadDescriptor->isKeyFrame)
+				if (this->payloadDescriptor.isKeyFrame)
 				{
 					MS_DEBUG_DEV(
 					  "upgrading tmpSpatialLayer from %" PRIu16 " to %" PRIu16 " (packet:%" PRIu8 ":%" PRIu8
@@ -264,7 +279,7 @@ namespace RTC
 				// In K-SVC we must wait for a keyframe.
 				if (context->IsKSvc())
 				{
-					if (this->payloadDescriptor->isKeyFrame)
+					if (this->payloadDescriptor.isKeyFrame)
 					// clang-format on
 					{
 						MS_DEBUG_DEV(
@@ -285,7 +300,7 @@ namespace RTC
 					// clang-format off
 					if (
 						packetSpatialLayer == context->GetTargetSpatialLayer() &&
-						this->payloadDescriptor->e
+						this->payloadDescriptor.e
 					)
 					// clang-format on
 					{
@@ -312,7 +327,7 @@ namespace RTC
 			  !isOldPacket &&
 			  (
 			  	packetSpatialLayer > tmpSpatialLayer ||
-			  	(context->IsKSvc() && this->payloadDescriptor->p && packetSpatialLayer != tmpSpatialLayer)
+			  	(context->IsKSvc() && this->payloadDescriptor.p && packetSpatialLayer != tmpSpatialLayer)
 			  )
 			)
 			// clang-format on
@@ -331,9 +346,9 @@ namespace RTC
 						packetTemporalLayer >= context->GetCurrentTemporalLayer() + 1 &&
 						(
 							context->GetCurrentTemporalLayer() == -1 ||
-							this->payloadDescriptor->switchingUpPoint
+							this->payloadDescriptor.switchingUpPoint
 						) &&
-						this->payloadDescriptor->b
+						this->payloadDescriptor.b
 					)
 					// clang-format on
 					{
@@ -354,7 +369,7 @@ namespace RTC
 					// clang-format off
 					if (
 						packetTemporalLayer == context->GetTargetTemporalLayer() &&
-						this->payloadDescriptor->e
+						this->payloadDescriptor.e
 					)
 					// clang-format on
 					{
@@ -378,17 +393,17 @@ namespace RTC
 			}
 
 			// Set marker bit if needed.
-			if (packetSpatialLayer == tmpSpatialLayer && this->payloadDescriptor->e)
+			if (packetSpatialLayer == tmpSpatialLayer && this->payloadDescriptor.e)
 			{
 				marker = true;
 			}
 
 			// Update the pictureId manager.
-			if (this->payloadDescriptor->hasPictureId)
+			if (this->payloadDescriptor.hasPictureId)
 			{
 				uint16_t pictureId;
 
-				context->pictureIdManager.Input(this->payloadDescriptor->pictureId, pictureId);
+				context->pictureIdManager.Input(this->payloadDescriptor.pictureId, pictureId);
 			}
 
 			// Update current spatial layer if needed.
@@ -90,6 +90,11 @@ namespace RTC
 				this->rtpHeaderExtensionIds.playoutDelay = exten.id;
 			}
 
+			if (this->rtpHeaderExtensionIds.dependencyDescriptor == 0u && exten.type == RTC::RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR)
+			{
+				this->rtpHeaderExtensionIds.dependencyDescriptor = exten.id;
+			}
+
 			if (this->rtpHeaderExtensionIds.absSendTime == 0u && exten.type == RTC::RtpHeaderExtensionUri::Type::ABS_SEND_TIME)
 			{
 				this->rtpHeaderExtensionIds.absSendTime = exten.id;
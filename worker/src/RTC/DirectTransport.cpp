@@ -155,6 +155,8 @@ namespace RTC
 			return;
 		}
 
+		UpdateRtpPacketMid(consumer, packet);
+
 		const auto data = this->shared->channelNotifier->GetBufferBuilder().CreateVector(
 		  packet->GetData(), packet->GetSize());
 
@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "RTC/DtlsTransport.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Settings.hpp"
@@ -9,8 +10,18 @@
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <uv.h>
-#include <cstdio>  // std::snprintf(), std::fopen()
+#include <sys/stat.h> // stat()
+#ifndef _WIN32
+#include <fcntl.h>  // open()
+#include <unistd.h> // close()
+#endif
+#include <algorithm>  // std::find()
+#include <condition_variable>
+#include <cstdio>  // std::snprintf(), std::fopen(), std::rename(), std::remove()
 #include <cstring> // std::memcpy(), std::strcmp()
+#include <ctime>   // std::time()
+#include <mutex>
+#include <thread>
 
 // clang-format off
 #define LOG_OPENSSL_ERROR(desc) \
@@ -117,11 +128,287 @@ namespace RTC
 	static constexpr size_t SrtpAesGcm128MasterLength{ SrtpAesGcm128MasterKeyLength + SrtpAesGcm128MasterSaltLength };
 	// clang-format on
 
+	// Generated certificate, private key and SSL context shared by all the
+	// workers running as threads of the same process (those not given PEM
+	// files), so they are generated once.
+	static std::mutex sharedContextMutex;
+	static X509* sharedCertificate{ nullptr };
+	static EVP_PKEY* sharedPrivateKey{ nullptr };
+	static SSL_CTX* sharedSslCtx{ nullptr };
+	static size_t sharedContextUsers{ 0u };
+
+	/**
+	 * DTLS data received during the handshake, processed by SSL_read() in the
+	 * handshake offload thread.
+	 */
+	struct DtlsTransport::HandshakeJob
+	{
+		HandshakeJob(DtlsTransport* dtlsTransport, const uint8_t* data, size_t len)
+		  : dtlsTransport(dtlsTransport), data(data, data + len)
+		{
+		}
+
+		DtlsTransport* dtlsTransport{ nullptr };
+		std::vector<uint8_t> data;
+		// Result of SSL_read() and SSL_get_error() (the latter depends on the
+		// OpenSSL error queue of the thread that called SSL_read()).
+		int read{ 0 };
+		int err{ SSL_ERROR_NONE };
+		// DTLS data to be sent to the peer.
+		std::vector<std::vector<uint8_t>> sendData;
+		std::vector<uint8_t> applicationData;
+		std::vector<std::string> opensslErrors;
+		// OpenSSL info events (and the SSL state when they were fired) to be
+		// handled by the worker loop.
+		struct SslInfo
+		{
+			int where;
+			int ret;
+			const char* state;
+		};
+		std::vector<SslInfo> sslInfos;
+	};
+
+	/**
+	 * Thread that runs the expensive DTLS handshake operations (key exchange,
+	 * signature and certificate processing) so they don't block the worker
+	 * loop. Completed jobs are handed back to the loop via a uv_async_t.
+	 *
+	 * NOTE: The SSL of a DtlsTransport is never used by the loop while it has a
+	 * handshake job in progress.
+	 */
+	class DtlsTransport::HandshakeOffloader
+	{
+	public:
+		// Set while the offload thread runs SSL_read() on a handshake job so
+		// SendDtlsData() stores the outgoing data into it.
+		thread_local static HandshakeJob* currentJob;
+
+	public:
+		HandshakeOffloader()
+		{
+			MS_TRACE();
+
+			this->uvHandle       = new uv_async_t;
+			this->uvHandle->data = static_cast<void*>(this);
+
+			const int err = uv_async_init(
+			  DepLibUV::GetLoop(),
+			  this->uvHandle,
+			  [](uv_async_t* handle)
+			  { static_cast<HandshakeOffloader*>(handle->data)->OnJobsDone(); });
+
+			if (err != 0)
+			{
+				delete this->uvHandle;
+				this->uvHandle = nullptr;
+
+				MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+			}
+
+			// Only keep the loop alive while there are jobs in progress.
+			uv_unref(reinterpret_cast<uv_handle_t*>(this->uvHandle));
+
+			this->thread = std::thread([this]() { Run(); });
+		}
+		~HandshakeOffloader()
+		{
+			MS_TRACE();
+
+			{
+				const std::lock_guard<std::mutex> lock(this->mutex);
+
+				this->stopping = true;
+			}
+
+			this->pendingCond.notify_one();
+			this->thread.join();
+
+			uv_close(
+			  reinterpret_cast<uv_handle_t*>(this->uvHandle),
+			  [](uv_handle_t* handle) { delete reinterpret_cast<uv_async_t*>(handle); });
+		}
+
+	public:
+		void Submit(HandshakeJob* job)
+		{
+			MS_TRACE();
+
+			{
+				const std::lock_guard<std::mutex> lock(this->mutex);
+
+				this->pendingJobs.push_back(job);
+			}
+
+			this->pendingCond.notify_one();
+
+			if (++this->numJobs == 1u)
+			{
+				uv_ref(reinterpret_cast<uv_handle_t*>(this->uvHandle));
+			}
+		}
+		// Removes the given job, waiting for it if it's being processed.
+		void Cancel(HandshakeJob* job)
+		{
+			MS_TRACE();
+
+			std::unique_lock<std::mutex> lock(this->mutex);
+
+			auto it = std::find(this->pendingJobs.begin(), this->pendingJobs.end(), job);
+
+			if (it != this->pendingJobs.end())
+			{
+				this->pendingJobs.erase(it);
+			}
+			else
+			{
+				this->doneCond.wait(lock, [this, job]() { return this->runningJob != job; });
+
+				it = std::find(this->doneJobs.begin(), this->doneJobs.end(), job);
+
+				if (it != this->doneJobs.end())
+				{
+					this->doneJobs.erase(it);
+				}
+			}
+
+			lock.unlock();
+
+			OnJobRemoved();
+		}
+
+	private:
+		// Runs in the offload thread.
+		void Run()
+		{
+			while (true)
+			{
+				std::unique_lock<std::mutex> lock(this->mutex);
+
+				this->pendingCond.wait(
+				  lock, [this]() { return this->stopping || !this->pendingJobs.empty(); });
+
+				if (this->stopping)
+				{
+					return;
+				}
+
+				auto* job = this->pendingJobs.front();
+
+				this->pendingJobs.pop_front();
+				this->runningJob = job;
+
+				lock.unlock();
+
+				ProcessJob(job);
+
+				lock.lock();
+
+				this->runningJob = nullptr;
+				this->doneJobs.push_back(job);
+
+				lock.unlock();
+
+				this->doneCond.notify_all();
+
+				uv_async_send(this->uvHandle);
+			}
+		}
+		// Runs in the offload thread.
+		// NOTE: Logging is not available here.
+		static void ProcessJob(HandshakeJob* job)
+		{
+			auto* dtlsTransport = job->dtlsTransport;
+
+			HandshakeOffloader::currentJob = job;
+
+			BIO_write(
+			  dtlsTransport->sslBioFromNetwork,
+			  static_cast<const void*>(job->data.data()),
+			  static_cast<int>(job->data.size()));
+
+			job->read = SSL_read(
+			  dtlsTransport->ssl, static_cast<void*>(DtlsTransport::sslReadBuffer), SslReadBufferSize);
+			job->err = SSL_get_error(dtlsTransport->ssl, job->read);
+
+			if (job->read > 0)
+			{
+				job->applicationData.assign(
+				  DtlsTransport::sslReadBuffer, DtlsTransport::sslReadBuffer + job->read);
+			}
+
+			unsigned long err; // NOLINT(google-runtime-int)
+
+			while ((err = ERR_get_error()) != 0)
+			{
+				job->opensslErrors.emplace_back(ERR_error_string(err, nullptr));
+			}
+
+			HandshakeOffloader::currentJob = nullptr;
+		}
+		void OnJobsDone()
+		{
+			MS_TRACE();
+
+			// NOTE: Take jobs one by one since handling a job may cancel others.
+			while (true)
+			{
+				HandshakeJob* job;
+
+				{
+					const std::lock_guard<std::mutex> lock(this->mutex);
+
+					if (this->doneJobs.empty())
+					{
+						return;
+					}
+
+					job = this->doneJobs.front();
+					this->doneJobs.pop_front();
+				}
+
+				OnJobRemoved();
+
+				job->dtlsTransport->OnHandshakeJobDone();
+			}
+		}
+		void OnJobRemoved()
+		{
+			if (--this->numJobs == 0u)
+			{
+				uv_unref(reinterpret_cast<uv_handle_t*>(this->uvHandle));
+			}
+		}
+
+	private:
+		// Allocated by this.
+		uv_async_t* uvHandle{ nullptr };
+		// Others.
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable pendingCond;
+		std::condition_variable doneCond;
+		std::deque<HandshakeJob*> pendingJobs;
+		std::deque<HandshakeJob*> doneJobs;
+		HandshakeJob* runningJob{ nullptr };
+		bool stopping{ false };
+		// Jobs submitted and not yet handled (only used by the loop thread).
+		size_t numJobs{ 0u };
+	};
+
+	thread_local DtlsTransport::HandshakeJob* DtlsTransport::HandshakeOffloader::currentJob{
+		nullptr
+	};
+
 	/* Class variables. */
 
 	thread_local X509* DtlsTransport::certificate{ nullptr };
 	thread_local EVP_PKEY* DtlsTransport::privateKey{ nullptr };
 	thread_local SSL_CTX* DtlsTransport::sslCtx{ nullptr };
+	thread_local bool DtlsTransport::usingSharedContext{ false };
+	thread_local bool DtlsTransport::certificateGenerated{ false };
+	thread_local uint64_t DtlsTransport::setupDurationUs{ 0u };
+	thread_local DtlsTransport::HandshakeOffloader* DtlsTransport::handshakeOffloader{ nullptr };
 	thread_local uint8_t DtlsTransport::sslReadBuffer[SslReadBufferSize];
 	// clang-format off
 	absl::flat_hash_map<std::string, DtlsTransport::FingerprintAlgorithm> DtlsTransport::string2FingerprintAlgorithm =
@@ -162,43 +449,120 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		const uint64_t startedAtUs = DepLibUV::GetTimeUs();
+
+		DtlsTransport::certificateGenerated = false;
+
 		// Generate a X509 certificate and private key (unless PEM files are provided).
 		if (
 		  Settings::configuration.dtlsCertificateFile.empty() ||
 		  Settings::configuration.dtlsPrivateKeyFile.empty())
 		{
-			GenerateCertificateAndPrivateKey();
+			const std::lock_guard<std::mutex> lock(sharedContextMutex);
+
+			// Reuse the ones of other workers in this process, if any.
+			if (sharedContextUsers != 0u)
+			{
+				MS_DEBUG_TAG(dtls, "reusing DTLS certificate and SSL context of another worker");
+
+				X509_up_ref(sharedCertificate);
+				EVP_PKEY_up_ref(sharedPrivateKey);
+				SSL_CTX_up_ref(sharedSslCtx);
+
+				DtlsTransport::certificate = sharedCertificate;
+				DtlsTransport::privateKey  = sharedPrivateKey;
+				DtlsTransport::sslCtx      = sharedSslCtx;
+			}
+			else
+			{
+				// Use the cached ones if not too old.
+				if (
+				  Settings::configuration.dtlsCertificateCacheFile.empty() ||
+				  !ReadCertificateAndPrivateKeyFromCache())
+				{
+					GenerateCertificateAndPrivateKey();
+
+					DtlsTransport::certificateGenerated = true;
+
+					if (!Settings::configuration.dtlsCertificateCacheFile.empty())
+					{
+						WriteCertificateAndPrivateKeyToCache();
+					}
+				}
+
+				// Create a global SSL_CTX.
+				CreateSslCtx();
+
+				sharedCertificate = DtlsTransport::certificate;
+				sharedPrivateKey  = DtlsTransport::privateKey;
+				sharedSslCtx      = DtlsTransport::sslCtx;
+			}
+
+			++sharedContextUsers;
+			DtlsTransport::usingSharedContext = true;
 		}
 		else
 		{
 			ReadCertificateAndPrivateKeyFromFiles();
-		}
 
-		// Create a global SSL_CTX.
-		CreateSslCtx();
+			// Create a global SSL_CTX.
+			CreateSslCtx();
+		}
 
 		// Generate certificate fingerprints.
 		GenerateFingerprints();
+
+		DtlsTransport::setupDurationUs = DepLibUV::GetTimeUs() - startedAtUs;
+
+		if (Settings::configuration.dtlsHandshakeOffload)
+		{
+			MS_DEBUG_TAG(dtls, "running DTLS handshakes in a separate thread");
+
+			DtlsTransport::handshakeOffloader = new HandshakeOffloader();
+		}
 	}
 
 	void DtlsTransport::ClassDestroy()
 	{
 		MS_TRACE();
 
+		delete DtlsTransport::handshakeOffloader;
+		DtlsTransport::handshakeOffloader = nullptr;
+
+		if (DtlsTransport::usingSharedContext)
+		{
+			const std::lock_guard<std::mutex> lock(sharedContextMutex);
+
+			// Each worker owns a reference, so they are freed by the last one.
+			if (--sharedContextUsers == 0u)
+			{
+				sharedCertificate = nullptr;
+				sharedPrivateKey  = nullptr;
+				sharedSslCtx      = nullptr;
+			}
+
+			DtlsTransport::usingSharedContext = false;
+		}
+
 		if (DtlsTransport::privateKey)
 		{
 			EVP_PKEY_free(DtlsTransport::privateKey);
+			DtlsTransport::privateKey = nullptr;
 		}
 
 		if (DtlsTransport::certificate)
 		{
 			X509_free(DtlsTransport::certificate);
+			DtlsTransport::certificate = nullptr;
 		}
 
 		if (DtlsTransport::sslCtx)
 		{
 			SSL_CTX_free(DtlsTransport::sslCtx);
+			DtlsTransport::sslCtx = nullptr;
 		}
+
+		DtlsTransport::localFingerprints.clear();
 	}
 
 	DtlsTransport::Role DtlsTransport::RoleFromFbs(FBS::WebRtcTransport::DtlsRole role)
@@ -431,11 +795,13 @@ namespace RTC
 		if (DtlsTransport::privateKey)
 		{
 			EVP_PKEY_free(DtlsTransport::privateKey);
+			DtlsTransport::privateKey = nullptr;
 		}
 
 		if (DtlsTransport::certificate)
 		{
 			X509_free(DtlsTransport::certificate);
+			DtlsTransport::certificate = nullptr;
 		}
 
 		MS_THROW_ERROR("DTLS certificate and private key generation failed");
@@ -494,6 +860,151 @@ namespace RTC
 		MS_THROW_ERROR("error reading DTLS certificate and private key PEM files");
 	}
 
+	/**
+	 * Reads the certificate and private key stored in the cache file by
+	 * WriteCertificateAndPrivateKeyToCache(), unless the file is older than
+	 * the configured max age.
+	 */
+	bool DtlsTransport::ReadCertificateAndPrivateKeyFromCache()
+	{
+		MS_TRACE();
+
+		const std::string& cacheFile = Settings::configuration.dtlsCertificateCacheFile;
+		struct stat fileStat
+		{
+		}; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		FILE* file{ nullptr };
+
+		if (stat(cacheFile.c_str(), &fileStat) != 0)
+		{
+			MS_DEBUG_TAG(dtls, "no DTLS certificate cache file");
+
+			return false;
+		}
+
+		const int64_t age = static_cast<int64_t>(std::time(nullptr) - fileStat.st_mtime);
+
+		if (age >= static_cast<int64_t>(Settings::configuration.dtlsCertificateCacheMaxAge))
+		{
+			MS_DEBUG_TAG(dtls, "cached DTLS certificate expired [age:%" PRIi64 "s]", age);
+
+			return false;
+		}
+
+		file = fopen(cacheFile.c_str(), "r");
+
+		if (!file)
+		{
+			MS_WARN_TAG(dtls, "error reading DTLS certificate cache file: %s", std::strerror(errno));
+
+			return false;
+		}
+
+		DtlsTransport::certificate = PEM_read_X509(file, nullptr, nullptr, nullptr);
+
+		if (DtlsTransport::certificate)
+		{
+			DtlsTransport::privateKey = PEM_read_PrivateKey(file, nullptr, nullptr, nullptr);
+		}
+
+		fclose(file);
+
+		if (
+		  !DtlsTransport::privateKey ||
+		  X509_check_private_key(DtlsTransport::certificate, DtlsTransport::privateKey) != 1 ||
+		  X509_cmp_current_time(X509_get0_notAfter(DtlsTransport::certificate)) <= 0)
+		{
+			MS_WARN_TAG(dtls, "invalid DTLS certificate cache file, ignoring it");
+
+			ERR_clear_error();
+
+			if (DtlsTransport::privateKey)
+			{
+				EVP_PKEY_free(DtlsTransport::privateKey);
+				DtlsTransport::privateKey = nullptr;
+			}
+
+			if (DtlsTransport::certificate)
+			{
+				X509_free(DtlsTransport::certificate);
+				DtlsTransport::certificate = nullptr;
+			}
+
+			return false;
+		}
+
+		MS_DEBUG_TAG(dtls, "using cached DTLS certificate [age:%" PRIi64 "s]", age);
+
+		return true;
+	}
+
+	/**
+	 * Stores the generated certificate and private key in the cache file. The
+	 * file is written apart and then renamed so other workers starting at the
+	 * same time never read a partial file.
+	 */
+	void DtlsTransport::WriteCertificateAndPrivateKeyToCache()
+	{
+		MS_TRACE();
+
+		const std::string& cacheFile = Settings::configuration.dtlsCertificateCacheFile;
+		const std::string tmpFile    = cacheFile + "." + std::to_string(Logger::Pid) + ".tmp";
+		FILE* file{ nullptr };
+		bool written{ false };
+
+#ifdef _WIN32
+		file = fopen(tmpFile.c_str(), "w");
+#else
+		// Remove a stale file left by a previous process with same pid.
+		std::remove(tmpFile.c_str());
+
+		// It contains the private key, so create it readable just by the owner
+		// (and never open an existing file).
+		const int fd =
+		  open(tmpFile.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+
+		if (fd != -1)
+		{
+			file = fdopen(fd, "w");
+
+			if (!file)
+			{
+				close(fd);
+				std::remove(tmpFile.c_str());
+			}
+		}
+#endif
+
+		if (!file)
+		{
+			MS_WARN_TAG(dtls, "error writing DTLS certificate cache file: %s", std::strerror(errno));
+
+			return;
+		}
+
+		written =
+		  PEM_write_X509(file, DtlsTransport::certificate) == 1 &&
+		  PEM_write_PrivateKey(
+		    file, DtlsTransport::privateKey, nullptr, nullptr, 0, nullptr, nullptr) == 1;
+
+		if (fclose(file) != 0)
+		{
+			written = false;
+		}
+
+		if (!written || std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0)
+		{
+			MS_WARN_TAG(dtls, "error writing DTLS certificate cache file");
+
+			ERR_clear_error();
+			std::remove(tmpFile.c_str());
+
+			return;
+		}
+
+		MS_DEBUG_TAG(dtls, "generated DTLS certificate stored in cache file");
+	}
+
 	void DtlsTransport::CreateSslCtx()
 	{
 		MS_TRACE();
@@ -786,6 +1297,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		CancelHandshakeJob();
+
 		if (IsRunning())
 		{
 			// Send close alert to the peer.
@@ -966,6 +1479,23 @@ namespace RTC
 			return;
 		}
 
+		// The SSL is in use by the handshake offload thread, so queue the data.
+		if (this->handshakeJob)
+		{
+			this->pendingHandshakeData.emplace_back(data, data + len);
+
+			return;
+		}
+
+		if (DtlsTransport::handshakeOffloader && !this->handshakeDone)
+		{
+			this->handshakeJob = new HandshakeJob(this, data, len);
+
+			DtlsTransport::handshakeOffloader->Submit(this->handshakeJob);
+
+			return;
+		}
+
 		// Write the received DTLS data into the sslBioFromNetwork.
 		written =
 		  BIO_write(this->sslBioFromNetwork, static_cast<const void*>(data), static_cast<int>(len));
@@ -1063,6 +1593,16 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Called by the handshake offload thread, so keep the data in the job.
+		if (HandshakeOffloader::currentJob)
+		{
+			HandshakeOffloader::currentJob->sendData.emplace_back(data, data + len);
+
+			BIO_reset(this->sslBioToNetwork);
+
+			return;
+		}
+
 		MS_DEBUG_DEV("%zu bytes of DTLS data ready to be sent", len);
 
 		// Notify the listener.
@@ -1090,6 +1630,8 @@ namespace RTC
 
 		MS_WARN_TAG(dtls, "resetting DTLS transport");
 
+		CancelHandshakeJob();
+
 		// Stop the DTLS timer.
 		this->timer->Stop();
 
@@ -1116,13 +1658,109 @@ namespace RTC
 		}
 	}
 
+	void DtlsTransport::CancelHandshakeJob()
+	{
+		MS_TRACE();
+
+		if (this->handshakeJob)
+		{
+			DtlsTransport::handshakeOffloader->Cancel(this->handshakeJob);
+
+			delete this->handshakeJob;
+			this->handshakeJob = nullptr;
+		}
+
+		this->pendingHandshakeData.clear();
+	}
+
+	/**
+	 * Called once the handshake offload thread has processed the DTLS data in
+	 * |this->handshakeJob|. Does what ProcessDtlsData() does after SSL_read().
+	 */
+	void DtlsTransport::OnHandshakeJobDone()
+	{
+		MS_TRACE();
+
+		MS_ASSERT(this->handshakeJob, "no handshake job");
+
+		auto* job          = this->handshakeJob;
+		this->handshakeJob = nullptr;
+
+		for (const auto& sslInfo : job->sslInfos)
+		{
+			HandleSslInfo(sslInfo.where, sslInfo.ret, sslInfo.state);
+		}
+
+		for (const auto& opensslError : job->opensslErrors)
+		{
+			MS_ERROR("OpenSSL error [desc:'SSL_read()', error:'%s']", opensslError.c_str());
+		}
+
+		for (const auto& sendData : job->sendData)
+		{
+			MS_DEBUG_DEV("%zu bytes of DTLS data ready to be sent", sendData.size());
+
+			// Notify the listener.
+			this->listener->OnDtlsTransportSendData(this, sendData.data(), sendData.size());
+		}
+
+		const int err = job->err;
+		const std::vector<uint8_t> applicationData(std::move(job->applicationData));
+
+		delete job;
+
+		// Check SSL status and return if it is bad/closed.
+		if (!CheckSslError(err))
+		{
+			return;
+		}
+
+		// Set/update the DTLS timeout.
+		// NOTE: This also handles a DTLS timeout that fired while the job was in
+		// progress.
+		if (!SetTimeout())
+		{
+			return;
+		}
+
+		if (!applicationData.empty())
+		{
+			if (!this->handshakeDone)
+			{
+				MS_WARN_TAG(dtls, "ignoring application data received while DTLS handshake not done");
+			}
+			else
+			{
+				// Notify the listener.
+				this->listener->OnDtlsTransportApplicationDataReceived(
+				  this, applicationData.data(), applicationData.size());
+			}
+		}
+
+		// Process DTLS data received in the meanwhile (ProcessDtlsData() may
+		// submit a new job, in which case the rest remains queued).
+		while (!this->handshakeJob && !this->pendingHandshakeData.empty() && IsRunning())
+		{
+			const std::vector<uint8_t> data(std::move(this->pendingHandshakeData.front()));
+
+			this->pendingHandshakeData.pop_front();
+
+			ProcessDtlsData(data.data(), data.size());
+		}
+	}
+
 	bool DtlsTransport::CheckStatus(int returnCode)
 	{
 		MS_TRACE();
 
-		const bool wasHandshakeDone = this->handshakeDone;
+		return CheckSslError(SSL_get_error(this->ssl, returnCode));
+	}
+
+	bool DtlsTransport::CheckSslError(int err)
+	{
+		MS_TRACE();
 
-		int err = SSL_get_error(this->ssl, returnCode);
+		const bool wasHandshakeDone = this->handshakeDone;
 
 		switch (err)
 		{
@@ -1596,7 +2234,7 @@ namespace RTC
 		return negotiatedSrtpCryptoSuite;
 	}
 
-	void DtlsTransport::OnSslInfo(int where, int ret)
+	void DtlsTransport::HandleSslInfo(int where, int ret, const char* state)
 	{
 		MS_TRACE();
 
@@ -1618,7 +2256,7 @@ namespace RTC
 
 		if ((where & SSL_CB_LOOP) != 0)
 		{
-			MS_DEBUG_TAG(dtls, "[role:%s, action:'%s']", role, SSL_state_string_long(this->ssl));
+			MS_DEBUG_TAG(dtls, "[role:%s, action:'%s']", role, state);
 		}
 		else if ((where & SSL_CB_ALERT) != 0)
 		{
@@ -1661,11 +2299,11 @@ namespace RTC
 		{
 			if (ret == 0)
 			{
-				MS_DEBUG_TAG(dtls, "[role:%s, failed:'%s']", role, SSL_state_string_long(this->ssl));
+				MS_DEBUG_TAG(dtls, "[role:%s, failed:'%s']", role, state);
 			}
 			else if (ret < 0)
 			{
-				MS_DEBUG_TAG(dtls, "role: %s, waiting:'%s']", role, SSL_state_string_long(this->ssl));
+				MS_DEBUG_TAG(dtls, "role: %s, waiting:'%s']", role, state);
 			}
 		}
 		else if ((where & SSL_CB_HANDSHAKE_START) != 0)
@@ -1684,6 +2322,24 @@ namespace RTC
 		// callback).
 	}
 
+	void DtlsTransport::OnSslInfo(int where, int ret)
+	{
+		MS_TRACE();
+
+		// Called by the handshake offload thread, where logging is not available,
+		// so keep the event in the job.
+		// NOTE: SSL_state_string_long() returns static strings.
+		if (HandshakeOffloader::currentJob)
+		{
+			HandshakeOffloader::currentJob->sslInfos.push_back(
+			  { where, ret, SSL_state_string_long(this->ssl) });
+
+			return;
+		}
+
+		HandleSslInfo(where, ret, SSL_state_string_long(this->ssl));
+	}
+
 	void DtlsTransport::OnTimer(TimerHandle* /*timer*/)
 	{
 		MS_TRACE();
@@ -1696,6 +2352,14 @@ namespace RTC
 			return;
 		}
 
+		// The timeout will be checked once the handshake job is done.
+		if (this->handshakeJob)
+		{
+			MS_DEBUG_DEV("handshake job in progress so return");
+
+			return;
+		}
+
 		// DTLSv1_handle_timeout is called when a DTLS handshake timeout expires.
 		// If no timeout had expired, it returns 0. Otherwise, it retransmits the
 		// previous flight of handshake messages and returns 1. If too many timeouts
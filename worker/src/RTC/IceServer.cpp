@@ -104,6 +104,9 @@ namespace RTC
 
 		this->consentTimeoutMs = consentTimeoutSec * 1000;
 
+		// Key the HMAC SHA1 context used to authenticate STUN messages once.
+		this->hmacSha1Ctx = Utils::Crypto::CreateHmacSha1Ctx(this->password);
+
 		// Notify the listener.
 		this->listener->OnIceServerLocalUsernameFragmentAdded(this, usernameFragment);
 	}
@@ -146,6 +149,9 @@ namespace RTC
 		// Delete the ICE consent check timer.
 		delete this->consentCheckTimer;
 		this->consentCheckTimer = nullptr;
+
+		Utils::Crypto::FreeHmacSha1Ctx(this->hmacSha1Ctx);
+		Utils::Crypto::FreeHmacSha1Ctx(this->oldHmacSha1Ctx);
 	}
 
 	void IceServer::ProcessStunPacket(RTC::StunPacket* packet, RTC::TransportTuple* tuple)
@@ -199,6 +205,11 @@ namespace RTC
 		this->oldPassword = this->password;
 		this->password    = password;
 
+		Utils::Crypto::FreeHmacSha1Ctx(this->oldHmacSha1Ctx);
+
+		this->oldHmacSha1Ctx = this->hmacSha1Ctx;
+		this->hmacSha1Ctx    = Utils::Crypto::CreateHmacSha1Ctx(this->password);
+
 		this->remoteNomination = 0u;
 
 		// Notify the listener.
@@ -366,7 +377,7 @@ namespace RTC
 		}
 
 		// Check authentication.
-		switch (request->CheckAuthentication(this->usernameFragment, this->password))
+		switch (request->CheckAuthentication(this->usernameFragment, this->hmacSha1Ctx))
 		{
 			case RTC::StunPacket::Authentication::OK:
 			{
@@ -379,6 +390,9 @@ namespace RTC
 
 					this->oldUsernameFragment.clear();
 					this->oldPassword.clear();
+
+					Utils::Crypto::FreeHmacSha1Ctx(this->oldHmacSha1Ctx);
+					this->oldHmacSha1Ctx = nullptr;
 				}
 
 				break;
@@ -393,7 +407,7 @@ namespace RTC
 				  !this->oldUsernameFragment.empty() &&
 				  !this->oldPassword.empty() &&
 				  request->CheckAuthentication(
-				    this->oldUsernameFragment, this->oldPassword
+				    this->oldUsernameFragment, this->oldHmacSha1Ctx
 				  ) == RTC::StunPacket::Authentication::OK
 				)
 				// clang-format on
@@ -462,11 +476,11 @@ namespace RTC
 		// Authenticate the response.
 		if (this->oldPassword.empty())
 		{
-			response->SetPassword(this->password);
+			response->SetHmacSha1Ctx(this->hmacSha1Ctx);
 		}
 		else
 		{
-			response->SetPassword(this->oldPassword);
+			response->SetHmacSha1Ctx(this->oldHmacSha1Ctx);
 		}
 
 		// Send back.
@@ -4,9 +4,10 @@
 #include "RTC/NackGenerator.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
-#include <iterator> // std::ostream_iterator
-#include <sstream>  // std::ostringstream
-#include <utility>  // std::make_pair()
+#include "Utils.hpp"
+#include <algorithm> // std::lower_bound(), std::min()
+#include <iterator>  // std::ostream_iterator
+#include <sstream>   // std::ostringstream
 
 namespace RTC
 {
@@ -17,6 +18,41 @@ namespace RTC
 	static constexpr uint32_t DefaultRtt{ 100u };
 	static constexpr uint8_t MaxNackRetries{ 10u };
 	static constexpr uint64_t TimerInterval{ 40u };
+	static constexpr size_t NackInitialCapacity{ 128u };
+	// Lowest power of two holding MaxPacketAge seqs.
+	static constexpr size_t NackMaxCapacity{ 16384u };
+
+	static_assert(NackMaxCapacity >= MaxPacketAge, "NACK ring cannot hold MaxPacketAge seqs");
+
+	/* Static methods. */
+
+	// Inserts given seq into a sorted list of seqs (if not already there).
+	static void InsertSeq(std::deque<uint16_t>& seqs, uint16_t seq)
+	{
+		// Fast path, seq is the newest one.
+		if (seqs.empty() || SeqManager<uint16_t>::IsSeqHigherThan(seq, seqs.back()))
+		{
+			seqs.push_back(seq);
+
+			return;
+		}
+
+		auto it = std::lower_bound(seqs.begin(), seqs.end(), seq, SeqManager<uint16_t>::SeqLowerThan{});
+
+		if (it == seqs.end() || *it != seq)
+		{
+			seqs.insert(it, seq);
+		}
+	}
+
+	// Removes seqs lower than the given one from a sorted list of seqs.
+	static void RemoveSeqsLowerThan(std::deque<uint16_t>& seqs, uint16_t seq)
+	{
+		while (!seqs.empty() && SeqManager<uint16_t>::IsSeqLowerThan(seqs.front(), seq))
+		{
+			seqs.pop_front();
+		}
+	}
 
 	/* Instance methods. */
 
@@ -50,7 +86,7 @@ namespace RTC
 
 			if (isKeyFrame)
 			{
-				this->keyFrameList.insert(seq);
+				InsertSeq(this->keyFrameList, seq);
 			}
 
 			return false;
@@ -66,10 +102,8 @@ namespace RTC
 		// or a retransmitted packet.
 		if (SeqManager<uint16_t>::IsSeqLowerThan(seq, this->lastSeq))
 		{
-			auto it = this->nackList.find(seq);
-
 			// It was a nacked packet.
-			if (it != this->nackList.end())
+			if (HasNackItem(seq))
 			{
 				MS_DEBUG_DEV(
 				  "NACKed packet received [ssrc:%" PRIu32 ", seq:%" PRIu16 ", recovered:%s]",
@@ -77,9 +111,9 @@ namespace RTC
 				  packet->GetSequenceNumber(),
 				  isRecovered ? "true" : "false");
 
-				auto retries = it->second.retries;
+				auto retries = GetNackItem(seq).retries;
 
-				this->nackList.erase(it);
+				RemoveNackItem(seq);
 
 				return retries != 0;
 			}
@@ -101,30 +135,18 @@ namespace RTC
 
 		if (isKeyFrame)
 		{
-			this->keyFrameList.insert(seq);
+			InsertSeq(this->keyFrameList, seq);
 		}
 
 		// Remove old keyframes.
-		{
-			auto it = this->keyFrameList.lower_bound(seq - MaxPacketAge);
-
-			if (it != this->keyFrameList.begin())
-			{
-				this->keyFrameList.erase(this->keyFrameList.begin(), it);
-			}
-		}
+		RemoveSeqsLowerThan(this->keyFrameList, seq - MaxPacketAge);
 
 		if (isRecovered)
 		{
-			this->recoveredList.insert(seq);
+			InsertSeq(this->recoveredList, seq);
 
 			// Remove old ones so we don't accumulate recovered packets.
-			auto it = this->recoveredList.lower_bound(seq - MaxPacketAge);
-
-			if (it != this->recoveredList.begin())
-			{
-				this->recoveredList.erase(this->recoveredList.begin(), it);
-			}
+			RemoveSeqsLowerThan(this->recoveredList, seq - MaxPacketAge);
 
 			// Do not let a packet pass if it's newer than last seen seq and came via
 			// RTX.
@@ -158,78 +180,230 @@ namespace RTC
 		MS_TRACE();
 
 		// Remove old packets.
-		auto it = this->nackList.lower_bound(seqEnd - MaxPacketAge);
-
-		this->nackList.erase(this->nackList.begin(), it);
+		RemoveNackItemsLowerThan(seqEnd - MaxPacketAge);
 
 		// If the nack list is too large, remove packets from the nack list until
 		// the latest first packet of a keyframe. If the list is still too large,
 		// clear it and request a keyframe.
 		const uint16_t numNewNacks = seqEnd - seqStart;
 
-		if (static_cast<uint16_t>(this->nackList.size()) + numNewNacks > MaxNackPackets)
+		if (static_cast<uint16_t>(this->nackListLength) + numNewNacks > MaxNackPackets)
 		{
 			// clang-format off
 			while (
 				RemoveNackItemsUntilKeyFrame() &&
-				static_cast<uint16_t>(this->nackList.size()) + numNewNacks > MaxNackPackets
+				static_cast<uint16_t>(this->nackListLength) + numNewNacks > MaxNackPackets
 			)
 			// clang-format on
 			{
 			}
 
-			if (static_cast<uint16_t>(this->nackList.size()) + numNewNacks > MaxNackPackets)
+			if (static_cast<uint16_t>(this->nackListLength) + numNewNacks > MaxNackPackets)
 			{
 				MS_WARN_TAG(
 				  rtx, "NACK list full, clearing it and requesting a key frame [seqEnd:%" PRIu16 "]", seqEnd);
 
-				this->nackList.clear();
+				ClearNackList();
 				this->listener->OnNackGeneratorKeyFrameRequired();
 
 				return;
 			}
 		}
 
-		for (uint16_t seq = seqStart; seq != seqEnd; ++seq)
+		if (numNewNacks == 0u)
+		{
+			return;
+		}
+
+		if (this->nackListLength == 0u)
 		{
-			MS_ASSERT(this->nackList.find(seq) == this->nackList.end(), "packet already in the NACK list");
+			this->nackStartSeq = seqStart;
+		}
+
+		// New items are newer than any existing one so the ring must just cover
+		// from the oldest item up to the newest new one.
+		EnsureNackCapacity(static_cast<uint16_t>(seqEnd - this->nackStartSeq));
+
+		const uint64_t nowMs = DepLibUV::GetTimeMs();
+
+		// Do not send NACK for packets that are already recovered by RTX.
+		auto recoveredIt = std::lower_bound(
+		  this->recoveredList.begin(),
+		  this->recoveredList.end(),
+		  seqStart,
+		  SeqManager<uint16_t>::SeqLowerThan{});
 
-			// Do not send NACK for packets that are already recovered by RTX.
-			if (this->recoveredList.find(seq) != this->recoveredList.end())
+		for (uint16_t seq = seqStart; seq != seqEnd;)
+		{
+			// Next recovered seq (if any) within the range.
+			const uint16_t nextRecoveredSeq =
+			  recoveredIt != this->recoveredList.end() &&
+			      SeqManager<uint16_t>::IsSeqLowerThan(*recoveredIt, seqEnd)
+			    ? *recoveredIt
+			    : seqEnd;
+
+			// Add the whole range of seqs up to it, setting the bitmap a word at a
+			// time.
+			while (seq != nextRecoveredSeq)
 			{
-				continue;
+				const size_t idx     = seq & this->nackMask;
+				const size_t numBits =
+				  std::min<size_t>(static_cast<uint16_t>(nextRecoveredSeq - seq), 64u - (idx & 63u));
+				const uint64_t bits =
+				  (numBits == 64u ? ~uint64_t{ 0u } : ((uint64_t{ 1u } << numBits) - 1u)) << (idx & 63u);
+
+				MS_ASSERT((this->nackBitmap[idx >> 6] & bits) == 0u, "packet already in the NACK list");
+
+				this->nackBitmap[idx >> 6] |= bits;
+
+				for (size_t i{ 0u }; i < numBits; ++i)
+				{
+					this->nackSlots[idx + i] = NackInfo{ nowMs, 0u, 0u };
+				}
+
+				this->nackListLength += numBits;
+				seq += static_cast<uint16_t>(numBits);
 			}
 
-			this->nackList.emplace(std::make_pair(
-			  seq,
-			  NackInfo{
-			    DepLibUV::GetTimeMs(),
-			    seq,
-			    seq,
-			  }));
+			if (seq != seqEnd)
+			{
+				++seq;
+				++recoveredIt;
+			}
+		}
+
+		// All the new seqs could have been recovered.
+		if (this->nackListLength != 0u && !HasNackItem(this->nackStartSeq))
+		{
+			this->nackStartSeq += FindNextNackItem(this->nackStartSeq);
 		}
 	}
 
-	bool NackGenerator::RemoveNackItemsUntilKeyFrame()
+	// Returns the distance from the given seq to the seq of the next item in the
+	// NACK list (which must not be empty).
+	size_t NackGenerator::FindNextNackItem(uint16_t seq) const
 	{
 		MS_TRACE();
 
-		while (!this->keyFrameList.empty())
+		MS_ASSERT(this->nackListLength != 0u, "NACK list is empty");
+
+		size_t idx = seq & this->nackMask;
+		size_t distance{ 0u };
+
+		while (true)
 		{
-			auto it = this->nackList.lower_bound(*this->keyFrameList.begin());
+			const uint64_t word = this->nackBitmap[idx >> 6] >> (idx & 63u);
 
-			if (it != this->nackList.begin())
+			if (word != 0u)
 			{
-				// We have found a keyframe that actually is newer than at least one
-				// packet in the nack list.
-				this->nackList.erase(this->nackList.begin(), it);
+				return distance + Utils::Bits::CountTrailingZeros(word);
+			}
 
+			distance += 64u - (idx & 63u);
+			idx = (idx + 64u - (idx & 63u)) & this->nackMask;
+		}
+	}
+
+	void NackGenerator::RemoveNackItem(uint16_t seq)
+	{
+		MS_TRACE();
+
+		const size_t idx = seq & this->nackMask;
+
+		this->nackBitmap[idx >> 6] &= ~(uint64_t{ 1u } << (idx & 63u));
+		--this->nackListLength;
+
+		// Keep nackStartSeq pointing to the oldest item.
+		if (seq == this->nackStartSeq && this->nackListLength != 0u)
+		{
+			this->nackStartSeq += FindNextNackItem(this->nackStartSeq);
+		}
+	}
+
+	// Returns true if some item was removed.
+	bool NackGenerator::RemoveNackItemsLowerThan(uint16_t seq)
+	{
+		MS_TRACE();
+
+		bool removed{ false };
+
+		while (this->nackListLength != 0u && SeqManager<uint16_t>::IsSeqLowerThan(this->nackStartSeq, seq))
+		{
+			RemoveNackItem(this->nackStartSeq);
+
+			removed = true;
+		}
+
+		return removed;
+	}
+
+	void NackGenerator::ClearNackList()
+	{
+		MS_TRACE();
+
+		std::fill(this->nackBitmap.begin(), this->nackBitmap.end(), 0u);
+
+		this->nackListLength = 0u;
+	}
+
+	void NackGenerator::EnsureNackCapacity(size_t numSlots)
+	{
+		MS_TRACE();
+
+		if (numSlots <= this->nackSlots.size())
+		{
+			return;
+		}
+
+		MS_ASSERT(numSlots <= NackMaxCapacity, "NACK ring cannot hold %zu slots", numSlots);
+
+		size_t capacity = this->nackSlots.empty() ? NackInitialCapacity : this->nackSlots.size();
+
+		while (capacity < numSlots)
+		{
+			capacity <<= 1;
+		}
+
+		std::vector<NackInfo> slots(capacity);
+		std::vector<uint64_t> bitmap(capacity / 64u, 0u);
+		const size_t mask = capacity - 1;
+
+		// Move current items to their position in the new ring.
+		uint16_t seq = this->nackStartSeq;
+
+		for (size_t i{ 0u }; i < this->nackListLength; ++i)
+		{
+			seq += FindNextNackItem(seq);
+
+			const size_t idx = seq & mask;
+
+			slots[idx] = GetNackItem(seq);
+			bitmap[idx >> 6] |= uint64_t{ 1u } << (idx & 63u);
+
+			++seq;
+		}
+
+		this->nackSlots  = std::move(slots);
+		this->nackBitmap = std::move(bitmap);
+		this->nackMask   = mask;
+	}
+
+	bool NackGenerator::RemoveNackItemsUntilKeyFrame()
+	{
+		MS_TRACE();
+
+		while (!this->keyFrameList.empty())
+		{
+			// We have found a keyframe that actually is newer than at least one
+			// packet in the nack list.
+			if (RemoveNackItemsLowerThan(this->keyFrameList.front()))
+			{
 				return true;
 			}
 
 			// If this keyframe is so old it does not remove any packets from the list,
 			// remove it from the list of keyframes and try the next keyframe.
-			this->keyFrameList.erase(this->keyFrameList.begin());
+			this->keyFrameList.pop_front();
 		}
 
 		return false;
@@ -242,16 +416,19 @@ namespace RTC
 		const uint64_t nowMs = DepLibUV::GetTimeMs();
 		std::vector<uint16_t> nackBatch;
 
-		auto it = this->nackList.begin();
+		// Walk the NACK list from oldest to newest item, skipping empty slots a
+		// bitmap word at a time.
+		const size_t numItems = this->nackListLength;
+		uint16_t seq          = this->nackStartSeq;
 
-		while (it != this->nackList.end())
+		for (size_t i{ 0u }; i < numItems; ++i, ++seq)
 		{
-			NackInfo& nackInfo = it->second;
-			const uint16_t seq = nackInfo.seq;
+			seq += FindNextNackItem(seq);
+
+			NackInfo& nackInfo = GetNackItem(seq);
 
 			if (this->sendNackDelayMs > 0 && nowMs - nackInfo.createdAtMs < this->sendNackDelayMs)
 			{
-				++it;
 				continue;
 			}
 
@@ -260,8 +437,8 @@ namespace RTC
 				filter == NackFilter::SEQ &&
 				nackInfo.sentAtMs == 0 &&
 				(
-					nackInfo.sendAtSeq == this->lastSeq ||
-					SeqManager<uint16_t>::IsSeqHigherThan(this->lastSeq, nackInfo.sendAtSeq)
+					seq == this->lastSeq ||
+					SeqManager<uint16_t>::IsSeqHigherThan(this->lastSeq, seq)
 				)
 			)
 			// clang-format on
@@ -278,11 +455,7 @@ namespace RTC
 					  "]",
 					  seq);
 
-					it = this->nackList.erase(it);
-				}
-				else
-				{
-					++it;
+					RemoveNackItem(seq);
 				}
 
 				continue;
@@ -305,17 +478,11 @@ namespace RTC
 					  "]",
 					  seq);
 
-					it = this->nackList.erase(it);
-				}
-				else
-				{
-					++it;
+					RemoveNackItem(seq);
 				}
 
 				continue;
 			}
-
-			++it;
 		}
 
 #if MS_LOG_DEV_LEVEL == 3
@@ -344,7 +511,7 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->nackList.clear();
+		ClearNackList();
 		this->keyFrameList.clear();
 		this->recoveredList.clear();
 		this->started = false;
@@ -353,7 +520,7 @@ namespace RTC
 
 	inline void NackGenerator::MayRunTimer() const
 	{
-		if (this->nackList.empty())
+		if (this->nackListLength == 0u)
 		{
 			this->timer->Stop();
 		}
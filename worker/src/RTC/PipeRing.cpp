@@ -0,0 +1,282 @@
+#define MS_CLASS "RTC::PipeRing"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/PipeRing.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include <cstring> // std::memcpy()
+#include <thread>  // std::this_thread::yield()
+
+/* Static methods for UV callbacks. */
+
+inline static void onAsync(uv_async_t* handle)
+{
+	static_cast<RTC::PipeRing*>(handle->data)->OnUvAsync();
+}
+
+inline static void onCloseAsync(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_async_t*>(handle);
+}
+
+namespace RTC
+{
+	/* Static. */
+
+	// Length written in place of a record that did not fit at the end of the
+	// buffer. The record is then written at the beginning.
+	static constexpr uint32_t WrapMarker{ 0xFFFFFFFF };
+	static constexpr size_t RecordHeaderSize{ sizeof(uint32_t) };
+	// NOTE: Packets are copied out of the ring into a buffer of this size, so
+	// they can grow in place (i.e. when mangling RTP header extensions) as they
+	// do when read from a socket.
+	static constexpr size_t ReadBufferSize{ 65536u };
+	// NOTE: Allocated on first usage to not bloat the TLS block of every thread.
+	thread_local static std::unique_ptr<uint8_t[]> ReadBuffer;
+
+	inline static size_t getRecordSize(size_t len)
+	{
+		// Records are 4 bytes aligned, so a WrapMarker always fits.
+		return RecordHeaderSize + ((len + 3u) & ~size_t{ 3u });
+	}
+
+	/* Instance methods. */
+
+	PipeRing::PipeRing(Listener* listener) : listener(listener)
+	{
+		MS_TRACE();
+
+		this->uvHandle       = new uv_async_t;
+		this->uvHandle->data = static_cast<void*>(this);
+
+		const int err =
+		  uv_async_init(DepLibUV::GetLoop(), this->uvHandle, static_cast<uv_async_cb>(onAsync));
+
+		if (err != 0)
+		{
+			delete this->uvHandle;
+			this->uvHandle = nullptr;
+
+			MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+		}
+
+		// Do not keep the loop alive just because of this handle.
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvHandle));
+	}
+
+	PipeRing::~PipeRing()
+	{
+		MS_TRACE();
+
+		// NOTE: The consumer must have called Close() already. This may run in
+		// the producer thread (if it held the last reference).
+		MS_ASSERT(!this->uvHandle, "ring not closed");
+	}
+
+	void PipeRing::Close()
+	{
+		MS_TRACE();
+
+		// NOTE: seq_cst along with RingDoorbell(), so a producer either sees the
+		// ring closed or is waited for here.
+		this->closed.store(true);
+
+		while (this->doorbellUsers.load() != 0u)
+		{
+			std::this_thread::yield();
+		}
+
+		if (this->uvHandle)
+		{
+			uv_close(
+			  reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onCloseAsync));
+
+			this->uvHandle = nullptr;
+		}
+	}
+
+	bool PipeRing::ClaimProducer(const std::string& producerKey)
+	{
+		MS_TRACE();
+
+		const std::lock_guard<std::mutex> lock(this->mutex);
+
+		if (IsClosed() || this->hasProducer)
+		{
+			return false;
+		}
+
+		if (!this->buffer)
+		{
+			this->buffer.reset(new uint8_t[PipeRing::Capacity]);
+		}
+
+		this->hasProducer = true;
+		this->producerKey = producerKey;
+
+		return true;
+	}
+
+	void PipeRing::ReleaseProducer()
+	{
+		MS_TRACE();
+
+		const std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->hasProducer = false;
+		this->producerKey.clear();
+	}
+
+	void PipeRing::AcceptProducer(const std::string& producerKey)
+	{
+		MS_TRACE();
+
+		const std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->acceptedProducerKey = producerKey;
+	}
+
+	bool PipeRing::Push(const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		if (IsClosed() || len == 0u || len > PipeRing::MaxPacketSize)
+		{
+			this->droppedCount.fetch_add(1u, std::memory_order_relaxed);
+
+			return false;
+		}
+
+		const size_t head       = this->head.load(std::memory_order_relaxed);
+		const size_t tail       = this->tail.load(std::memory_order_acquire);
+		const size_t recordSize = getRecordSize(len);
+		size_t pos              = head % PipeRing::Capacity;
+		const size_t contiguous = PipeRing::Capacity - pos;
+		const bool wrap         = recordSize > contiguous;
+		const size_t needed     = wrap ? contiguous + recordSize : recordSize;
+
+		if (PipeRing::Capacity - (head - tail) < needed)
+		{
+			this->droppedCount.fetch_add(1u, std::memory_order_relaxed);
+
+			return false;
+		}
+
+		auto* buffer = this->buffer.get();
+
+		if (wrap)
+		{
+			std::memcpy(buffer + pos, std::addressof(WrapMarker), RecordHeaderSize);
+
+			pos = 0u;
+		}
+
+		const auto recordLen = static_cast<uint32_t>(len);
+
+		std::memcpy(buffer + pos, std::addressof(recordLen), RecordHeaderSize);
+		std::memcpy(buffer + pos + RecordHeaderSize, data, len);
+
+		this->head.store(head + needed, std::memory_order_release);
+
+		RingDoorbell();
+
+		return true;
+	}
+
+	void PipeRing::OnUvAsync()
+	{
+		MS_TRACE();
+
+		// The listener may release the last reference to the ring while a packet
+		// is delivered.
+		const auto self = shared_from_this();
+
+		// NOTE: Clear it before reading the head, so packets pushed meanwhile
+		// ring the doorbell again.
+		this->signaled.exchange(false);
+
+		const size_t head = this->head.load(std::memory_order_acquire);
+		size_t tail       = this->tail.load(std::memory_order_relaxed);
+
+		if (tail == head)
+		{
+			return;
+		}
+
+		bool accepted;
+
+		{
+			const std::lock_guard<std::mutex> lock(this->mutex);
+
+			accepted = this->hasProducer && this->producerKey == this->acceptedProducerKey;
+		}
+
+		// Discard packets of a producer that is not accepted (yet).
+		if (!accepted || IsClosed())
+		{
+			this->tail.store(head, std::memory_order_release);
+
+			return;
+		}
+
+		if (!ReadBuffer)
+		{
+			ReadBuffer.reset(new uint8_t[ReadBufferSize]);
+		}
+
+		const auto* buffer = this->buffer.get();
+
+		while (tail != head)
+		{
+			const size_t pos = tail % PipeRing::Capacity;
+			uint32_t len;
+
+			std::memcpy(std::addressof(len), buffer + pos, RecordHeaderSize);
+
+			if (len == WrapMarker)
+			{
+				tail += PipeRing::Capacity - pos;
+
+				continue;
+			}
+
+			std::memcpy(ReadBuffer.get(), buffer + pos + RecordHeaderSize, len);
+
+			tail += getRecordSize(len);
+
+			// Free the space before delivering the packet.
+			this->tail.store(tail, std::memory_order_release);
+
+			this->listener->OnPipeRingPacket(this, ReadBuffer.get(), len);
+
+			// The listener may have closed the ring.
+			if (IsClosed())
+			{
+				return;
+			}
+		}
+
+		this->tail.store(tail, std::memory_order_release);
+	}
+
+	inline void PipeRing::RingDoorbell()
+	{
+		MS_TRACE();
+
+		// Already rung and not handled yet by the consumer.
+		if (this->signaled.exchange(true))
+		{
+			return;
+		}
+
+		this->doorbellUsers.fetch_add(1u);
+
+		if (!this->closed.load())
+		{
+			uv_async_send(this->uvHandle);
+		}
+
+		this->doorbellUsers.fetch_sub(1u);
+	}
+} // namespace RTC
@@ -2,10 +2,26 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "RTC/PipeTransport.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
+#include "RTC/RtpPacketBufferPool.hpp"
 #include <cstring> // std::memcpy()
+#include <mutex>
+#include <utility> // std::move()
+
+/* Static methods for UV callbacks. */
+
+inline static void onIdle(uv_idle_t* /*handle*/)
+{
+	RTC::PipeTransport::DeliverLocalPackets();
+}
+
+inline static void onCloseIdle(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_idle_t*>(handle);
+}
 
 namespace RTC
 {
@@ -17,6 +33,75 @@ namespace RTC
 	};
 	// MAster length of AEAD_AES_256_GCM.
 	size_t PipeTransport::srtpMasterLength{ 44 };
+	thread_local absl::flat_hash_map<std::string, PipeTransport*>
+	  PipeTransport::mapLocalAddressPipeTransport;
+	thread_local std::deque<PipeTransport::LocalPacket> PipeTransport::localPacketQueue;
+	thread_local uv_idle_t* PipeTransport::localPacketsIdleHandle{ nullptr };
+	thread_local size_t PipeTransport::numPipeTransports{ 0u };
+
+	// Max size of a RTP packet passed to the local peer. It is cloned into a
+	// RtpPacketBufferPool buffer which must leave room for the header extensions
+	// that the receiving Producer sets in place (the MID, abs-send-time and
+	// transport-wide-cc ones plus a byte per proxied extension if it switches to
+	// Two-Bytes extensions, which sum up to less than 64 bytes). Bigger packets
+	// go through the socket.
+	static constexpr size_t MaxLocalRtpPacketSize{ RTC::RtpPacketBufferPool::BufferSize - 64u };
+
+	/* Struct for a PipeTransport of any worker of this process. */
+	struct ProcessPipeTransport
+	{
+		std::shared_ptr<RTC::PipeRing> inboundRing;
+		// Loop of its worker.
+		const uv_loop_t* loop{ nullptr };
+		bool srtp{ false };
+	};
+
+	// PipeTransports of all the workers (threads) of this process indexed by
+	// their local "ip:port".
+	static std::mutex ProcessPipeTransportsMutex;
+	static absl::flat_hash_map<std::string, ProcessPipeTransport> ProcessPipeTransports;
+
+	/* Class methods. */
+
+	void PipeTransport::SendLocalPacket(LocalPacket&& localPacket)
+	{
+		MS_TRACE();
+
+		PipeTransport::localPacketQueue.push_back(std::move(localPacket));
+
+		// Packets are not delivered right away since the sender may be within
+		// its Router's fan-out loop, which the destination Router could re-enter
+		// (i.e. Routers piping to each other).
+		// NOTE: An active idle handle also makes the loop poll without blocking.
+		uv_idle_start(PipeTransport::localPacketsIdleHandle, static_cast<uv_idle_cb>(onIdle));
+	}
+
+	void PipeTransport::DeliverLocalPackets()
+	{
+		MS_TRACE();
+
+		// Packets queued while delivering are delivered in the next iteration.
+		auto count = PipeTransport::localPacketQueue.size();
+
+		while (count-- > 0u && !PipeTransport::localPacketQueue.empty())
+		{
+			auto queuedPacket = std::move(PipeTransport::localPacketQueue.front());
+
+			PipeTransport::localPacketQueue.pop_front();
+
+			// Destination may have been closed meanwhile.
+			if (queuedPacket.destination)
+			{
+				queuedPacket.destination->OnLocalPacketReceived(queuedPacket);
+			}
+		}
+
+		// NOTE: The last PipeTransport may have been closed meanwhile.
+		if (PipeTransport::localPacketQueue.empty() && PipeTransport::localPacketsIdleHandle)
+		{
+			uv_idle_stop(PipeTransport::localPacketsIdleHandle);
+		}
+	}
 
 	/* Instance methods. */
 
@@ -121,19 +206,70 @@ namespace RTC
 			  udpSocket->GetSendBufferSize(),
 			  udpSocket->GetRecvBufferSize());
 
+			if (!PipeTransport::localPacketsIdleHandle)
+			{
+				PipeTransport::localPacketsIdleHandle = new uv_idle_t;
+
+				const int err = uv_idle_init(DepLibUV::GetLoop(), PipeTransport::localPacketsIdleHandle);
+
+				if (err != 0)
+				{
+					delete PipeTransport::localPacketsIdleHandle;
+					PipeTransport::localPacketsIdleHandle = nullptr;
+
+					MS_THROW_ERROR("uv_idle_init() failed: %s", uv_strerror(err));
+				}
+			}
+
+			// NOTE: This may throw.
+			this->inboundRing = std::make_shared<RTC::PipeRing>(this);
+
 			// NOTE: This may throw.
 			this->shared->channelMessageRegistrator->RegisterHandler(
 			  this->id,
 			  /*channelRequestHandler*/ this,
 			  /*channelNotificationHandler*/ this);
+
+			this->localAddressKey =
+			  this->udpSocket->GetLocalIp() + ":" + std::to_string(this->udpSocket->GetLocalPort());
+
+			PipeTransport::mapLocalAddressPipeTransport.try_emplace(this->localAddressKey, this);
+
+			// NOTE: A port shared with other sockets does not identify this
+			// PipeTransport.
+			if (!this->listenInfo.flags.udpReusePort)
+			{
+				const std::lock_guard<std::mutex> lock(ProcessPipeTransportsMutex);
+
+				ProcessPipeTransports.try_emplace(
+				  this->localAddressKey,
+				  ProcessPipeTransport{ this->inboundRing, DepLibUV::GetLoop(), HasSrtp() });
+			}
+
+			++PipeTransport::numPipeTransports;
 		}
 		catch (const MediaSoupError& error)
 		{
 			// Must delete everything since the destructor won't be called.
 
+			if (this->inboundRing)
+			{
+				this->inboundRing->Close();
+				this->inboundRing.reset();
+			}
+
 			delete this->udpSocket;
 			this->udpSocket = nullptr;
 
+			if (PipeTransport::numPipeTransports == 0u && PipeTransport::localPacketsIdleHandle)
+			{
+				uv_close(
+				  reinterpret_cast<uv_handle_t*>(PipeTransport::localPacketsIdleHandle),
+				  static_cast<uv_close_cb>(onCloseIdle));
+
+				PipeTransport::localPacketsIdleHandle = nullptr;
+			}
+
 			throw;
 		}
 	}
@@ -148,6 +284,62 @@ namespace RTC
 
 		this->shared->channelMessageRegistrator->UnregisterHandler(this->id);
 
+		if (this->localPeer)
+		{
+			this->localPeer->localPeer = nullptr;
+			this->localPeer            = nullptr;
+		}
+
+		auto it = PipeTransport::mapLocalAddressPipeTransport.find(this->localAddressKey);
+
+		if (it != PipeTransport::mapLocalAddressPipeTransport.end() && it->second == this)
+		{
+			PipeTransport::mapLocalAddressPipeTransport.erase(it);
+		}
+
+		UnlinkThreadPeer();
+
+		{
+			const std::lock_guard<std::mutex> lock(ProcessPipeTransportsMutex);
+
+			auto processIt = ProcessPipeTransports.find(this->localAddressKey);
+
+			if (
+			  processIt != ProcessPipeTransports.end() &&
+			  processIt->second.inboundRing == this->inboundRing)
+			{
+				ProcessPipeTransports.erase(processIt);
+			}
+		}
+
+		// Producers holding the ring drop their packets from now on.
+		this->inboundRing->Close();
+		this->inboundRing.reset();
+
+		// Drop packets queued for this PipeTransport.
+		for (auto& localPacket : PipeTransport::localPacketQueue)
+		{
+			if (localPacket.destination == this)
+			{
+				delete localPacket.rtpPacket;
+				localPacket.rtpPacket   = nullptr;
+				localPacket.destination = nullptr;
+			}
+		}
+
+		// Close the idle handle with the last PipeTransport. Queued packets, if
+		// any, have no destination anymore.
+		if (--PipeTransport::numPipeTransports == 0u)
+		{
+			PipeTransport::localPacketQueue.clear();
+
+			uv_close(
+			  reinterpret_cast<uv_handle_t*>(PipeTransport::localPacketsIdleHandle),
+			  static_cast<uv_close_cb>(onCloseIdle));
+
+			PipeTransport::localPacketsIdleHandle = nullptr;
+		}
+
 		delete this->udpSocket;
 		this->udpSocket = nullptr;
 
@@ -438,6 +630,8 @@ namespace RTC
 					{
 						this->tuple->SetLocalAnnouncedAddress(this->listenInfo.announcedAddress);
 					}
+
+					this->remoteAddressKey = ip + ":" + std::to_string(port);
 				}
 				catch (const MediaSoupError& error)
 				{
@@ -460,6 +654,17 @@ namespace RTC
 
 				request->Accept(FBS::Response::Body::PipeTransport_ConnectResponse, responseOffset);
 
+				// Packets of the PipeTransport we are connected to, if it belongs to
+				// another worker of this process, come through our ring.
+				this->inboundRing->AcceptProducer(this->remoteAddressKey);
+
+				MayLinkLocalPeer();
+
+				if (!this->localPeer)
+				{
+					MayLinkThreadPeer();
+				}
+
 				// Assume we are connected (there is no much more we can do to know it)
 				// and tell the parent class.
 				RTC::Transport::Connected();
@@ -494,7 +699,7 @@ namespace RTC
 	}
 
 	void PipeTransport::SendRtpPacket(
-	  RTC::Consumer* /*consumer*/, RTC::RtpPacket* packet, RTC::Transport::onSendCallback* cb)
+	  RTC::Consumer* consumer, RTC::RtpPacket* packet, RTC::Transport::onSendCallback* cb)
 	{
 		MS_TRACE();
 
@@ -509,20 +714,78 @@ namespace RTC
 			return;
 		}
 
-		const uint8_t* data = packet->GetData();
-		auto len            = packet->GetSize();
-
-		if (HasSrtp() && !this->srtpSendSession->EncryptRtp(&data, &len))
+		if (this->localPeer && packet->GetSize() <= MaxLocalRtpPacketSize)
 		{
+			UpdateRtpPacketMid(consumer, packet);
+
+			LocalPacket localPacket;
+
+			localPacket.destination = this->localPeer;
+			localPacket.rtpPacket   = packet->Clone();
+
 			if (cb)
 			{
-				(*cb)(false);
+				(*cb)(true);
 				delete cb;
 			}
 
+			// Increase send transmission.
+			RTC::Transport::DataSent(packet->GetSize());
+
+			PipeTransport::SendLocalPacket(std::move(localPacket));
+
 			return;
 		}
 
+		if (this->threadPeerRing)
+		{
+			UpdateRtpPacketMid(consumer, packet);
+
+			if (SendToThreadPeer(packet->GetData(), packet->GetSize()))
+			{
+				if (cb)
+				{
+					(*cb)(true);
+					delete cb;
+				}
+
+				// Increase send transmission.
+				RTC::Transport::DataSent(packet->GetSize());
+
+				return;
+			}
+		}
+
+		const uint8_t* data = packet->GetData();
+		auto len            = packet->GetSize();
+
+		if (HasSrtp())
+		{
+			if (!EncryptRtpPacket(this->srtpSendSession, consumer, packet, this->tuple, &data, &len, cb))
+			{
+				if (cb)
+				{
+					(*cb)(false);
+					delete cb;
+				}
+
+				return;
+			}
+
+			// Protected and sent by the SrtpCryptoPool.
+			if (!data)
+			{
+				// Increase send transmission.
+				RTC::Transport::DataSent(len);
+
+				return;
+			}
+		}
+		else
+		{
+			UpdateRtpPacketMid(consumer, packet);
+		}
+
 		this->tuple->Send(data, len, cb);
 
 		// Increase send transmission.
@@ -541,6 +804,29 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		auto len            = packet->GetSize();
 
+		if (this->localPeer)
+		{
+			LocalPacket localPacket;
+
+			localPacket.destination = this->localPeer;
+			localPacket.data.assign(data, data + len);
+
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+
+			PipeTransport::SendLocalPacket(std::move(localPacket));
+
+			return;
+		}
+
+		if (this->threadPeerRing && SendToThreadPeer(data, len))
+		{
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+
+			return;
+		}
+
 		if (HasSrtp() && !this->srtpSendSession->EncryptRtcp(&data, &len))
 		{
 			return;
@@ -566,6 +852,29 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		auto len            = packet->GetSize();
 
+		if (this->localPeer)
+		{
+			LocalPacket localPacket;
+
+			localPacket.destination = this->localPeer;
+			localPacket.data.assign(data, data + len);
+
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+
+			PipeTransport::SendLocalPacket(std::move(localPacket));
+
+			return;
+		}
+
+		if (this->threadPeerRing && SendToThreadPeer(data, len))
+		{
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+
+			return;
+		}
+
 		if (HasSrtp() && !this->srtpSendSession->EncryptRtcp(&data, &len))
 		{
 			return;
@@ -594,6 +903,30 @@ namespace RTC
 			return;
 		}
 
+		if (this->localPeer)
+		{
+			LocalPacket localPacket;
+
+			localPacket.destination = this->localPeer;
+			localPacket.sctp        = true;
+			localPacket.data.assign(data, data + len);
+
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+
+			PipeTransport::SendLocalPacket(std::move(localPacket));
+
+			return;
+		}
+
+		if (this->threadPeerRing && SendToThreadPeer(data, len))
+		{
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+
+			return;
+		}
+
 		this->tuple->Send(data, len);
 
 		// Increase send transmission.
@@ -766,6 +1099,192 @@ namespace RTC
 		RTC::Transport::ReceiveSctpData(data, len);
 	}
 
+	/**
+	 * If the remote address is the one of another PipeTransport of this worker
+	 * connected to this one (and none of them uses SRTP), link both so packets
+	 * are handed to each other instead of going through their UDP sockets.
+	 */
+	void PipeTransport::MayLinkLocalPeer()
+	{
+		MS_TRACE();
+
+		if (HasSrtp())
+		{
+			return;
+		}
+
+		auto it = PipeTransport::mapLocalAddressPipeTransport.find(this->remoteAddressKey);
+
+		if (it == PipeTransport::mapLocalAddressPipeTransport.end())
+		{
+			return;
+		}
+
+		auto* peer = it->second;
+
+		if (
+		  peer == this || !peer->IsConnected() || peer->HasSrtp() || peer->localPeer ||
+		  peer->remoteAddressKey != this->localAddressKey)
+		{
+			return;
+		}
+
+		MS_DEBUG_TAG(
+		  info,
+		  "linked to local PipeTransport [id:%s, peerId:%s]",
+		  this->id.c_str(),
+		  peer->id.c_str());
+
+		this->localPeer = peer;
+		peer->localPeer = this;
+	}
+
+	/**
+	 * If the remote address is the one of a PipeTransport of another worker
+	 * (thread) of this process (and none of them uses SRTP), put packets into
+	 * its ring instead of sending them through the UDP socket. The ring has a
+	 * single producer, so just the first PipeTransport connected to it gets it.
+	 */
+	void PipeTransport::MayLinkThreadPeer()
+	{
+		MS_TRACE();
+
+		if (HasSrtp())
+		{
+			return;
+		}
+
+		std::shared_ptr<RTC::PipeRing> ring;
+
+		{
+			const std::lock_guard<std::mutex> lock(ProcessPipeTransportsMutex);
+
+			auto it = ProcessPipeTransports.find(this->remoteAddressKey);
+
+			if (it == ProcessPipeTransports.end())
+			{
+				return;
+			}
+
+			const auto& peer = it->second;
+
+			if (peer.loop == DepLibUV::GetLoop() || peer.srtp)
+			{
+				return;
+			}
+
+			ring = peer.inboundRing;
+		}
+
+		if (!ring->ClaimProducer(this->localAddressKey))
+		{
+			return;
+		}
+
+		MS_DEBUG_TAG(
+		  info,
+		  "linked to PipeTransport of another worker [id:%s, remoteAddress:%s]",
+		  this->id.c_str(),
+		  this->remoteAddressKey.c_str());
+
+		this->threadPeerRing = std::move(ring);
+	}
+
+	void PipeTransport::UnlinkThreadPeer()
+	{
+		MS_TRACE();
+
+		if (!this->threadPeerRing)
+		{
+			return;
+		}
+
+		this->threadPeerRing->ReleaseProducer();
+		this->threadPeerRing.reset();
+	}
+
+	/**
+	 * Returns false if the peer has been closed, so the packet must be sent
+	 * through the UDP socket.
+	 */
+	inline bool PipeTransport::SendToThreadPeer(const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		if (this->threadPeerRing->IsClosed())
+		{
+			UnlinkThreadPeer();
+
+			return false;
+		}
+
+		// NOTE: If the ring is full the packet is dropped, as it would be if the
+		// receive buffer of the peer socket was full.
+		this->threadPeerRing->Push(data, len);
+
+		return true;
+	}
+
+	void PipeTransport::OnLocalPacketReceived(LocalPacket& localPacket)
+	{
+		MS_TRACE();
+
+		if (!IsConnected())
+		{
+			delete localPacket.rtpPacket;
+
+			return;
+		}
+
+		if (localPacket.rtpPacket)
+		{
+			auto* packet = localPacket.rtpPacket;
+
+			// Leave the packet as if it had been parsed from the network.
+			packet->SetFrameMarking07ExtensionId(0u);
+			packet->SetFrameMarkingExtensionId(0u);
+			packet->SetSsrcAudioLevelExtensionId(0u);
+			packet->SetVideoOrientationExtensionId(0u);
+			packet->SetPlayoutDelayExtensionId(0u);
+			packet->SetDependencyDescriptorExtensionId(0u);
+			packet->ResetPayloadDescriptorHandler();
+
+			// Increase receive transmission.
+			RTC::Transport::DataReceived(packet->GetSize());
+
+			// Pass the packet to the parent transport.
+			RTC::Transport::ReceiveRtpPacket(packet);
+
+			return;
+		}
+
+		const uint8_t* data = localPacket.data.data();
+		const size_t len    = localPacket.data.size();
+
+		// Increase receive transmission.
+		RTC::Transport::DataReceived(len);
+
+		if (localPacket.sctp)
+		{
+			// Pass it to the parent transport.
+			RTC::Transport::ReceiveSctpData(data, len);
+
+			return;
+		}
+
+		RTC::RTCP::Packet* packet = RTC::RTCP::Packet::Parse(data, len);
+
+		if (!packet)
+		{
+			MS_WARN_TAG(rtcp, "received data is not a valid RTCP compound or single packet");
+
+			return;
+		}
+
+		// Pass the packet to the parent transport.
+		RTC::Transport::ReceiveRtcpPacket(packet);
+	}
+
 	inline void PipeTransport::OnUdpSocketPacketReceived(
 	  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr)
 	{
@@ -775,4 +1294,14 @@ namespace RTC
 
 		OnPacketReceived(&tuple, data, len);
 	}
+
+	inline void PipeTransport::OnPipeRingPacket(
+	  RTC::PipeRing* /*ring*/, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		// NOTE: The ring just delivers packets of the PipeTransport we are
+		// connected to, so they come from our tuple.
+		OnPacketReceived(this->tuple, data, len);
+	}
 } // namespace RTC
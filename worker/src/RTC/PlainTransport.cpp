@@ -798,7 +798,7 @@ namespace RTC
 	}
 
 	void PlainTransport::SendRtpPacket(
-	  RTC::Consumer* /*consumer*/, RTC::RtpPacket* packet, RTC::Transport::onSendCallback* cb)
+	  RTC::Consumer* consumer, RTC::RtpPacket* packet, RTC::Transport::onSendCallback* cb)
 	{
 		MS_TRACE();
 
@@ -816,15 +816,31 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		auto len            = packet->GetSize();
 
-		if (HasSrtp() && !this->srtpSendSession->EncryptRtp(&data, &len))
+		if (HasSrtp())
 		{
-			if (cb)
+			if (!EncryptRtpPacket(this->srtpSendSession, consumer, packet, this->tuple, &data, &len, cb))
 			{
-				(*cb)(false);
-				delete cb;
+				if (cb)
+				{
+					(*cb)(false);
+					delete cb;
+				}
+
+				return;
 			}
 
-			return;
+			// Protected and sent by the SrtpCryptoPool.
+			if (!data)
+			{
+				// Increase send transmission.
+				RTC::Transport::DataSent(len);
+
+				return;
+			}
+		}
+		else
+		{
+			UpdateRtpPacketMid(consumer, packet);
 		}
 
 		this->tuple->Send(data, len, cb);
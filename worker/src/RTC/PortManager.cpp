@@ -9,6 +9,21 @@
 #include "Utils.hpp"
 #include <tuple>   // std:make_tuple()
 #include <utility> // std::piecewise_construct
+#ifdef __linux__
+#include <bitset>
+#include <cerrno>
+#include <cstddef> // offsetof()
+#include <cstring> // std::strerror()
+#include <linux/bpf.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <netinet/in.h>
+#include <mutex>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h> // syscall(), close()
+#include <vector>
+#endif
 
 /* Static methods for UV callbacks. */
 
@@ -29,6 +44,868 @@ inline static void onFakeConnection(uv_stream_t* /*handle*/, int /*status*/)
 	// Do nothing.
 }
 
+/* Static methods for UDP sharding. */
+
+#ifdef __linux__
+// Shard indexes are encoded in a single character ('0'-'9', 'a'-'z').
+static constexpr uint32_t MaxUdpShards{ 36 };
+
+// Max number of ICE tuples (remote addresses) of all the shards of a group.
+static constexpr uint32_t MaxUdpShardingTuples{ 65536 };
+
+// eBPF program, REUSEPORT_SOCKARRAY map and tuples map of the SO_REUSEPORT
+// group of a sharded ip:port.
+struct UdpShardingGroup
+{
+	int mapFd{ -1 };
+	int tuplesMapFd{ -1 };
+	int programFd{ -1 };
+	// Paths of the maps in the BPF filesystem (empty if not pinned).
+	std::string pinPath;
+	std::string tuplesPinPath;
+	// Shards of this process stored in the map.
+	std::bitset<MaxUdpShards> shards;
+};
+
+// Key of the tuples map: remote IP (IPv4 ones in the first 4 bytes) and port
+// in network byte order.
+struct UdpShardingTupleKey
+{
+	uint8_t ip[16];
+	uint16_t port;
+	uint16_t padding;
+};
+
+// NOTE: Not thread_local since workers running as threads of the same process
+// (Rust) share them. They are closed once the last shard of the process is
+// unbound.
+static std::mutex UdpShardingGroupsMutex;
+static absl::flat_hash_map<std::string, UdpShardingGroup> UdpShardingGroups;
+
+static inline int bpfSyscall(int cmd, union bpf_attr& attr)
+{
+	return static_cast<int>(syscall(__NR_bpf, cmd, std::addressof(attr), sizeof(attr)));
+}
+
+static inline struct bpf_insn bpfInsn(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm)
+{
+	struct bpf_insn insn
+	{
+	};
+
+	insn.code    = code;
+	insn.dst_reg = dst;
+	insn.src_reg = src;
+	insn.off     = off;
+	insn.imm     = imm;
+
+	return insn;
+}
+
+/**
+ * eBPF program for SO_ATTACH_REUSEPORT_EBPF that selects the socket of the
+ * SO_REUSEPORT group stored in the given REUSEPORT_SOCKARRAY map with the
+ * shard index encoded in the first character of the local ICE username
+ * fragment ('0'-'9', 'a'-'z') within the USERNAME attribute of received STUN
+ * requests. Other packets get the socket of the shard stored for their remote
+ * address (ICE tuple) in the given tuples map. Otherwise (or if the shard is
+ * missing) the kernel selects the socket by hash.
+ *
+ * NOTE: Packet offsets are relative to the UDP header.
+ */
+static std::vector<struct bpf_insn> getUdpShardingProgram(int mapFd, int tuplesMapFd)
+{
+	// USERNAME is usually the first attribute, but look at a few of them.
+	static constexpr size_t MaxAttributes{ 4 };
+	static constexpr int32_t UdpHeaderLength{ 8 };
+	static constexpr int32_t StunHeaderLength{ 20 };
+
+	std::vector<struct bpf_insn> program;
+	// Jumps to patch once the position of their target is known.
+	std::vector<size_t> jumpsToTuple;
+	std::vector<size_t> jumpsToSelect;
+	std::vector<size_t> jumpsToPass;
+	std::vector<size_t> jumpsToFound;
+
+	// Loads len bytes at the offset in offsetReg (or at offset if none) into
+	// the stack at stackOffset. Adds a jump (to patch) to the given ones if
+	// they are not within the packet.
+	auto loadBytes = [&](
+	                   int offsetReg,
+	                   int32_t offset,
+	                   int16_t stackOffset,
+	                   int32_t len,
+	                   std::vector<size_t>& jumpsOnError)
+	{
+		program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_1, BPF_REG_6, 0, 0));
+
+		if (offsetReg != -1)
+		{
+			program.push_back(
+			  bpfInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, static_cast<uint8_t>(offsetReg), 0, 0));
+		}
+		else
+		{
+			program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_2, 0, 0, offset));
+		}
+
+		program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_3, BPF_REG_10, 0, 0));
+		program.push_back(bpfInsn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_3, 0, 0, stackOffset));
+		program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_4, 0, 0, len));
+		program.push_back(bpfInsn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_skb_load_bytes));
+		jumpsOnError.push_back(program.size());
+		program.push_back(bpfInsn(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_0, 0, 0, 0));
+	};
+
+	// R6 = context.
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_1, 0, 0));
+	// STUN message type (must start with 0b0000000) and magic cookie.
+	loadBytes(-1, UdpHeaderLength, -8, 8, jumpsToTuple);
+	program.push_back(bpfInsn(BPF_LDX | BPF_MEM | BPF_B, BPF_REG_0, BPF_REG_10, -8, 0));
+	jumpsToTuple.push_back(program.size());
+	program.push_back(bpfInsn(BPF_JMP | BPF_JGE | BPF_K, BPF_REG_0, 0, 0, 2));
+	program.push_back(bpfInsn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_0, BPF_REG_10, -4, 0));
+	program.push_back(bpfInsn(BPF_ALU | BPF_END | BPF_TO_BE, BPF_REG_0, 0, 0, 32));
+	jumpsToTuple.push_back(program.size());
+	program.push_back(bpfInsn(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_0, 0, 0, 0x2112a442));
+	// R7 = offset of the current attribute.
+	program.push_back(
+	  bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_7, 0, 0, UdpHeaderLength + StunHeaderLength));
+
+	for (size_t i{ 0 }; i < MaxAttributes; ++i)
+	{
+		// Attribute type, length and first value byte.
+		loadBytes(BPF_REG_7, 0, -16, 5, jumpsToTuple);
+		program.push_back(bpfInsn(BPF_LDX | BPF_MEM | BPF_H, BPF_REG_0, BPF_REG_10, -16, 0));
+		program.push_back(bpfInsn(BPF_ALU | BPF_END | BPF_TO_BE, BPF_REG_0, 0, 0, 16));
+		jumpsToFound.push_back(program.size());
+		program.push_back(bpfInsn(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_0, 0, 0, 0x0006));
+		// Next attribute offset: offset + 4 + length padded to 4 bytes.
+		program.push_back(bpfInsn(BPF_LDX | BPF_MEM | BPF_H, BPF_REG_0, BPF_REG_10, -14, 0));
+		program.push_back(bpfInsn(BPF_ALU | BPF_END | BPF_TO_BE, BPF_REG_0, 0, 0, 16));
+		program.push_back(bpfInsn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_0, 0, 0, 7));
+		program.push_back(bpfInsn(BPF_ALU64 | BPF_AND | BPF_K, BPF_REG_0, 0, 0, ~3));
+		program.push_back(bpfInsn(BPF_ALU64 | BPF_ADD | BPF_X, BPF_REG_7, BPF_REG_0, 0, 0));
+	}
+
+	jumpsToTuple.push_back(program.size());
+	program.push_back(bpfInsn(BPF_JMP | BPF_JA, 0, 0, 0, 0));
+
+	// Found: map the first USERNAME character to the shard index.
+	const size_t foundPos = program.size();
+
+	program.push_back(bpfInsn(BPF_LDX | BPF_MEM | BPF_B, BPF_REG_0, BPF_REG_10, -12, 0));
+	program.push_back(bpfInsn(BPF_JMP | BPF_JGE | BPF_K, BPF_REG_0, 0, 2, 'a'));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_SUB | BPF_K, BPF_REG_0, 0, 0, '0'));
+	jumpsToSelect.push_back(program.size());
+	program.push_back(bpfInsn(BPF_JMP | BPF_JA, 0, 0, 0, 0));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_SUB | BPF_K, BPF_REG_0, 0, 0, 'a' - 10));
+	jumpsToSelect.push_back(program.size());
+	program.push_back(bpfInsn(BPF_JMP | BPF_JA, 0, 0, 0, 0));
+
+	// Tuple: look up the shard index of the remote address. The key is the
+	// source IP (16 bytes, IPv4 ones in the first 4) and UDP port.
+	const size_t tuplePos = program.size();
+
+	program.push_back(bpfInsn(BPF_ST | BPF_MEM | BPF_DW, BPF_REG_10, 0, -40, 0));
+	program.push_back(bpfInsn(BPF_ST | BPF_MEM | BPF_DW, BPF_REG_10, 0, -32, 0));
+	program.push_back(bpfInsn(BPF_ST | BPF_MEM | BPF_W, BPF_REG_10, 0, -24, 0));
+	// R2 = offset of the source IP within the IP header, R4 = its length.
+	program.push_back(bpfInsn(
+	  BPF_LDX | BPF_MEM | BPF_W,
+	  BPF_REG_0,
+	  BPF_REG_6,
+	  static_cast<int16_t>(offsetof(struct sk_reuseport_md, eth_protocol)),
+	  0));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_2, 0, 0, 12));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_4, 0, 0, 4));
+	program.push_back(bpfInsn(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_0, 0, 2, htons(ETH_P_IPV6)));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_2, 0, 0, 8));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_4, 0, 0, 16));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_1, BPF_REG_6, 0, 0));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_3, BPF_REG_10, 0, 0));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_3, 0, 0, -40));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_5, 0, 0, BPF_HDR_START_NET));
+	program.push_back(bpfInsn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_skb_load_bytes_relative));
+	jumpsToPass.push_back(program.size());
+	program.push_back(bpfInsn(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_0, 0, 0, 0));
+	// UDP source port.
+	loadBytes(-1, 0, -24, 2, jumpsToPass);
+	// 64 bits immediate load of the tuples map (two instructions).
+	program.push_back(
+	  bpfInsn(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, tuplesMapFd));
+	program.push_back(bpfInsn(0, 0, 0, 0, 0));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_10, 0, 0));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_2, 0, 0, -40));
+	program.push_back(bpfInsn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_map_lookup_elem));
+	jumpsToPass.push_back(program.size());
+	program.push_back(bpfInsn(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_0, 0, 0, 0));
+	program.push_back(bpfInsn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_0, BPF_REG_0, 0, 0));
+
+	// Select: select the socket of the shard index in R0.
+	const size_t selectPos = program.size();
+
+	program.push_back(bpfInsn(BPF_STX | BPF_MEM | BPF_W, BPF_REG_10, BPF_REG_0, -20, 0));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_1, BPF_REG_6, 0, 0));
+	// 64 bits immediate load of the map (two instructions).
+	program.push_back(bpfInsn(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_2, BPF_PSEUDO_MAP_FD, 0, mapFd));
+	program.push_back(bpfInsn(0, 0, 0, 0, 0));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_3, BPF_REG_10, 0, 0));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_3, 0, 0, -20));
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_4, 0, 0, 0));
+	program.push_back(bpfInsn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_sk_select_reuseport));
+
+	// Pass: the selected socket, if any, gets the packet.
+	const size_t passPos = program.size();
+
+	program.push_back(bpfInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, SK_PASS));
+	program.push_back(bpfInsn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+
+	for (const auto pos : jumpsToTuple)
+	{
+		program[pos].off = static_cast<int16_t>(tuplePos - pos - 1);
+	}
+
+	for (const auto pos : jumpsToSelect)
+	{
+		program[pos].off = static_cast<int16_t>(selectPos - pos - 1);
+	}
+
+	for (const auto pos : jumpsToPass)
+	{
+		program[pos].off = static_cast<int16_t>(passPos - pos - 1);
+	}
+
+	for (const auto pos : jumpsToFound)
+	{
+		program[pos].off = static_cast<int16_t>(foundPos - pos - 1);
+	}
+
+	return program;
+}
+
+/**
+ * Whether the given map stores the socket of any shard (of any process).
+ */
+static bool hasUdpShardingSockets(int mapFd)
+{
+	for (uint32_t key{ 0 }; key < MaxUdpShards; ++key)
+	{
+		uint64_t value{ 0 };
+		union bpf_attr attr
+		{
+		};
+
+		attr.map_fd = mapFd;
+		attr.key    = reinterpret_cast<uint64_t>(std::addressof(key));
+		attr.value  = reinterpret_cast<uint64_t>(std::addressof(value));
+
+		// NOTE: It fails with ENOENT if there is no socket for the key.
+		if (bpfSyscall(BPF_MAP_LOOKUP_ELEM, attr) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Closes the maps and program of the given group. If the map is pinned and no
+ * shard of other processes remains in it, the pins are removed too.
+ *
+ * NOTE: A process getting the pinned maps right before they are removed would
+ * add its shard to maps no other process can get. Shards created later would
+ * not steer packets to it.
+ */
+static void closeUdpShardingGroup(const UdpShardingGroup& group)
+{
+	if (group.mapFd != -1 && !hasUdpShardingSockets(group.mapFd))
+	{
+		if (!group.pinPath.empty())
+		{
+			unlink(group.pinPath.c_str());
+		}
+
+		if (!group.tuplesPinPath.empty())
+		{
+			unlink(group.tuplesPinPath.c_str());
+		}
+	}
+
+	if (group.programFd != -1)
+	{
+		close(group.programFd);
+	}
+
+	if (group.tuplesMapFd != -1)
+	{
+		close(group.tuplesMapFd);
+	}
+
+	if (group.mapFd != -1)
+	{
+		close(group.mapFd);
+	}
+}
+
+/**
+ * Gets the map pinned at the given path or, if none, creates it with the
+ * given attributes and pins it. The path is cleared if it cannot be pinned.
+ */
+static int getPinnedMap(std::string& pinPath, const union bpf_attr& mapAttr)
+{
+	union bpf_attr attr
+	{
+	};
+
+	attr.pathname = reinterpret_cast<uint64_t>(pinPath.c_str());
+
+	int fd = bpfSyscall(BPF_OBJ_GET, attr);
+
+	if (fd != -1)
+	{
+		return fd;
+	}
+
+	attr = mapAttr;
+	fd   = bpfSyscall(BPF_MAP_CREATE, attr);
+
+	if (fd == -1)
+	{
+		return -errno;
+	}
+
+	attr          = {};
+	attr.pathname = reinterpret_cast<uint64_t>(pinPath.c_str());
+	attr.bpf_fd   = fd;
+
+	if (bpfSyscall(BPF_OBJ_PIN, attr) == 0)
+	{
+		return fd;
+	}
+
+	// Other process pinned its map meanwhile, so use it.
+	if (errno == EEXIST)
+	{
+		close(fd);
+
+		attr          = {};
+		attr.pathname = reinterpret_cast<uint64_t>(pinPath.c_str());
+		fd            = bpfSyscall(BPF_OBJ_GET, attr);
+
+		return fd != -1 ? fd : -errno;
+	}
+
+	MS_WARN_TAG(
+	  info,
+	  "cannot pin UDP sharding map at '%s', shards in other processes will not be steered: %s",
+	  pinPath.c_str(),
+	  std::strerror(errno));
+
+	pinPath.clear();
+
+	return fd;
+}
+
+/**
+ * Gets the maps and program of the SO_REUSEPORT group of the given ip:port,
+ * creating them if needed, and adds the given shard to the group. The maps
+ * are pinned in the BPF filesystem so shards running in other processes
+ * (Node) use the same ones.
+ */
+static int getUdpShardingGroup(
+  const std::string& ip, uint16_t port, uint8_t shardIndex, UdpShardingGroup& group)
+{
+	const std::string key = ip + "_" + std::to_string(port);
+	const std::lock_guard<std::mutex> lock(UdpShardingGroupsMutex);
+
+	auto it = UdpShardingGroups.find(key);
+
+	if (it != UdpShardingGroups.end())
+	{
+		it->second.shards.set(shardIndex);
+
+		group = it->second;
+
+		return 0;
+	}
+
+	// NOTE: The BPF filesystem does not allow dots in names.
+	std::string pinName = key;
+
+	std::replace_if(
+	  pinName.begin(), pinName.end(), [](char c) { return c == '.' || c == ':'; }, '_');
+
+	group.pinPath       = "/sys/fs/bpf/mediasoup_udp_shards_" + pinName;
+	group.tuplesPinPath = "/sys/fs/bpf/mediasoup_udp_tuples_" + pinName;
+
+	union bpf_attr attr
+	{
+	};
+
+	attr.map_type    = BPF_MAP_TYPE_REUSEPORT_SOCKARRAY;
+	attr.key_size    = sizeof(uint32_t);
+	attr.value_size  = sizeof(uint64_t);
+	attr.max_entries = MaxUdpShards;
+
+	const int mapFd = getPinnedMap(group.pinPath, attr);
+
+	if (mapFd < 0)
+	{
+		return mapFd;
+	}
+
+	group.mapFd = mapFd;
+
+	attr             = {};
+	attr.map_type    = BPF_MAP_TYPE_HASH;
+	attr.key_size    = sizeof(UdpShardingTupleKey);
+	attr.value_size  = sizeof(uint32_t);
+	attr.max_entries = MaxUdpShardingTuples;
+	attr.map_flags   = BPF_F_NO_PREALLOC;
+
+	const int tuplesMapFd = getPinnedMap(group.tuplesPinPath, attr);
+
+	if (tuplesMapFd < 0)
+	{
+		closeUdpShardingGroup(group);
+
+		return tuplesMapFd;
+	}
+
+	group.tuplesMapFd = tuplesMapFd;
+
+	const auto program = getUdpShardingProgram(group.mapFd, group.tuplesMapFd);
+	static const char License[]{ "ISC" };
+
+	attr           = {};
+	attr.prog_type = BPF_PROG_TYPE_SK_REUSEPORT;
+	attr.insns     = reinterpret_cast<uint64_t>(program.data());
+	attr.insn_cnt  = static_cast<uint32_t>(program.size());
+	attr.license   = reinterpret_cast<uint64_t>(License);
+
+	group.programFd = bpfSyscall(BPF_PROG_LOAD, attr);
+
+	if (group.programFd == -1)
+	{
+		const int err = -errno;
+
+		closeUdpShardingGroup(group);
+
+		return err;
+	}
+
+	group.shards.set(shardIndex);
+
+	UdpShardingGroups[key] = group;
+
+	return 0;
+}
+
+static bool getUdpShardingTupleKey(const struct sockaddr* remoteAddr, UdpShardingTupleKey& key)
+{
+	key = {};
+
+	switch (remoteAddr->sa_family)
+	{
+		case AF_INET:
+		{
+			const auto* addr4 = reinterpret_cast<const struct sockaddr_in*>(remoteAddr);
+
+			std::memcpy(key.ip, std::addressof(addr4->sin_addr), 4);
+			key.port = addr4->sin_port;
+
+			return true;
+		}
+
+		case AF_INET6:
+		{
+			const auto* addr6 = reinterpret_cast<const struct sockaddr_in6*>(remoteAddr);
+
+			// NOTE: The program reads IPv4 addresses from the IPv4 header, also in
+			// dual stack sockets.
+			if (IN6_IS_ADDR_V4MAPPED(std::addressof(addr6->sin6_addr)))
+			{
+				std::memcpy(key.ip, addr6->sin6_addr.s6_addr + 12, 4);
+			}
+			else
+			{
+				std::memcpy(key.ip, std::addressof(addr6->sin6_addr), 16);
+			}
+
+			key.port = addr6->sin6_port;
+
+			return true;
+		}
+
+		default:
+		{
+			return false;
+		}
+	}
+}
+
+/**
+ * Removes the tuples of the given shard from the given tuples map.
+ */
+static void removeUdpShardingTuples(int tuplesMapFd, uint8_t shardIndex)
+{
+	std::vector<UdpShardingTupleKey> keys;
+	UdpShardingTupleKey key{};
+	UdpShardingTupleKey nextKey{};
+	union bpf_attr attr
+	{
+	};
+
+	// NOTE: Collect them first since deleting the current key would restart
+	// the iteration.
+	for (bool first{ true };; first = false)
+	{
+		attr          = {};
+		attr.map_fd   = tuplesMapFd;
+		attr.key      = first ? 0u : reinterpret_cast<uint64_t>(std::addressof(key));
+		attr.next_key = reinterpret_cast<uint64_t>(std::addressof(nextKey));
+
+		if (bpfSyscall(BPF_MAP_GET_NEXT_KEY, attr) != 0)
+		{
+			break;
+		}
+
+		key = nextKey;
+
+		uint32_t value{ 0 };
+
+		attr        = {};
+		attr.map_fd = tuplesMapFd;
+		attr.key    = reinterpret_cast<uint64_t>(std::addressof(key));
+		attr.value  = reinterpret_cast<uint64_t>(std::addressof(value));
+
+		if (bpfSyscall(BPF_MAP_LOOKUP_ELEM, attr) == 0 && value == shardIndex)
+		{
+			keys.push_back(key);
+		}
+	}
+
+	for (const auto& tupleKey : keys)
+	{
+		attr        = {};
+		attr.map_fd = tuplesMapFd;
+		attr.key    = reinterpret_cast<uint64_t>(std::addressof(tupleKey));
+
+		bpfSyscall(BPF_MAP_DELETE_ELEM, attr);
+	}
+}
+
+/**
+ * Removes the given shard from the SO_REUSEPORT group of the given ip:port
+ * (and its socket and tuples from the maps if stored). The group is closed once it has
+ * no shards of this process.
+ */
+static void releaseUdpShardingGroup(
+  const std::string& ip, uint16_t port, uint8_t shardIndex, bool stored)
+{
+	const std::string key = ip + "_" + std::to_string(port);
+	const std::lock_guard<std::mutex> lock(UdpShardingGroupsMutex);
+
+	auto it = UdpShardingGroups.find(key);
+
+	if (it == UdpShardingGroups.end() || !it->second.shards.test(shardIndex))
+	{
+		return;
+	}
+
+	auto& group = it->second;
+
+	group.shards.reset(shardIndex);
+
+	// NOTE: The kernel removes it once the socket is closed, but it's still
+	// open and the map must be empty to remove its pin.
+	if (stored)
+	{
+		const uint32_t mapKey{ shardIndex };
+		union bpf_attr attr
+		{
+		};
+
+		attr.map_fd = group.mapFd;
+		attr.key    = reinterpret_cast<uint64_t>(std::addressof(mapKey));
+
+		bpfSyscall(BPF_MAP_DELETE_ELEM, attr);
+
+		removeUdpShardingTuples(group.tuplesMapFd, shardIndex);
+	}
+
+	if (group.shards.none())
+	{
+		closeUdpShardingGroup(group);
+
+		UdpShardingGroups.erase(it);
+	}
+}
+
+/**
+ * Classic BPF program for SO_ATTACH_REUSEPORT_CBPF used when the eBPF one
+ * cannot be loaded (it does not require any capability). It selects the
+ * socket of the SO_REUSEPORT group (in bind order) whose position is the
+ * shard index encoded in the USERNAME attribute of received STUN requests.
+ * Other packets get an invalid position so the kernel selects the socket by
+ * hash.
+ *
+ * NOTE: Positions only match shard indexes while shards are created in index
+ * order and none but the last one is closed (the kernel moves the last socket
+ * of the group into the position of a closed one).
+ *
+ * NOTE: The program runs with the UDP payload at offset 0.
+ */
+static std::vector<struct sock_filter> getUdpShardingFallbackProgram()
+{
+	// USERNAME is usually the first attribute, but look at a few of them.
+	static constexpr size_t MaxAttributes{ 4 };
+
+	std::vector<struct sock_filter> program;
+	// Jumps to patch once the position of their target is known.
+	std::vector<std::pair<size_t, bool /*jt*/>> jumpsToFallback;
+	std::vector<size_t> jumpsToFound;
+
+	// M[0] = payload length. Must have a full STUN header.
+	program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0));
+	jumpsToFallback.emplace_back(program.size(), false);
+	program.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, 20, 0, 0));
+	program.push_back(BPF_STMT(BPF_ST, 0));
+	// STUN message type starts with 0b00.
+	program.push_back(BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0));
+	jumpsToFallback.emplace_back(program.size(), true);
+	program.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, 2, 0, 0));
+	// Magic cookie.
+	program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 4));
+	jumpsToFallback.emplace_back(program.size(), false);
+	program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x2112a442, 0, 0));
+	// M[1] = offset of the current attribute.
+	program.push_back(BPF_STMT(BPF_LD | BPF_IMM, 20));
+	program.push_back(BPF_STMT(BPF_ST, 1));
+
+	for (size_t i{ 0 }; i < MaxAttributes; ++i)
+	{
+		// Attribute header and first value byte must be within the payload.
+		program.push_back(BPF_STMT(BPF_LD | BPF_MEM, 1));
+		program.push_back(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 5));
+		program.push_back(BPF_STMT(BPF_LDX | BPF_MEM, 0));
+		jumpsToFallback.emplace_back(program.size(), true);
+		program.push_back(BPF_JUMP(BPF_JMP | BPF_JGT | BPF_X, 0, 0, 0));
+		// Attribute type.
+		program.push_back(BPF_STMT(BPF_LDX | BPF_MEM, 1));
+		program.push_back(BPF_STMT(BPF_LD | BPF_H | BPF_IND, 0));
+		jumpsToFound.push_back(program.size());
+		program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x0006, 0, 0));
+		// Next attribute offset: offset + 4 + length padded to 4 bytes.
+		program.push_back(BPF_STMT(BPF_LD | BPF_H | BPF_IND, 2));
+		program.push_back(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 7));
+		program.push_back(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0xfffffffc));
+		program.push_back(BPF_STMT(BPF_ALU | BPF_ADD | BPF_X, 0));
+		program.push_back(BPF_STMT(BPF_ST, 1));
+	}
+
+	// Fallback: invalid socket position.
+	const size_t fallbackPos = program.size();
+
+	program.push_back(BPF_STMT(BPF_RET | BPF_K, 0xffffffff));
+
+	// Found: map the first USERNAME character to the socket position.
+	const size_t foundPos = program.size();
+
+	program.push_back(BPF_STMT(BPF_LD | BPF_B | BPF_IND, 4));
+	program.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, 'a', 0, 2));
+	program.push_back(BPF_STMT(BPF_ALU | BPF_SUB | BPF_K, 'a' - 10));
+	program.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+	program.push_back(BPF_STMT(BPF_ALU | BPF_SUB | BPF_K, '0'));
+	program.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+
+	for (const auto& [pos, jt] : jumpsToFallback)
+	{
+		const auto offset = static_cast<uint8_t>(fallbackPos - pos - 1);
+
+		if (jt)
+		{
+			program[pos].jt = offset;
+		}
+		else
+		{
+			program[pos].jf = offset;
+		}
+	}
+
+	for (const auto pos : jumpsToFound)
+	{
+		program[pos].jt = static_cast<uint8_t>(foundPos - pos - 1);
+	}
+
+	return program;
+}
+
+static int attachUdpShardingEbpfProgram(int fd, const UdpShardingGroup& group, uint8_t shardIndex)
+{
+	// NOTE: It must be attached once bound, otherwise the kernel would create
+	// a new SO_REUSEPORT group for this socket rather than joining the existing
+	// one. Every shard attaches it (replacing the same program).
+	if (
+	  setsockopt(
+	    fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_EBPF, &group.programFd, sizeof(group.programFd)) != 0)
+	{
+		return -errno;
+	}
+
+	// Store the socket in the map with the shard index as key, so the socket
+	// of each shard is selected regardless of its position in the group (which
+	// changes when other sockets leave it). The kernel removes it from the map
+	// once closed.
+	const uint32_t key{ shardIndex };
+	const uint64_t value{ static_cast<uint64_t>(fd) };
+	union bpf_attr attr
+	{
+	};
+
+	attr.map_fd = group.mapFd;
+	attr.key    = reinterpret_cast<uint64_t>(std::addressof(key));
+	attr.value  = reinterpret_cast<uint64_t>(std::addressof(value));
+	attr.flags  = BPF_ANY;
+
+	if (bpfSyscall(BPF_MAP_UPDATE_ELEM, attr) != 0)
+	{
+		return -errno;
+	}
+
+	return 0;
+}
+
+static int attachUdpShardingFallbackProgram(int fd)
+{
+	// NOTE: Same program for every socket in the group, so build it once.
+	static const std::vector<struct sock_filter> Program = getUdpShardingFallbackProgram();
+
+	struct sock_fprog fprog
+	{
+	};
+
+	fprog.len    = static_cast<unsigned short>(Program.size());
+	fprog.filter = const_cast<struct sock_filter*>(Program.data());
+
+	if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &fprog, sizeof(fprog)) != 0)
+	{
+		return -errno;
+	}
+
+	return 0;
+}
+#endif
+
+static int attachUdpRejectFilter(uv_udp_t* uvHandle)
+{
+#ifdef __linux__
+	// Socket filter that drops every datagram.
+	static struct sock_filter Program[]{ BPF_STMT(BPF_RET | BPF_K, 0) };
+
+	uv_os_fd_t fd;
+	const int err = uv_fileno(reinterpret_cast<uv_handle_t*>(uvHandle), std::addressof(fd));
+
+	if (err != 0)
+	{
+		return err;
+	}
+
+	struct sock_fprog fprog
+	{
+	};
+
+	fprog.len    = 1;
+	fprog.filter = Program;
+
+	if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) != 0)
+	{
+		return -errno;
+	}
+
+	return 0;
+#else
+	return UV_ENOTSUP;
+#endif
+}
+
+static int enableUdpReusePort(uv_udp_t* uvHandle)
+
+{
+#ifdef __linux__
+	uv_os_fd_t fd;
+	int err = uv_fileno(reinterpret_cast<uv_handle_t*>(uvHandle), std::addressof(fd));
+
+	if (err != 0)
+	{
+		return err;
+	}
+
+	const int enable{ 1 };
+
+	if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0)
+	{
+		return -errno;
+	}
+
+	return 0;
+#else
+	return UV_ENOTSUP;
+#endif
+}
+
+/**
+ * Attaches the steering eBPF program to the given bound socket and makes it
+ * the socket of the given shard. If the program cannot be loaded (it requires
+ * CAP_BPF) or attached, the classic BPF one is attached instead.
+ */
+static int attachUdpShardingProgram(
+  uv_udp_t* uvHandle, const std::string& ip, uint16_t port, uint8_t shardIndex)
+{
+#ifdef __linux__
+	UdpShardingGroup group;
+	uv_os_fd_t fd;
+	int err = uv_fileno(reinterpret_cast<uv_handle_t*>(uvHandle), std::addressof(fd));
+
+	if (err != 0)
+	{
+		return err;
+	}
+
+	err = getUdpShardingGroup(ip, port, shardIndex, group);
+
+	if (err == 0)
+	{
+		err = attachUdpShardingEbpfProgram(fd, group, shardIndex);
+
+		if (err != 0)
+		{
+			releaseUdpShardingGroup(ip, port, shardIndex, /*stored*/ false);
+		}
+	}
+
+	if (err == 0)
+	{
+		return 0;
+	}
+
+	MS_WARN_TAG(
+	  info,
+	  "cannot use UDP sharding eBPF program, steering by SO_REUSEPORT group position [ip:'%s', port:%" PRIu16
+	  ", shardIndex:%" PRIu8 "]: %s",
+	  ip.c_str(),
+	  port,
+	  shardIndex,
+	  uv_strerror(err));
+
+	return attachUdpShardingFallbackProgram(fd);
+#else
+	return UV_ENOTSUP;
+#endif
+}
+
 namespace RTC
 {
 	/* Class variables. */
@@ -127,9 +1004,15 @@ namespace RTC
 		{
 			case Protocol::UDP:
 			{
+				// NOTE: If the socket joins a SO_REUSEPORT group, passing the family
+				// makes libuv create the socket now so the option can be set before
+				// binding.
+				const unsigned int initFlags =
+				  flags.udpShardingReusePort ? UV_UDP_RECVMMSG | family : UV_UDP_RECVMMSG;
+
 				uvHandle = reinterpret_cast<uv_handle_t*>(new uv_udp_t());
-				err      = uv_udp_init_ex(
-          DepLibUV::GetLoop(), reinterpret_cast<uv_udp_t*>(uvHandle), UV_UDP_RECVMMSG);
+				err =
+				  uv_udp_init_ex(DepLibUV::GetLoop(), reinterpret_cast<uv_udp_t*>(uvHandle), initFlags);
 
 				break;
 			}
@@ -171,6 +1054,46 @@ namespace RTC
 		{
 			case Protocol::UDP:
 			{
+				if (flags.udpShardingReusePort)
+				{
+					err = enableUdpReusePort(reinterpret_cast<uv_udp_t*>(uvHandle));
+
+					if (err != 0)
+					{
+						uv_close(
+						  reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onCloseUdp));
+
+						MS_THROW_ERROR(
+						  "setting SO_REUSEPORT failed [protocol:%s, ip:'%s', port:%" PRIu16 "]: %s",
+						  protocolStr.c_str(),
+						  ip.c_str(),
+						  port,
+						  uv_strerror(err));
+					}
+
+					// NOTE: A socket that joins the group without steering is going to be
+					// connected to a remote address. Until then the kernel may select it
+					// for datagrams of any remote address, so make it drop them.
+					// UdpSocketHandle::Connect() removes the filter.
+					if (!flags.udpShardingSteering)
+					{
+						err = attachUdpRejectFilter(reinterpret_cast<uv_udp_t*>(uvHandle));
+
+						if (err != 0)
+						{
+							uv_close(
+							  reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onCloseUdp));
+
+							MS_THROW_ERROR(
+							  "attaching socket filter failed [protocol:%s, ip:'%s', port:%" PRIu16 "]: %s",
+							  protocolStr.c_str(),
+							  ip.c_str(),
+							  port,
+							  uv_strerror(err));
+						}
+					}
+				}
+
 				err = uv_udp_bind(
 				  reinterpret_cast<uv_udp_t*>(uvHandle),
 				  reinterpret_cast<const struct sockaddr*>(&bindAddr),
@@ -189,6 +1112,26 @@ namespace RTC
 					  uv_strerror(err));
 				}
 
+				if (flags.udpShardingSteering)
+				{
+					err = attachUdpShardingProgram(
+					  reinterpret_cast<uv_udp_t*>(uvHandle), ip, port, flags.udpShardIndex);
+
+					// NOTE: The socket is still usable, but the kernel will select the
+					// shard of every packet by hash.
+					if (err != 0)
+					{
+						MS_WARN_TAG(
+						  info,
+						  "cannot attach SO_REUSEPORT steering program, steering by hash [protocol:%s, ip:'%s', port:%" PRIu16
+						  "]: %s",
+						  protocolStr.c_str(),
+						  ip.c_str(),
+						  port,
+						  uv_strerror(err));
+					}
+				}
+
 				break;
 			}
 
@@ -257,6 +1200,11 @@ namespace RTC
 			MS_THROW_TYPE_ERROR("maxPort cannot be less than minPort");
 		}
 
+		if (flags.udpShardingReusePort)
+		{
+			MS_THROW_TYPE_ERROR("UDP sharding requires a fixed port");
+		}
+
 		// First normalize the IP. This may throw if invalid IP.
 		Utils::IP::NormalizeIp(ip);
 
@@ -623,6 +1571,118 @@ namespace RTC
 		}
 	}
 
+	void PortManager::UnbindUdpShard(const std::string& ip, uint16_t port, uint8_t shardIndex)
+	{
+		MS_TRACE();
+
+#ifdef __linux__
+		releaseUdpShardingGroup(ip, port, shardIndex, /*stored*/ true);
+#endif
+	}
+
+	bool PortManager::AddUdpShardTuple(
+	  const std::string& ip, uint16_t port, uint8_t shardIndex, const struct sockaddr* remoteAddr)
+	{
+		MS_TRACE();
+
+#ifdef __linux__
+		UdpShardingTupleKey key;
+
+		if (!getUdpShardingTupleKey(remoteAddr, key))
+		{
+			return false;
+		}
+
+		const std::lock_guard<std::mutex> lock(UdpShardingGroupsMutex);
+
+		auto it = UdpShardingGroups.find(ip + "_" + std::to_string(port));
+
+		if (it == UdpShardingGroups.end() || !it->second.shards.test(shardIndex))
+		{
+			return false;
+		}
+
+		const uint32_t value{ shardIndex };
+		union bpf_attr attr
+		{
+		};
+
+		attr.map_fd = it->second.tuplesMapFd;
+		attr.key    = reinterpret_cast<uint64_t>(std::addressof(key));
+		attr.value  = reinterpret_cast<uint64_t>(std::addressof(value));
+		attr.flags  = BPF_ANY;
+
+		if (bpfSyscall(BPF_MAP_UPDATE_ELEM, attr) != 0)
+		{
+			MS_DEBUG_TAG(info, "cannot add tuple to UDP sharding map: %s", std::strerror(errno));
+
+			return false;
+		}
+
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void PortManager::RemoveUdpShardTuple(
+	  const std::string& ip, uint16_t port, uint8_t shardIndex, const struct sockaddr* remoteAddr)
+	{
+		MS_TRACE();
+
+#ifdef __linux__
+		UdpShardingTupleKey key;
+
+		if (!getUdpShardingTupleKey(remoteAddr, key))
+		{
+			return;
+		}
+
+		const std::lock_guard<std::mutex> lock(UdpShardingGroupsMutex);
+
+		auto it = UdpShardingGroups.find(ip + "_" + std::to_string(port));
+
+		if (it == UdpShardingGroups.end())
+		{
+			return;
+		}
+
+		uint32_t value{ 0 };
+		union bpf_attr attr
+		{
+		};
+
+		attr.map_fd = it->second.tuplesMapFd;
+		attr.key    = reinterpret_cast<uint64_t>(std::addressof(key));
+		attr.value  = reinterpret_cast<uint64_t>(std::addressof(value));
+
+		// NOTE: Other shard may have added the same remote address meanwhile.
+		if (bpfSyscall(BPF_MAP_LOOKUP_ELEM, attr) != 0 || value != shardIndex)
+		{
+			return;
+		}
+
+		attr        = {};
+		attr.map_fd = it->second.tuplesMapFd;
+		attr.key    = reinterpret_cast<uint64_t>(std::addressof(key));
+
+		bpfSyscall(BPF_MAP_DELETE_ELEM, attr);
+#endif
+	}
+
+	bool PortManager::HasUdpShardingProgram(const std::string& ip, uint16_t port)
+	{
+		MS_TRACE();
+
+#ifdef __linux__
+		const std::lock_guard<std::mutex> lock(UdpShardingGroupsMutex);
+
+		return UdpShardingGroups.find(ip + "_" + std::to_string(port)) != UdpShardingGroups.end();
+#else
+		return false;
+#endif
+	}
+
 	void PortManager::Dump()
 	{
 		MS_DUMP("<PortManager>");
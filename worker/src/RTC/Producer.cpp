@@ -197,6 +197,11 @@ namespace RTC
 			{
 				this->rtpHeaderExtensionIds.playoutDelay = exten.id;
 			}
+
+			if (this->rtpHeaderExtensionIds.dependencyDescriptor == 0u && exten.type == RTC::RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR)
+			{
+				this->rtpHeaderExtensionIds.dependencyDescriptor = exten.id;
+			}
 		}
 
 		// Set the RTCP report generation interval.
@@ -639,7 +644,8 @@ namespace RTC
 			MS_ABORT("found stream does not match received packet");
 		}
 
-		if (packet->IsKeyFrame())
+		// NOTE: Check the kind first so audio payloads are not parsed for nothing.
+		if (this->kind == RTC::Media::Kind::VIDEO && packet->IsKeyFrame())
 		{
 			MS_DEBUG_TAG(
 			  rtp,
@@ -919,7 +925,7 @@ namespace RTC
 		}
 
 		// If not found, look for an encoding matching the packet RID value.
-		std::string rid;
+		std::string_view rid;
 
 		if (packet->ReadRid(rid))
 		{
@@ -1196,6 +1202,7 @@ namespace RTC
 			// NOTE: Remove this once framemarking draft becomes RFC.
 			packet->SetFrameMarking07ExtensionId(this->rtpHeaderExtensionIds.frameMarking07);
 			packet->SetFrameMarkingExtensionId(this->rtpHeaderExtensionIds.frameMarking);
+			packet->SetDependencyDescriptorExtensionId(this->rtpHeaderExtensionIds.dependencyDescriptor);
 		}
 	}
 
@@ -1243,6 +1250,7 @@ namespace RTC
 			uint8_t* extenValue;
 			uint8_t extenLen;
 			uint8_t* bufferPtr{ buffer };
+			uint8_t extensionsType{ 1u };
 
 			// Add urn:ietf:params:rtp-hdrext:sdes:mid.
 			{
@@ -1390,13 +1398,37 @@ namespace RTC
 					extensions.emplace_back(
 					  static_cast<uint8_t>(RTC::RtpHeaderExtensionUri::Type::TOFFSET), extenLen, bufferPtr);
 
+					bufferPtr += extenLen;
+				}
+
+				// Proxy AV1 Dependency Descriptor (https://aomediacodec.github.io/av1-rtp-spec/).
+				extenValue =
+				  packet->GetExtension(this->rtpHeaderExtensionIds.dependencyDescriptor, extenLen);
+
+				if (extenValue)
+				{
+					std::memcpy(bufferPtr, extenValue, extenLen);
+
+					extensions.emplace_back(
+					  static_cast<uint8_t>(RTC::RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR),
+					  extenLen,
+					  bufferPtr);
+
+					// NOTE: One-Byte extension values cannot be longer than 16 bytes and the
+					// Dependency Descriptor carrying the template structure usually is.
+					if (extenLen > 16u)
+					{
+						extensionsType = 2u;
+					}
+
 					// Not needed since this is the latest added extension.
 					// bufferPtr += extenLen;
 				}
 			}
 
-			// Set the new extensions into the packet using One-Byte format.
-			packet->SetExtensions(1, extensions);
+			// Set the new extensions into the packet using One-Byte format (unless
+			// some value doesn't fit into it).
+			packet->SetExtensions(extensionsType, extensions);
 
 			// Assign mediasoup RTP header extension ids (just those that mediasoup may
 			// be interested in after passing it to the Router).
@@ -1416,6 +1448,8 @@ namespace RTC
 			  static_cast<uint8_t>(RTC::RtpHeaderExtensionUri::Type::VIDEO_ORIENTATION));
 			packet->SetPlayoutDelayExtensionId(
 			  static_cast<uint8_t>(RTC::RtpHeaderExtensionUri::Type::PLAYOUT_DELAY));
+			packet->SetDependencyDescriptorExtensionId(
+			  static_cast<uint8_t>(RTC::RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR));
 		}
 
 		return true;
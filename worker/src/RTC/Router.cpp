@@ -5,6 +5,9 @@
 #ifdef MS_LIBURING_SUPPORTED
 #include "DepLibUring.hpp"
 #endif
+#ifdef MS_SENDMMSG_SUPPORTED
+#include "handles/UdpSocketHandle.hpp"
+#endif
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "RTC/ActiveSpeakerObserver.hpp"
@@ -662,7 +665,7 @@ namespace RTC
 			// Cloned ref-counted packet that RtpStreamSend will store for as long as
 			// needed avoiding multiple allocations unless absolutely necessary.
 			// Clone only happens if needed.
-			std::shared_ptr<RTC::RtpPacket> sharedPacket;
+			RTC::SharedRtpPacket sharedPacket;
 
 #ifdef MS_LIBURING_SUPPORTED
 			if (DepLibUring::IsEnabled())
@@ -672,19 +675,23 @@ namespace RTC
 			}
 #endif
 
+#ifdef MS_SENDMMSG_SUPPORTED
+			// Queue UDP datagrams to send them in a single sendmmsg() call.
+			UdpSocketHandle::StartSendBatch();
+#endif
+
+			// NOTE: The MID RTP extension value of each Consumer is written by its
+			// Transport when sending the packet.
 			for (auto* consumer : consumers)
 			{
-				// Update MID RTP extension value.
-				const auto& mid = consumer->GetRtpParameters().mid;
-
-				if (!mid.empty())
-				{
-					packet->UpdateMid(mid);
-				}
-
 				consumer->SendRtpPacket(packet, sharedPacket);
 			}
 
+#ifdef MS_SENDMMSG_SUPPORTED
+			// Send all queued UDP datagrams.
+			UdpSocketHandle::FlushSendBatch();
+#endif
+
 #ifdef MS_LIBURING_SUPPORTED
 			if (DepLibUring::IsEnabled())
 			{
@@ -940,11 +947,21 @@ namespace RTC
 			}
 #endif
 
+#ifdef MS_SENDMMSG_SUPPORTED
+			// Queue UDP datagrams to send them in a single sendmmsg() call.
+			UdpSocketHandle::StartSendBatch();
+#endif
+
 			for (auto* dataConsumer : dataConsumers)
 			{
 				dataConsumer->SendMessage(msg, len, ppid, subchannels, requiredSubchannel);
 			}
 
+#ifdef MS_SENDMMSG_SUPPORTED
+			// Send all queued UDP datagrams.
+			UdpSocketHandle::FlushSendBatch();
+#endif
+
 #ifdef MS_LIBURING_SUPPORTED
 			if (DepLibUring::IsEnabled())
 			{
@@ -39,6 +39,7 @@ namespace RTC
 		{ "h264-svc",        RtpCodecMimeType::Subtype::H264_SVC        },
 		{ "x-h264uc",        RtpCodecMimeType::Subtype::X_H264UC        },
 		{ "h265",            RtpCodecMimeType::Subtype::H265            },
+		{ "av1",             RtpCodecMimeType::Subtype::AV1             },
 		// Complementary codecs:
 		{ "cn",              RtpCodecMimeType::Subtype::CN              },
 		{ "telephone-event", RtpCodecMimeType::Subtype::TELEPHONE_EVENT },
@@ -67,6 +68,7 @@ namespace RTC
 		{ RtpCodecMimeType::Subtype::H264_SVC,        "H264-SVC"        },
 		{ RtpCodecMimeType::Subtype::X_H264UC,        "X-H264UC"        },
 		{ RtpCodecMimeType::Subtype::H265,            "H265"            },
+		{ RtpCodecMimeType::Subtype::AV1,             "AV1"             },
 		// Complementary codecs:
 		{ RtpCodecMimeType::Subtype::CN,              "CN"              },
 		{ RtpCodecMimeType::Subtype::TELEPHONE_EVENT, "telephone-event" },
@@ -5,6 +5,7 @@
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "RTC/Producer.hpp"
+#include <string_view>
 
 namespace RTC
 {
@@ -146,49 +147,23 @@ namespace RTC
 		MS_TRACE();
 
 		// Remove from the listener tables all entries pointing to the Producer.
-
-		for (auto it = this->ssrcTable.begin(); it != this->ssrcTable.end();)
+		auto pointsToProducer = [producer](const auto& kv)
 		{
-			if (it->second == producer)
-			{
-				it = this->ssrcTable.erase(it);
-			}
-			else
-			{
-				++it;
-			}
-		}
-
-		for (auto it = this->midTable.begin(); it != this->midTable.end();)
-		{
-			if (it->second == producer)
-			{
-				it = this->midTable.erase(it);
-			}
-			else
-			{
-				++it;
-			}
-		}
+			return kv.second == producer;
+		};
 
-		for (auto it = this->ridTable.begin(); it != this->ridTable.end();)
-		{
-			if (it->second == producer)
-			{
-				it = this->ridTable.erase(it);
-			}
-			else
-			{
-				++it;
-			}
-		}
+		absl::erase_if(this->ssrcTable, pointsToProducer);
+		absl::erase_if(this->midTable, pointsToProducer);
+		absl::erase_if(this->ridTable, pointsToProducer);
 	}
 
 	RTC::Producer* RtpListener::GetProducer(const RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
 
-		// First lookup into the SSRC table.
+		// First lookup into the SSRC table. Once a MID or RID has been matched,
+		// its SSRC is learnt here so following packets of the same stream don't
+		// need to parse header extensions at all.
 		{
 			auto it = this->ssrcTable.find(packet->GetSsrc());
 
@@ -202,7 +177,7 @@ namespace RTC
 
 		// Otherwise lookup into the MID table.
 		{
-			std::string mid;
+			std::string_view mid;
 
 			if (packet->ReadMid(mid))
 			{
@@ -214,7 +189,7 @@ namespace RTC
 
 					// Fill the ssrc table.
 					// NOTE: We may be overriding an exiting SSRC here, but we don't care.
-					this->ssrcTable[packet->GetSsrc()] = producer;
+					this->ssrcTable.insert_or_assign(packet->GetSsrc(), producer);
 
 					return producer;
 				}
@@ -223,7 +198,7 @@ namespace RTC
 
 		// Otherwise lookup into the RID table.
 		{
-			std::string rid;
+			std::string_view rid;
 
 			if (packet->ReadRid(rid))
 			{
@@ -235,7 +210,7 @@ namespace RTC
 
 					// Fill the ssrc table.
 					// NOTE: We may be overriding an exiting SSRC here, but we don't care.
-					this->ssrcTable[packet->GetSsrc()] = producer;
+					this->ssrcTable.insert_or_assign(packet->GetSsrc(), producer);
 
 					return producer;
 				}
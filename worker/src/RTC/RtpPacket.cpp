@@ -4,6 +4,7 @@
 #include "RTC/RtpPacket.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "RTC/RtpPacketBufferPool.hpp"
 #include <cstring>  // std::memcpy(), std::memmove(), std::memset()
 #include <iterator> // std::ostream_iterator
 #include <sstream>  // std::ostringstream
@@ -160,7 +161,12 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		delete[] this->buffer;
+		ResetPayloadDescriptorHandler();
+
+		if (this->buffer)
+		{
+			RTC::RtpPacketBufferPool::Release(this->buffer);
+		}
 	}
 
 	void RtpPacket::Dump() const
@@ -314,6 +320,19 @@ namespace RTC
 				  maxDelay);
 			}
 		}
+		if (this->dependencyDescriptorExtensionId != 0u)
+		{
+			const uint8_t* data;
+			uint8_t len;
+
+			if (ReadDependencyDescriptor(&data, len))
+			{
+				MS_DUMP(
+				  "  dependencyDescriptor: extId:%" PRIu8 ", length:%" PRIu8,
+				  this->dependencyDescriptorExtensionId,
+				  len);
+			}
+		}
 		MS_DUMP("  csrc count: %" PRIu8, this->header->csrcCount);
 		MS_DUMP("  marker: %s", HasMarker() ? "true" : "false");
 		MS_DUMP("  payload type: %" PRIu8, GetPayloadType());
@@ -392,16 +411,17 @@ namespace RTC
 		MS_ASSERT(type == 1u || type == 2u, "type must be 1 or 2");
 
 		// Reset extension ids.
-		this->midExtensionId               = 0u;
-		this->ridExtensionId               = 0u;
-		this->rridExtensionId              = 0u;
-		this->absSendTimeExtensionId       = 0u;
-		this->transportWideCc01ExtensionId = 0u;
-		this->frameMarking07ExtensionId    = 0u;
-		this->frameMarkingExtensionId      = 0u;
-		this->ssrcAudioLevelExtensionId    = 0u;
-		this->videoOrientationExtensionId  = 0u;
-		this->playoutDelayExtensionId      = 0u;
+		this->midExtensionId                  = 0u;
+		this->ridExtensionId                  = 0u;
+		this->rridExtensionId                 = 0u;
+		this->absSendTimeExtensionId          = 0u;
+		this->transportWideCc01ExtensionId    = 0u;
+		this->frameMarking07ExtensionId       = 0u;
+		this->frameMarkingExtensionId         = 0u;
+		this->ssrcAudioLevelExtensionId       = 0u;
+		this->videoOrientationExtensionId     = 0u;
+		this->playoutDelayExtensionId         = 0u;
+		this->dependencyDescriptorExtensionId = 0u;
 
 		// Clear the One-Byte and Two-Bytes extension elements maps.
 		std::fill(std::begin(this->oneByteExtensions), std::end(this->oneByteExtensions), nullptr);
@@ -597,6 +617,71 @@ namespace RTC
 		SetExtensionLength(this->midExtensionId, midLen);
 	}
 
+	/**
+	 * Copies the header into the given buffer (which must have room for
+	 * GetHeaderLength() bytes) and writes the given MID into the MID extension
+	 * of the copy, if any. The packet itself is not modified. Returns the number
+	 * of bytes written.
+	 */
+	size_t RtpPacket::CopyHeader(uint8_t* buffer, const std::string& mid) const
+	{
+		MS_TRACE();
+
+		const size_t headerLength = GetHeaderLength();
+
+		std::memcpy(buffer, this->header, headerLength);
+
+		if (mid.empty())
+		{
+			return headerLength;
+		}
+
+		uint8_t extenLen;
+		uint8_t* extenValue = GetExtension(this->midExtensionId, extenLen);
+
+		if (!extenValue)
+		{
+			return headerLength;
+		}
+
+		const size_t midLen = mid.length();
+
+		// Here we assume that there is MidMaxLength available bytes, even if now
+		// they are padding bytes.
+		if (midLen > RTC::MidMaxLength)
+		{
+			MS_ERROR(
+			  "no enough space for MID value [MidMaxLength:%" PRIu8 ", mid:'%s']",
+			  RTC::MidMaxLength,
+			  mid.c_str());
+
+			return headerLength;
+		}
+
+		uint8_t* midValue = buffer + (extenValue - reinterpret_cast<const uint8_t*>(this->header));
+
+		std::memcpy(midValue, mid.c_str(), midLen);
+
+		// Fill with 0's if new length is minor.
+		if (midLen < extenLen)
+		{
+			std::memset(midValue + midLen, 0, extenLen - midLen);
+		}
+
+		// Update the extension length, which is right before its value.
+		if (HasOneByteExtensions())
+		{
+			// In One-Byte extensions value length 0 means 1.
+			midValue[-1] = static_cast<uint8_t>((this->midExtensionId << 4) | (midLen - 1));
+		}
+		else
+		{
+			midValue[-1] = static_cast<uint8_t>(midLen);
+		}
+
+		return headerLength;
+	}
+
 	/**
 	 * The caller is responsible of not setting a length higher than the
 	 * available one (taking into account existing padding bytes).
@@ -692,7 +777,19 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		auto* buffer = new uint8_t[MtuSize + 100];
+		if (this->size > RTC::RtpPacketBufferPool::BufferSize)
+		{
+			MS_WARN_TAG(
+			  rtp,
+			  "packet too big to be cloned [ssrc:%" PRIu32 ", seq:%" PRIu16 ", size:%zu]",
+			  GetSsrc(),
+			  GetSequenceNumber(),
+			  this->size);
+
+			return nullptr;
+		}
+
+		auto* buffer = RTC::RtpPacketBufferPool::Get();
 		auto* ptr    = const_cast<uint8_t*>(buffer);
 
 		size_t numBytes{ 0 };
@@ -754,18 +851,26 @@ namespace RTC
 		  newHeader, newHeaderExtension, newPayload, this->payloadLength, this->payloadPadding, this->size);
 
 		// Keep already set extension ids.
-		packet->midExtensionId               = this->midExtensionId;
-		packet->ridExtensionId               = this->ridExtensionId;
-		packet->rridExtensionId              = this->rridExtensionId;
-		packet->absSendTimeExtensionId       = this->absSendTimeExtensionId;
-		packet->transportWideCc01ExtensionId = this->transportWideCc01ExtensionId;
-		packet->frameMarking07ExtensionId    = this->frameMarking07ExtensionId; // Remove once RFC.
-		packet->frameMarkingExtensionId      = this->frameMarkingExtensionId;
-		packet->ssrcAudioLevelExtensionId    = this->ssrcAudioLevelExtensionId;
-		packet->videoOrientationExtensionId  = this->videoOrientationExtensionId;
-		packet->playoutDelayExtensionId      = this->playoutDelayExtensionId;
-		// Assign the payload descriptor handler.
-		packet->payloadDescriptorHandler = this->payloadDescriptorHandler;
+		packet->midExtensionId                  = this->midExtensionId;
+		packet->ridExtensionId                  = this->ridExtensionId;
+		packet->rridExtensionId                 = this->rridExtensionId;
+		packet->absSendTimeExtensionId          = this->absSendTimeExtensionId;
+		packet->transportWideCc01ExtensionId    = this->transportWideCc01ExtensionId;
+		packet->frameMarking07ExtensionId       = this->frameMarking07ExtensionId; // Remove once RFC.
+		packet->frameMarkingExtensionId         = this->frameMarkingExtensionId;
+		packet->ssrcAudioLevelExtensionId       = this->ssrcAudioLevelExtensionId;
+		packet->videoOrientationExtensionId     = this->videoOrientationExtensionId;
+		packet->playoutDelayExtensionId         = this->playoutDelayExtensionId;
+		packet->dependencyDescriptorExtensionId = this->dependencyDescriptorExtensionId;
+		// Copy the payload descriptor handler (or its pending parser).
+		packet->payloadDescriptorParser = this->payloadDescriptorParser;
+
+		if (this->payloadDescriptorHandler)
+		{
+			packet->payloadDescriptorHandler = this->payloadDescriptorHandlerCopier(
+			  this->payloadDescriptorHandler, packet->payloadDescriptorHandlerStorage);
+			packet->payloadDescriptorHandlerCopier = this->payloadDescriptorHandlerCopier;
+		}
 		// Store allocated buffer.
 		packet->buffer = buffer;
 
@@ -859,6 +964,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		MayParsePayloadDescriptor();
+
 		if (!this->payloadDescriptorHandler)
 		{
 			return true;
@@ -871,6 +978,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		MayParsePayloadDescriptor();
+
 		if (!this->payloadDescriptorHandler)
 		{
 			return;
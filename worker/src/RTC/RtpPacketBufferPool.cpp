@@ -0,0 +1,82 @@
+#define MS_CLASS "RTC::RtpPacketBufferPool"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/RtpPacketBufferPool.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Class variables. */
+
+	thread_local std::vector<std::unique_ptr<uint8_t[]>> RtpPacketBufferPool::slabs;
+	thread_local std::vector<uint8_t*> RtpPacketBufferPool::freeBuffers;
+	thread_local size_t RtpPacketBufferPool::inUse{ 0u };
+	thread_local size_t RtpPacketBufferPool::highWaterMark{ 0u };
+
+	/* Class methods. */
+
+	uint8_t* RtpPacketBufferPool::Get()
+	{
+		MS_TRACE();
+
+		if (RtpPacketBufferPool::freeBuffers.empty())
+		{
+			AllocateSlab();
+		}
+
+		auto* buffer = RtpPacketBufferPool::freeBuffers.back();
+
+		RtpPacketBufferPool::freeBuffers.pop_back();
+
+		if (++RtpPacketBufferPool::inUse > RtpPacketBufferPool::highWaterMark)
+		{
+			RtpPacketBufferPool::highWaterMark = RtpPacketBufferPool::inUse;
+		}
+
+		return buffer;
+	}
+
+	void RtpPacketBufferPool::Release(uint8_t* buffer)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(RtpPacketBufferPool::inUse > 0u, "no buffer in use");
+
+		RtpPacketBufferPool::freeBuffers.push_back(buffer);
+
+		--RtpPacketBufferPool::inUse;
+	}
+
+	flatbuffers::Offset<FBS::Worker::RtpPacketBufferPoolDump> RtpPacketBufferPool::FillBuffer(
+	  flatbuffers::FlatBufferBuilder& builder)
+	{
+		MS_TRACE();
+
+		return FBS::Worker::CreateRtpPacketBufferPoolDump(
+		  builder,
+		  // capacity.
+		  RtpPacketBufferPool::GetCapacity(),
+		  // inUse.
+		  RtpPacketBufferPool::inUse,
+		  // highWaterMark.
+		  RtpPacketBufferPool::highWaterMark);
+	}
+
+	void RtpPacketBufferPool::AllocateSlab()
+	{
+		MS_TRACE();
+
+		auto* slab = new uint8_t[RtpPacketBufferPool::SlabSize * RtpPacketBufferPool::BufferSize];
+
+		RtpPacketBufferPool::slabs.emplace_back(slab);
+		RtpPacketBufferPool::freeBuffers.reserve(RtpPacketBufferPool::GetCapacity());
+
+		// Push them in reverse order so buffers are taken in memory order.
+		for (size_t i{ RtpPacketBufferPool::SlabSize }; i > 0u; --i)
+		{
+			RtpPacketBufferPool::freeBuffers.push_back(slab + ((i - 1) * RtpPacketBufferPool::BufferSize));
+		}
+
+		MS_DEBUG_DEV("new slab allocated [capacity:%zu]", RtpPacketBufferPool::GetCapacity());
+	}
+} // namespace RTC
@@ -7,35 +7,37 @@
 
 namespace RTC
 {
+	/* Static. */
+
+	static constexpr size_t InitialCapacity{ 64u };
+
 	/* Class methods. */
 
-	RtpRetransmissionBuffer::Item* RtpRetransmissionBuffer::FillItem(
-	  RtpRetransmissionBuffer::Item* item,
-	  RTC::RtpPacket* packet,
-	  std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void RtpRetransmissionBuffer::FillItem(
+	  RtpRetransmissionBuffer::Item& item, RTC::RtpPacket* packet, RTC::SharedRtpPacket& sharedPacket)
 	{
 		MS_TRACE();
 
 		// Store original packet into the item. Only clone once and only if
 		// necessary.
 		//
-		// NOTE: This must be done BEFORE assigning item->packet = sharedPacket,
-		// otherwise the value being copied in item->packet will remain nullptr.
-		// This is because we are copying an **empty** shared_ptr into another
-		// shared_ptr (item->packet), so future value assigned via reset() in the
-		// former doesn't update the value in the copy.
+		// NOTE: This must be done BEFORE assigning item.packet = sharedPacket,
+		// otherwise the value being copied in item.packet will remain nullptr.
+		// This is because we are copying an **empty** SharedRtpPacket into another
+		// SharedRtpPacket (item.packet), so future value assigned via Reset() in
+		// the former doesn't update the value in the copy.
 		if (!sharedPacket)
 		{
-			sharedPacket.reset(packet->Clone());
+			sharedPacket.Reset(packet->Clone());
 		}
 
 		// Store original packet and some extra info into the item.
-		item->packet         = sharedPacket;
-		item->ssrc           = packet->GetSsrc();
-		item->sequenceNumber = packet->GetSequenceNumber();
-		item->timestamp      = packet->GetTimestamp();
-
-		return item;
+		item.packet         = sharedPacket;
+		item.ssrc           = packet->GetSsrc();
+		item.sequenceNumber = packet->GetSequenceNumber();
+		item.timestamp      = packet->GetTimestamp();
+		item.resentAtMs     = 0u;
+		item.sentTimes      = 0u;
 	}
 
 	/* Instance methods. */
@@ -47,6 +49,14 @@ namespace RTC
 		MS_TRACE();
 
 		MS_ASSERT(maxItems > 0u, "maxItems must be greater than 0");
+
+		// Ring capacity is the lowest power of two holding maxItems.
+		this->maxCapacity = 1u;
+
+		while (this->maxCapacity < maxItems)
+		{
+			this->maxCapacity <<= 1;
+		}
 	}
 
 	RtpRetransmissionBuffer::~RtpRetransmissionBuffer()
@@ -56,30 +66,36 @@ namespace RTC
 		Clear();
 	}
 
-	RtpRetransmissionBuffer::Item* RtpRetransmissionBuffer::Get(uint16_t seq) const
+	RtpRetransmissionBuffer::Item* RtpRetransmissionBuffer::Get(uint16_t seq)
 	{
 		MS_TRACE();
 
-		const auto* oldestItem = GetOldest();
+		if (this->size == 0u)
+		{
+			return nullptr;
+		}
 
-		if (!oldestItem)
+		if (RTC::SeqManager<uint16_t>::IsSeqLowerThan(seq, this->startSeq))
 		{
 			return nullptr;
 		}
 
-		if (RTC::SeqManager<uint16_t>::IsSeqLowerThan(seq, oldestItem->sequenceNumber))
+		const uint16_t idx = seq - this->startSeq;
+
+		if (static_cast<size_t>(idx) > this->size - 1)
 		{
 			return nullptr;
 		}
 
-		const uint16_t idx = seq - oldestItem->sequenceNumber;
+		auto& item = GetSlot(seq);
 
-		if (static_cast<size_t>(idx) > this->buffer.size() - 1)
+		// Blank slot.
+		if (!item.packet)
 		{
 			return nullptr;
 		}
 
-		return this->buffer.at(idx);
+		return std::addressof(item);
 	}
 
 	/**
@@ -90,7 +106,7 @@ namespace RTC
 	 * ordered by increasing seq but also that their timestamp are incremental).
 	 */
 	void RtpRetransmissionBuffer::Insert(
-	  RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	  RTC::RtpPacket* packet, RTC::SharedRtpPacket& sharedPacket)
 	{
 		MS_TRACE();
 
@@ -101,13 +117,11 @@ namespace RTC
 		MS_DEBUG_DEV("packet [seq:%" PRIu16 ", timestamp:%" PRIu32 "]", seq, timestamp);
 
 		// Buffer is empty, so just insert new item.
-		if (this->buffer.empty())
+		if (this->size == 0u)
 		{
 			MS_DEBUG_DEV("buffer empty [seq:%" PRIu16 ", timestamp:%" PRIu32 "]", seq, timestamp);
 
-			auto* item = new Item();
-
-			this->buffer.push_back(RtpRetransmissionBuffer::FillItem(item, packet, sharedPacket));
+			RtpRetransmissionBuffer::FillItem(EmplaceNewest(seq), packet, sharedPacket);
 
 			return;
 		}
@@ -131,9 +145,7 @@ namespace RTC
 
 			Clear();
 
-			auto* item = new Item();
-
-			this->buffer.push_back(RtpRetransmissionBuffer::FillItem(item, packet, sharedPacket));
+			RtpRetransmissionBuffer::FillItem(EmplaceNewest(seq), packet, sharedPacket);
 
 			return;
 		}
@@ -153,7 +165,7 @@ namespace RTC
 		if (ClearTooOldByTimestamp(newestTimestamp))
 		{
 			// Buffer content has been modified so we must check it again.
-			if (this->buffer.empty())
+			if (this->size == 0u)
 			{
 				MS_WARN_TAG(
 				  rtp,
@@ -161,9 +173,7 @@ namespace RTC
 				  seq,
 				  timestamp);
 
-				auto* item = new Item();
-
-				this->buffer.push_back(RtpRetransmissionBuffer::FillItem(item, packet, sharedPacket));
+				RtpRetransmissionBuffer::FillItem(EmplaceNewest(seq), packet, sharedPacket);
 
 				return;
 			}
@@ -198,17 +208,17 @@ namespace RTC
 
 			// Calculate how many blank slots it would be necessary to add when
 			// pushing new item to the back of the buffer.
-			uint16_t numBlankSlots = seq - newestItem->sequenceNumber - 1;
+			const uint16_t numBlankSlots = seq - newestItem->sequenceNumber - 1;
 
 			// We may have to remove oldest items not to exceed the maximum size of
 			// the buffer.
-			if (this->buffer.size() + numBlankSlots + 1 > this->maxItems)
+			if (this->size + numBlankSlots + 1 > this->maxItems)
 			{
-				const uint16_t numItemsToRemove = this->buffer.size() + numBlankSlots + 1 - this->maxItems;
+				const uint16_t numItemsToRemove = this->size + numBlankSlots + 1 - this->maxItems;
 
 				// If num of items to be removed exceed buffer size minus one (needed to
 				// allocate current packet) then we must clear the entire buffer.
-				if (numItemsToRemove > this->buffer.size() - 1)
+				if (numItemsToRemove > this->size - 1)
 				{
 					MS_WARN_TAG(
 					  rtp,
@@ -218,8 +228,6 @@ namespace RTC
 					  seq,
 					  timestamp);
 
-					numBlankSlots = 0u;
-
 					Clear();
 				}
 				else
@@ -228,7 +236,7 @@ namespace RTC
 					  "calling RemoveOldest(%" PRIu16 ") [bufferSize:%zu, numBlankSlots:%" PRIu16
 					  ", maxItems:%" PRIu16 "]",
 					  numItemsToRemove,
-					  this->buffer.size(),
+					  this->size,
 					  numBlankSlots,
 					  this->maxItems);
 
@@ -236,16 +244,9 @@ namespace RTC
 				}
 			}
 
-			// Push blank slots to the back.
-			for (uint16_t i{ 0u }; i < numBlankSlots; ++i)
-			{
-				this->buffer.push_back(nullptr);
-			}
-
-			// Push the packet, which becomes the newest one in the buffer.
-			auto* item = new Item();
-
-			this->buffer.push_back(RtpRetransmissionBuffer::FillItem(item, packet, sharedPacket));
+			// Push the packet (preceded by blank slots if needed), which becomes the
+			// newest one in the buffer.
+			RtpRetransmissionBuffer::FillItem(EmplaceNewest(seq), packet, sharedPacket);
 		}
 		// Packet arrived out order and its seq is less than seq of the oldest
 		// stored packet, so will become the oldest one in the buffer.
@@ -289,7 +290,7 @@ namespace RTC
 
 			// If adding this packet (and needed blank slots) to the front makes the
 			// buffer exceed its max size, discard this packet.
-			if (this->buffer.size() + numBlankSlots + 1 > this->maxItems)
+			if (this->size + numBlankSlots + 1 > this->maxItems)
 			{
 				MS_WARN_TAG(
 				  rtp,
@@ -302,16 +303,9 @@ namespace RTC
 				return;
 			}
 
-			// Push blank slots to the front.
-			for (uint16_t i{ 0u }; i < numBlankSlots; ++i)
-			{
-				this->buffer.push_front(nullptr);
-			}
-
-			// Insert the packet, which becomes the oldest one in the buffer.
-			auto* item = new Item();
-
-			this->buffer.push_front(RtpRetransmissionBuffer::FillItem(item, packet, sharedPacket));
+			// Insert the packet (followed by blank slots if needed), which becomes
+			// the oldest one in the buffer.
+			RtpRetransmissionBuffer::FillItem(EmplaceOldest(seq), packet, sharedPacket);
 		}
 		// Otherwise packet must be inserted between oldest and newest stored items
 		// so there is already an allocated slot for it.
@@ -338,22 +332,22 @@ namespace RTC
 			}
 
 			// idx is the intended position of the received packet in the buffer.
-			const uint16_t idx = seq - oldestItem->sequenceNumber;
+			const uint16_t idx = seq - this->startSeq;
 
 			// Validate that packet timestamp is equal or higher than the timestamp of
 			// the immediate older packet (if any).
 			for (int32_t idx2 = idx - 1; idx2 >= 0; --idx2)
 			{
-				const auto* olderItem = this->buffer.at(idx2);
+				const auto& olderItem = GetSlot(this->startSeq + idx2);
 
 				// Blank slot, continue.
-				if (!olderItem)
+				if (!olderItem.packet)
 				{
 					continue;
 				}
 
 				// We are done.
-				if (timestamp >= olderItem->timestamp)
+				if (timestamp >= olderItem.timestamp)
 				{
 					break;
 				}
@@ -373,18 +367,18 @@ namespace RTC
 
 			// Validate that packet timestamp is equal or less than the timestamp of
 			// the immediate newer packet (if any).
-			for (size_t idx2 = idx + 1; idx2 < this->buffer.size(); ++idx2)
+			for (size_t idx2 = idx + 1; idx2 < this->size; ++idx2)
 			{
-				const auto* newerItem = this->buffer.at(idx2);
+				const auto& newerItem = GetSlot(this->startSeq + idx2);
 
 				// Blank slot, continue.
-				if (!newerItem)
+				if (!newerItem.packet)
 				{
 					continue;
 				}
 
 				// We are done.
-				if (timestamp <= newerItem->timestamp)
+				if (timestamp <= newerItem.timestamp)
 				{
 					break;
 				}
@@ -403,15 +397,13 @@ namespace RTC
 			}
 
 			// Store the packet.
-			item = new Item();
-
-			this->buffer[idx] = RtpRetransmissionBuffer::FillItem(item, packet, sharedPacket);
+			RtpRetransmissionBuffer::FillItem(GetSlot(seq), packet, sharedPacket);
 		}
 
 		MS_ASSERT(
-		  this->buffer.size() <= this->maxItems,
+		  this->size <= this->maxItems,
 		  "buffer contains %zu items (more than %" PRIu16 " max items)",
-		  this->buffer.size(),
+		  this->size,
 		  this->maxItems);
 	}
 
@@ -419,20 +411,13 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		for (auto* item : this->buffer)
+		// NOTE: Resetting items decreases their RTP packet reference counter.
+		for (size_t idx{ 0u }; idx < this->size; ++idx)
 		{
-			if (!item)
-			{
-				continue;
-			}
-
-			// Reset the stored item (decrease RTP packet shared pointer counter).
-			item->Reset();
-
-			delete item;
+			GetSlot(this->startSeq + idx).Reset();
 		}
 
-		this->buffer.clear();
+		this->size = 0u;
 	}
 
 	void RtpRetransmissionBuffer::Dump() const
@@ -440,8 +425,12 @@ namespace RTC
 		MS_TRACE();
 
 		MS_DUMP("<RtpRetransmissionBuffer>");
-		MS_DUMP("  buffer [size:%zu, maxSize:%" PRIu16 "]", this->buffer.size(), this->maxItems);
-		if (!this->buffer.empty())
+		MS_DUMP(
+		  "  buffer [size:%zu, capacity:%zu, maxSize:%" PRIu16 "]",
+		  this->size,
+		  this->slots.size(),
+		  this->maxItems);
+		if (this->size != 0u)
 		{
 			const auto* oldestItem = GetOldest();
 			const auto* newestItem = GetNewest();
@@ -462,57 +451,142 @@ namespace RTC
 		MS_DUMP("</RtpRetransmissionBuffer>");
 	}
 
-	RtpRetransmissionBuffer::Item* RtpRetransmissionBuffer::GetOldest() const
+	/**
+	 * Makes room for given seq at the back of the buffer (by adding blank slots
+	 * in between if needed) and returns its slot. Given seq must be higher than
+	 * the newest seq in the buffer.
+	 */
+	RtpRetransmissionBuffer::Item& RtpRetransmissionBuffer::EmplaceNewest(uint16_t seq)
 	{
 		MS_TRACE();
 
-		if (this->buffer.empty())
+		if (this->size == 0u)
+		{
+			EnsureCapacity(1u);
+
+			this->startSeq = seq;
+			this->size     = 1u;
+
+			return GetSlot(seq);
+		}
+
+		const uint16_t newestSeq   = this->startSeq + this->size - 1;
+		const size_t numNewSlots = static_cast<uint16_t>(seq - newestSeq);
+
+		EnsureCapacity(this->size + numNewSlots);
+
+		this->size += numNewSlots;
+
+		return GetSlot(seq);
+	}
+
+	/**
+	 * Makes room for given seq at the front of the buffer (by adding blank slots
+	 * in between if needed) and returns its slot. Given seq must be lower than
+	 * the oldest seq in the buffer.
+	 */
+	RtpRetransmissionBuffer::Item& RtpRetransmissionBuffer::EmplaceOldest(uint16_t seq)
+	{
+		MS_TRACE();
+
+		const size_t numNewSlots = static_cast<uint16_t>(this->startSeq - seq);
+
+		EnsureCapacity(this->size + numNewSlots);
+
+		this->startSeq = seq;
+		this->size += numNewSlots;
+
+		return GetSlot(seq);
+	}
+
+	void RtpRetransmissionBuffer::EnsureCapacity(size_t numItems)
+	{
+		MS_TRACE();
+
+		if (numItems <= this->slots.size())
+		{
+			return;
+		}
+
+		MS_ASSERT(
+		  numItems <= this->maxCapacity,
+		  "cannot hold more than %zu items [numItems:%zu]",
+		  this->maxCapacity,
+		  numItems);
+
+		size_t capacity = this->slots.empty() ? std::min(InitialCapacity, this->maxCapacity)
+		                                      : this->slots.size();
+
+		while (capacity < numItems)
+		{
+			capacity <<= 1;
+		}
+
+		MS_DEBUG_DEV("growing buffer [capacity:%zu, newCapacity:%zu]", this->slots.size(), capacity);
+
+		std::vector<Item> slots(capacity);
+		const size_t mask = capacity - 1;
+
+		// Move current items to their position in the new ring.
+		for (size_t idx{ 0u }; idx < this->size; ++idx)
+		{
+			const uint16_t seq = this->startSeq + idx;
+
+			slots[seq & mask] = std::move(GetSlot(seq));
+		}
+
+		this->slots = std::move(slots);
+		this->mask  = mask;
+	}
+
+	const RtpRetransmissionBuffer::Item* RtpRetransmissionBuffer::GetOldest() const
+	{
+		MS_TRACE();
+
+		if (this->size == 0u)
 		{
 			return nullptr;
 		}
 
-		return this->buffer.front();
+		return std::addressof(GetSlot(this->startSeq));
 	}
 
-	RtpRetransmissionBuffer::Item* RtpRetransmissionBuffer::GetNewest() const
+	const RtpRetransmissionBuffer::Item* RtpRetransmissionBuffer::GetNewest() const
 	{
 		MS_TRACE();
 
-		if (this->buffer.empty())
+		if (this->size == 0u)
 		{
 			return nullptr;
 		}
 
-		return this->buffer.back();
+		return std::addressof(GetSlot(this->startSeq + this->size - 1));
 	}
 
 	void RtpRetransmissionBuffer::RemoveOldest()
 	{
 		MS_TRACE();
 
-		if (this->buffer.empty())
+		if (this->size == 0u)
 		{
 			return;
 		}
 
-		auto* item = this->buffer.front();
-
-		// Reset the stored item (decrease RTP packet shared pointer counter).
-		item->Reset();
-
-		delete item;
+		// NOTE: Resetting the item decreases its RTP packet reference counter.
+		GetSlot(this->startSeq).Reset();
 
-		this->buffer.pop_front();
+		++this->startSeq;
+		--this->size;
 
 		MS_DEBUG_DEV("removed 1 item from the front");
 
-		// Remove all nullptr elements from the beginning of the buffer.
-		// NOTE: Calling front on an empty container is undefined.
+		// Remove all blank slots from the beginning of the buffer.
 		size_t numItemsRemoved{ 0u };
 
-		while (!this->buffer.empty() && this->buffer.front() == nullptr)
+		while (this->size != 0u && !GetSlot(this->startSeq).packet)
 		{
-			this->buffer.pop_front();
+			++this->startSeq;
+			--this->size;
 
 			++numItemsRemoved;
 		}
@@ -528,15 +602,15 @@ namespace RTC
 		MS_TRACE();
 
 		MS_ASSERT(
-		  numItems <= this->buffer.size(),
+		  numItems <= this->size,
 		  "attempting to remove more items than current buffer size [numItems:%" PRIu16
 		  ", bufferSize:%zu]",
 		  numItems,
-		  this->buffer.size());
+		  this->size);
 
-		const size_t intendedBufferSize = this->buffer.size() - numItems;
+		const size_t intendedBufferSize = this->size - numItems;
 
-		while (this->buffer.size() > intendedBufferSize)
+		while (this->size > intendedBufferSize)
 		{
 			RemoveOldest();
 		}
@@ -546,7 +620,7 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		RtpRetransmissionBuffer::Item* oldestItem{ nullptr };
+		const RtpRetransmissionBuffer::Item* oldestItem{ nullptr };
 		bool itemsRemoved{ false };
 
 		// Go through all buffer items starting with the first and free all items
@@ -588,7 +662,7 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->packet.reset();
+		this->packet.Reset();
 		this->ssrc           = 0u;
 		this->sequenceNumber = 0u;
 		this->timestamp      = 0u;
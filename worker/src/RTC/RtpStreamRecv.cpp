@@ -36,6 +36,15 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Single layer stream, no need to ask the packet (and parse its payload
+		// descriptor) for its layers.
+		if (this->spatialLayerCounters.size() == 1 && this->spatialLayerCounters[0].size() == 1)
+		{
+			this->spatialLayerCounters[0][0].Update(packet);
+
+			return;
+		}
+
 		auto spatialLayer  = packet->GetSpatialLayer();
 		auto temporalLayer = packet->GetTemporalLayer();
 
@@ -279,7 +288,8 @@ namespace RTC
 		// Process the packet at codec level.
 		if (packet->GetPayloadType() == GetPayloadType())
 		{
-			RTC::Codecs::Tools::ProcessRtpPacket(packet, GetMimeType());
+			RTC::Codecs::Tools::ProcessRtpPacket(
+			  packet, GetMimeType(), this->templateDependencyStructure);
 		}
 
 		// Pass the packet to the NackGenerator.
@@ -410,7 +420,8 @@ namespace RTC
 		// Process the packet at codec level.
 		if (packet->GetPayloadType() == GetPayloadType())
 		{
-			RTC::Codecs::Tools::ProcessRtpPacket(packet, GetMimeType());
+			RTC::Codecs::Tools::ProcessRtpPacket(
+			  packet, GetMimeType(), this->templateDependencyStructure);
 		}
 
 		// Mark the packet as retransmitted.
@@ -5,6 +5,9 @@
 #ifdef MS_LIBURING_SUPPORTED
 #include "DepLibUring.hpp"
 #endif
+#ifdef MS_SENDMMSG_SUPPORTED
+#include "handles/UdpSocketHandle.hpp"
+#endif
 #include "Logger.hpp"
 #include "Utils.hpp"
 #include "RTC/RtpDictionaries.hpp"
@@ -96,7 +99,7 @@ namespace RTC
 		this->rtxSeq = Utils::Crypto::GetRandomUInt(0u, 0xFFFF);
 	}
 
-	bool RtpStreamSend::ReceivePacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	bool RtpStreamSend::ReceivePacket(RTC::RtpPacket* packet, RTC::SharedRtpPacket& sharedPacket)
 	{
 		MS_TRACE();
 
@@ -135,6 +138,11 @@ namespace RTC
 		}
 #endif
 
+#ifdef MS_SENDMMSG_SUPPORTED
+		// Queue UDP datagrams to send them in a single sendmmsg() call.
+		UdpSocketHandle::StartSendBatch();
+#endif
+
 		for (auto it = nackPacket->Begin(); it != nackPacket->End(); ++it)
 		{
 			RTC::RTCP::FeedbackRtpNackItem* item = *it;
@@ -156,15 +164,15 @@ namespace RTC
 
 				// Retransmit the packet.
 				static_cast<RTC::RtpStreamSend::Listener*>(this->listener)
-				  ->OnRtpStreamRetransmitRtpPacket(this, packet.get());
+				  ->OnRtpStreamRetransmitRtpPacket(this, packet.Get());
 
 				// Mark the packet as retransmitted.
-				RTC::RtpStream::PacketRetransmitted(packet.get());
+				RTC::RtpStream::PacketRetransmitted(packet.Get());
 
 				// Mark the packet as repaired (only if this is the first retransmission).
 				if (item->sentTimes == 1)
 				{
-					RTC::RtpStream::PacketRepaired(packet.get());
+					RTC::RtpStream::PacketRepaired(packet.Get());
 				}
 
 				if (HasRtx())
@@ -175,6 +183,11 @@ namespace RTC
 			}
 		}
 
+#ifdef MS_SENDMMSG_SUPPORTED
+		// Send all queued UDP datagrams.
+		UdpSocketHandle::FlushSendBatch();
+#endif
+
 #ifdef MS_LIBURING_SUPPORTED
 		if (DepLibUring::IsEnabled())
 		{
@@ -370,7 +383,7 @@ namespace RTC
 		MS_ABORT("invalid method call");
 	}
 
-	void RtpStreamSend::StorePacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void RtpStreamSend::StorePacket(RTC::RtpPacket* packet, RTC::SharedRtpPacket& sharedPacket)
 	{
 		MS_TRACE();
 
@@ -436,7 +449,7 @@ namespace RTC
 			if (requested)
 			{
 				auto* item = this->retransmissionBuffer->Get(currentSeq);
-				std::shared_ptr<RTC::RtpPacket> packet{ nullptr };
+				RTC::SharedRtpPacket packet;
 
 				// Calculate the elapsed time between the max timestamp seen and the
 				// requested packet's timestamp (in ms).
@@ -4,6 +4,7 @@
 #include "RTC/SenderBandwidthEstimator.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include <algorithm> // std::fill()
 
 namespace RTC
 {
@@ -11,6 +12,8 @@ namespace RTC
 
 	// static constexpr uint64_t AvailableBitrateEventInterval{ 2000u }; // In ms.
 	static constexpr uint16_t MaxSentInfoAge{ 2000u }; // TODO: Let's see.
+	// Must be a power of two not lower than MaxSentInfoAge.
+	static constexpr size_t SentInfosCapacity{ 2048u };
 	static constexpr float DefaultRtt{ 100 };
 
 	/* Instance methods. */
@@ -21,6 +24,9 @@ namespace RTC
 	    sendTransmission(1000u), sendTransmissionTrend(0.15f)
 	{
 		MS_TRACE();
+
+		this->sentInfos.resize(SentInfosCapacity);
+		this->sentInfoValids.resize(SentInfosCapacity, false);
 	}
 
 	SenderBandwidthEstimator::~SenderBandwidthEstimator()
@@ -42,7 +48,7 @@ namespace RTC
 
 		this->availableBitrate = 0u;
 
-		this->sentInfos.clear();
+		ClearSentInfos();
 		this->cummulativeResult.Reset();
 	}
 
@@ -52,13 +58,8 @@ namespace RTC
 
 		auto nowMs = sentInfo.sentAtMs;
 
-		// Remove old sent infos.
-		auto it = this->sentInfos.lower_bound(sentInfo.wideSeq - MaxSentInfoAge + 1);
-
-		this->sentInfos.erase(this->sentInfos.begin(), it);
-
-		// Insert the sent info into the map.
-		this->sentInfos[sentInfo.wideSeq] = sentInfo;
+		// Insert the sent info into the ring.
+		InsertSentInfo(sentInfo);
 
 		// Fill the send transmission counter.
 		this->sendTransmission.Update(sentInfo.size, nowMs);
@@ -99,26 +100,24 @@ namespace RTC
 			}
 
 			const uint16_t wideSeq = result.sequenceNumber;
-			auto it                = this->sentInfos.find(wideSeq);
+			const auto* sentInfo   = GetSentInfo(wideSeq);
 
-			if (it == this->sentInfos.end())
+			if (!sentInfo)
 			{
 				MS_WARN_DEV("received packet not present in sent infos [wideSeq:%" PRIu16 "]", wideSeq);
 
 				continue;
 			}
 
-			auto& sentInfo = it->second;
-
-			if (!sentInfo.isProbation)
+			if (!sentInfo->isProbation)
 			{
 				this->cummulativeResult.AddPacket(
-				  sentInfo.size, static_cast<int64_t>(sentInfo.sentAtMs), result.receivedAtMs);
+				  sentInfo->size, static_cast<int64_t>(sentInfo->sentAtMs), result.receivedAtMs);
 			}
 			else
 			{
 				this->probationCummulativeResult.AddPacket(
-				  sentInfo.size, static_cast<int64_t>(sentInfo.sentAtMs), result.receivedAtMs);
+				  sentInfo->size, static_cast<int64_t>(sentInfo->sentAtMs), result.receivedAtMs);
 			}
 		}
 
@@ -226,6 +225,87 @@ namespace RTC
 		this->lastAvailableBitrateEventAtMs = DepLibUV::GetTimeMs();
 	}
 
+	void SenderBandwidthEstimator::InsertSentInfo(const SentInfo& sentInfo)
+	{
+		MS_TRACE();
+
+		const uint16_t wideSeq = sentInfo.wideSeq;
+
+		if (!this->hasSentInfos)
+		{
+			this->hasSentInfos          = true;
+			this->newestSentInfoWideSeq = wideSeq;
+		}
+		// Newer than the newest one.
+		else if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(wideSeq, this->newestSentInfoWideSeq))
+		{
+			const uint16_t distance = wideSeq - this->newestSentInfoWideSeq;
+
+			// Invalidate the slots of skipped wide seq numbers, or all of them if
+			// the gap is larger than the covered range.
+			if (distance >= MaxSentInfoAge)
+			{
+				std::fill(this->sentInfoValids.begin(), this->sentInfoValids.end(), false);
+			}
+			else
+			{
+				for (uint16_t seq = this->newestSentInfoWideSeq + 1; seq != wideSeq; ++seq)
+				{
+					this->sentInfoValids[seq & (SentInfosCapacity - 1)] = false;
+				}
+			}
+
+			this->newestSentInfoWideSeq = wideSeq;
+		}
+		// Too old.
+		else if (static_cast<uint16_t>(this->newestSentInfoWideSeq - wideSeq) >= MaxSentInfoAge)
+		{
+			MS_WARN_DEV("ignoring too old sent info [wideSeq:%" PRIu16 "]", wideSeq);
+
+			return;
+		}
+
+		const size_t idx = wideSeq & (SentInfosCapacity - 1);
+
+		this->sentInfos[idx]      = sentInfo;
+		this->sentInfoValids[idx] = true;
+	}
+
+	const SenderBandwidthEstimator::SentInfo* SenderBandwidthEstimator::GetSentInfo(
+	  uint16_t wideSeq) const
+	{
+		MS_TRACE();
+
+		if (!this->hasSentInfos)
+		{
+			return nullptr;
+		}
+
+		// Out of the covered range (newer than the newest or too old).
+		if (static_cast<uint16_t>(this->newestSentInfoWideSeq - wideSeq) >= MaxSentInfoAge)
+		{
+			return nullptr;
+		}
+
+		const size_t idx = wideSeq & (SentInfosCapacity - 1);
+
+		if (!this->sentInfoValids[idx])
+		{
+			return nullptr;
+		}
+
+		return &this->sentInfos[idx];
+	}
+
+	void SenderBandwidthEstimator::ClearSentInfos()
+	{
+		MS_TRACE();
+
+		std::fill(this->sentInfoValids.begin(), this->sentInfoValids.end(), false);
+
+		this->hasSentInfos = false;
+	}
+
 	void SenderBandwidthEstimator::CummulativeResult::AddPacket(
 	  size_t size, int64_t sentAtMs, int64_t receivedAtMs)
 	{
@@ -46,18 +46,20 @@ namespace RTC
 		this->rtpSeqManager.reset(new RTC::SeqManager<uint16_t>(initialOutputSeq));
 
 		// Create the encoding context for Opus.
+		// NOTE: It's only needed to drop DTX packets (ignoreDtx is false by
+		// default) so, without it, Opus payloads are never parsed.
 		if (
 		  mediaCodec->mimeType.type == RTC::RtpCodecMimeType::Type::AUDIO &&
 		  (mediaCodec->mimeType.subtype == RTC::RtpCodecMimeType::Subtype::OPUS ||
-		   mediaCodec->mimeType.subtype == RTC::RtpCodecMimeType::Subtype::MULTIOPUS))
+		   mediaCodec->mimeType.subtype == RTC::RtpCodecMimeType::Subtype::MULTIOPUS) &&
+		  data->ignoreDtx())
 		{
 			RTC::Codecs::EncodingContext::Params params;
 
 			this->encodingContext.reset(
 			  RTC::Codecs::Tools::GetEncodingContext(mediaCodec->mimeType, params));
 
-			// ignoreDtx is set to false by default.
-			this->encodingContext->SetIgnoreDtx(data->ignoreDtx());
+			this->encodingContext->SetIgnoreDtx(true);
 		}
 
 		// NOTE: This may throw.
@@ -306,7 +308,7 @@ namespace RTC
 		return desiredBitrate;
 	}
 
-	void SimpleConsumer::SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void SimpleConsumer::SendRtpPacket(RTC::RtpPacket* packet, RTC::SharedRtpPacket& sharedPacket)
 	{
 		MS_TRACE();
 
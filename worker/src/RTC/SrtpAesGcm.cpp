@@ -0,0 +1,401 @@
+#define MS_CLASS "RTC::SrtpAesGcm"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/SrtpAesGcm.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include <algorithm> // std::min()
+#include <cstring>   // std::memcpy()
+#include <limits>    // std::numeric_limits()
+
+namespace RTC
+{
+	/* Static. */
+
+	// SRTP key derivation labels (RFC 3711 section 4.3.1).
+	static constexpr uint8_t LabelRtpEncryption{ 0x00 };
+	static constexpr uint8_t LabelRtpSalt{ 0x02 };
+	static constexpr uint8_t LabelRtcpEncryption{ 0x03 };
+	static constexpr uint8_t LabelRtcpSalt{ 0x05 };
+	static constexpr size_t MaxKeyLength{ 32u };
+	static constexpr size_t RtpHeaderLength{ 12u };
+	static constexpr size_t RtcpHeaderLength{ 8u };
+	static constexpr uint16_t SeqNumMedian{ 0x8000 };
+	static constexpr uint32_t MaxSrtcpIndex{ 0x7FFFFFFF };
+	static constexpr uint32_t SrtcpEncryptedFlag{ 0x80000000 };
+
+	/**
+	 * SRTP key derivation function (RFC 3711 section 4.3.3) with a key derivation
+	 * rate of 0, as done by libsrtp for the AEAD suites (the 12 bytes master salt
+	 * is padded with zeroes as AES-CM expects 14 bytes).
+	 */
+	static bool deriveKey(
+	  const EVP_CIPHER* cipher,
+	  const uint8_t* masterKey,
+	  const uint8_t* masterSalt,
+	  uint8_t label,
+	  uint8_t* out,
+	  size_t outLen)
+	{
+		uint8_t counter[16]{};
+		uint8_t block[16];
+		int blockLen;
+		bool ok{ true };
+		auto* ctx = EVP_CIPHER_CTX_new();
+
+		if (!ctx)
+		{
+			return false;
+		}
+
+		std::memcpy(counter, masterSalt, SrtpAesGcm::SaltLength);
+		counter[7] ^= label;
+
+		ok = EVP_EncryptInit_ex(ctx, cipher, nullptr, masterKey, nullptr) == 1 &&
+		     EVP_CIPHER_CTX_set_padding(ctx, 0) == 1;
+
+		for (size_t offset{ 0u }; ok && offset < outLen; offset += sizeof(block))
+		{
+			ok = EVP_EncryptUpdate(ctx, block, &blockLen, counter, sizeof(counter)) == 1 &&
+			     blockLen == sizeof(block);
+
+			std::memcpy(out + offset, block, std::min(sizeof(block), outLen - offset));
+
+			// Increment the 16 bits block counter.
+			if (++counter[15] == 0u)
+			{
+				++counter[14];
+			}
+		}
+
+		EVP_CIPHER_CTX_free(ctx);
+		OPENSSL_cleanse(block, sizeof(block));
+
+		return ok;
+	}
+
+	static EVP_CIPHER_CTX* createGcmContext(const EVP_CIPHER* cipher, const uint8_t* key)
+	{
+		auto* ctx = EVP_CIPHER_CTX_new();
+
+		if (!ctx)
+		{
+			return nullptr;
+		}
+
+		// NOTE: The key schedule is computed here. Later calls just set the IV.
+		if (
+		  EVP_EncryptInit_ex(ctx, cipher, nullptr, nullptr, nullptr) != 1 ||
+		  EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, SrtpAesGcm::SaltLength, nullptr) != 1 ||
+		  EVP_EncryptInit_ex(ctx, nullptr, nullptr, key, nullptr) != 1)
+		{
+			EVP_CIPHER_CTX_free(ctx);
+
+			return nullptr;
+		}
+
+		return ctx;
+	}
+
+	/**
+	 * Encrypts data in place authenticating aad with the given IV and writes the
+	 * tag at tag.
+	 */
+	static bool gcmEncrypt(
+	  EVP_CIPHER_CTX* ctx,
+	  const uint8_t* iv,
+	  const uint8_t* aad1,
+	  size_t aad1Len,
+	  const uint8_t* aad2,
+	  size_t aad2Len,
+	  uint8_t* data,
+	  size_t dataLen,
+	  uint8_t* tag)
+	{
+		int outLen;
+
+		if (EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, iv) != 1)
+		{
+			return false;
+		}
+
+		if (EVP_EncryptUpdate(ctx, nullptr, &outLen, aad1, static_cast<int>(aad1Len)) != 1)
+		{
+			return false;
+		}
+
+		if (
+		  aad2Len != 0u &&
+		  EVP_EncryptUpdate(ctx, nullptr, &outLen, aad2, static_cast<int>(aad2Len)) != 1)
+		{
+			return false;
+		}
+
+		if (
+		  dataLen != 0u &&
+		  EVP_EncryptUpdate(ctx, data, &outLen, data, static_cast<int>(dataLen)) != 1)
+		{
+			return false;
+		}
+
+		if (EVP_EncryptFinal_ex(ctx, data + dataLen, &outLen) != 1)
+		{
+			return false;
+		}
+
+		return EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, SrtpAesGcm::TagLength, tag) == 1;
+	}
+
+	/* Instance methods. */
+
+	SrtpAesGcm::SrtpAesGcm(size_t keyLen, const uint8_t* masterKey)
+	{
+		MS_TRACE();
+
+		const EVP_CIPHER* ecbCipher{ nullptr };
+		const EVP_CIPHER* gcmCipher{ nullptr };
+
+		switch (keyLen)
+		{
+			case 16u:
+			{
+				ecbCipher = EVP_aes_128_ecb();
+				gcmCipher = EVP_aes_128_gcm();
+
+				break;
+			}
+
+			case 32u:
+			{
+				ecbCipher = EVP_aes_256_ecb();
+				gcmCipher = EVP_aes_256_gcm();
+
+				break;
+			}
+
+			default:
+			{
+				MS_THROW_TYPE_ERROR("invalid key length %zu", keyLen);
+			}
+		}
+
+		const uint8_t* masterSalt = masterKey + keyLen;
+		uint8_t key[MaxKeyLength];
+
+		if (
+		  !deriveKey(ecbCipher, masterKey, masterSalt, LabelRtpEncryption, key, keyLen) ||
+		  !deriveKey(ecbCipher, masterKey, masterSalt, LabelRtpSalt, this->rtpSalt, SaltLength) ||
+		  !(this->rtpCtx = createGcmContext(gcmCipher, key)) ||
+		  !deriveKey(ecbCipher, masterKey, masterSalt, LabelRtcpEncryption, key, keyLen) ||
+		  !deriveKey(ecbCipher, masterKey, masterSalt, LabelRtcpSalt, this->rtcpSalt, SaltLength) ||
+		  !(this->rtcpCtx = createGcmContext(gcmCipher, key)))
+		{
+			OPENSSL_cleanse(key, sizeof(key));
+
+			EVP_CIPHER_CTX_free(this->rtpCtx);
+			EVP_CIPHER_CTX_free(this->rtcpCtx);
+
+			MS_THROW_ERROR("SRTP AES-GCM session keys derivation failed");
+		}
+
+		OPENSSL_cleanse(key, sizeof(key));
+	}
+
+	SrtpAesGcm::~SrtpAesGcm()
+	{
+		MS_TRACE();
+
+		EVP_CIPHER_CTX_free(this->rtpCtx);
+		EVP_CIPHER_CTX_free(this->rtcpCtx);
+		OPENSSL_cleanse(this->rtpSalt, sizeof(this->rtpSalt));
+		OPENSSL_cleanse(this->rtcpSalt, sizeof(this->rtcpSalt));
+	}
+
+	bool SrtpAesGcm::ProtectRtp(uint8_t* data, size_t* len)
+	{
+		// NOTE: No MS_TRACE() nor logs since it may be called from a thread
+		// other than the one owning this instance (see SrtpCryptoPool).
+
+		if (*len < RtpHeaderLength)
+		{
+			return false;
+		}
+
+		size_t headerLen = RtpHeaderLength + (4u * (data[0] & 0x0F));
+
+		// Header extension.
+		if ((data[0] & 0x10) != 0u)
+		{
+			if (*len < headerLen + 4u)
+			{
+				return false;
+			}
+
+			headerLen += 4u + (4u * Utils::Byte::Get2Bytes(data, headerLen + 2u));
+		}
+
+		if (*len < headerLen)
+		{
+			return false;
+		}
+
+		const uint16_t seq  = Utils::Byte::Get2Bytes(data, 2);
+		const uint32_t ssrc = Utils::Byte::Get4Bytes(data, 8);
+		auto& stream        = GetStream(ssrc);
+		uint64_t index;
+
+		// Estimate the packet index as libsrtp does (RFC 3711 appendix A).
+		if (stream.rtpIndex > SeqNumMedian)
+		{
+			const uint64_t localRoc = stream.rtpIndex >> 16;
+			const auto localSeq     = static_cast<uint16_t>(stream.rtpIndex);
+			uint64_t roc{ localRoc };
+
+			if (localSeq < SeqNumMedian)
+			{
+				if (seq - localSeq > SeqNumMedian)
+				{
+					roc = localRoc - 1u;
+				}
+			}
+			else if (localSeq - SeqNumMedian > seq)
+			{
+				roc = localRoc + 1u;
+			}
+
+			if (roc > std::numeric_limits<uint32_t>::max())
+			{
+				return false;
+			}
+
+			index = (roc << 16) | seq;
+		}
+		else
+		{
+			index = seq;
+		}
+
+		if (index > stream.rtpIndex)
+		{
+			stream.rtpIndex = index;
+		}
+
+		// IV (RFC 7714 section 8.1).
+		uint8_t iv[SaltLength]{};
+
+		Utils::Byte::Set4Bytes(iv, 2, ssrc);
+		Utils::Byte::Set4Bytes(iv, 6, static_cast<uint32_t>(index >> 16));
+		iv[10] = static_cast<uint8_t>(seq >> 8);
+		iv[11] = static_cast<uint8_t>(seq);
+
+		for (size_t i{ 0u }; i < SaltLength; ++i)
+		{
+			iv[i] ^= this->rtpSalt[i];
+		}
+
+		if (!gcmEncrypt(
+		      this->rtpCtx,
+		      iv,
+		      data,
+		      headerLen,
+		      nullptr,
+		      0u,
+		      data + headerLen,
+		      *len - headerLen,
+		      data + *len))
+		{
+			return false;
+		}
+
+		*len += TagLength;
+
+		return true;
+	}
+
+	void SrtpAesGcm::ProtectRtp(RtpBuffer* buffers, size_t count)
+	{
+		for (size_t i{ 0u }; i < count; ++i)
+		{
+			auto& buffer = buffers[i];
+
+			buffer.ok = ProtectRtp(buffer.data, &buffer.len);
+		}
+	}
+
+	bool SrtpAesGcm::ProtectRtcp(uint8_t* data, size_t* len)
+	{
+		if (*len < RtcpHeaderLength)
+		{
+			return false;
+		}
+
+		const uint32_t ssrc = Utils::Byte::Get4Bytes(data, 4);
+		auto& stream        = GetStream(ssrc);
+
+		if (stream.rtcpIndex >= MaxSrtcpIndex)
+		{
+			return false;
+		}
+
+		const uint32_t index = ++stream.rtcpIndex;
+		uint8_t trailer[SrtcpTrailerLength];
+
+		Utils::Byte::Set4Bytes(trailer, 0, SrtcpEncryptedFlag | index);
+
+		// IV (RFC 7714 section 9.1).
+		uint8_t iv[SaltLength]{};
+
+		Utils::Byte::Set4Bytes(iv, 2, ssrc);
+		Utils::Byte::Set4Bytes(iv, 8, index);
+
+		for (size_t i{ 0u }; i < SaltLength; ++i)
+		{
+			iv[i] ^= this->rtcpSalt[i];
+		}
+
+		if (!gcmEncrypt(
+		      this->rtcpCtx,
+		      iv,
+		      data,
+		      RtcpHeaderLength,
+		      trailer,
+		      sizeof(trailer),
+		      data + RtcpHeaderLength,
+		      *len - RtcpHeaderLength,
+		      data + *len))
+		{
+			return false;
+		}
+
+		// The SRTCP trailer goes after the tag.
+		std::memcpy(data + *len + TagLength, trailer, sizeof(trailer));
+
+		*len += TagLength + SrtcpTrailerLength;
+
+		return true;
+	}
+
+	void SrtpAesGcm::RemoveStream(uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		this->mapSsrcStream.erase(ssrc);
+
+		this->lastStream = nullptr;
+	}
+
+	SrtpAesGcm::Stream& SrtpAesGcm::GetStream(uint32_t ssrc)
+	{
+		if (this->lastStream && this->lastSsrc == ssrc)
+		{
+			return *this->lastStream;
+		}
+
+		// NOTE: Inserting may invalidate the previously cached pointer.
+		this->lastSsrc   = ssrc;
+		this->lastStream = std::addressof(this->mapSsrcStream[ssrc]);
+
+		return *this->lastStream;
+	}
+} // namespace RTC
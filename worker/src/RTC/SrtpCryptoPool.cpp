@@ -0,0 +1,672 @@
+#define MS_CLASS "RTC::SrtpCryptoPool"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/SrtpCryptoPool.hpp"
+#include "DepLibUV.hpp"
+#ifdef MS_LIBURING_SUPPORTED
+#include "DepLibUring.hpp"
+#endif
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
+#include "Utils.hpp"
+#include "RTC/SrtpSession.hpp"
+#include "RTC/UdpSocket.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstring> // std::memcpy()
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+	/* Static. */
+
+	/* Struct for a RTP packet being protected. */
+	struct CryptoJob
+	{
+		// Only used by the pool thread (and by the event loop before queueing it).
+		RTC::SrtpSession* session{ nullptr };
+		uint8_t data[SrtpCryptoPool::MaxPacketSize];
+		size_t len{ 0u };
+		bool ok{ false };
+		// Event fired by libsrtp while protecting it, if any.
+		int srtpEvent{ -1 };
+		// Only used by the event loop.
+		RTC::UdpSocket* socket{ nullptr };
+		struct sockaddr_storage addr
+		{
+		};
+		::UdpSocketHandle::onSendCallback* cb{ nullptr };
+		uint64_t queuedAtNs{ 0u };
+	};
+
+	/* Struct for a pool thread and its queue. */
+	struct CryptoPartition
+	{
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<CryptoJob*> jobs;
+		// Jobs being protected.
+		std::vector<CryptoJob*> runningJobs;
+		bool waiting{ false };
+	};
+
+	/* Struct holding the threads and the protected jobs. */
+	struct CryptoThreads
+	{
+		std::vector<std::unique_ptr<CryptoPartition>> partitions;
+		std::atomic<bool> stopping{ false };
+		// Protected jobs to be sent by the event loop.
+		std::mutex doneMutex;
+		std::condition_variable doneCondition;
+		std::vector<CryptoJob*> doneJobs;
+		uv_async_t* uvAsyncHandle{ nullptr };
+		// Only used by the event loop.
+		std::vector<CryptoJob*> freeJobs;
+		std::vector<CryptoJob*> sendingJobs;
+		// Next job of sendingJobs to be sent.
+		size_t sendingIndex{ 0u };
+		// Stats.
+		uint64_t protectedPackets{ 0u };
+		uint64_t inlinePackets{ 0u };
+		uint64_t failedPackets{ 0u };
+		size_t queueDepth{ 0u };
+		size_t maxQueueDepth{ 0u };
+		uint64_t latencyNs{ 0u };
+	};
+
+	// NOTE: Allocated only if enabled.
+	thread_local static std::unique_ptr<CryptoThreads> CryptoPool;
+	// Job being protected by this pool thread.
+	thread_local static CryptoJob* CurrentJob{ nullptr };
+
+	/* Static methods for UV callbacks. */
+
+	inline static void onAsync(uv_async_t* /*handle*/)
+	{
+		SrtpCryptoPool::OnUvAsync();
+	}
+
+	inline static void onCloseAsync(uv_handle_t* handle)
+	{
+		delete reinterpret_cast<uv_async_t*>(handle);
+	}
+
+	/**
+	 * Sends the protected jobs from sendingIndex on. Called again (from
+	 * SrtpCryptoPool::SendPending()) if a send callback makes a packet be
+	 * protected inline, so it's sent after them.
+	 */
+	static void sendJobs(CryptoThreads& pool)
+	{
+		const uint64_t nowNs = DepLibUV::GetTimeNs();
+
+		// NOTE: Iterate by index since a send callback may close a socket, which
+		// resets its jobs.
+		while (pool.sendingIndex < pool.sendingJobs.size())
+		{
+			auto* job = pool.sendingJobs[pool.sendingIndex++];
+
+			pool.queueDepth--;
+			pool.latencyNs += nowNs - job->queuedAtNs;
+
+			if (job->srtpEvent != -1)
+			{
+				RTC::SrtpSession::LogSrtpEvent(job->srtpEvent);
+			}
+
+			if (job->ok)
+			{
+				pool.protectedPackets++;
+			}
+			else
+			{
+				MS_WARN_TAG(srtp, "SRTP protect failed in SRTP crypto pool");
+
+				pool.failedPackets++;
+			}
+
+			auto* socket = job->socket;
+			auto* cb     = job->cb;
+
+			job->socket = nullptr;
+			job->cb     = nullptr;
+
+			// Socket closed meanwhile.
+			if (!socket)
+			{
+				continue;
+			}
+
+			if (job->ok)
+			{
+				socket->Send(
+				  job->data, job->len, reinterpret_cast<const struct sockaddr*>(std::addressof(job->addr)), cb);
+			}
+			else if (cb)
+			{
+				(*cb)(false);
+				delete cb;
+			}
+		}
+	}
+
+	// Max number of jobs taken at once by a pool thread.
+	static constexpr size_t ThreadBatchSize{ 64u };
+
+	/**
+	 * Protects the given jobs in order. Consecutive jobs of the same session are
+	 * protected at once.
+	 */
+	static void protectJobs(CryptoJob** jobs, size_t count)
+	{
+		RTC::SrtpSession::RtpBuffer buffers[ThreadBatchSize];
+		size_t i{ 0u };
+
+		while (i < count)
+		{
+			auto* session = jobs[i]->session;
+			size_t numBuffers{ 0u };
+
+			for (size_t j{ i }; j < count && jobs[j]->session == session; ++j)
+			{
+				buffers[numBuffers].data = jobs[j]->data;
+				buffers[numBuffers].len  = jobs[j]->len;
+
+				++numBuffers;
+			}
+
+			// Events fired by libsrtp are logged along with the first job.
+			CurrentJob = jobs[i];
+
+			session->ProtectRtp(buffers, numBuffers);
+
+			CurrentJob = nullptr;
+
+			for (size_t k{ 0u }; k < numBuffers; ++k)
+			{
+				jobs[i + k]->len = buffers[k].len;
+				jobs[i + k]->ok  = buffers[k].ok;
+			}
+
+			i += numBuffers;
+		}
+	}
+
+	// NOTE: No MS_TRACE() nor logs in the pool threads since the Logger belongs
+	// to the event loop thread.
+	static void runThread(CryptoThreads* pool, CryptoPartition* partition)
+	{
+		CryptoJob* jobs[ThreadBatchSize];
+
+		while (true)
+		{
+			size_t count{ 0u };
+
+			{
+				std::unique_lock<std::mutex> lock(partition->mutex);
+
+				partition->waiting = true;
+
+				partition->condition.wait(
+				  lock, [pool, partition]() { return pool->stopping || !partition->jobs.empty(); });
+
+				partition->waiting = false;
+
+				if (pool->stopping)
+				{
+					return;
+				}
+
+				while (!partition->jobs.empty() && count < ThreadBatchSize)
+				{
+					jobs[count++] = partition->jobs.front();
+
+					partition->jobs.pop_front();
+				}
+
+				partition->runningJobs.assign(jobs, jobs + count);
+			}
+
+			protectJobs(jobs, count);
+
+			{
+				const std::lock_guard<std::mutex> lock(partition->mutex);
+
+				partition->runningJobs.clear();
+			}
+
+			bool wakeUp;
+
+			{
+				const std::lock_guard<std::mutex> lock(pool->doneMutex);
+
+				wakeUp = pool->doneJobs.empty();
+
+				for (size_t i{ 0u }; i < count; ++i)
+				{
+					pool->doneJobs.push_back(jobs[i]);
+					jobs[i]->session->DecreasePoolJobs();
+				}
+			}
+
+			// Wake up the session being removed, if any.
+			pool->doneCondition.notify_all();
+
+			if (wakeUp)
+			{
+				uv_async_send(pool->uvAsyncHandle);
+			}
+		}
+	}
+
+	/* Class methods. */
+
+	void SrtpCryptoPool::ClassInit()
+	{
+		MS_TRACE();
+
+		const size_t numThreads = Settings::configuration.srtpCryptoThreads;
+
+		if (numThreads == 0u)
+		{
+			return;
+		}
+
+		CryptoPool.reset(new CryptoThreads());
+
+		CryptoPool->uvAsyncHandle = new uv_async_t;
+
+		const int err = uv_async_init(
+		  DepLibUV::GetLoop(), CryptoPool->uvAsyncHandle, static_cast<uv_async_cb>(onAsync));
+
+		if (err != 0)
+		{
+			delete CryptoPool->uvAsyncHandle;
+			CryptoPool.reset();
+
+			MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+		}
+
+		// Don't keep the loop alive because of this handle.
+		uv_unref(reinterpret_cast<uv_handle_t*>(CryptoPool->uvAsyncHandle));
+
+		for (size_t i{ 0u }; i < numThreads; ++i)
+		{
+			CryptoPool->partitions.emplace_back(new CryptoPartition());
+
+			auto* partition = CryptoPool->partitions.back().get();
+
+			partition->thread = std::thread(runThread, CryptoPool.get(), partition);
+		}
+
+		MS_DEBUG_TAG(info, "SRTP crypto pool enabled [threads:%zu]", numThreads);
+	}
+
+	void SrtpCryptoPool::ClassDestroy()
+	{
+		MS_TRACE();
+
+		if (!CryptoPool)
+		{
+			return;
+		}
+
+		CryptoPool->stopping = true;
+
+		for (auto& partition : CryptoPool->partitions)
+		{
+			{
+				// NOTE: Needed so the thread doesn't miss the notification.
+				const std::lock_guard<std::mutex> lock(partition->mutex);
+			}
+
+			partition->condition.notify_one();
+			partition->thread.join();
+		}
+
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(CryptoPool->uvAsyncHandle),
+		  static_cast<uv_close_cb>(onCloseAsync));
+
+		// NOTE: All sessions have been closed, so no job is queued in the threads.
+		for (auto* job : CryptoPool->doneJobs)
+		{
+			delete job->cb;
+			delete job;
+		}
+
+		for (auto* job : CryptoPool->freeJobs)
+		{
+			delete job;
+		}
+
+		CryptoPool.reset();
+	}
+
+	bool SrtpCryptoPool::IsEnabled()
+	{
+		return CryptoPool != nullptr;
+	}
+
+	bool SrtpCryptoPool::ProtectAndSend(
+	  RTC::SrtpSession* session,
+	  RTC::UdpSocket* socket,
+	  const struct sockaddr* addr,
+	  const uint8_t* header,
+	  size_t headerLen,
+	  const uint8_t* payload,
+	  size_t payloadLen,
+	  ::UdpSocketHandle::onSendCallback* cb)
+	{
+		MS_TRACE();
+
+		auto& pool = *CryptoPool;
+
+		if (headerLen + payloadLen + session->GetRtpTrailerLength() > SrtpCryptoPool::MaxPacketSize)
+		{
+			pool.inlinePackets++;
+
+			return false;
+		}
+
+		CryptoJob* job;
+
+		if (!pool.freeJobs.empty())
+		{
+			job = pool.freeJobs.back();
+
+			pool.freeJobs.pop_back();
+		}
+		else
+		{
+			job = new CryptoJob();
+		}
+
+		std::memcpy(job->data, header, headerLen);
+
+		if (payloadLen != 0u)
+		{
+			std::memcpy(job->data + headerLen, payload, payloadLen);
+		}
+
+		job->session    = session;
+		job->len        = headerLen + payloadLen;
+		job->ok         = false;
+		job->srtpEvent  = -1;
+		job->socket     = socket;
+		job->cb         = cb;
+		job->queuedAtNs = DepLibUV::GetTimeNs();
+
+		std::memcpy(std::addressof(job->addr), addr, Utils::IP::GetAddressLen(addr));
+
+		auto& partition = *pool.partitions[SrtpCryptoPool::GetPartition(session)];
+		bool wakeUp;
+
+		{
+			const std::lock_guard<std::mutex> lock(partition.mutex);
+
+			partition.jobs.push_back(job);
+			session->IncreasePoolJobs();
+
+			wakeUp = partition.waiting;
+		}
+
+		if (wakeUp)
+		{
+			partition.condition.notify_one();
+		}
+
+		if (++pool.queueDepth > pool.maxQueueDepth)
+		{
+			pool.maxQueueDepth = pool.queueDepth;
+		}
+
+		return true;
+	}
+
+	void SrtpCryptoPool::RemoveSocket(const RTC::UdpSocket* socket)
+	{
+		MS_TRACE();
+
+		if (!CryptoPool)
+		{
+			return;
+		}
+
+		auto& pool = *CryptoPool;
+		std::vector<::UdpSocketHandle::onSendCallback*> cbs;
+
+		// NOTE: Pool threads don't use the socket and cb of the jobs, so they can
+		// be reset even for the job being protected.
+		auto dropJob = [socket, &cbs](CryptoJob* job)
+		{
+			if (job->socket != socket)
+			{
+				return;
+			}
+
+			if (job->cb)
+			{
+				cbs.push_back(job->cb);
+			}
+
+			job->socket = nullptr;
+			job->cb     = nullptr;
+		};
+
+		for (auto& partition : pool.partitions)
+		{
+			const std::lock_guard<std::mutex> lock(partition->mutex);
+
+			for (auto* job : partition->jobs)
+			{
+				dropJob(job);
+			}
+
+			for (auto* job : partition->runningJobs)
+			{
+				dropJob(job);
+			}
+		}
+
+		{
+			const std::lock_guard<std::mutex> lock(pool.doneMutex);
+
+			for (auto* job : pool.doneJobs)
+			{
+				dropJob(job);
+			}
+		}
+
+		// Jobs being sent by OnUvAsync() (i.e. the socket is closed by a send
+		// callback).
+		for (auto* job : pool.sendingJobs)
+		{
+			dropJob(job);
+		}
+
+		for (auto* cb : cbs)
+		{
+			(*cb)(false);
+			delete cb;
+		}
+	}
+
+	void SrtpCryptoPool::RemoveSession(const RTC::SrtpSession* session)
+	{
+		MS_TRACE();
+
+		if (!CryptoPool)
+		{
+			return;
+		}
+
+		auto& pool = *CryptoPool;
+		std::unique_lock<std::mutex> lock(pool.doneMutex);
+
+		// NOTE: This blocks just if packets of the session are still queued,
+		// which only happens when closing a transport that is sending media.
+		pool.doneCondition.wait(lock, [session]() { return session->GetPoolJobs() == 0u; });
+	}
+
+	void SrtpCryptoPool::SendPending(const RTC::SrtpSession* session)
+	{
+		MS_TRACE();
+
+		if (!CryptoPool)
+		{
+			return;
+		}
+
+		auto& pool = *CryptoPool;
+
+		// Being called by a send callback of a protected job, so just send the
+		// rest of them.
+		if (!pool.sendingJobs.empty())
+		{
+			sendJobs(pool);
+
+			return;
+		}
+
+		bool pending{ false };
+
+		{
+			std::unique_lock<std::mutex> lock(pool.doneMutex);
+
+			// NOTE: Just blocks while the pool thread protects the packets of the
+			// session, which is much shorter than the time they wait for the event
+			// loop to be woken up.
+			pool.doneCondition.wait(lock, [session]() { return session->GetPoolJobs() == 0u; });
+
+			for (const auto* job : pool.doneJobs)
+			{
+				if (job->session == session)
+				{
+					pending = true;
+
+					break;
+				}
+			}
+		}
+
+		if (pending)
+		{
+			SrtpCryptoPool::OnUvAsync();
+		}
+	}
+
+	bool SrtpCryptoPool::DeferSrtpEvent(int event)
+	{
+		if (!CurrentJob)
+		{
+			return false;
+		}
+
+		CurrentJob->srtpEvent = event;
+
+		return true;
+	}
+
+	size_t SrtpCryptoPool::GetPartition(const RTC::SrtpSession* session)
+	{
+		// NOTE: Pointers are aligned, so mix their bits (Fibonacci hashing).
+		const uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(session)) *
+		                      UINT64_C(0x9E3779B97F4A7C15);
+
+		return static_cast<size_t>(hash >> 32) % CryptoPool->partitions.size();
+	}
+
+	flatbuffers::Offset<FBS::Worker::SrtpCryptoPoolDump> SrtpCryptoPool::FillBuffer(
+	  flatbuffers::FlatBufferBuilder& builder)
+	{
+		MS_TRACE();
+
+		if (!CryptoPool)
+		{
+			return FBS::Worker::CreateSrtpCryptoPoolDump(builder);
+		}
+
+		const uint64_t sentPackets = CryptoPool->protectedPackets + CryptoPool->failedPackets;
+
+		return FBS::Worker::CreateSrtpCryptoPoolDump(
+		  builder,
+		  // threads.
+		  static_cast<uint8_t>(CryptoPool->partitions.size()),
+		  // protectedPackets.
+		  CryptoPool->protectedPackets,
+		  // inlinePackets.
+		  CryptoPool->inlinePackets,
+		  // failedPackets.
+		  CryptoPool->failedPackets,
+		  // queueDepth.
+		  static_cast<uint32_t>(CryptoPool->queueDepth),
+		  // maxQueueDepth.
+		  static_cast<uint32_t>(CryptoPool->maxQueueDepth),
+		  // avgLatencyNs.
+		  sentPackets != 0u ? CryptoPool->latencyNs / sentPackets : 0u);
+	}
+
+	void SrtpCryptoPool::OnUvAsync()
+	{
+		MS_TRACE();
+
+		auto& pool = *CryptoPool;
+
+		MS_ASSERT(pool.sendingJobs.empty(), "already sending protected jobs");
+
+		{
+			const std::lock_guard<std::mutex> lock(pool.doneMutex);
+
+			pool.sendingJobs.swap(pool.doneJobs);
+		}
+
+		if (pool.sendingJobs.empty())
+		{
+			return;
+		}
+
+#ifdef MS_LIBURING_SUPPORTED
+		if (DepLibUring::IsEnabled())
+		{
+			// Activate liburing usage.
+			DepLibUring::SetActive();
+		}
+#endif
+
+#ifdef MS_SENDMMSG_SUPPORTED
+		// Queue UDP datagrams to send them in a single sendmmsg() call.
+		UdpSocketHandle::StartSendBatch();
+#endif
+
+		pool.sendingIndex = 0u;
+
+		sendJobs(pool);
+
+#ifdef MS_SENDMMSG_SUPPORTED
+		// Send all queued UDP datagrams.
+		UdpSocketHandle::FlushSendBatch();
+#endif
+
+#ifdef MS_LIBURING_SUPPORTED
+		if (DepLibUring::IsEnabled())
+		{
+			// Submit all prepared submission entries.
+			DepLibUring::Submit();
+		}
+#endif
+
+		for (auto* job : pool.sendingJobs)
+		{
+			pool.freeJobs.push_back(job);
+		}
+
+		pool.sendingJobs.clear();
+	}
+} // namespace RTC
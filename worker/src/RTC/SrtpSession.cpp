@@ -8,6 +8,7 @@
 #endif
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "RTC/SrtpCryptoPool.hpp"
 #include <cstring> // std::memset(), std::memcpy()
 
 namespace RTC
@@ -67,11 +68,11 @@ namespace RTC
 		}
 	}
 
-	void SrtpSession::OnSrtpEvent(srtp_event_data_t* data)
+	void SrtpSession::LogSrtpEvent(int event)
 	{
 		MS_TRACE();
 
-		switch (data->event)
+		switch (event)
 		{
 			case event_ssrc_collision:
 				MS_WARN_TAG(srtp, "SSRC collision occurred");
@@ -91,6 +92,18 @@ namespace RTC
 		}
 	}
 
+	void SrtpSession::OnSrtpEvent(srtp_event_data_t* data)
+	{
+		// NOTE: No MS_TRACE() since it may be called in a SrtpCryptoPool thread,
+		// which cannot log.
+		if (SrtpCryptoPool::DeferSrtpEvent(data->event))
+		{
+			return;
+		}
+
+		LogSrtpEvent(data->event);
+	}
+
 	/* Instance methods. */
 
 	SrtpSession::SrtpSession(Type type, CryptoSuite cryptoSuite, uint8_t* key, size_t keyLen)
@@ -109,6 +122,8 @@ namespace RTC
 				srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtp);
 				srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtcp);
 
+				this->rtpTrailerLength = 16u;
+
 				break;
 			}
 
@@ -117,6 +132,8 @@ namespace RTC
 				srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtp);
 				srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtcp);
 
+				this->rtpTrailerLength = 16u;
+
 				break;
 			}
 
@@ -125,6 +142,8 @@ namespace RTC
 				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
 				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
 
+				this->rtpTrailerLength = 10u;
+
 				break;
 			}
 
@@ -134,6 +153,8 @@ namespace RTC
 				// NOTE: Must be 80 for RTCP.
 				srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
 
+				this->rtpTrailerLength = 4u;
+
 				break;
 			}
 
@@ -165,11 +186,21 @@ namespace RTC
 		policy.window_size     = 1024;
 		policy.next            = nullptr;
 
+		// Outgoing packets of AEAD suites are protected by SrtpAesGcm.
+		if (
+		  type == Type::OUTBOUND &&
+		  (cryptoSuite == CryptoSuite::AEAD_AES_256_GCM || cryptoSuite == CryptoSuite::AEAD_AES_128_GCM))
+		{
+			this->aesGcm = new SrtpAesGcm(keyLen - SrtpAesGcm::SaltLength, key);
+		}
+
 		// Set the SRTP session.
 		const srtp_err_status_t err = srtp_create(&this->session, &policy);
 
 		if (DepLibSRTP::IsError(err))
 		{
+			delete this->aesGcm;
+
 			MS_THROW_ERROR("srtp_create() failed: %s", DepLibSRTP::GetErrorString(err));
 		}
 	}
@@ -178,6 +209,9 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Wait for the packets being protected in the pool, if any.
+		SrtpCryptoPool::RemoveSession(this);
+
 		if (this->session != nullptr)
 		{
 			const srtp_err_status_t err = srtp_dealloc(this->session);
@@ -187,20 +221,44 @@ namespace RTC
 				MS_ABORT("srtp_dealloc() failed: %s", DepLibSRTP::GetErrorString(err));
 			}
 		}
+
+		delete this->aesGcm;
 	}
 
 	bool SrtpSession::EncryptRtp(const uint8_t** data, size_t* len)
 	{
 		MS_TRACE();
 
+		return EncryptRtp(*data, *len, nullptr, 0u, data, len);
+	}
+
+	/**
+	 * Gathers the given header and payload into the encrypt buffer and encrypts
+	 * it, so the header can be built apart from the payload without modifying
+	 * the original packet.
+	 */
+	bool SrtpSession::EncryptRtp(
+	  const uint8_t* header,
+	  size_t headerLen,
+	  const uint8_t* payload,
+	  size_t payloadLen,
+	  const uint8_t** data,
+	  size_t* len)
+	{
+		MS_TRACE();
+
+		size_t rtpLen = headerLen + payloadLen;
+
 		// Ensure that the resulting SRTP packet fits into the encrypt buffer.
-		if (*len + SRTP_MAX_TRAILER_LEN > EncryptBufferSize)
+		if (rtpLen + SRTP_MAX_TRAILER_LEN > EncryptBufferSize)
 		{
-			MS_WARN_TAG(srtp, "cannot encrypt RTP packet, size too big (%zu bytes)", *len);
+			MS_WARN_TAG(srtp, "cannot encrypt RTP packet, size too big (%zu bytes)", rtpLen);
 
 			return false;
 		}
 
+		const std::lock_guard<std::mutex> lock(this->mutex);
+
 		uint8_t* encryptBuffer = EncryptBuffer;
 
 #ifdef MS_LIBURING_SUPPORTED
@@ -223,23 +281,85 @@ namespace RTC
 	protect:
 #endif
 
-		std::memcpy(encryptBuffer, *data, *len);
+		std::memcpy(encryptBuffer, header, headerLen);
 
-		const srtp_err_status_t err = srtp_protect(this->session, encryptBuffer, len);
+		if (payloadLen != 0u)
+		{
+			std::memcpy(encryptBuffer + headerLen, payload, payloadLen);
+		}
 
-		if (DepLibSRTP::IsError(err))
+		if (this->aesGcm)
+		{
+			if (!this->aesGcm->ProtectRtp(encryptBuffer, &rtpLen))
+			{
+				MS_WARN_TAG(srtp, "SrtpAesGcm::ProtectRtp() failed");
+
+				return false;
+			}
+		}
+		else
 		{
-			MS_WARN_TAG(srtp, "srtp_protect() failed: %s", DepLibSRTP::GetErrorString(err));
+			const srtp_err_status_t err = srtp_protect(this->session, encryptBuffer, &rtpLen);
 
-			return false;
+			if (DepLibSRTP::IsError(err))
+			{
+				MS_WARN_TAG(srtp, "srtp_protect() failed: %s", DepLibSRTP::GetErrorString(err));
+
+				return false;
+			}
 		}
 
-		// Update the given data pointer.
+		// Update the given data pointer and length.
 		*data = const_cast<const uint8_t*>(encryptBuffer);
+		*len  = rtpLen;
 
 		return true;
 	}
 
+	/**
+	 * Encrypts the given RTP packet in place. The buffer must have room for the
+	 * SRTP trailer.
+	 *
+	 * NOTE: It may be called from a thread other than the one owning the
+	 * session (see SrtpCryptoPool), so it must not log.
+	 */
+	bool SrtpSession::ProtectRtp(uint8_t* data, size_t* len)
+	{
+		const std::lock_guard<std::mutex> lock(this->mutex);
+
+		if (this->aesGcm)
+		{
+			return this->aesGcm->ProtectRtp(data, len);
+		}
+
+		const srtp_err_status_t err = srtp_protect(this->session, data, len);
+
+		return !DepLibSRTP::IsError(err);
+	}
+
+	/**
+	 * Encrypts the given RTP packets in place and in order. Same considerations
+	 * as in ProtectRtp() apply.
+	 */
+	void SrtpSession::ProtectRtp(RtpBuffer* buffers, size_t count)
+	{
+		const std::lock_guard<std::mutex> lock(this->mutex);
+
+		if (this->aesGcm)
+		{
+			this->aesGcm->ProtectRtp(buffers, count);
+
+			return;
+		}
+
+		for (size_t i{ 0u }; i < count; ++i)
+		{
+			auto& buffer = buffers[i];
+
+			buffer.ok = !DepLibSRTP::IsError(srtp_protect(this->session, buffer.data, &buffer.len));
+		}
+	}
+
 	bool SrtpSession::DecryptSrtp(uint8_t* data, size_t* len)
 	{
 		MS_TRACE();
@@ -268,15 +388,29 @@ namespace RTC
 			return false;
 		}
 
+		const std::lock_guard<std::mutex> lock(this->mutex);
+
 		std::memcpy(EncryptBuffer, *data, *len);
 
-		const srtp_err_status_t err = srtp_protect_rtcp(this->session, EncryptBuffer, len);
+		if (this->aesGcm)
+		{
+			if (!this->aesGcm->ProtectRtcp(EncryptBuffer, len))
+			{
+				MS_WARN_TAG(srtp, "SrtpAesGcm::ProtectRtcp() failed");
 
-		if (DepLibSRTP::IsError(err))
+				return false;
+			}
+		}
+		else
 		{
-			MS_WARN_TAG(srtp, "srtp_protect_rtcp() failed: %s", DepLibSRTP::GetErrorString(err));
+			const srtp_err_status_t err = srtp_protect_rtcp(this->session, EncryptBuffer, len);
 
-			return false;
+			if (DepLibSRTP::IsError(err))
+			{
+				MS_WARN_TAG(srtp, "srtp_protect_rtcp() failed: %s", DepLibSRTP::GetErrorString(err));
+
+				return false;
+			}
 		}
 
 		// Update the given data pointer.
@@ -285,6 +419,20 @@ namespace RTC
 		return true;
 	}
 
+	void SrtpSession::RemoveStream(uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		const std::lock_guard<std::mutex> lock(this->mutex);
+
+		srtp_stream_remove(this->session, uint32_t{ htonl(ssrc) });
+
+		if (this->aesGcm)
+		{
+			this->aesGcm->RemoveStream(ssrc);
+		}
+	}
+
 	bool SrtpSession::DecryptSrtcp(uint8_t* data, size_t* len)
 	{
 		MS_TRACE();
@@ -469,11 +469,40 @@ namespace RTC
 		this->password = password;
 	}
 
+	void StunPacket::SetHmacSha1Ctx(EVP_MAC_CTX* hmacSha1Ctx)
+	{
+		// Just for request, indication and success response messages.
+		if (this->klass == Class::ERROR_RESPONSE)
+		{
+			MS_ERROR("cannot set password for error responses");
+
+			return;
+		}
+
+		this->hmacSha1Ctx = hmacSha1Ctx;
+	}
+
 	StunPacket::Authentication StunPacket::CheckAuthentication(
 	  const std::string& usernameFragment1, const std::string& password)
 	{
 		MS_TRACE();
 
+		return CheckAuthentication(usernameFragment1, std::addressof(password), nullptr);
+	}
+
+	StunPacket::Authentication StunPacket::CheckAuthentication(
+	  const std::string& usernameFragment1, EVP_MAC_CTX* hmacSha1Ctx)
+	{
+		MS_TRACE();
+
+		return CheckAuthentication(usernameFragment1, nullptr, hmacSha1Ctx);
+	}
+
+	StunPacket::Authentication StunPacket::CheckAuthentication(
+	  const std::string& usernameFragment1, const std::string* password, EVP_MAC_CTX* hmacSha1Ctx)
+	{
+		MS_TRACE();
+
 		switch (this->klass)
 		{
 			case Class::REQUEST:
@@ -556,8 +585,10 @@ namespace RTC
 
 		// Calculate the HMAC-SHA1 of the message according to MESSAGE-INTEGRITY
 		// rules.
+		const size_t hmacDataLen = (this->messageIntegrity - 4) - this->data;
 		const uint8_t* computedMessageIntegrity =
-		  Utils::Crypto::GetHmacSha1(password, this->data, (this->messageIntegrity - 4) - this->data);
+		  hmacSha1Ctx ? Utils::Crypto::GetHmacSha1(hmacSha1Ctx, this->data, hmacDataLen)
+		              : Utils::Crypto::GetHmacSha1(*password, this->data, hmacDataLen);
 
 		Authentication result;
 
@@ -607,6 +638,20 @@ namespace RTC
 		return response;
 	}
 
+	const uint8_t* StunPacket::GetHmacSha1(const uint8_t* data, size_t len) const
+	{
+		MS_TRACE();
+
+		if (this->hmacSha1Ctx)
+		{
+			return Utils::Crypto::GetHmacSha1(this->hmacSha1Ctx, data, len);
+		}
+		else
+		{
+			return Utils::Crypto::GetHmacSha1(this->password, data, len);
+		}
+	}
+
 	void StunPacket::Serialize(uint8_t* buffer)
 	{
 		MS_TRACE();
@@ -619,7 +664,7 @@ namespace RTC
 		   this->klass == Class::SUCCESS_RESPONSE);
 		const bool addErrorCode = ((this->errorCode != 0u) && this->klass == Class::ERROR_RESPONSE);
 		const bool addMessageIntegrity =
-		  (this->klass != Class::ERROR_RESPONSE && !this->password.empty());
+		  (this->klass != Class::ERROR_RESPONSE && (this->hmacSha1Ctx || !this->password.empty()));
 		const bool addFingerprint{ true }; // Do always.
 
 		// Update data pointer.
@@ -869,8 +914,7 @@ namespace RTC
 
 			// Calculate the HMAC-SHA1 of the packet according to MESSAGE-INTEGRITY
 			// rules.
-			const uint8_t* computedMessageIntegrity =
-			  Utils::Crypto::GetHmacSha1(this->password, buffer, pos);
+			const uint8_t* computedMessageIntegrity = GetHmacSha1(buffer, pos);
 
 			Utils::Byte::Set2Bytes(buffer, pos, static_cast<uint16_t>(Attribute::MESSAGE_INTEGRITY));
 			Utils::Byte::Set2Bytes(buffer, pos + 2, 20);
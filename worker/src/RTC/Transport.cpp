@@ -6,6 +6,9 @@
 #ifdef MS_LIBURING_SUPPORTED
 #include "DepLibUring.hpp"
 #endif
+#ifdef MS_SENDMMSG_SUPPORTED
+#include "handles/UdpSocketHandle.hpp"
+#endif
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
@@ -22,6 +25,7 @@
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/SimpleConsumer.hpp"
 #include "RTC/SimulcastConsumer.hpp"
+#include "RTC/SrtpCryptoPool.hpp"
 #include "RTC/SvcConsumer.hpp"
 #include <libwebrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h> // webrtc::RtpPacketSendInfo
 #include <iterator>                                              // std::ostream_iterator
@@ -31,6 +35,8 @@ namespace RTC
 {
 	static const size_t DefaultSctpSendBufferSize{ 262144 }; // 2^18.
 	static const size_t MaxSctpSendBufferSize{ 268435456 };  // 2^28.
+	static constexpr size_t RtpHeaderBufferSize{ RTC::MtuSize };
+	thread_local static uint8_t RtpHeaderBuffer[RtpHeaderBufferSize];
 
 	/* Instance methods. */
 
@@ -1752,6 +1758,84 @@ namespace RTC
 		return it->second;
 	}
 
+	/**
+	 * Encrypts the RTP packet as it must be sent to the given Consumer (with its
+	 * MID) without writing into the packet, which is shared by all Consumers of
+	 * the Producer. The Consumer's header is built apart and gathered with the
+	 * untouched payload into the SRTP encrypt buffer.
+	 *
+	 * If the SRTP crypto pool is enabled and the given tuple is UDP, the packet
+	 * is handed to the pool, which protects it in another thread and then sends
+	 * it through the tuple. In that case data is set to nullptr, len is the size
+	 * of the protected packet and the pool owns cb. Otherwise packets of the
+	 * session queued in the pool are sent before it's encrypted inline.
+	 */
+	bool Transport::EncryptRtpPacket(
+	  RTC::SrtpSession* srtpSession,
+	  const RTC::Consumer* consumer,
+	  RTC::RtpPacket* packet,
+	  const RTC::TransportTuple* tuple,
+	  const uint8_t** data,
+	  size_t* len,
+	  onSendCallback* cb) const
+	{
+		MS_TRACE();
+
+		const uint8_t* header  = packet->GetData();
+		const size_t headerLen = packet->GetHeaderLength();
+
+		if (consumer && !consumer->GetRtpParameters().mid.empty())
+		{
+			if (headerLen <= RtpHeaderBufferSize)
+			{
+				packet->CopyHeader(RtpHeaderBuffer, consumer->GetRtpParameters().mid);
+
+				header = RtpHeaderBuffer;
+			}
+			else
+			{
+				packet->UpdateMid(consumer->GetRtpParameters().mid);
+			}
+		}
+
+		const uint8_t* payload  = packet->GetData() + headerLen;
+		const size_t payloadLen = packet->GetSize() - headerLen;
+
+		if (
+		  tuple && tuple->GetProtocol() == RTC::TransportTuple::Protocol::UDP &&
+		  RTC::SrtpCryptoPool::IsEnabled() &&
+		  RTC::SrtpCryptoPool::ProtectAndSend(
+		    srtpSession,
+		    tuple->GetUdpSocket(),
+		    tuple->GetRemoteAddress(),
+		    header,
+		    headerLen,
+		    payload,
+		    payloadLen,
+		    cb))
+		{
+			*data = nullptr;
+			*len  = headerLen + payloadLen + srtpSession->GetRtpTrailerLength();
+
+			return true;
+		}
+
+		// Packets of the session given to the pool (if any) must be sent first.
+		RTC::SrtpCryptoPool::SendPending(srtpSession);
+
+		return srtpSession->EncryptRtp(header, headerLen, payload, payloadLen, data, len);
+	}
+
+	void Transport::UpdateRtpPacketMid(const RTC::Consumer* consumer, RTC::RtpPacket* packet) const
+	{
+		MS_TRACE();
+
+		if (consumer && !consumer->GetRtpParameters().mid.empty())
+		{
+			packet->UpdateMid(consumer->GetRtpParameters().mid);
+		}
+	}
+
 	void Transport::HandleRtcpPacket(RTC::RTCP::Packet* packet)
 	{
 		MS_TRACE();
@@ -2165,6 +2249,11 @@ namespace RTC
 		}
 #endif
 
+#ifdef MS_SENDMMSG_SUPPORTED
+		// Queue UDP datagrams to send them in a single sendmmsg() call.
+		UdpSocketHandle::StartSendBatch();
+#endif
+
 		for (auto& kv : this->mapConsumers)
 		{
 			auto* consumer = kv.second;
@@ -2209,6 +2298,11 @@ namespace RTC
 			SendRtcpCompoundPacket(packet.get());
 		}
 
+#ifdef MS_SENDMMSG_SUPPORTED
+		// Send all queued UDP datagrams.
+		UdpSocketHandle::FlushSendBatch();
+#endif
+
 #ifdef MS_LIBURING_SUPPORTED
 		if (DepLibUring::IsEnabled())
 		{
@@ -5,8 +5,10 @@
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "RTC/RTCP/FeedbackPsRemb.hpp"
-#include <iterator> // std::ostream_iterator
-#include <sstream>  // std::ostringstream
+#include <algorithm> // std::fill()
+#include <iterator>  // std::ostream_iterator
+#include <limits>    // std::numeric_limits
+#include <sstream>   // std::ostringstream
 
 namespace RTC
 {
@@ -17,6 +19,10 @@ namespace RTC
 	static constexpr uint64_t PacketArrivalTimestampWindow{ 500u };    // In ms.
 	static constexpr uint8_t UnlimitedRembNumPackets{ 4u };
 	static constexpr size_t PacketLossHistogramLength{ 24 };
+	// Must be a power of two. Enough to hold PacketArrivalTimestampWindow ms of
+	// packets at more than 16000 packets per second.
+	static constexpr size_t PacketArrivalTimesCapacity{ 8192u };
+	static constexpr uint64_t NoPacketArrivalTime{ std::numeric_limits<uint64_t>::max() };
 
 	/* Instance methods. */
 
@@ -35,6 +41,8 @@ namespace RTC
 				// Create a feedback packet.
 				ResetTransportCcFeedback(0u);
 
+				this->packetArrivalTimes.assign(PacketArrivalTimesCapacity, NoPacketArrivalTime);
+
 				// Create the feedback send periodic timer.
 				this->transportCcFeedbackSendPeriodicTimer = new TimerHandle(this);
 
@@ -123,7 +131,7 @@ namespace RTC
 				}
 
 				// Only insert the packet when receiving it for the first time.
-				if (!this->mapPacketArrivalTimes.try_emplace(wideSeqNumber, nowMs).second)
+				if (!InsertPacketArrivalTime(wideSeqNumber, nowMs))
 				{
 					break;
 				}
@@ -183,17 +191,33 @@ namespace RTC
 			return;
 		}
 
-		auto it = this->mapPacketArrivalTimes.lower_bound(this->transportCcFeedbackWideSeqNumStart);
+		// Start from the oldest packet whose seq is not lower than the start seq
+		// of the feedback.
+		uint16_t sequenceNumber = this->oldestPacketArrivalSeqNum;
 
-		if (it == this->mapPacketArrivalTimes.end())
+		if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(
+		      this->transportCcFeedbackWideSeqNumStart, this->oldestPacketArrivalSeqNum))
 		{
-			return;
+			if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(
+			      this->transportCcFeedbackWideSeqNumStart, this->newestPacketArrivalSeqNum))
+			{
+				return;
+			}
+
+			sequenceNumber = this->transportCcFeedbackWideSeqNumStart;
 		}
 
-		for (; it != this->mapPacketArrivalTimes.end(); ++it)
+		const uint16_t endSequenceNumber = this->newestPacketArrivalSeqNum + 1;
+
+		for (; sequenceNumber != endSequenceNumber; ++sequenceNumber)
 		{
-			auto sequenceNumber = it->first;
-			auto timestamp      = it->second;
+			const auto timestamp = GetPacketArrivalTime(sequenceNumber);
+
+			// Packet not received.
+			if (timestamp == NoPacketArrivalTime)
+			{
+				continue;
+			}
 
 			// If the base is not set in this packet let's set it.
 			// NOTE: This maybe needed many times during this loop since the current
@@ -339,16 +363,82 @@ namespace RTC
 		if (nowMs >= PacketArrivalTimestampWindow)
 		{
 			uint64_t expiryTimestamp = nowMs - PacketArrivalTimestampWindow;
-			auto it                  = this->mapPacketArrivalTimes.begin();
 
-			while (it != this->mapPacketArrivalTimes.end() &&
-			       it->first != this->transportCcFeedbackWideSeqNumStart &&
-			       RTC::SeqManager<uint16_t>::IsSeqLowerThan(it->first, seqNum) &&
-			       it->second <= expiryTimestamp)
+			// NOTE: The packet with seqNum was just inserted so the ring cannot
+			// become empty.
+			while (this->oldestPacketArrivalSeqNum != this->transportCcFeedbackWideSeqNumStart &&
+			       RTC::SeqManager<uint16_t>::IsSeqLowerThan(this->oldestPacketArrivalSeqNum, seqNum) &&
+			       GetPacketArrivalTime(this->oldestPacketArrivalSeqNum) <= expiryTimestamp)
+			{
+				RemoveOldestPacketArrivalTime();
+			}
+		}
+	}
+
+	// Returns false if the packet was already there or doesn't fit in the ring.
+	bool TransportCongestionControlServer::InsertPacketArrivalTime(uint16_t seqNum, uint64_t nowMs)
+	{
+		MS_TRACE();
+
+		if (!this->transportWideSeqNumberReceived)
+		{
+			this->oldestPacketArrivalSeqNum = seqNum;
+			this->newestPacketArrivalSeqNum = seqNum;
+		}
+		else if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(seqNum, this->newestPacketArrivalSeqNum))
+		{
+			// Make room for it by removing the oldest packets.
+			if (static_cast<uint16_t>(seqNum - this->newestPacketArrivalSeqNum) >= PacketArrivalTimesCapacity)
+			{
+				std::fill(
+				  this->packetArrivalTimes.begin(), this->packetArrivalTimes.end(), NoPacketArrivalTime);
+
+				this->oldestPacketArrivalSeqNum = seqNum;
+			}
+			else
+			{
+				while (static_cast<uint16_t>(seqNum - this->oldestPacketArrivalSeqNum) >=
+				       PacketArrivalTimesCapacity)
+				{
+					RemoveOldestPacketArrivalTime();
+				}
+			}
+
+			this->newestPacketArrivalSeqNum = seqNum;
+		}
+		else if (RTC::SeqManager<uint16_t>::IsSeqLowerThan(seqNum, this->oldestPacketArrivalSeqNum))
+		{
+			if (static_cast<uint16_t>(this->newestPacketArrivalSeqNum - seqNum) >= PacketArrivalTimesCapacity)
 			{
-				it = this->mapPacketArrivalTimes.erase(it);
+				MS_WARN_DEV("packet too old to fit in the ring, ignoring it [seq:%" PRIu16 "]", seqNum);
+
+				return false;
 			}
+
+			this->oldestPacketArrivalSeqNum = seqNum;
 		}
+		else if (GetPacketArrivalTime(seqNum) != NoPacketArrivalTime)
+		{
+			return false;
+		}
+
+		GetPacketArrivalTime(seqNum) = nowMs;
+
+		return true;
+	}
+
+	// Removes the oldest packet and moves to the next received one.
+	// NOTE: It must not be called if the oldest packet is the only one.
+	void TransportCongestionControlServer::RemoveOldestPacketArrivalTime()
+	{
+		MS_TRACE();
+
+		GetPacketArrivalTime(this->oldestPacketArrivalSeqNum) = NoPacketArrivalTime;
+
+		do
+		{
+			++this->oldestPacketArrivalSeqNum;
+		} while (GetPacketArrivalTime(this->oldestPacketArrivalSeqNum) == NoPacketArrivalTime);
 	}
 
 	void TransportCongestionControlServer::MaySendLimitationRembFeedback(uint64_t nowMs)
@@ -4,6 +4,7 @@
 #include "RTC/UdpSocket.hpp"
 #include "Logger.hpp"
 #include "RTC/PortManager.hpp"
+#include "RTC/SrtpCryptoPool.hpp"
 #include <string>
 
 namespace RTC
@@ -17,6 +18,12 @@ namespace RTC
 	    listener(listener), fixedPort(true)
 	{
 		MS_TRACE();
+
+		if (flags.udpShardingSteering)
+		{
+			this->udpShard      = true;
+			this->udpShardIndex = flags.udpShardIndex;
+		}
 	}
 
 	UdpSocket::UdpSocket(
@@ -40,13 +47,27 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Deleted by the listener while delivering a batch.
+		if (this->deletedWhileDelivering)
+		{
+			*this->deletedWhileDelivering = true;
+		}
+
+		// Drop packets being protected to be sent through this socket.
+		RTC::SrtpCryptoPool::RemoveSocket(this);
+
 		if (!this->fixedPort)
 		{
 			RTC::PortManager::Unbind(this->portRangeHash, this->localPort);
 		}
+		else if (this->udpShard)
+		{
+			RTC::PortManager::UnbindUdpShard(this->localIp, this->localPort, this->udpShardIndex);
+		}
 	}
 
-	void UdpSocket::UserOnUdpDatagramReceived(const uint8_t* data, size_t len, const struct sockaddr* addr)
+	void UdpSocket::UserOnUdpDatagramsReceived(
+	  const std::vector<::UdpSocketHandle::RecvDatagram>& datagrams)
 	{
 		MS_TRACE();
 
@@ -57,7 +78,31 @@ namespace RTC
 			return;
 		}
 
+		bool deleted{ false };
+
+		this->deletedWhileDelivering = std::addressof(deleted);
+
 		// Notify the reader.
-		this->listener->OnUdpSocketPacketReceived(this, data, len, addr);
+		for (const auto& datagram : datagrams)
+		{
+			this->listener->OnUdpSocketPacketReceived(
+			  this,
+			  datagram.data,
+			  datagram.len,
+			  reinterpret_cast<const struct sockaddr*>(std::addressof(datagram.addr)));
+
+			// The listener may have closed or deleted this socket while handling the
+			// datagram, so don't deliver the rest of the batch.
+			if (deleted)
+			{
+				return;
+			}
+			else if (IsClosed())
+			{
+				break;
+			}
+		}
+
+		this->deletedWhileDelivering = nullptr;
 	}
 } // namespace RTC
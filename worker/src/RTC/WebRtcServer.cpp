@@ -4,6 +4,7 @@
 #include "RTC/WebRtcServer.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "RTC/PortManager.hpp"
 #include "Settings.hpp"
 #include "Utils.hpp"
 #include <cmath> // std::pow()
@@ -17,6 +18,11 @@ namespace RTC
 	static constexpr uint16_t IceTypePreference{ 64 };
 	// We do not support non rtcp-mux so component is always 1.
 	static constexpr uint16_t IceComponent{ 1 };
+	// Characters of the local ICE username fragment (its first one encodes the
+	// shard index, which is also the key of the shard socket in the steering
+	// map of the SO_REUSEPORT group).
+	static constexpr char ShardIndexChars[]{ "0123456789abcdefghijklmnopqrstuvwxyz" };
+	static constexpr size_t MaxShards{ sizeof(ShardIndexChars) - 1 };
 
 	static inline uint32_t generateIceCandidatePriority(uint16_t localPreference)
 	{
@@ -55,7 +61,8 @@ namespace RTC
 	WebRtcServer::WebRtcServer(
 	  RTC::Shared* shared,
 	  const std::string& id,
-	  const flatbuffers::Vector<flatbuffers::Offset<FBS::Transport::ListenInfo>>* listenInfos)
+	  const flatbuffers::Vector<flatbuffers::Offset<FBS::Transport::ListenInfo>>* listenInfos,
+	  const FBS::Worker::WebRtcServerShard* shard)
 	  : id(id), shared(shared)
 	{
 		MS_TRACE();
@@ -69,6 +76,25 @@ namespace RTC
 			MS_THROW_TYPE_ERROR("wrong listenInfos (too many entries)");
 		}
 
+		if (shard)
+		{
+#ifndef __linux__
+			MS_THROW_TYPE_ERROR("wrong shard (only supported in Linux)");
+#endif
+
+			if (shard->count() == 0 || shard->count() > MaxShards)
+			{
+				MS_THROW_TYPE_ERROR("wrong shard.count (must be between 1 and %zu)", MaxShards);
+			}
+			else if (shard->index() >= shard->count())
+			{
+				MS_THROW_TYPE_ERROR("wrong shard.index (must be lower than shard.count)");
+			}
+
+			this->shardIndex = shard->index();
+			this->shardCount = shard->count();
+		}
+
 		try
 		{
 			for (const auto* listenInfo : *listenInfos)
@@ -92,6 +118,21 @@ namespace RTC
 
 				if (listenInfo->protocol() == FBS::Transport::Protocol::UDP)
 				{
+					// All shards listen on the same UDP port so a fixed one is required.
+					if (this->shardCount != 0)
+					{
+						if (
+						  listenInfo->port() == 0 ||
+						  (listenInfo->portRange()->min() != 0 && listenInfo->portRange()->max() != 0))
+						{
+							MS_THROW_TYPE_ERROR("wrong listenInfo (sharding requires a fixed UDP port)");
+						}
+
+						flags.udpShardingReusePort = true;
+						flags.udpShardingSteering  = true;
+						flags.udpShardIndex        = this->shardIndex;
+					}
+
 					// This may throw.
 					RTC::UdpSocket* udpSocket;
 
@@ -127,7 +168,7 @@ namespace RTC
 						  portRangeHash);
 					}
 
-					this->udpSocketOrTcpServers.emplace_back(udpSocket, nullptr, announcedAddress);
+					this->udpSocketOrTcpServers.emplace_back(udpSocket, nullptr, announcedAddress, flags);
 
 					if (listenInfo->sendBufferSize() != 0)
 					{
@@ -184,7 +225,7 @@ namespace RTC
 						  portRangeHash);
 					}
 
-					this->udpSocketOrTcpServers.emplace_back(nullptr, tcpServer, announcedAddress);
+					this->udpSocketOrTcpServers.emplace_back(nullptr, tcpServer, announcedAddress, flags);
 
 					if (listenInfo->sendBufferSize() != 0)
 					{
@@ -245,6 +286,15 @@ namespace RTC
 		}
 		this->webRtcTransports.clear();
 
+		for (auto& kv : this->mapTupleConnectedUdpSocket)
+		{
+			auto* connectedUdpSocket = kv.second;
+
+			delete connectedUdpSocket;
+		}
+		this->mapTupleConnectedUdpSocket.clear();
+		this->mapConnectedUdpSocketUdpSocket.clear();
+
 		for (auto& item : this->udpSocketOrTcpServers)
 		{
 			delete item.udpSocket;
@@ -483,6 +533,93 @@ namespace RTC
 		webRtcTransport->ProcessNonStunPacketFromWebRtcServer(tuple, data, len);
 	}
 
+	void WebRtcServer::CreateConnectedUdpSocket(RTC::TransportTuple* tuple)
+	{
+		MS_TRACE();
+
+		// Fallback for shards whose tuples cannot be added to the steering
+		// program (i.e. it's the classic BPF one). Non STUN packets carry no ICE
+		// username fragment, however the kernel prefers a socket connected to the
+		// remote address over the ones in the SO_REUSEPORT group, so create one
+		// for the tuple. It's just used to receive.
+		//
+		// NOTE: It costs a fd per tuple. It drops every datagram until connected
+		// (see PortManager::Bind()) so it does not take packets of other tuples.
+
+		const UdpSocketOrTcpServer* listening{ nullptr };
+
+		// NOTE: The local address of a UDP tuple points to the one of its UdpSocket.
+		for (const auto& item : this->udpSocketOrTcpServers)
+		{
+			if (item.udpSocket && item.udpSocket->GetLocalAddress() == tuple->GetLocalAddress())
+			{
+				listening = std::addressof(item);
+
+				break;
+			}
+		}
+
+		if (!listening)
+		{
+			MS_ERROR("no UdpSocket found for the tuple");
+
+			return;
+		}
+
+		auto ip    = listening->udpSocket->GetLocalIp();
+		auto flags = listening->flags;
+
+		// NOTE: Joins the SO_REUSEPORT group but it's not stored in the steering
+		// map, so STUN requests are still steered to the listening socket of each
+		// shard.
+		flags.udpShardingSteering = false;
+
+		RTC::UdpSocket* connectedUdpSocket{ nullptr };
+
+		try
+		{
+			// This may throw.
+			connectedUdpSocket =
+			  new RTC::UdpSocket(this, ip, listening->udpSocket->GetLocalPort(), flags);
+
+			// This may throw.
+			connectedUdpSocket->Connect(tuple->GetRemoteAddress());
+		}
+		catch (const MediaSoupError& error)
+		{
+			MS_WARN_TAG(
+			  ice,
+			  "cannot create connected UDP socket, non STUN packets may reach other shard: %s",
+			  error.what());
+
+			delete connectedUdpSocket;
+
+			return;
+		}
+
+		this->mapTupleConnectedUdpSocket[tuple->hash]             = connectedUdpSocket;
+		this->mapConnectedUdpSocketUdpSocket[connectedUdpSocket] = listening->udpSocket;
+	}
+
+	void WebRtcServer::DeleteConnectedUdpSocket(RTC::TransportTuple* tuple)
+	{
+		MS_TRACE();
+
+		auto it = this->mapTupleConnectedUdpSocket.find(tuple->hash);
+
+		if (it == this->mapTupleConnectedUdpSocket.end())
+		{
+			return;
+		}
+
+		auto* connectedUdpSocket = it->second;
+
+		this->mapTupleConnectedUdpSocket.erase(it);
+		this->mapConnectedUdpSocketUdpSocket.erase(connectedUdpSocket);
+
+		delete connectedUdpSocket;
+	}
+
 	inline void WebRtcServer::OnWebRtcTransportCreated(RTC::WebRtcTransport* webRtcTransport)
 	{
 		MS_TRACE();
@@ -512,6 +649,22 @@ namespace RTC
 		}
 	}
 
+	inline void WebRtcServer::OnWebRtcTransportNeedLocalIceUsernameFragment(
+	  RTC::WebRtcTransport* /*webRtcTransport*/, std::string& usernameFragment)
+	{
+		MS_TRACE();
+
+		usernameFragment = Utils::Crypto::GetRandomString(32);
+
+		// NOTE: The steering program attached to the SO_REUSEPORT group reads the
+		// first character of the USERNAME attribute of STUN requests to choose
+		// the socket (so the shard) to deliver them to.
+		if (this->shardCount != 0)
+		{
+			usernameFragment[0] = ShardIndexChars[this->shardIndex];
+		}
+	}
+
 	inline void WebRtcServer::OnWebRtcTransportLocalIceUsernameFragmentAdded(
 	  RTC::WebRtcTransport* webRtcTransport, const std::string& usernameFragment)
 	{
@@ -551,6 +704,22 @@ namespace RTC
 		}
 
 		this->mapTupleWebRtcTransport[tuple->hash] = webRtcTransport;
+
+		if (this->shardCount != 0 && tuple->GetProtocol() == RTC::TransportTuple::Protocol::UDP)
+		{
+			auto* udpSocket = tuple->GetUdpSocket();
+
+			// Make the steering program deliver non STUN packets of the tuple to
+			// this shard.
+			if (!RTC::PortManager::AddUdpShardTuple(
+			      udpSocket->GetLocalIp(),
+			      udpSocket->GetLocalPort(),
+			      this->shardIndex,
+			      tuple->GetRemoteAddress()))
+			{
+				CreateConnectedUdpSocket(tuple);
+			}
+		}
 	}
 
 	inline void WebRtcServer::OnWebRtcTransportTransportTupleRemoved(
@@ -566,6 +735,16 @@ namespace RTC
 		}
 
 		this->mapTupleWebRtcTransport.erase(tuple->hash);
+
+		if (this->shardCount != 0 && tuple->GetProtocol() == RTC::TransportTuple::Protocol::UDP)
+		{
+			auto* udpSocket = tuple->GetUdpSocket();
+
+			RTC::PortManager::RemoveUdpShardTuple(
+			  udpSocket->GetLocalIp(), udpSocket->GetLocalPort(), this->shardIndex, tuple->GetRemoteAddress());
+
+			DeleteConnectedUdpSocket(tuple);
+		}
 	}
 
 	inline void WebRtcServer::OnUdpSocketPacketReceived(
@@ -573,6 +752,18 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Packets received in a connected UdpSocket belong to the tuple of the
+		// listening UdpSocket, which is the one used to send.
+		if (this->shardCount != 0)
+		{
+			auto it = this->mapConnectedUdpSocketUdpSocket.find(socket);
+
+			if (it != this->mapConnectedUdpSocketUdpSocket.end())
+			{
+				socket = it->second;
+			}
+		}
+
 		RTC::TransportTuple tuple(socket, remoteAddr);
 
 		OnPacketReceived(&tuple, data, len);
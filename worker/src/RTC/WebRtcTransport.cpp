@@ -279,10 +279,16 @@ namespace RTC
 			}
 
 			auto iceConsentTimeout = options->iceConsentTimeout();
+			std::string usernameFragment;
+
+			// The WebRtcServer may need to encode data into the local ICE username
+			// fragment.
+			this->webRtcTransportListener->OnWebRtcTransportNeedLocalIceUsernameFragment(
+			  this, usernameFragment);
 
 			// Create a ICE server.
 			this->iceServer = new RTC::IceServer(
-			  this, Utils::Crypto::GetRandomString(32), Utils::Crypto::GetRandomString(32), iceConsentTimeout);
+			  this, usernameFragment, Utils::Crypto::GetRandomString(32), iceConsentTimeout);
 
 			// Create a DTLS transport.
 			this->dtlsTransport = new RTC::DtlsTransport(this);
@@ -554,8 +560,18 @@ namespace RTC
 
 			case Channel::ChannelRequest::Method::TRANSPORT_RESTART_ICE:
 			{
-				const std::string usernameFragment = Utils::Crypto::GetRandomString(32);
-				const std::string password         = Utils::Crypto::GetRandomString(32);
+				std::string usernameFragment;
+				const std::string password = Utils::Crypto::GetRandomString(32);
+
+				if (this->webRtcTransportListener)
+				{
+					this->webRtcTransportListener->OnWebRtcTransportNeedLocalIceUsernameFragment(
+					  this, usernameFragment);
+				}
+				else
+				{
+					usernameFragment = Utils::Crypto::GetRandomString(32);
+				}
 
 				this->iceServer->RestartIce(usernameFragment, password);
 
@@ -732,7 +748,7 @@ namespace RTC
 	}
 
 	void WebRtcTransport::SendRtpPacket(
-	  RTC::Consumer* /*consumer*/, RTC::RtpPacket* packet, RTC::Transport::onSendCallback* cb)
+	  RTC::Consumer* consumer, RTC::RtpPacket* packet, RTC::Transport::onSendCallback* cb)
 	{
 		MS_TRACE();
 
@@ -761,10 +777,11 @@ namespace RTC
 			return;
 		}
 
-		const uint8_t* data = packet->GetData();
-		auto len            = packet->GetSize();
+		const uint8_t* data{ nullptr };
+		size_t len{ 0u };
 
-		if (!this->srtpSendSession->EncryptRtp(&data, &len))
+		if (!EncryptRtpPacket(
+		      this->srtpSendSession, consumer, packet, this->iceServer->GetSelectedTuple(), &data, &len, cb))
 		{
 			if (cb)
 			{
@@ -775,6 +792,15 @@ namespace RTC
 			return;
 		}
 
+		// Protected and sent by the SrtpCryptoPool.
+		if (!data)
+		{
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+
+			return;
+		}
+
 		this->iceServer->GetSelectedTuple()->Send(data, len, cb);
 
 		// Increase send transmission.
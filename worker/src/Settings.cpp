@@ -53,15 +53,21 @@ void Settings::SetConfiguration(int argc, char* argv[])
 	// clang-format off
 	struct option options[] =
 	{
-		{ "logLevel",             optional_argument, nullptr, 'l' },
-		{ "logTags",              optional_argument, nullptr, 't' },
-		{ "rtcMinPort",           optional_argument, nullptr, 'm' },
-		{ "rtcMaxPort",           optional_argument, nullptr, 'M' },
-		{ "dtlsCertificateFile",  optional_argument, nullptr, 'c' },
-		{ "dtlsPrivateKeyFile",   optional_argument, nullptr, 'p' },
-		{ "libwebrtcFieldTrials", optional_argument, nullptr, 'W' },
-		{ "disableLiburing",      optional_argument, nullptr, 'd' },
-		{ nullptr,                0,                 nullptr,  0  }
+		{ "logLevel",                   optional_argument, nullptr, 'l' },
+		{ "logTags",                    optional_argument, nullptr, 't' },
+		{ "rtcMinPort",                 optional_argument, nullptr, 'm' },
+		{ "rtcMaxPort",                 optional_argument, nullptr, 'M' },
+		{ "dtlsCertificateFile",        optional_argument, nullptr, 'c' },
+		{ "dtlsPrivateKeyFile",         optional_argument, nullptr, 'p' },
+		{ "libwebrtcFieldTrials",       optional_argument, nullptr, 'W' },
+		{ "disableLiburing",            optional_argument, nullptr, 'd' },
+		{ "channelWriteCoalescing",     optional_argument, nullptr, 'C' },
+		{ "notificationBatchWindow",    optional_argument, nullptr, 'B' },
+		{ "srtpCryptoThreads",          optional_argument, nullptr, 'S' },
+		{ "dtlsHandshakeOffload",       optional_argument, nullptr, 'H' },
+		{ "dtlsCertificateCacheFile",   optional_argument, nullptr, 'k' },
+		{ "dtlsCertificateCacheMaxAge", optional_argument, nullptr, 'K' },
+		{ nullptr,                      0,                 nullptr,  0  }
 	};
 	// clang-format on
 	std::string stringValue;
@@ -172,6 +178,108 @@ void Settings::SetConfiguration(int argc, char* argv[])
 				break;
 			}
 
+			case 'C':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue == "true")
+				{
+					Settings::configuration.channelWriteCoalescing = true;
+				}
+
+				break;
+			}
+
+			case 'B':
+			{
+				int64_t window;
+
+				try
+				{
+					window = std::stoll(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (window < 0 || window > 1000)
+				{
+					MS_THROW_TYPE_ERROR("notificationBatchWindow must be between 0 and 1000");
+				}
+
+				Settings::configuration.notificationBatching    = true;
+				Settings::configuration.notificationBatchWindow = static_cast<uint32_t>(window);
+
+				break;
+			}
+
+			case 'S':
+			{
+				int64_t threads;
+
+				try
+				{
+					threads = std::stoll(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (threads < 0 || threads > 16)
+				{
+					MS_THROW_TYPE_ERROR("srtpCryptoThreads must be between 0 and 16");
+				}
+
+				Settings::configuration.srtpCryptoThreads = static_cast<uint8_t>(threads);
+
+				break;
+			}
+
+			case 'H':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue == "true")
+				{
+					Settings::configuration.dtlsHandshakeOffload = true;
+				}
+
+				break;
+			}
+
+			case 'k':
+			{
+				stringValue                                      = std::string(optarg);
+				Settings::configuration.dtlsCertificateCacheFile = stringValue;
+
+				break;
+			}
+
+			case 'K':
+			{
+				int64_t maxAge;
+
+				try
+				{
+					maxAge = std::stoll(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (maxAge <= 0 || maxAge > UINT32_MAX)
+				{
+					MS_THROW_TYPE_ERROR("invalid dtlsCertificateCacheMaxAge");
+				}
+
+				Settings::configuration.dtlsCertificateCacheMaxAge = static_cast<uint32_t>(maxAge);
+
+				break;
+			}
+
 			// Invalid option.
 			case '?':
 			{
@@ -215,6 +323,14 @@ void Settings::SetConfiguration(int argc, char* argv[])
 
 	// Set DTLS certificate files (if provided),
 	Settings::SetDtlsCertificateAndPrivateKeyFiles();
+
+	// The DTLS certificate cache is for generated certificates.
+	if (
+	  !Settings::configuration.dtlsCertificateCacheFile.empty() &&
+	  !Settings::configuration.dtlsCertificateFile.empty())
+	{
+		MS_THROW_TYPE_ERROR("dtlsCertificateCacheFile cannot be used with dtlsCertificateFile");
+	}
 }
 
 void Settings::PrintConfiguration()
@@ -302,6 +418,34 @@ void Settings::PrintConfiguration()
 		MS_DEBUG_TAG(
 		  info, "  libwebrtcFieldTrials: %s", Settings::configuration.libwebrtcFieldTrials.c_str());
 	}
+	if (Settings::configuration.channelWriteCoalescing)
+	{
+		MS_DEBUG_TAG(info, "  channelWriteCoalescing: true");
+	}
+	if (Settings::configuration.notificationBatching)
+	{
+		MS_DEBUG_TAG(
+		  info, "  notificationBatchWindow: %" PRIu32, Settings::configuration.notificationBatchWindow);
+	}
+	if (Settings::configuration.srtpCryptoThreads != 0u)
+	{
+		MS_DEBUG_TAG(info, "  srtpCryptoThreads: %" PRIu8, Settings::configuration.srtpCryptoThreads);
+	}
+	if (Settings::configuration.dtlsHandshakeOffload)
+	{
+		MS_DEBUG_TAG(info, "  dtlsHandshakeOffload: true");
+	}
+	if (!Settings::configuration.dtlsCertificateCacheFile.empty())
+	{
+		MS_DEBUG_TAG(
+		  info,
+		  "  dtlsCertificateCacheFile: %s",
+		  Settings::configuration.dtlsCertificateCacheFile.c_str());
+		MS_DEBUG_TAG(
+		  info,
+		  "  dtlsCertificateCacheMaxAge: %" PRIu32,
+		  Settings::configuration.dtlsCertificateCacheMaxAge);
+	}
 
 	MS_DEBUG_TAG(info, "</configuration>");
 }
@@ -14,10 +14,13 @@
 #include "Channel/ChannelNotifier.hpp"
 #include "FBS/response.h"
 #include "FBS/worker.h"
+#include "RTC/DtlsTransport.hpp"
+#include "RTC/RtpPacketBufferPool.hpp"
+#include "RTC/SrtpCryptoPool.hpp"
 
 /* Instance methods. */
 
-Worker::Worker(::Channel::ChannelSocket* channel) : channel(channel)
+Worker::Worker(::Channel::ChannelSocket* channel, uint64_t startedAtUs) : channel(channel)
 {
 	MS_TRACE();
 
@@ -32,6 +35,12 @@ Worker::Worker(::Channel::ChannelSocket* channel) : channel(channel)
 	  /*channelMessageRegistrator*/ new ChannelMessageRegistrator(),
 	  /*channelNotifier*/ new Channel::ChannelNotifier(this->channel));
 
+	if (Settings::configuration.notificationBatching)
+	{
+		this->shared->channelNotifier->SetBatching(
+		  true, Settings::configuration.notificationBatchWindow);
+	}
+
 #ifdef MS_EXECUTABLE
 	{
 		// Add signals to handle.
@@ -51,6 +60,10 @@ Worker::Worker(::Channel::ChannelSocket* channel) : channel(channel)
 	}
 #endif
 
+	this->startupDurationUs = DepLibUV::GetTimeUs() - startedAtUs;
+
+	MS_DEBUG_TAG(info, "worker started in %" PRIu64 "us", this->startupDurationUs);
+
 	// Tell the Node process that we are running.
 	this->shared->channelNotifier->Emit(
 	  std::to_string(Logger::Pid), FBS::Notification::Event::WORKER_RUNNING);
@@ -148,6 +161,22 @@ flatbuffers::Offset<FBS::Worker::DumpResponse> Worker::FillBuffer(
 	// Add channelMessageHandlers.
 	auto channelMessageHandlers = this->shared->channelMessageRegistrator->FillBuffer(builder);
 
+	// Add rtpPacketBufferPool.
+	auto rtpPacketBufferPool = RTC::RtpPacketBufferPool::FillBuffer(builder);
+
+	// Add channelNotifier.
+	auto channelNotifier = this->shared->channelNotifier->FillBufferDump(builder);
+
+	// Add srtpCryptoPool.
+	auto srtpCryptoPool = RTC::SrtpCryptoPool::FillBuffer(builder);
+
+	// Add startup.
+	auto startup = FBS::Worker::CreateStartupDump(
+	  builder,
+	  this->startupDurationUs,
+	  RTC::DtlsTransport::GetSetupDurationUs(),
+	  RTC::DtlsTransport::IsCertificateGenerated());
+
 #ifdef MS_LIBURING_SUPPORTED
 	if (DepLibUring::IsEnabled())
 	{
@@ -157,16 +186,38 @@ flatbuffers::Offset<FBS::Worker::DumpResponse> Worker::FillBuffer(
 		  &webRtcServerIds,
 		  &routerIds,
 		  channelMessageHandlers,
-		  DepLibUring::FillBuffer(builder));
+		  DepLibUring::FillBuffer(builder),
+		  rtpPacketBufferPool,
+		  channelNotifier,
+		  srtpCryptoPool,
+		  startup);
 	}
 	else
 	{
 		return FBS::Worker::CreateDumpResponseDirect(
-		  builder, Logger::Pid, &webRtcServerIds, &routerIds, channelMessageHandlers);
+		  builder,
+		  Logger::Pid,
+		  &webRtcServerIds,
+		  &routerIds,
+		  channelMessageHandlers,
+		  0,
+		  rtpPacketBufferPool,
+		  channelNotifier,
+		  srtpCryptoPool,
+		  startup);
 	}
 #else
 	return FBS::Worker::CreateDumpResponseDirect(
-	  builder, Logger::Pid, &webRtcServerIds, &routerIds, channelMessageHandlers);
+	  builder,
+	  Logger::Pid,
+	  &webRtcServerIds,
+	  &routerIds,
+	  channelMessageHandlers,
+	  0,
+	  rtpPacketBufferPool,
+	  channelNotifier,
+	  srtpCryptoPool,
+	  startup);
 #endif
 }
 
@@ -332,7 +383,8 @@ void Worker::HandleRequest(Channel::ChannelRequest* request)
 
 				CheckNoWebRtcServer(webRtcServerId);
 
-				auto* webRtcServer = new RTC::WebRtcServer(this->shared, webRtcServerId, body->listenInfos());
+				auto* webRtcServer =
+				  new RTC::WebRtcServer(this->shared, webRtcServerId, body->listenInfos(), body->shard());
 
 				this->mapWebRtcServers[webRtcServerId] = webRtcServer;
 
@@ -9,7 +9,8 @@
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
-#include <cstring> // std::memcpy()
+#include <algorithm> // std::min()
+#include <cstring>   // std::memcpy()
 
 /* Static methods for UV callbacks. */
 
@@ -150,23 +151,14 @@ void TcpConnectionHandle::Start()
 		return;
 	}
 
-	// NOLINTNEXTLINE(misc-const-correctness)
-	int err = uv_read_start(
-	  reinterpret_cast<uv_stream_t*>(this->uvHandle),
-	  static_cast<uv_alloc_cb>(onAlloc),
-	  static_cast<uv_read_cb>(onRead));
-
-	if (err != 0)
-	{
-		MS_THROW_ERROR("uv_read_start() failed: %s", uv_strerror(err));
-	}
-
 	// Get the peer address.
 	if (!SetPeerAddress())
 	{
 		MS_THROW_ERROR("error setting peer IP and port");
 	}
 
+	int err;
+
 #ifdef MS_LIBURING_SUPPORTED
 	if (DepLibUring::IsEnabled())
 	{
@@ -176,8 +168,26 @@ void TcpConnectionHandle::Start()
 		{
 			MS_THROW_ERROR("uv_fileno() failed: %s", uv_strerror(err));
 		}
+
+		// Receive via io_uring if possible.
+		this->recvRequest = DepLibUring::StartRecv(this->fd, /*datagram*/ false, this);
+
+		if (this->recvRequest)
+		{
+			return;
+		}
 	}
 #endif
+
+	err = uv_read_start(
+	  reinterpret_cast<uv_stream_t*>(this->uvHandle),
+	  static_cast<uv_alloc_cb>(onAlloc),
+	  static_cast<uv_read_cb>(onRead));
+
+	if (err != 0)
+	{
+		MS_THROW_ERROR("uv_read_start() failed: %s", uv_strerror(err));
+	}
 }
 
 void TcpConnectionHandle::Write(
@@ -351,6 +361,15 @@ void TcpConnectionHandle::InternalClose()
 
 	this->closed = true;
 
+#ifdef MS_LIBURING_SUPPORTED
+	if (this->recvRequest)
+	{
+		DepLibUring::StopRecv(this->recvRequest);
+
+		this->recvRequest = nullptr;
+	}
+#endif
+
 	// Tell the UV handle that the TcpConnectionHandle has been closed.
 	this->uvHandle->data = nullptr;
 
@@ -483,6 +502,63 @@ inline void TcpConnectionHandle::OnUvRead(ssize_t nread, const uv_buf_t* /*buf*/
 	}
 }
 
+#ifdef MS_LIBURING_SUPPORTED
+void TcpConnectionHandle::OnLibUringRecv(const DepLibUring::RecvData* recvs, size_t count)
+{
+	MS_TRACE();
+
+	// NOTE: The request outlives this instance if it's closed and deleted while
+	// notifying the subclass, so use it to know it.
+	const auto* request = this->recvRequest;
+
+	for (size_t i{ 0 }; i < count; ++i)
+	{
+		const uint8_t* data = recvs[i].data;
+		size_t len          = recvs[i].len;
+
+		// Copy the received data into the buffer as libuv does, in chunks if there
+		// is not enough space.
+		while (len > 0)
+		{
+			uv_buf_t buf;
+
+			OnUvReadAlloc(len, std::addressof(buf));
+
+			if (buf.len == 0)
+			{
+				OnUvRead(UV_ENOBUFS, std::addressof(buf));
+
+				return;
+			}
+
+			const size_t chunkLen = std::min(len, static_cast<size_t>(buf.len));
+
+			std::memcpy(buf.base, data, chunkLen);
+
+			data += chunkLen;
+			len -= chunkLen;
+
+			OnUvRead(static_cast<ssize_t>(chunkLen), std::addressof(buf));
+
+			if (!request->listener)
+			{
+				return;
+			}
+		}
+	}
+}
+
+void TcpConnectionHandle::OnLibUringRecvError(int err)
+{
+	MS_TRACE();
+
+	this->recvRequest = nullptr;
+
+	// NOTE: Error codes in libuv are negated errno values.
+	OnUvRead(err == 0 ? UV_EOF : err, nullptr);
+}
+#endif
+
 inline void TcpConnectionHandle::OnUvWrite(int status, TcpConnectionHandle::onSendCallback* cb)
 {
 	MS_TRACE();
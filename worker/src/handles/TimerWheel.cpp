@@ -0,0 +1,424 @@
+#define MS_CLASS "TimerWheel"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "handles/TimerWheel.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include "handles/TimerHandle.hpp"
+#include <algorithm> // std::min(), std::max()
+#include <limits>    // std::numeric_limits()
+
+/* Static. */
+
+static constexpr uint64_t Level0Mask{ TimerWheel::Level0Slots - 1u };
+static constexpr uint64_t LevelMask{ TimerWheel::LevelSlots - 1u };
+
+/* Static methods. */
+
+TimerWheel* TimerWheel::GetInstance()
+{
+	thread_local static TimerWheel timerWheel;
+
+	return &timerWheel;
+}
+
+/* Static methods for UV callbacks. */
+
+void TimerWheel::OnUvTimer(uv_timer_t* handle)
+{
+	auto* timerWheel = static_cast<TimerWheel*>(handle->data);
+
+	timerWheel->armed = false;
+
+	timerWheel->Advance(timerWheel->GetNowMs());
+
+	if (timerWheel->numTimers == 0u)
+	{
+		timerWheel->CloseUvTimer();
+	}
+	else
+	{
+		timerWheel->ArmUvTimer(timerWheel->GetNextTickMs());
+	}
+}
+
+void TimerWheel::OnCloseUvTimer(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_timer_t*>(handle);
+}
+
+/* Instance methods. */
+
+/**
+ * Inserts the given timer (or moves it if already active) according to its
+ * expiration time.
+ */
+void TimerWheel::Add(TimerHandle* timer)
+{
+	MS_TRACE();
+
+	if (timer->active)
+	{
+		Unlink(timer);
+	}
+	else
+	{
+		// If there was no timer, move the wheel to current time.
+		if (this->numTimers == 0u && !this->advancing)
+		{
+			this->currentMs = std::max(this->currentMs, GetNowMs());
+		}
+
+		timer->active = true;
+
+		++this->numTimers;
+	}
+
+	Link(timer, /*fromCascade*/ false);
+}
+
+void TimerWheel::Remove(TimerHandle* timer)
+{
+	MS_TRACE();
+
+	if (!timer->active)
+	{
+		return;
+	}
+
+	Unlink(timer);
+
+	timer->active = false;
+
+	--this->numTimers;
+
+	// Close the uv timer if there are no more timers. If we are advancing it
+	// will be done once done.
+	if (this->numTimers == 0u && !this->advancing)
+	{
+		CloseUvTimer();
+	}
+}
+
+uint64_t TimerWheel::GetNowMs() const
+{
+	return uv_now(DepLibUV::GetLoop());
+}
+
+void TimerWheel::Link(TimerHandle* timer, bool fromCascade)
+{
+	MS_TRACE();
+
+	uint64_t expiresAtMs = timer->expiresAtMs;
+
+	// A timer cannot expire in the current (already processed) tick, except if
+	// it comes from an upper level being cascaded into it.
+	if (!fromCascade)
+	{
+		expiresAtMs = std::max(expiresAtMs, this->currentMs + 1u);
+	}
+
+	uint64_t delta = expiresAtMs - this->currentMs;
+	size_t slotIdx;
+	// Absolute time at which the slot must be processed.
+	uint64_t wakeUpMs;
+
+	if (delta < Level0Slots)
+	{
+		slotIdx  = expiresAtMs & Level0Mask;
+		wakeUpMs = expiresAtMs;
+
+		this->level0Bitmap[slotIdx / 64u] |= uint64_t{ 1u } << (slotIdx % 64u);
+	}
+	else
+	{
+		// Too far, it will be moved to the right slot once cascaded.
+		if (delta > MaxDelayMs)
+		{
+			expiresAtMs = this->currentMs + MaxDelayMs;
+			delta       = MaxDelayMs;
+		}
+
+		size_t level = 0u;
+		size_t shift = Level0Bits;
+
+		while (delta >= (uint64_t{ 1u } << (shift + LevelBits)))
+		{
+			++level;
+			shift += LevelBits;
+		}
+
+		const size_t idx = (expiresAtMs >> shift) & LevelMask;
+
+		slotIdx  = Level0Slots + (level * LevelSlots) + idx;
+		wakeUpMs = (expiresAtMs >> shift) << shift;
+
+		this->levelBitmaps[level] |= uint64_t{ 1u } << idx;
+	}
+
+	auto*& head = this->slots[slotIdx];
+
+	timer->slotIdx = static_cast<uint16_t>(slotIdx);
+	timer->prev    = nullptr;
+	timer->next    = head;
+
+	if (head)
+	{
+		head->prev = timer;
+	}
+
+	head = timer;
+
+	// Wake up earlier if needed. Not needed if we are advancing since the uv
+	// timer will be armed once done.
+	if (!this->advancing && (!this->armed || wakeUpMs < this->armedAtMs))
+	{
+		ArmUvTimer(wakeUpMs);
+	}
+}
+
+void TimerWheel::Unlink(TimerHandle* timer)
+{
+	MS_TRACE();
+
+	const size_t slotIdx = timer->slotIdx;
+
+	if (timer->prev)
+	{
+		timer->prev->next = timer->next;
+	}
+	else
+	{
+		this->slots[slotIdx] = timer->next;
+	}
+
+	if (timer->next)
+	{
+		timer->next->prev = timer->prev;
+	}
+
+	timer->prev = nullptr;
+	timer->next = nullptr;
+
+	if (!this->slots[slotIdx])
+	{
+		if (slotIdx < Level0Slots)
+		{
+			this->level0Bitmap[slotIdx / 64u] &= ~(uint64_t{ 1u } << (slotIdx % 64u));
+		}
+		else
+		{
+			const size_t level = (slotIdx - Level0Slots) / LevelSlots;
+			const size_t idx   = (slotIdx - Level0Slots) % LevelSlots;
+
+			this->levelBitmaps[level] &= ~(uint64_t{ 1u } << idx);
+		}
+	}
+}
+
+/**
+ * Processes all the ticks up to the given time, firing expired timers.
+ */
+void TimerWheel::Advance(uint64_t nowMs)
+{
+	MS_TRACE();
+
+	this->advancing = true;
+
+	while (this->numTimers != 0u)
+	{
+		const uint64_t tickMs = GetNextTickMs();
+
+		if (tickMs > nowMs)
+		{
+			break;
+		}
+
+		this->currentMs = tickMs;
+
+		if ((tickMs & Level0Mask) == 0u)
+		{
+			Cascade(tickMs);
+		}
+
+		Expire(tickMs & Level0Mask, nowMs);
+	}
+
+	this->currentMs = std::max(this->currentMs, nowMs);
+	this->advancing = false;
+}
+
+/**
+ * Moves the timers of the upper level slots that start at the given tick to
+ * lower levels.
+ */
+void TimerWheel::Cascade(uint64_t tickMs)
+{
+	MS_TRACE();
+
+	size_t shift = Level0Bits;
+
+	for (size_t level = 0u; level < NumUpperLevels; ++level, shift += LevelBits)
+	{
+		const size_t idx     = (tickMs >> shift) & LevelMask;
+		const size_t slotIdx = Level0Slots + (level * LevelSlots) + idx;
+		auto* timer          = this->slots[slotIdx];
+
+		this->slots[slotIdx] = nullptr;
+		this->levelBitmaps[level] &= ~(uint64_t{ 1u } << idx);
+
+		while (timer)
+		{
+			auto* next = timer->next;
+
+			Link(timer, /*fromCascade*/ true);
+
+			timer = next;
+		}
+
+		// Upper level only starts a slot if this one wrapped around.
+		if (idx != 0u)
+		{
+			break;
+		}
+	}
+}
+
+void TimerWheel::Expire(size_t slotIdx, uint64_t nowMs)
+{
+	MS_TRACE();
+
+	// NOTE: Listeners may start, stop or delete any timer (including the one
+	// being notified), so take them one by one from the slot. Timers started
+	// meanwhile never go into this slot.
+	while (auto* timer = this->slots[slotIdx])
+	{
+		Unlink(timer);
+
+		if (timer->repeat != 0u)
+		{
+			timer->expiresAtMs = nowMs + timer->repeat;
+
+			Link(timer, /*fromCascade*/ false);
+		}
+		else
+		{
+			timer->active = false;
+
+			--this->numTimers;
+		}
+
+		timer->OnTimerWheelTimer();
+	}
+}
+
+/**
+ * Next tick that must be processed: the next level 0 slot with timers or the
+ * next cascade of an upper level slot with timers. Ticks in between can be
+ * skipped. Must not be called if there are no timers.
+ */
+uint64_t TimerWheel::GetNextTickMs() const
+{
+	MS_TRACE();
+
+	const uint64_t blockStartMs = this->currentMs & ~Level0Mask;
+	const size_t currentIdx     = this->currentMs & Level0Mask;
+	uint64_t tickMs             = std::numeric_limits<uint64_t>::max();
+
+	// Next level 0 slot with timers in the current block.
+	for (size_t idx = currentIdx + 1u; idx < Level0Slots; idx = ((idx / 64u) + 1u) * 64u)
+	{
+		const uint64_t bits = this->level0Bitmap[idx / 64u] & (~uint64_t{ 0u } << (idx % 64u));
+
+		if (bits != 0u)
+		{
+			return blockStartMs + ((idx / 64u) * 64u) + Utils::Bits::CountTrailingZeros(bits);
+		}
+	}
+
+	// Remaining level 0 slots with timers belong to the next block.
+	for (const auto bits : this->level0Bitmap)
+	{
+		if (bits != 0u)
+		{
+			tickMs = blockStartMs + Level0Slots;
+
+			break;
+		}
+	}
+
+	size_t shift = Level0Bits;
+
+	for (size_t level = 0u; level < NumUpperLevels; ++level, shift += LevelBits)
+	{
+		const uint64_t bits = this->levelBitmaps[level];
+
+		if (bits == 0u)
+		{
+			continue;
+		}
+
+		// Distance (in slots of this level) to the next slot with timers, being
+		// the current slot the farthest one.
+		const size_t rotation = (((this->currentMs >> shift) & LevelMask) + 1u) & LevelMask;
+		const uint64_t rotatedBits =
+		  rotation == 0u ? bits : (bits >> rotation) | (bits << (LevelSlots - rotation));
+		const uint64_t distance = Utils::Bits::CountTrailingZeros(rotatedBits) + 1u;
+
+		tickMs = std::min(tickMs, ((this->currentMs >> shift) + distance) << shift);
+	}
+
+	return tickMs;
+}
+
+void TimerWheel::ArmUvTimer(uint64_t wakeUpMs)
+{
+	MS_TRACE();
+
+	if (!this->uvHandle)
+	{
+		this->uvHandle       = new uv_timer_t;
+		this->uvHandle->data = static_cast<void*>(this);
+
+		const int err = uv_timer_init(DepLibUV::GetLoop(), this->uvHandle);
+
+		if (err != 0)
+		{
+			delete this->uvHandle;
+			this->uvHandle = nullptr;
+
+			MS_THROW_ERROR("uv_timer_init() failed: %s", uv_strerror(err));
+		}
+	}
+
+	const uint64_t nowMs   = GetNowMs();
+	const uint64_t timeout = wakeUpMs > nowMs ? wakeUpMs - nowMs : 0u;
+
+	const int err = uv_timer_start(this->uvHandle, TimerWheel::OnUvTimer, timeout, 0u);
+
+	if (err != 0)
+	{
+		MS_THROW_ERROR("uv_timer_start() failed: %s", uv_strerror(err));
+	}
+
+	this->armed     = true;
+	this->armedAtMs = wakeUpMs;
+}
+
+void TimerWheel::CloseUvTimer()
+{
+	MS_TRACE();
+
+	this->armed = false;
+
+	if (!this->uvHandle)
+	{
+		return;
+	}
+
+	uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), TimerWheel::OnCloseUvTimer);
+
+	this->uvHandle = nullptr;
+}
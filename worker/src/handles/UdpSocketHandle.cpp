@@ -9,11 +9,72 @@
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
 #include <cstring> // std::memcpy()
+#include <memory>  // std::unique_ptr
+#ifdef __linux__
+#include <sys/socket.h> // setsockopt()
+#endif
+#ifdef MS_SENDMMSG_SUPPORTED
+#include <cerrno>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#endif
+
+#ifdef MS_SENDMMSG_SUPPORTED
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#endif
 
 /* Static. */
 
-static constexpr size_t ReadBufferSize{ 65536 };
-thread_local static uint8_t ReadBuffer[ReadBufferSize];
+// NOTE: libuv only uses recvmmsg() if the given buffer can hold more than one
+// datagram of max size, and it then splits it into chunks of such a size.
+static constexpr size_t ReadBufferSize{ UdpSocketHandle::DatagramMaxSize *
+	                                      UdpSocketHandle::RecvBatchSize };
+// NOTE: Allocated on first usage to not bloat the TLS block of every thread.
+thread_local static std::unique_ptr<uint8_t[]> ReadBuffer;
+// Datagrams received within the current recvmmsg() batch.
+thread_local static std::vector<UdpSocketHandle::RecvDatagram> RecvBatch;
+
+#ifdef MS_SENDMMSG_SUPPORTED
+/* Struct for a datagram queued in the send batch. */
+struct SendBatchItem
+{
+	UdpSocketHandle* socket{ nullptr };
+	int fd{ -1 };
+	uint8_t store[UdpSocketHandle::SendBatchBufferSize];
+	size_t len{ 0u };
+	struct sockaddr_storage addr
+	{
+	};
+	socklen_t addrLen{ 0u };
+	UdpSocketHandle::onSendCallback* cb{ nullptr };
+	// Index of the mmsghdr carrying this datagram while flushing.
+	size_t msgIdx{ 0u };
+};
+
+/* Struct holding the send batch. */
+struct SendBatch
+{
+	SendBatchItem items[UdpSocketHandle::SendBatchSize];
+	size_t count{ 0u };
+	// Nesting level of StartSendBatch() calls.
+	size_t depth{ 0u };
+	// Whether the batch is being flushed.
+	bool flushing{ false };
+	// Whether UDP GSO can be used (it's disabled upon first failure).
+	bool gsoEnabled{ true };
+	// Structs given to sendmmsg().
+	struct mmsghdr msgs[UdpSocketHandle::SendBatchSize];
+	struct iovec iovs[UdpSocketHandle::SendBatchSize];
+	alignas(struct cmsghdr) uint8_t
+	  controls[UdpSocketHandle::SendBatchSize][CMSG_SPACE(sizeof(uint16_t))];
+};
+
+// NOTE: Allocated on first usage to not bloat the TLS block of every thread.
+thread_local static std::unique_ptr<SendBatch> SendBatchQueue;
+#endif
 
 /* Static methods for UV callbacks. */
 
@@ -68,17 +129,6 @@ UdpSocketHandle::UdpSocketHandle(uv_udp_t* uvHandle) : uvHandle(uvHandle)
 
 	this->uvHandle->data = static_cast<void*>(this);
 
-	// NOLINTNEXTLINE(misc-const-correctness)
-	int err = uv_udp_recv_start(
-	  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
-
-	if (err != 0)
-	{
-		uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onCloseUdp));
-
-		MS_THROW_ERROR("uv_udp_recv_start() failed: %s", uv_strerror(err));
-	}
-
 	// Set local address.
 	if (!SetLocalAddress())
 	{
@@ -87,17 +137,39 @@ UdpSocketHandle::UdpSocketHandle(uv_udp_t* uvHandle) : uvHandle(uvHandle)
 		MS_THROW_ERROR("error setting local IP and port");
 	}
 
+	int err;
+
+#if defined(MS_LIBURING_SUPPORTED) || defined(MS_SENDMMSG_SUPPORTED)
+	err = uv_fileno(reinterpret_cast<uv_handle_t*>(this->uvHandle), std::addressof(this->fd));
+
+	if (err != 0)
+	{
+		MS_THROW_ERROR("uv_fileno() failed: %s", uv_strerror(err));
+	}
+#endif
+
 #ifdef MS_LIBURING_SUPPORTED
+	// Receive via io_uring if possible.
 	if (DepLibUring::IsEnabled())
 	{
-		err = uv_fileno(reinterpret_cast<uv_handle_t*>(this->uvHandle), std::addressof(this->fd));
+		this->recvRequest = DepLibUring::StartRecv(this->fd, /*datagram*/ true, this);
 
-		if (err != 0)
+		if (this->recvRequest)
 		{
-			MS_THROW_ERROR("uv_fileno() failed: %s", uv_strerror(err));
+			return;
 		}
 	}
 #endif
+
+	err = uv_udp_recv_start(
+	  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+
+	if (err != 0)
+	{
+		uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onCloseUdp));
+
+		MS_THROW_ERROR("uv_udp_recv_start() failed: %s", uv_strerror(err));
+	}
 }
 
 UdpSocketHandle::~UdpSocketHandle()
@@ -115,6 +187,7 @@ void UdpSocketHandle::Dump() const
 	MS_DUMP("<UdpSocketHandle>");
 	MS_DUMP("  localIp: %s", this->localIp.c_str());
 	MS_DUMP("  localPort: %" PRIu16, static_cast<uint16_t>(this->localPort));
+	MS_DUMP("  recvBatches: %zu", this->recvBatches);
 	MS_DUMP("  closed: %s", this->closed ? "yes" : "no");
 	MS_DUMP("</UdpSocketHandle>");
 }
@@ -172,6 +245,271 @@ void UdpSocketHandle::Send(
 send_libuv:
 #endif
 
+#ifdef MS_SENDMMSG_SUPPORTED
+	if (SendBatchQueue && SendBatchQueue->depth > 0 && QueueSend(data, len, addr, cb))
+	{
+		return;
+	}
+#endif
+
+	InternalSend(data, len, addr, cb);
+}
+
+void UdpSocketHandle::Connect(const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	if (this->closed)
+	{
+		MS_THROW_ERROR("socket closed");
+	}
+
+	const int err = uv_udp_connect(this->uvHandle, addr);
+
+	if (err != 0)
+	{
+		MS_THROW_ERROR("uv_udp_connect() failed: %s", uv_strerror(err));
+	}
+
+#ifdef __linux__
+	// Remove the filter that makes sockets joining a SO_REUSEPORT group drop
+	// datagrams until connected (if any).
+	uv_os_fd_t fd;
+	int dummy{ 0 };
+
+	if (uv_fileno(reinterpret_cast<uv_handle_t*>(this->uvHandle), std::addressof(fd)) == 0)
+	{
+		setsockopt(fd, SOL_SOCKET, SO_DETACH_FILTER, &dummy, sizeof(dummy));
+	}
+#endif
+}
+
+#ifdef MS_SENDMMSG_SUPPORTED
+void UdpSocketHandle::StartSendBatch()
+{
+	MS_TRACE();
+
+	if (!SendBatchQueue)
+	{
+		SendBatchQueue.reset(new SendBatch());
+	}
+
+	SendBatchQueue->depth++;
+}
+
+void UdpSocketHandle::FlushSendBatch()
+{
+	MS_TRACE();
+
+	MS_ASSERT(SendBatchQueue && SendBatchQueue->depth > 0, "send batch not started");
+
+	// Nested batch, the outermost one will flush.
+	if (--SendBatchQueue->depth > 0)
+	{
+		return;
+	}
+
+	if (SendBatchQueue->count > 0)
+	{
+		SendQueuedBatch();
+	}
+}
+
+void UdpSocketHandle::SendQueuedBatch()
+{
+	MS_TRACE();
+
+	auto& batch       = *SendBatchQueue;
+	const size_t count = batch.count;
+
+	// Datagrams sent from send callbacks while flushing are not queued.
+	batch.flushing = true;
+
+	// Send queued datagrams grouped by socket, keeping their order.
+	for (size_t i{ 0u }; i < count; ++i)
+	{
+		// Already sent or dropped.
+		if (!batch.items[i].socket)
+		{
+			continue;
+		}
+
+		const int fd = batch.items[i].fd;
+		size_t msgCount{ 0u };
+		size_t iovCount{ 0u };
+		// Segments of the last mmsghdr.
+		size_t segmentSize{ 0u };
+		size_t segmentCount{ 0u };
+		size_t msgSize{ 0u };
+
+		for (size_t j{ i }; j < count; ++j)
+		{
+			auto& item = batch.items[j];
+
+			if (!item.socket || item.fd != fd)
+			{
+				continue;
+			}
+
+			auto* iov = std::addressof(batch.iovs[iovCount++]);
+
+			iov->iov_base = item.store;
+			iov->iov_len  = item.len;
+
+			// Coalesce it into the previous mmsghdr by using UDP GSO if it has same
+			// destination and same size (only the last segment can be smaller).
+			if (
+			  msgCount > 0 && batch.gsoEnabled && item.len <= segmentSize &&
+			  segmentCount < UdpSocketHandle::GsoMaxSegments &&
+			  msgSize + item.len <= UdpSocketHandle::GsoMaxSize &&
+			  (segmentCount == 1 || msgSize == segmentSize * segmentCount) &&
+			  Utils::IP::CompareAddresses(
+			    static_cast<const struct sockaddr*>(batch.msgs[msgCount - 1].msg_hdr.msg_name),
+			    reinterpret_cast<const struct sockaddr*>(std::addressof(item.addr))))
+			{
+				auto& msg = batch.msgs[msgCount - 1].msg_hdr;
+
+				if (segmentCount == 1)
+				{
+					msg.msg_control    = batch.controls[msgCount - 1];
+					msg.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+
+					auto* cmsg            = CMSG_FIRSTHDR(std::addressof(msg));
+					const auto gsoSize    = static_cast<uint16_t>(segmentSize);
+					cmsg->cmsg_level      = IPPROTO_UDP;
+					cmsg->cmsg_type       = UDP_SEGMENT;
+					cmsg->cmsg_len        = CMSG_LEN(sizeof(uint16_t));
+
+					std::memcpy(CMSG_DATA(cmsg), std::addressof(gsoSize), sizeof(uint16_t));
+				}
+
+				msg.msg_iovlen++;
+				segmentCount++;
+				msgSize += item.len;
+			}
+			else
+			{
+				auto& msg = batch.msgs[msgCount++].msg_hdr;
+
+				msg.msg_name       = std::addressof(item.addr);
+				msg.msg_namelen    = item.addrLen;
+				msg.msg_iov        = iov;
+				msg.msg_iovlen     = 1;
+				msg.msg_control    = nullptr;
+				msg.msg_controllen = 0;
+				msg.msg_flags      = 0;
+
+				segmentSize  = item.len;
+				segmentCount = 1;
+				msgSize      = item.len;
+			}
+
+			item.msgIdx = msgCount - 1;
+		}
+
+		// Complete the datagrams of the given mmsghdrs, falling back to libuv if
+		// they were not sent.
+		auto completeMsgs = [&batch, count, i, fd](size_t fromMsg, size_t toMsg, bool sent)
+		{
+			for (size_t j{ i }; j < count; ++j)
+			{
+				auto& item = batch.items[j];
+
+				if (!item.socket || item.fd != fd || item.msgIdx < fromMsg || item.msgIdx >= toMsg)
+				{
+					continue;
+				}
+
+				auto* socket = item.socket;
+				auto* cb     = item.cb;
+
+				item.socket = nullptr;
+				item.cb     = nullptr;
+
+				if (sent)
+				{
+					// Update sent bytes.
+					socket->sentBytes += item.len;
+
+					if (cb)
+					{
+						(*cb)(true);
+						delete cb;
+					}
+				}
+				else
+				{
+					socket->InternalSend(
+					  item.store, item.len, reinterpret_cast<const struct sockaddr*>(&item.addr), cb);
+				}
+			}
+		};
+
+		size_t sentMsgs{ 0u };
+
+		while (sentMsgs < msgCount)
+		{
+			const int ret = sendmmsg(fd, batch.msgs + sentMsgs, msgCount - sentMsgs, 0);
+
+			if (ret > 0)
+			{
+				completeMsgs(sentMsgs, sentMsgs + ret, true);
+
+				sentMsgs += ret;
+
+				continue;
+			}
+			else if (ret == 0)
+			{
+				completeMsgs(sentMsgs, msgCount, false);
+
+				break;
+			}
+
+			const int error = errno;
+
+			if (error == EINTR)
+			{
+				continue;
+			}
+			// Socket buffer is full, let libuv queue remaining datagrams.
+			else if (error == EAGAIN || error == EWOULDBLOCK)
+			{
+				completeMsgs(sentMsgs, msgCount, false);
+
+				break;
+			}
+
+			// First pending mmsghdr failed, so send its datagrams via libuv.
+			if (
+			  batch.msgs[sentMsgs].msg_hdr.msg_controllen != 0 &&
+			  (error == EIO || error == EINVAL || error == ENOPROTOOPT))
+			{
+				MS_DEBUG_TAG(info, "UDP GSO not supported, disabling it: %s", std::strerror(error));
+
+				batch.gsoEnabled = false;
+			}
+			else
+			{
+				MS_WARN_DEV("sendmmsg() failed: %s", std::strerror(error));
+			}
+
+			completeMsgs(sentMsgs, sentMsgs + 1, false);
+
+			sentMsgs++;
+		}
+	}
+
+	batch.count    = 0;
+	batch.flushing = false;
+}
+#endif
+
+void UdpSocketHandle::InternalSend(
+  const uint8_t* data, size_t len, const struct sockaddr* addr, UdpSocketHandle::onSendCallback* cb)
+{
+	MS_TRACE();
+
 	// First try uv_udp_try_send(). In case it can not directly send the datagram
 	// then build a uv_req_t and use uv_udp_send().
 
@@ -245,6 +583,84 @@ send_libuv:
 	}
 }
 
+#ifdef MS_SENDMMSG_SUPPORTED
+bool UdpSocketHandle::QueueSend(
+  const uint8_t* data, size_t len, const struct sockaddr* addr, UdpSocketHandle::onSendCallback* cb)
+{
+	MS_TRACE();
+
+	auto& batch = *SendBatchQueue;
+
+	if (batch.flushing)
+	{
+		return false;
+	}
+
+	// Datagram cannot be queued (too big or libuv has pending datagrams for this
+	// socket), so send queued ones first to keep the order.
+	if (
+	  len > UdpSocketHandle::SendBatchBufferSize ||
+	  uv_udp_get_send_queue_count(this->uvHandle) != 0)
+	{
+		if (batch.count > 0)
+		{
+			SendQueuedBatch();
+		}
+
+		return false;
+	}
+
+	if (batch.count == UdpSocketHandle::SendBatchSize)
+	{
+		SendQueuedBatch();
+	}
+
+	auto& item = batch.items[batch.count++];
+
+	item.socket  = this;
+	item.fd      = this->fd;
+	item.len     = len;
+	item.addrLen = Utils::IP::GetAddressLen(addr);
+	item.cb      = cb;
+
+	std::memcpy(item.store, data, len);
+	std::memcpy(std::addressof(item.addr), addr, item.addrLen);
+
+	return true;
+}
+
+void UdpSocketHandle::DropQueuedSends()
+{
+	MS_TRACE();
+
+	if (!SendBatchQueue)
+	{
+		return;
+	}
+
+	auto& batch = *SendBatchQueue;
+
+	for (size_t i{ 0u }; i < batch.count; ++i)
+	{
+		auto& item = batch.items[i];
+
+		if (item.socket != this)
+		{
+			continue;
+		}
+
+		if (item.cb)
+		{
+			(*item.cb)(false);
+			delete item.cb;
+		}
+
+		item.socket = nullptr;
+		item.cb     = nullptr;
+	}
+}
+#endif
+
 uint32_t UdpSocketHandle::GetSendBufferSize() const
 {
 	MS_TRACE();
@@ -328,6 +744,20 @@ void UdpSocketHandle::InternalClose()
 
 	this->closed = true;
 
+#ifdef MS_SENDMMSG_SUPPORTED
+	// Drop datagrams of this socket pending in the send batch.
+	DropQueuedSends();
+#endif
+
+#ifdef MS_LIBURING_SUPPORTED
+	if (this->recvRequest)
+	{
+		DepLibUring::StopRecv(this->recvRequest);
+
+		this->recvRequest = nullptr;
+	}
+#endif
+
 	// Tell the UV handle that the UdpSocketHandle has been closed.
 	this->uvHandle->data = nullptr;
 
@@ -372,8 +802,14 @@ inline void UdpSocketHandle::OnUvRecvAlloc(size_t /*suggestedSize*/, uv_buf_t* b
 {
 	MS_TRACE();
 
+	if (!ReadBuffer)
+	{
+		ReadBuffer.reset(new uint8_t[ReadBufferSize]);
+		RecvBatch.reserve(UdpSocketHandle::RecvBatchSize);
+	}
+
 	// Tell UV to write into the static buffer.
-	buf->base = reinterpret_cast<char*>(ReadBuffer);
+	buf->base = reinterpret_cast<char*>(ReadBuffer.get());
 	// Give UV all the buffer space.
 	buf->len = ReadBufferSize;
 }
@@ -383,6 +819,17 @@ inline void UdpSocketHandle::OnUvRecv(
 {
 	MS_TRACE();
 
+	// End of a recvmmsg() batch, so deliver all its datagrams at once.
+	if ((flags & UV_UDP_MMSG_FREE) != 0u)
+	{
+		if (!RecvBatch.empty())
+		{
+			DeliverRecvBatch();
+		}
+
+		return;
+	}
+
 	// NOTE: Ignore if there is nothing to read or if it was an empty datagram.
 	if (nread == 0)
 	{
@@ -403,8 +850,24 @@ inline void UdpSocketHandle::OnUvRecv(
 		// Update received bytes.
 		this->recvBytes += nread;
 
-		// Notify the subclass.
-		UserOnUdpDatagramReceived(reinterpret_cast<uint8_t*>(buf->base), nread, addr);
+		RecvBatch.emplace_back();
+
+		auto& datagram = RecvBatch.back();
+
+		datagram.data = reinterpret_cast<uint8_t*>(buf->base);
+		datagram.len  = nread;
+
+		std::memcpy(std::addressof(datagram.addr), addr, Utils::IP::GetAddressLen(addr));
+
+		// This datagram is part of a recvmmsg() batch that will be delivered once
+		// libuv notifies its end.
+		if ((flags & UV_UDP_MMSG_CHUNK) != 0u)
+		{
+			return;
+		}
+
+		// Single datagram read, deliver it now.
+		DeliverRecvBatch();
 	}
 	// Some error.
 	else
@@ -413,6 +876,64 @@ inline void UdpSocketHandle::OnUvRecv(
 	}
 }
 
+#ifdef MS_LIBURING_SUPPORTED
+void UdpSocketHandle::OnLibUringRecv(const DepLibUring::RecvData* recvs, size_t count)
+{
+	MS_TRACE();
+
+	for (size_t i{ 0 }; i < count; ++i)
+	{
+		const auto& recv = recvs[i];
+
+		// Update received bytes.
+		this->recvBytes += recv.len;
+
+		RecvBatch.emplace_back();
+
+		auto& datagram = RecvBatch.back();
+
+		datagram.data = recv.data;
+		datagram.len  = recv.len;
+
+		std::memcpy(std::addressof(datagram.addr), recv.addr, Utils::IP::GetAddressLen(recv.addr));
+	}
+
+	DeliverRecvBatch();
+}
+
+void UdpSocketHandle::OnLibUringRecvError(int err)
+{
+	MS_TRACE();
+
+	MS_DEBUG_DEV("io_uring receive failed, receiving via libuv: %s", std::strerror(-err));
+
+	this->recvRequest = nullptr;
+
+	err = uv_udp_recv_start(
+	  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+
+	if (err != 0)
+	{
+		MS_ERROR("uv_udp_recv_start() failed: %s", uv_strerror(err));
+	}
+}
+#endif
+
+inline void UdpSocketHandle::DeliverRecvBatch()
+{
+	MS_TRACE();
+
+	// Update received batches.
+	this->recvBatches++;
+
+	// Notify the subclass.
+	UserOnUdpDatagramsReceived(RecvBatch);
+
+	// NOTE: Do not access this instance from here since it may have been closed
+	// and deleted by the subclass.
+	RecvBatch.clear();
+}
+
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 inline void UdpSocketHandle::OnUvSend(int status, UdpSocketHandle::onSendCallback* cb)
 {
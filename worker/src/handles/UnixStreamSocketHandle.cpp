@@ -12,6 +12,11 @@
 #include "MediaSoupErrors.hpp"
 #include <cstring> // std::memcpy()
 
+/* Static. */
+
+// Coalesced data is written once it reaches this size.
+static constexpr size_t MaxCoalescedWriteLen{ 65536 };
+
 /* Static methods for UV callbacks. */
 
 inline static void onAlloc(uv_handle_t* handle, size_t suggestedSize, uv_buf_t* buf)
@@ -50,6 +55,26 @@ inline static void onWrite(uv_write_t* req, int status)
 	delete writeData;
 }
 
+inline static void onPrepare(uv_prepare_t* handle)
+{
+	auto* socket = static_cast<UnixStreamSocketHandle*>(handle->data);
+
+	if (socket)
+	{
+		socket->OnUvFlush();
+	}
+}
+
+inline static void onCheck(uv_check_t* handle)
+{
+	auto* socket = static_cast<UnixStreamSocketHandle*>(handle->data);
+
+	if (socket)
+	{
+		socket->OnUvFlush();
+	}
+}
+
 // NOTE: We have different onCloseXxx() callbacks to avoid an ASAN warning by
 // ensuring that we call `delete xxx` with same type as `new xxx` before.
 inline static void onClosePipe(uv_handle_t* handle)
@@ -57,6 +82,16 @@ inline static void onClosePipe(uv_handle_t* handle)
 	delete reinterpret_cast<uv_pipe_t*>(handle);
 }
 
+inline static void onClosePrepare(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_prepare_t*>(handle);
+}
+
+inline static void onCloseCheck(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_check_t*>(handle);
+}
+
 inline static void onShutdown(uv_shutdown_t* req, int /*status*/)
 {
 	auto* handle = req->handle;
@@ -142,6 +177,9 @@ void UnixStreamSocketHandle::Close()
 
 	int err;
 
+	// Write coalesced data before closing.
+	SetWriteCoalescing(false);
+
 	this->closed = true;
 
 	// Tell the UV handle that the UnixStreamSocketHandle has been closed.
@@ -193,6 +231,131 @@ void UnixStreamSocketHandle::Write(const uint8_t* data, size_t len)
 		return;
 	}
 
+	if (!this->uvPrepareHandle)
+	{
+		WriteImpl(data, len);
+
+		return;
+	}
+
+	// Coalescing writes. Keep the data until the current phase of the loop ends
+	// so everything written meanwhile is sent at once.
+
+	if (this->pendingWriteData.size() + len > MaxCoalescedWriteLen)
+	{
+		Flush();
+
+		// Too big to be coalesced.
+		if (len >= MaxCoalescedWriteLen)
+		{
+			WriteImpl(data, len);
+
+			return;
+		}
+	}
+
+	if (this->pendingWriteData.empty())
+	{
+		uv_prepare_start(this->uvPrepareHandle, static_cast<uv_prepare_cb>(onPrepare));
+		uv_check_start(this->uvCheckHandle, static_cast<uv_check_cb>(onCheck));
+	}
+
+	this->pendingWriteData.insert(this->pendingWriteData.end(), data, data + len);
+}
+
+/**
+ * When enabled, data given to Write() is kept and written at once right before
+ * the loop polls for I/O and right after I/O callbacks are invoked, so a single
+ * write is done for all the messages generated meanwhile.
+ */
+void UnixStreamSocketHandle::SetWriteCoalescing(bool enabled)
+{
+	MS_TRACE_STD();
+
+	if (this->closed)
+	{
+		return;
+	}
+
+	if (enabled && !this->uvPrepareHandle)
+	{
+		int err;
+
+		this->uvPrepareHandle       = new uv_prepare_t;
+		this->uvPrepareHandle->data = static_cast<void*>(this);
+
+		err = uv_prepare_init(DepLibUV::GetLoop(), this->uvPrepareHandle);
+
+		if (err != 0)
+		{
+			delete this->uvPrepareHandle;
+			this->uvPrepareHandle = nullptr;
+
+			MS_THROW_ERROR_STD("uv_prepare_init() failed: %s", uv_strerror(err));
+		}
+
+		this->uvCheckHandle       = new uv_check_t;
+		this->uvCheckHandle->data = static_cast<void*>(this);
+
+		err = uv_check_init(DepLibUV::GetLoop(), this->uvCheckHandle);
+
+		if (err != 0)
+		{
+			delete this->uvCheckHandle;
+			this->uvCheckHandle = nullptr;
+
+			uv_close(
+			  reinterpret_cast<uv_handle_t*>(this->uvPrepareHandle),
+			  static_cast<uv_close_cb>(onClosePrepare));
+
+			this->uvPrepareHandle = nullptr;
+
+			MS_THROW_ERROR_STD("uv_check_init() failed: %s", uv_strerror(err));
+		}
+
+		// These handles must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvPrepareHandle));
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvCheckHandle));
+	}
+	else if (!enabled && this->uvPrepareHandle)
+	{
+		Flush();
+
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(this->uvPrepareHandle),
+		  static_cast<uv_close_cb>(onClosePrepare));
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(this->uvCheckHandle), static_cast<uv_close_cb>(onCloseCheck));
+
+		this->uvPrepareHandle = nullptr;
+		this->uvCheckHandle   = nullptr;
+	}
+}
+
+/**
+ * Writes the data kept by write coalescing now.
+ */
+void UnixStreamSocketHandle::Flush()
+{
+	MS_TRACE_STD();
+
+	if (this->pendingWriteData.empty())
+	{
+		return;
+	}
+
+	uv_prepare_stop(this->uvPrepareHandle);
+	uv_check_stop(this->uvCheckHandle);
+
+	WriteImpl(this->pendingWriteData.data(), this->pendingWriteData.size());
+
+	this->pendingWriteData.clear();
+}
+
+void UnixStreamSocketHandle::WriteImpl(const uint8_t* data, size_t len)
+{
+	MS_TRACE_STD();
+
 	// First try uv_try_write(). In case it can not directly send all the given data
 	// then build a uv_req_t and use uv_write().
 
@@ -385,6 +548,13 @@ inline void UnixStreamSocketHandle::OnUvRead(ssize_t nread, const uv_buf_t* /*bu
 	}
 }
 
+inline void UnixStreamSocketHandle::OnUvFlush()
+{
+	MS_TRACE_STD();
+
+	Flush();
+}
+
 inline void UnixStreamSocketHandle::OnUvWriteError(int error)
 {
 	MS_TRACE_STD();
@@ -17,6 +17,7 @@
 #include "Worker.hpp"
 #include "Channel/ChannelSocket.hpp"
 #include "RTC/DtlsTransport.hpp"
+#include "RTC/SrtpCryptoPool.hpp"
 #include "RTC/SrtpSession.hpp"
 #include <uv.h>
 #include <absl/container/flat_hash_map.h>
@@ -40,6 +41,8 @@ extern "C" int mediasoup_worker_run(
 	// Initialize libuv stuff (we need it for the Channel).
 	DepLibUV::ClassInit();
 
+	const uint64_t startedAtUs = DepLibUV::GetTimeUs();
+
 	// Channel socket. If Worker instance runs properly, this socket is closed by
 	// it in its destructor. Otherwise it's closed here by also letting libuv
 	// deallocate its UV handles.
@@ -98,6 +101,11 @@ extern "C" int mediasoup_worker_run(
 		return 40;
 	}
 
+	if (Settings::configuration.channelWriteCoalescing)
+	{
+		channel->SetWriteCoalescing(true);
+	}
+
 	MS_DEBUG_TAG(info, "starting mediasoup-worker process [version:%s]", version);
 
 #if defined(MS_LITTLE_ENDIAN)
@@ -132,6 +140,7 @@ extern "C" int mediasoup_worker_run(
 		Utils::Crypto::ClassInit();
 		RTC::DtlsTransport::ClassInit();
 		RTC::SrtpSession::ClassInit();
+		RTC::SrtpCryptoPool::ClassInit();
 
 #ifdef MS_EXECUTABLE
 		// Ignore some signals.
@@ -139,9 +148,10 @@ extern "C" int mediasoup_worker_run(
 #endif
 
 		// Run the Worker.
-		const Worker worker(channel.get());
+		const Worker worker(channel.get(), startedAtUs);
 
 		// Free static stuff.
+		RTC::SrtpCryptoPool::ClassDestroy();
 		DepLibSRTP::ClassDestroy();
 		Utils::Crypto::ClassDestroy();
 		DepLibWebRTC::ClassDestroy();
@@ -0,0 +1,171 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "Channel/ChannelNotifier.hpp"
+#include "Channel/ChannelSocket.hpp"
+#include "FBS/consumer.h"
+#include "FBS/message.h"
+#include "FBS/response.h"
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+static std::vector<std::vector<uint8_t>> sentMessages;
+
+static ChannelReadFreeFn channelReadFn(
+  uint8_t** /*message*/,
+  uint32_t* /*messageLen*/,
+  size_t* /*messageCtx*/,
+  const void* /*handle*/,
+  ChannelReadCtx /*ctx*/)
+{
+	return nullptr;
+}
+
+static void channelWriteFn(const uint8_t* message, uint32_t messageLen, ChannelWriteCtx /*ctx*/)
+{
+	sentMessages.emplace_back(message, message + messageLen);
+}
+
+static const FBS::Message::Message* getSentMessage(size_t idx)
+{
+	return FBS::Message::GetSizePrefixedMessage(sentMessages.at(idx).data());
+}
+
+static void emitScore(Channel::ChannelNotifier* notifier, const std::string& targetId, uint8_t score)
+{
+	auto& builder = notifier->GetBufferBuilder();
+	std::vector<uint8_t> producerScores{ 10 };
+	auto scoreOffset =
+	  FBS::Consumer::CreateConsumerScoreDirect(builder, score, /*producerScore*/ 10, &producerScores);
+	auto notificationOffset = FBS::Consumer::CreateScoreNotification(builder, scoreOffset);
+
+	notifier->Emit(
+	  targetId,
+	  FBS::Notification::Event::CONSUMER_SCORE,
+	  FBS::Notification::Body::Consumer_ScoreNotification,
+	  notificationOffset);
+}
+
+static void checkDump(
+  Channel::ChannelNotifier* notifier,
+  uint64_t rawNotifications,
+  uint64_t batchedNotifications,
+  uint64_t coalescedNotifications,
+  uint64_t batches)
+{
+	flatbuffers::FlatBufferBuilder builder;
+
+	builder.Finish(notifier->FillBufferDump(builder));
+
+	const auto* dump = flatbuffers::GetRoot<FBS::Worker::ChannelNotifierDump>(builder.GetBufferPointer());
+
+	REQUIRE(dump->rawNotifications() == rawNotifications);
+	REQUIRE(dump->batchedNotifications() == batchedNotifications);
+	REQUIRE(dump->coalescedNotifications() == coalescedNotifications);
+	REQUIRE(dump->batches() == batches);
+}
+
+SCENARIO("ChannelNotifier", "[channel][notifier]")
+{
+	sentMessages.clear();
+
+	auto* channel  = new Channel::ChannelSocket(channelReadFn, nullptr, channelWriteFn, nullptr);
+	auto* notifier = new Channel::ChannelNotifier(channel);
+
+	SECTION("notifications are sent right away if batching is disabled")
+	{
+		notifier->Emit("1234", FBS::Notification::Event::WORKER_RUNNING);
+		emitScore(notifier, "consumer1", 1);
+		emitScore(notifier, "consumer1", 2);
+
+		REQUIRE(sentMessages.size() == 3);
+
+		for (size_t i{ 0 }; i < sentMessages.size(); ++i)
+		{
+			REQUIRE(getSentMessage(i)->data_type() == FBS::Message::Body::Notification);
+		}
+
+		checkDump(notifier, 3, 0, 0, 0);
+	}
+
+	SECTION("notifications generated within a loop iteration are batched")
+	{
+		notifier->SetBatching(true, /*windowMs*/ 0);
+
+		notifier->Emit("1234", FBS::Notification::Event::WORKER_RUNNING);
+		emitScore(notifier, "consumer1", 1);
+		emitScore(notifier, "consumer2", 5);
+		emitScore(notifier, "consumer1", 2);
+
+		REQUIRE(sentMessages.empty());
+		REQUIRE(notifier->HasPendingNotifications());
+
+		// Run a single loop iteration.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(sentMessages.size() == 1);
+		REQUIRE(notifier->HasPendingNotifications() == false);
+
+		const auto* message = getSentMessage(0);
+
+		REQUIRE(message->data_type() == FBS::Message::Body::NotificationBatch);
+
+		const auto* notifications = message->data_as<FBS::Notification::NotificationBatch>()->notifications();
+
+		// First score of consumer1 is replaced by the last one.
+		REQUIRE(notifications->size() == 3);
+		REQUIRE(notifications->Get(0)->event() == FBS::Notification::Event::WORKER_RUNNING);
+		REQUIRE(notifications->Get(1)->handlerId()->str() == "consumer2");
+		REQUIRE(
+		  notifications->Get(1)->body_as<FBS::Consumer::ScoreNotification>()->score()->score() == 5);
+		REQUIRE(notifications->Get(2)->handlerId()->str() == "consumer1");
+		REQUIRE(
+		  notifications->Get(2)->body_as<FBS::Consumer::ScoreNotification>()->score()->score() == 2);
+
+		checkDump(notifier, 0, 3, 1, 1);
+	}
+
+	SECTION("a single pending notification is not sent as a batch")
+	{
+		notifier->SetBatching(true, /*windowMs*/ 0);
+
+		emitScore(notifier, "consumer1", 1);
+		emitScore(notifier, "consumer1", 2);
+
+		notifier->Flush();
+
+		REQUIRE(sentMessages.size() == 1);
+		REQUIRE(getSentMessage(0)->data_type() == FBS::Message::Body::Notification);
+
+		checkDump(notifier, 1, 0, 1, 0);
+	}
+
+	SECTION("pending notifications are sent before any other message")
+	{
+		notifier->SetBatching(true, /*windowMs*/ 100);
+
+		notifier->Emit("1234", FBS::Notification::Event::WORKER_RUNNING);
+		emitScore(notifier, "consumer1", 1);
+
+		flatbuffers::FlatBufferBuilder builder;
+		auto response = FBS::Response::CreateResponse(builder, /*id*/ 1, /*accepted*/ true);
+
+		builder.FinishSizePrefixed(
+		  FBS::Message::CreateMessage(builder, FBS::Message::Body::Response, response.Union()));
+		channel->Send(builder.GetBufferPointer(), builder.GetSize());
+
+		REQUIRE(sentMessages.size() == 2);
+		REQUIRE(getSentMessage(0)->data_type() == FBS::Message::Body::NotificationBatch);
+		REQUIRE(getSentMessage(1)->data_type() == FBS::Message::Body::Response);
+
+		checkDump(notifier, 0, 2, 0, 1);
+	}
+
+	delete notifier;
+
+	channel->Close();
+	delete channel;
+
+	// Must run the loop to close UV handles.
+	DepLibUV::RunLoop();
+}
@@ -0,0 +1,384 @@
+#include "common.hpp"
+#include "RTC/Codecs/AV1.hpp"
+#include "RTC/Codecs/DependencyDescriptor.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace RTC;
+
+using TemplateDependencyStructure = Codecs::DependencyDescriptor::TemplateDependencyStructure;
+
+// L1T3 Dependency Descriptor of a key frame (template id 0, frame number 1)
+// carrying a template dependency structure with 3 decode targets and these
+// templates:
+// - 0: T0, dtis SSS, no references (key frame).
+// - 1: T0, dtis SSS, fdiffs {4}.
+// - 2: T1, dtis -SS, fdiffs {2}.
+// - 3: T2, dtis --D, fdiffs {1}.
+// clang-format off
+static const uint8_t KeyFrameDependencyDescriptor[] =
+{
+	0xC0, 0x00, 0x01, 0x80, 0x02, 0x17, 0xAA, 0xA2, 0x81, 0x4D, 0x14, 0x00
+};
+// clang-format on
+
+// L3T1_KEY (K-SVC) Dependency Descriptor of a key frame (template id 0, frame
+// number 1) carrying a template dependency structure with 3 decode targets (one
+// per spatial layer) and these templates:
+// - 0: S0, dtis SSS, no references (key frame).
+// - 1: S0, dtis S--, fdiffs {3}.
+// - 2: S1, dtis -SS, fdiffs {1}.
+// - 3: S1, dtis -S-, fdiffs {3}.
+// - 4: S2, dtis --S, fdiffs {1}.
+// - 5: S2, dtis --S, fdiffs {3}.
+// clang-format off
+static const uint8_t KSvcKeyFrameDependencyDescriptor[] =
+{
+	0xC0, 0x00, 0x01, 0x80, 0x02, 0x22, 0x3A, 0xA0,
+	0x28, 0x80, 0x82, 0x49, 0x04, 0x90, 0x48, 0x00
+};
+// clang-format on
+
+// L3T1 (full SVC) Dependency Descriptor of a key frame (template id 0, frame
+// number 1) carrying a template dependency structure with 3 decode targets (one
+// per spatial layer) and these templates:
+// - 0: S0, dtis SSS, no references (key frame).
+// - 1: S0, dtis SRR, fdiffs {3}.
+// - 2: S1, dtis -SS, fdiffs {1}.
+// - 3: S1, dtis -RR, fdiffs {1, 3}.
+// - 4: S2, dtis --S, fdiffs {1}.
+// - 5: S2, dtis --R, fdiffs {1, 3}.
+// clang-format off
+static const uint8_t FullSvcKeyFrameDependencyDescriptor[] =
+{
+	0xC0, 0x00, 0x01, 0x80, 0x02, 0x22, 0x3A, 0xAF,
+	0x28, 0xF0, 0x83, 0x49, 0x04, 0x24, 0x82, 0x12,
+	0x00
+};
+// clang-format on
+
+// Dependency Descriptor with just mandatory fields (start and end of frame).
+static void createDependencyDescriptor(uint8_t* buffer, uint8_t templateId, uint16_t frameNumber)
+{
+	buffer[0] = 0xC0 | templateId;
+	buffer[1] = frameNumber >> 8;
+	buffer[2] = frameNumber & 0xFF;
+}
+
+static bool processAV1Frame(
+  Codecs::AV1::EncodingContext& context,
+  std::unique_ptr<TemplateDependencyStructure>& templateDependencyStructure,
+  uint8_t templateId,
+  uint16_t frameNumber,
+  bool& marker)
+{
+	uint8_t descriptor[3];
+	uint8_t payload[] = { 0x10, 0x00 };
+	Codecs::DependencyDescriptor dependencyDescriptor;
+	Codecs::AV1::PayloadDescriptor payloadDescriptor{};
+
+	createDependencyDescriptor(descriptor, templateId, frameNumber);
+
+	REQUIRE(Codecs::DependencyDescriptor::Parse(
+	  descriptor, sizeof(descriptor), dependencyDescriptor, templateDependencyStructure));
+	REQUIRE(Codecs::AV1::Parse(payload, sizeof(payload), payloadDescriptor, &dependencyDescriptor));
+
+	Codecs::AV1::PayloadDescriptorHandler payloadDescriptorHandler(payloadDescriptor);
+
+	marker = false;
+
+	return payloadDescriptorHandler.Process(&context, payload, marker);
+}
+
+SCENARIO("parse Dependency Descriptor", "[codecs][av1]")
+{
+	std::unique_ptr<TemplateDependencyStructure> templateDependencyStructure;
+	Codecs::DependencyDescriptor dependencyDescriptor;
+	uint8_t descriptor[3];
+
+	SECTION("parse key frame with template dependency structure")
+	{
+		REQUIRE(Codecs::DependencyDescriptor::Parse(
+		  KeyFrameDependencyDescriptor,
+		  sizeof(KeyFrameDependencyDescriptor),
+		  dependencyDescriptor,
+		  templateDependencyStructure));
+
+		REQUIRE(templateDependencyStructure);
+		REQUIRE(templateDependencyStructure->templateCount == 4);
+		REQUIRE(templateDependencyStructure->decodeTargetCount == 3);
+		REQUIRE(templateDependencyStructure->chainCount == 0);
+		REQUIRE(templateDependencyStructure->maxSpatialId == 0);
+		REQUIRE(templateDependencyStructure->maxTemporalId == 2);
+		REQUIRE(templateDependencyStructure->decodeTargetTemporalIds[0] == 0);
+		REQUIRE(templateDependencyStructure->decodeTargetTemporalIds[1] == 1);
+		REQUIRE(templateDependencyStructure->decodeTargetTemporalIds[2] == 2);
+		REQUIRE(templateDependencyStructure->activeDecodeTargetsBitmask == 0b111);
+
+		REQUIRE(dependencyDescriptor.startOfFrame == true);
+		REQUIRE(dependencyDescriptor.endOfFrame == true);
+		REQUIRE(dependencyDescriptor.frameNumber == 1);
+		REQUIRE(dependencyDescriptor.spatialId == 0);
+		REQUIRE(dependencyDescriptor.temporalId == 0);
+		REQUIRE(dependencyDescriptor.hasTemplateDependencyStructure == true);
+		REQUIRE(dependencyDescriptor.independent == true);
+		REQUIRE(dependencyDescriptor.switchingUpPoint == true);
+	}
+
+	SECTION("parse frames using the cached template dependency structure")
+	{
+		REQUIRE(Codecs::DependencyDescriptor::Parse(
+		  KeyFrameDependencyDescriptor,
+		  sizeof(KeyFrameDependencyDescriptor),
+		  dependencyDescriptor,
+		  templateDependencyStructure));
+
+		const auto* cachedTemplateDependencyStructure = templateDependencyStructure.get();
+
+		createDependencyDescriptor(descriptor, 2, 2);
+
+		REQUIRE(Codecs::DependencyDescriptor::Parse(
+		  descriptor, sizeof(descriptor), dependencyDescriptor, templateDependencyStructure));
+		REQUIRE(templateDependencyStructure.get() == cachedTemplateDependencyStructure);
+		REQUIRE(dependencyDescriptor.frameNumber == 2);
+		REQUIRE(dependencyDescriptor.temporalId == 1);
+		REQUIRE(dependencyDescriptor.fdiffCount == 1);
+		REQUIRE(dependencyDescriptor.hasTemplateDependencyStructure == false);
+		REQUIRE(dependencyDescriptor.independent == false);
+		REQUIRE(dependencyDescriptor.switchingUpPoint == true);
+
+		createDependencyDescriptor(descriptor, 3, 3);
+
+		REQUIRE(Codecs::DependencyDescriptor::Parse(
+		  descriptor, sizeof(descriptor), dependencyDescriptor, templateDependencyStructure));
+		REQUIRE(dependencyDescriptor.temporalId == 2);
+		REQUIRE(dependencyDescriptor.switchingUpPoint == false);
+
+		// Unknown template.
+		createDependencyDescriptor(descriptor, 4, 4);
+
+		REQUIRE_FALSE(Codecs::DependencyDescriptor::Parse(
+		  descriptor, sizeof(descriptor), dependencyDescriptor, templateDependencyStructure));
+		REQUIRE(templateDependencyStructure.get() == cachedTemplateDependencyStructure);
+	}
+
+	SECTION("do not parse frames without template dependency structure")
+	{
+		createDependencyDescriptor(descriptor, 0, 1);
+
+		REQUIRE_FALSE(Codecs::DependencyDescriptor::Parse(
+		  descriptor, sizeof(descriptor), dependencyDescriptor, templateDependencyStructure));
+		REQUIRE_FALSE(templateDependencyStructure);
+	}
+
+	SECTION("do not replace cached structure with a truncated one")
+	{
+		REQUIRE(Codecs::DependencyDescriptor::Parse(
+		  KeyFrameDependencyDescriptor,
+		  sizeof(KeyFrameDependencyDescriptor),
+		  dependencyDescriptor,
+		  templateDependencyStructure));
+
+		const auto* cachedTemplateDependencyStructure = templateDependencyStructure.get();
+
+		REQUIRE_FALSE(Codecs::DependencyDescriptor::Parse(
+		  KeyFrameDependencyDescriptor, 8, dependencyDescriptor, templateDependencyStructure));
+		REQUIRE(templateDependencyStructure.get() == cachedTemplateDependencyStructure);
+	}
+}
+
+SCENARIO("process AV1 payload descriptor", "[codecs][av1]")
+{
+	SECTION("key frame is detected in RTP packet")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x90, 0x60, 0x00, 0x01,
+			0x00, 0x00, 0x00, 0x04,
+			0x00, 0x00, 0x00, 0x05,
+			0xBE, 0xDE, 0x00, 0x04, // Header Extension
+			0x1B, 0xC0, 0x00, 0x01, // Dependency Descriptor (id 1, length 12)
+			0x80, 0x02, 0x17, 0xAA,
+			0xA2, 0x81, 0x4D, 0x14,
+			0x00, 0x00, 0x00, 0x00,
+			0x18, 0x12, 0x00, 0x0A  // Aggregation header (W=1, N=1) and OBU
+		};
+		// clang-format on
+
+		std::unique_ptr<RtpPacket> packet{ RtpPacket::Parse(buffer, sizeof(buffer)) };
+		std::unique_ptr<TemplateDependencyStructure> templateDependencyStructure;
+
+		REQUIRE(packet);
+
+		packet->SetDependencyDescriptorExtensionId(1);
+
+		Codecs::AV1::ProcessRtpPacket(packet.get(), templateDependencyStructure);
+
+		REQUIRE(templateDependencyStructure);
+		REQUIRE(packet->IsKeyFrame());
+		REQUIRE(packet->GetSpatialLayer() == 0);
+		REQUIRE(packet->GetTemporalLayer() == 0);
+	}
+
+	SECTION("drop and switch temporal layers")
+	{
+		RTC::Codecs::EncodingContext::Params params;
+		params.spatialLayers  = 1;
+		params.temporalLayers = 3;
+
+		Codecs::AV1::EncodingContext context(params);
+		context.SyncRequired();
+		context.SetTargetSpatialLayer(0);
+		context.SetTargetTemporalLayer(0);
+
+		std::unique_ptr<TemplateDependencyStructure> templateDependencyStructure;
+		Codecs::DependencyDescriptor dependencyDescriptor;
+		bool marker;
+
+		REQUIRE(Codecs::DependencyDescriptor::Parse(
+		  KeyFrameDependencyDescriptor,
+		  sizeof(KeyFrameDependencyDescriptor),
+		  dependencyDescriptor,
+		  templateDependencyStructure));
+
+		// Key frame (T0).
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 0, 1, marker));
+		REQUIRE(marker == true);
+		REQUIRE(context.GetCurrentSpatialLayer() == 0);
+		REQUIRE(context.GetCurrentTemporalLayer() == 0);
+
+		// T2 and T1 frames are dropped.
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 3, 2, marker));
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 2, 3, marker));
+
+		// T0 frame.
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 1, 4, marker));
+
+		context.SetTargetTemporalLayer(2);
+
+		// T2 frame is not a switching point so it's dropped.
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 3, 5, marker));
+		REQUIRE(context.GetCurrentTemporalLayer() == 0);
+
+		// T1 frame is a switching point.
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 2, 6, marker));
+		REQUIRE(context.GetCurrentTemporalLayer() == 1);
+
+		context.SetTargetTemporalLayer(0);
+
+		// Downgrade once a T0 frame ends.
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 1, 7, marker));
+		REQUIRE(context.GetCurrentTemporalLayer() == 0);
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 2, 8, marker));
+
+		// Packets of frames older than the last forwarded one are not filtered.
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 2, 6, marker));
+		REQUIRE(context.GetCurrentTemporalLayer() == 0);
+	}
+
+	SECTION("drop and switch spatial layers (K-SVC)")
+	{
+		RTC::Codecs::EncodingContext::Params params;
+		params.spatialLayers  = 3;
+		params.temporalLayers = 1;
+		params.ksvc           = true;
+
+		Codecs::AV1::EncodingContext context(params);
+		context.SyncRequired();
+		context.SetTargetSpatialLayer(2);
+		context.SetTargetTemporalLayer(0);
+
+		std::unique_ptr<TemplateDependencyStructure> templateDependencyStructure;
+		Codecs::DependencyDescriptor dependencyDescriptor;
+		bool marker;
+
+		REQUIRE(Codecs::DependencyDescriptor::Parse(
+		  KSvcKeyFrameDependencyDescriptor,
+		  sizeof(KSvcKeyFrameDependencyDescriptor),
+		  dependencyDescriptor,
+		  templateDependencyStructure));
+		REQUIRE(templateDependencyStructure->maxSpatialId == 2);
+
+		// Every frame of the key picture is forwarded.
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 0, 1, marker));
+		REQUIRE(marker == false);
+		REQUIRE(context.GetCurrentSpatialLayer() == 2);
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 2, 2, marker));
+		REQUIRE(marker == false);
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 4, 3, marker));
+		REQUIRE(marker == true);
+
+		// Lower spatial layers of delta frames are dropped.
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 1, 4, marker));
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 3, 5, marker));
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 5, 6, marker));
+		REQUIRE(marker == true);
+
+		context.SetTargetSpatialLayer(1);
+
+		// Downgrade waits for a key frame.
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 1, 7, marker));
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 3, 8, marker));
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 5, 9, marker));
+		REQUIRE(context.GetCurrentSpatialLayer() == 2);
+
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 0, 10, marker));
+		REQUIRE(marker == false);
+		REQUIRE(context.GetCurrentSpatialLayer() == 1);
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 2, 11, marker));
+		REQUIRE(marker == true);
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 4, 12, marker));
+
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 1, 13, marker));
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 3, 14, marker));
+		REQUIRE(marker == true);
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 5, 15, marker));
+	}
+
+	SECTION("drop and switch spatial layers (full SVC)")
+	{
+		RTC::Codecs::EncodingContext::Params params;
+		params.spatialLayers  = 3;
+		params.temporalLayers = 1;
+
+		Codecs::AV1::EncodingContext context(params);
+		context.SyncRequired();
+		context.SetTargetSpatialLayer(2);
+		context.SetTargetTemporalLayer(0);
+
+		std::unique_ptr<TemplateDependencyStructure> templateDependencyStructure;
+		Codecs::DependencyDescriptor dependencyDescriptor;
+		bool marker;
+
+		REQUIRE(Codecs::DependencyDescriptor::Parse(
+		  FullSvcKeyFrameDependencyDescriptor,
+		  sizeof(FullSvcKeyFrameDependencyDescriptor),
+		  dependencyDescriptor,
+		  templateDependencyStructure));
+
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 0, 1, marker));
+		REQUIRE(context.GetCurrentSpatialLayer() == 2);
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 2, 2, marker));
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 4, 3, marker));
+		REQUIRE(marker == true);
+
+		// Lower spatial layers of delta frames are forwarded.
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 1, 4, marker));
+		REQUIRE(marker == false);
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 3, 5, marker));
+		REQUIRE(marker == false);
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 5, 6, marker));
+		REQUIRE(marker == true);
+
+		context.SetTargetSpatialLayer(1);
+
+		// Downgrade once a S1 frame ends, without key frame.
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 1, 7, marker));
+		REQUIRE(context.GetCurrentSpatialLayer() == 2);
+		REQUIRE(processAV1Frame(context, templateDependencyStructure, 3, 8, marker));
+		REQUIRE(marker == true);
+		REQUIRE(context.GetCurrentSpatialLayer() == 1);
+		REQUIRE_FALSE(processAV1Frame(context, templateDependencyStructure, 5, 9, marker));
+	}
+}
@@ -251,12 +251,11 @@ std::unique_ptr<Codecs::VP8::PayloadDescriptor> ProcessPacket(
 	};
 	// clang-format on
 	bool marker;
-	auto* payloadDescriptor =
-	  CreatePacket(buffer, sizeof(buffer), pictureId, tl0PictureIndex, tlIndex, layerSync);
-	std::unique_ptr<Codecs::VP8::PayloadDescriptorHandler> payloadDescriptorHandler(
-	  new Codecs::VP8::PayloadDescriptorHandler(payloadDescriptor));
+	std::unique_ptr<Codecs::VP8::PayloadDescriptor> payloadDescriptor{ CreatePacket(
+	  buffer, sizeof(buffer), pictureId, tl0PictureIndex, tlIndex, layerSync) };
+	Codecs::VP8::PayloadDescriptorHandler payloadDescriptorHandler(*payloadDescriptor);
 
-	if (payloadDescriptorHandler->Process(&context, buffer, marker))
+	if (payloadDescriptorHandler.Process(&context, buffer, marker))
 	{
 		return std::unique_ptr<Codecs::VP8::PayloadDescriptor>(Codecs::VP8::Parse(buffer, sizeof(buffer)));
 	}
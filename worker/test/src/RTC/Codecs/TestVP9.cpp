@@ -33,11 +33,11 @@ std::unique_ptr<Codecs::VP9::PayloadDescriptor> ProcessVP9Packet(
 	};
 	// clang-format on
 	bool marker;
-	auto* payloadDescriptor = CreateVP9Packet(buffer, sizeof(buffer), pictureId, tlIndex);
-	std::unique_ptr<Codecs::VP9::PayloadDescriptorHandler> payloadDescriptorHandler(
-	  new Codecs::VP9::PayloadDescriptorHandler(payloadDescriptor));
+	std::unique_ptr<Codecs::VP9::PayloadDescriptor> payloadDescriptor{ CreateVP9Packet(
+	  buffer, sizeof(buffer), pictureId, tlIndex) };
+	Codecs::VP9::PayloadDescriptorHandler payloadDescriptorHandler(*payloadDescriptor);
 
-	if (payloadDescriptorHandler->Process(&context, buffer, marker))
+	if (payloadDescriptorHandler.Process(&context, buffer, marker))
 	{
 		return std::unique_ptr<Codecs::VP9::PayloadDescriptor>(Codecs::VP9::Parse(buffer, sizeof(buffer)));
 	}
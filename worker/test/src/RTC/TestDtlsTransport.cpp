@@ -0,0 +1,393 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "Settings.hpp"
+#include "RTC/DtlsTransport.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <iostream>
+#endif
+
+using namespace RTC;
+
+class TestDtlsTransportListener : public DtlsTransport::Listener
+{
+public:
+	/* Pure virtual methods inherited from DtlsTransport::Listener. */
+	void OnDtlsTransportConnecting(const DtlsTransport* /*dtlsTransport*/) override
+	{
+	}
+	void OnDtlsTransportConnected(
+	  const DtlsTransport* /*dtlsTransport*/,
+	  SrtpSession::CryptoSuite /*srtpCryptoSuite*/,
+	  uint8_t* srtpLocalKey,
+	  size_t srtpLocalKeyLen,
+	  uint8_t* srtpRemoteKey,
+	  size_t srtpRemoteKeyLen,
+	  std::string& /*remoteCert*/) override
+	{
+		this->connected = true;
+		this->srtpLocalKey.assign(srtpLocalKey, srtpLocalKey + srtpLocalKeyLen);
+		this->srtpRemoteKey.assign(srtpRemoteKey, srtpRemoteKey + srtpRemoteKeyLen);
+	}
+	void OnDtlsTransportFailed(const DtlsTransport* /*dtlsTransport*/) override
+	{
+		this->failed = true;
+	}
+	void OnDtlsTransportClosed(const DtlsTransport* /*dtlsTransport*/) override
+	{
+	}
+	void OnDtlsTransportSendData(
+	  const DtlsTransport* /*dtlsTransport*/, const uint8_t* data, size_t len) override
+	{
+		this->sentData.emplace_back(data, data + len);
+	}
+	void OnDtlsTransportApplicationDataReceived(
+	  const DtlsTransport* /*dtlsTransport*/, const uint8_t* data, size_t len) override
+	{
+		this->applicationData.assign(data, data + len);
+	}
+
+public:
+	bool connected{ false };
+	bool failed{ false };
+	std::vector<uint8_t> srtpLocalKey;
+	std::vector<uint8_t> srtpRemoteKey;
+	std::deque<std::vector<uint8_t>> sentData;
+	std::vector<uint8_t> applicationData;
+};
+
+// A DTLS client and server whose DTLS data is delivered to each other by the
+// loop.
+struct DtlsTransportPair
+{
+	DtlsTransportPair()
+	{
+		DtlsTransport::Fingerprint fingerprint;
+
+		for (const auto& localFingerprint : DtlsTransport::GetLocalFingerprints())
+		{
+			if (localFingerprint.algorithm == DtlsTransport::FingerprintAlgorithm::SHA256)
+			{
+				fingerprint = localFingerprint;
+			}
+		}
+
+		this->client = new DtlsTransport(&this->clientListener);
+		this->server = new DtlsTransport(&this->serverListener);
+
+		// Both use the same certificate.
+		this->client->SetRemoteFingerprint(fingerprint);
+		this->server->SetRemoteFingerprint(fingerprint);
+	}
+	~DtlsTransportPair()
+	{
+		delete this->client;
+		delete this->server;
+	}
+
+	void Run()
+	{
+		this->server->Run(DtlsTransport::Role::SERVER);
+		this->client->Run(DtlsTransport::Role::CLIENT);
+	}
+	void DeliverSentData()
+	{
+		while (!this->clientListener.sentData.empty())
+		{
+			const auto data = std::move(this->clientListener.sentData.front());
+
+			this->clientListener.sentData.pop_front();
+			this->server->ProcessDtlsData(data.data(), data.size());
+		}
+
+		while (!this->serverListener.sentData.empty())
+		{
+			const auto data = std::move(this->serverListener.sentData.front());
+
+			this->serverListener.sentData.pop_front();
+			this->client->ProcessDtlsData(data.data(), data.size());
+		}
+	}
+	bool IsDone() const
+	{
+		return (this->clientListener.connected || this->clientListener.failed) &&
+		       (this->serverListener.connected || this->serverListener.failed);
+	}
+
+	TestDtlsTransportListener clientListener;
+	TestDtlsTransportListener serverListener;
+	DtlsTransport* client{ nullptr };
+	DtlsTransport* server{ nullptr };
+};
+
+// Runs the handshakes of the given pairs concurrently and returns the maximum
+// time (in ns) the loop was blocked.
+static uint64_t runHandshakes(std::vector<DtlsTransportPair*>& pairs)
+{
+	struct Context
+	{
+		std::vector<DtlsTransportPair*>* pairs;
+		uint64_t lastIdleAt{ 0u };
+		uint64_t maxLoopStall{ 0u };
+	};
+
+	Context context;
+	uv_idle_t idle;
+
+	context.pairs = &pairs;
+	idle.data     = &context;
+
+	for (auto* pair : pairs)
+	{
+		pair->Run();
+	}
+
+	uv_idle_init(DepLibUV::GetLoop(), &idle);
+	uv_idle_start(
+	  &idle,
+	  [](uv_idle_t* handle)
+	  {
+		  auto* context = static_cast<Context*>(handle->data);
+		  const uint64_t now = uv_hrtime();
+
+		  if (context->lastIdleAt != 0u && now - context->lastIdleAt > context->maxLoopStall)
+		  {
+			  context->maxLoopStall = now - context->lastIdleAt;
+		  }
+
+		  bool done{ true };
+
+		  for (auto* pair : *context->pairs)
+		  {
+			  pair->DeliverSentData();
+
+			  done = done && pair->IsDone();
+		  }
+
+		  if (done)
+		  {
+			  uv_idle_stop(handle);
+		  }
+
+		  context->lastIdleAt = uv_hrtime();
+	  });
+
+	DepLibUV::RunLoop();
+
+	uv_close(reinterpret_cast<uv_handle_t*>(&idle), nullptr);
+	DepLibUV::RunLoop();
+
+	return context.maxLoopStall;
+}
+
+static std::vector<std::string> getLocalFingerprintValues()
+{
+	std::vector<std::string> values;
+
+	for (const auto& fingerprint : DtlsTransport::GetLocalFingerprints())
+	{
+		values.push_back(fingerprint.value);
+	}
+
+	return values;
+}
+
+SCENARIO("DtlsTransport", "[rtc][dtls]")
+{
+	SECTION("workers running in the same process share the generated certificate")
+	{
+		DtlsTransport::ClassInit();
+
+		const auto fingerprints = getLocalFingerprintValues();
+		std::vector<std::string> threadFingerprints;
+
+		REQUIRE(!fingerprints.empty());
+
+		// Run another worker like the Rust crate does.
+		std::thread thread(
+		  [&threadFingerprints]()
+		  {
+			  DtlsTransport::ClassInit();
+
+			  threadFingerprints = getLocalFingerprintValues();
+
+			  DtlsTransport::ClassDestroy();
+		  });
+
+		thread.join();
+
+		REQUIRE(threadFingerprints == fingerprints);
+
+		DtlsTransport::ClassDestroy();
+
+		REQUIRE(DtlsTransport::GetLocalFingerprints().empty());
+
+		// Once no worker uses it, a new certificate is generated.
+		DtlsTransport::ClassInit();
+
+		REQUIRE(getLocalFingerprintValues() != fingerprints);
+
+		DtlsTransport::ClassDestroy();
+	}
+
+	SECTION("handshake succeeds with DTLS handshake offload")
+	{
+		Settings::configuration.dtlsHandshakeOffload = true;
+
+		DtlsTransport::ClassInit();
+
+		std::vector<DtlsTransportPair*> pairs;
+
+		for (size_t i{ 0 }; i < 4; ++i)
+		{
+			pairs.push_back(new DtlsTransportPair());
+		}
+
+		runHandshakes(pairs);
+
+		for (auto* pair : pairs)
+		{
+			REQUIRE(pair->clientListener.connected);
+			REQUIRE(pair->serverListener.connected);
+			REQUIRE(pair->client->GetState() == DtlsTransport::DtlsState::CONNECTED);
+			REQUIRE(pair->server->GetState() == DtlsTransport::DtlsState::CONNECTED);
+			REQUIRE(pair->clientListener.srtpLocalKey == pair->serverListener.srtpRemoteKey);
+			REQUIRE(pair->clientListener.srtpRemoteKey == pair->serverListener.srtpLocalKey);
+		}
+
+		// Application data is processed right away once connected.
+		const std::vector<uint8_t> applicationData{ 1, 2, 3, 4 };
+
+		pairs[0]->client->SendApplicationData(applicationData.data(), applicationData.size());
+		pairs[0]->DeliverSentData();
+
+		REQUIRE(pairs[0]->serverListener.applicationData == applicationData);
+
+		for (auto* pair : pairs)
+		{
+			delete pair;
+		}
+
+		// Destroy a transport whose handshake is in progress.
+		auto* pair = new DtlsTransportPair();
+
+		pair->Run();
+		pair->DeliverSentData();
+
+		delete pair;
+
+		DtlsTransport::ClassDestroy();
+
+		Settings::configuration.dtlsHandshakeOffload = false;
+	}
+
+	SECTION("generated certificate is reused from the certificate cache file")
+	{
+		const std::string cacheFile =
+		  (std::filesystem::temp_directory_path() / "mediasoup-test-dtls-cache.pem").string();
+
+		std::filesystem::remove(cacheFile);
+
+		Settings::configuration.dtlsCertificateCacheFile = cacheFile;
+
+		DtlsTransport::ClassInit();
+
+		const auto fingerprints = getLocalFingerprintValues();
+
+		REQUIRE(DtlsTransport::IsCertificateGenerated());
+		REQUIRE(std::filesystem::exists(cacheFile));
+
+		DtlsTransport::ClassDestroy();
+
+		DtlsTransport::ClassInit();
+
+		REQUIRE(!DtlsTransport::IsCertificateGenerated());
+		REQUIRE(getLocalFingerprintValues() == fingerprints);
+
+		DtlsTransport::ClassDestroy();
+
+		// An expired cache file is replaced.
+		std::filesystem::last_write_time(
+		  cacheFile,
+		  std::filesystem::last_write_time(cacheFile) -
+		    std::chrono::seconds(Settings::configuration.dtlsCertificateCacheMaxAge));
+
+		DtlsTransport::ClassInit();
+
+		REQUIRE(DtlsTransport::IsCertificateGenerated());
+		REQUIRE(getLocalFingerprintValues() != fingerprints);
+
+		DtlsTransport::ClassDestroy();
+
+		// An invalid cache file is replaced.
+		std::ofstream(cacheFile) << "foo";
+
+		DtlsTransport::ClassInit();
+
+		REQUIRE(DtlsTransport::IsCertificateGenerated());
+
+		DtlsTransport::ClassDestroy();
+
+		DtlsTransport::ClassInit();
+
+		REQUIRE(!DtlsTransport::IsCertificateGenerated());
+
+		DtlsTransport::ClassDestroy();
+
+		std::filesystem::remove(cacheFile);
+
+		Settings::configuration.dtlsCertificateCacheFile.clear();
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		// Runs many concurrent DTLS handshakes and measures the maximum time the
+		// loop was blocked with and without DTLS handshake offload.
+		static constexpr size_t NumPairs{ 200 };
+
+		for (const bool dtlsHandshakeOffload : { false, true })
+		{
+			Settings::configuration.dtlsHandshakeOffload = dtlsHandshakeOffload;
+
+			DtlsTransport::ClassInit();
+
+			std::vector<DtlsTransportPair*> pairs;
+
+			for (size_t i{ 0 }; i < NumPairs; ++i)
+			{
+				pairs.push_back(new DtlsTransportPair());
+			}
+
+			const uint64_t start        = uv_hrtime();
+			const uint64_t maxLoopStall = runHandshakes(pairs);
+			const uint64_t end          = uv_hrtime();
+
+			for (auto* pair : pairs)
+			{
+				REQUIRE(pair->clientListener.connected);
+				REQUIRE(pair->serverListener.connected);
+
+				delete pair;
+			}
+
+			std::cout << (dtlsHandshakeOffload ? "handshake offload" : "inline handshake") << " ["
+			          << NumPairs << " handshakes]: " << ((end - start) / 1000000) << " ms total, "
+			          << (maxLoopStall / 1000) << " us max loop stall" << std::endl;
+
+			DtlsTransport::ClassDestroy();
+		}
+
+		Settings::configuration.dtlsHandshakeOffload = false;
+	}
+#endif
+}
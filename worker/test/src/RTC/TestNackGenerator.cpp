@@ -129,9 +129,7 @@ void validate(std::vector<TestNackGeneratorInput>& inputs)
 	{
 		listener.Reset(input);
 
-		auto* tpdh = new TestPayloadDescriptorHandler(input.isKeyFrame);
-
-		packet->SetPayloadDescriptorHandler(tpdh);
+		packet->EmplacePayloadDescriptorHandler<TestPayloadDescriptorHandler>(input.isKeyFrame);
 		packet->SetSequenceNumber(input.seq);
 		nackGenerator.ReceivePacket(packet.get(), /*isRecovered*/ false);
 
@@ -282,6 +280,22 @@ SCENARIO("NACK generator", "[rtp][rtcp]")
 		validate(inputs);
 	}
 
+	SECTION("Nack list too large, remove packets until key frame")
+	{
+		// clang-format off
+		std::vector<TestNackGeneratorInput> inputs =
+		{
+			{    1, false,   0,   0, false,   0 },
+			{  600, false,   2, 598, false, 598 },
+			{  601,  true,   0,   0, false, 598 },
+			{ 1200, false, 602, 598, false, 598 },
+			{ 1201, false,   0,   0, false, 598 }
+		};
+		// clang-format on
+
+		validate(inputs);
+	}
+
 	// Must run the loop to wait for UV timers and close them.
 	DepLibUV::RunLoop();
 }
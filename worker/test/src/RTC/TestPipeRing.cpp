@@ -0,0 +1,274 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/PipeRing.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <memory> // std::make_shared(), std::weak_ptr
+#include <thread>
+#include <unistd.h> // usleep()
+#include <vector>
+
+using namespace RTC;
+
+class TestPipeRingListener : public PipeRing::Listener
+{
+	/* Pure virtual methods inherited from PipeRing::Listener. */
+public:
+	void OnPipeRingPacket(PipeRing* /*ring*/, const uint8_t* data, size_t len) override
+	{
+		this->packets.emplace_back(data, data + len);
+	}
+
+public:
+	std::vector<std::vector<uint8_t>> packets;
+};
+
+// Closes the ring and releases the last reference to it while a packet is
+// delivered (as a PipeTransport being closed does).
+class TestClosingPipeRingListener : public PipeRing::Listener
+{
+	/* Pure virtual methods inherited from PipeRing::Listener. */
+public:
+	void OnPipeRingPacket(PipeRing* ring, const uint8_t* /*data*/, size_t /*len*/) override
+	{
+		++this->numPackets;
+
+		ring->Close();
+		this->ring.reset();
+	}
+
+public:
+	std::shared_ptr<PipeRing> ring;
+	size_t numPackets{ 0u };
+};
+
+// Packet of the given size filled with the given value.
+static std::vector<uint8_t> createPacket(size_t len, uint8_t value)
+{
+	return std::vector<uint8_t>(len, value);
+}
+
+// Runs the loop until the given condition is met (or the given iterations
+// pass).
+template<typename T>
+static void runLoopUntil(T condition, size_t maxIterations = 5000u)
+{
+	// NOTE: The ring uv_async handle does not keep the loop alive, so make it
+	// poll while waiting.
+	uv_idle_t idle;
+
+	uv_idle_init(DepLibUV::GetLoop(), std::addressof(idle));
+	uv_idle_start(std::addressof(idle), [](uv_idle_t* /*handle*/) {});
+
+	for (size_t i{ 0u }; i < maxIterations && !condition(); ++i)
+	{
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		if (!condition())
+		{
+			usleep(1000);
+		}
+	}
+
+	uv_close(reinterpret_cast<uv_handle_t*>(std::addressof(idle)), nullptr);
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+}
+
+SCENARIO("PipeRing", "[pipe][ring]")
+{
+	TestPipeRingListener listener;
+	auto ring = std::make_shared<PipeRing>(std::addressof(listener));
+
+	SECTION("packets of the accepted producer are delivered in order")
+	{
+		REQUIRE(ring->ClaimProducer("127.0.0.1:1000"));
+
+		ring->AcceptProducer("127.0.0.1:1000");
+
+		REQUIRE(ring->Push(createPacket(1u, 0x01).data(), 1u));
+		REQUIRE(ring->Push(createPacket(1500u, 0x02).data(), 1500u));
+		REQUIRE(
+		  ring->Push(createPacket(PipeRing::MaxPacketSize, 0x03).data(), PipeRing::MaxPacketSize));
+
+		runLoopUntil([&listener]() { return listener.packets.size() >= 3u; });
+
+		REQUIRE(listener.packets.size() == 3u);
+		REQUIRE(listener.packets[0] == createPacket(1u, 0x01));
+		REQUIRE(listener.packets[1] == createPacket(1500u, 0x02));
+		REQUIRE(listener.packets[2] == createPacket(PipeRing::MaxPacketSize, 0x03));
+	}
+
+	SECTION("packets wrap around the end of the buffer")
+	{
+		REQUIRE(ring->ClaimProducer("127.0.0.1:1000"));
+
+		ring->AcceptProducer("127.0.0.1:1000");
+
+		// Push many more bytes than the ring capacity, with sizes that do not
+		// divide it, draining it in between.
+		static constexpr size_t Len{ 1499u };
+		const size_t numPackets{ (PipeRing::Capacity / Len) * 3u };
+		size_t pushed{ 0u };
+
+		while (pushed < numPackets)
+		{
+			if (ring->Push(createPacket(Len, static_cast<uint8_t>(pushed)).data(), Len))
+			{
+				++pushed;
+
+				continue;
+			}
+
+			runLoopUntil([&listener, pushed]() { return listener.packets.size() == pushed; });
+		}
+
+		runLoopUntil([&listener, numPackets]() { return listener.packets.size() == numPackets; });
+
+		REQUIRE(listener.packets.size() == numPackets);
+
+		for (size_t i{ 0u }; i < numPackets; ++i)
+		{
+			REQUIRE(listener.packets[i] == createPacket(Len, static_cast<uint8_t>(i)));
+		}
+	}
+
+	SECTION("packets are dropped when the ring is full")
+	{
+		REQUIRE(ring->ClaimProducer("127.0.0.1:1000"));
+
+		ring->AcceptProducer("127.0.0.1:1000");
+
+		const auto packet = createPacket(PipeRing::MaxPacketSize, 0x04);
+		size_t pushed{ 0u };
+
+		while (ring->Push(packet.data(), packet.size()))
+		{
+			++pushed;
+		}
+
+		REQUIRE(pushed > 0u);
+		REQUIRE(pushed < PipeRing::Capacity / PipeRing::MaxPacketSize);
+		REQUIRE(ring->GetDroppedCount() == 1u);
+
+		runLoopUntil([&listener, pushed]() { return listener.packets.size() == pushed; });
+
+		REQUIRE(listener.packets.size() == pushed);
+
+		// There is room again.
+		REQUIRE(ring->Push(packet.data(), packet.size()));
+	}
+
+	SECTION("packets of a producer that is not accepted are discarded")
+	{
+		REQUIRE(ring->ClaimProducer("127.0.0.1:1000"));
+
+		ring->AcceptProducer("127.0.0.1:2000");
+
+		REQUIRE(ring->Push(createPacket(100u, 0x05).data(), 100u));
+
+		runLoopUntil([]() { return false; }, 20u);
+
+		REQUIRE(listener.packets.empty());
+
+		// Once accepted, later packets are delivered.
+		ring->AcceptProducer("127.0.0.1:1000");
+
+		REQUIRE(ring->Push(createPacket(100u, 0x06).data(), 100u));
+
+		runLoopUntil([&listener]() { return !listener.packets.empty(); });
+
+		REQUIRE(listener.packets.size() == 1u);
+		REQUIRE(listener.packets[0] == createPacket(100u, 0x06));
+	}
+
+	SECTION("ring has a single producer")
+	{
+		REQUIRE(ring->ClaimProducer("127.0.0.1:1000"));
+		REQUIRE(!ring->ClaimProducer("127.0.0.1:2000"));
+
+		ring->ReleaseProducer();
+
+		REQUIRE(ring->ClaimProducer("127.0.0.1:2000"));
+	}
+
+	SECTION("packets pushed by another thread are delivered in order")
+	{
+		REQUIRE(ring->ClaimProducer("127.0.0.1:1000"));
+
+		ring->AcceptProducer("127.0.0.1:1000");
+
+		static constexpr size_t NumPackets{ 20000u };
+
+		std::thread producer(
+		  [&ring]()
+		  {
+			  for (size_t i{ 0u }; i < NumPackets; ++i)
+			  {
+				  const auto packet = createPacket(100u + (i % 1400u), static_cast<uint8_t>(i));
+
+				  // Wait for room if full.
+				  while (!ring->Push(packet.data(), packet.size()))
+				  {
+					  std::this_thread::yield();
+				  }
+			  }
+		  });
+
+		runLoopUntil([&listener]() { return listener.packets.size() >= NumPackets; });
+
+		producer.join();
+
+		REQUIRE(listener.packets.size() == NumPackets);
+
+		for (size_t i{ 0u }; i < NumPackets; ++i)
+		{
+			REQUIRE(listener.packets[i] == createPacket(100u + (i % 1400u), static_cast<uint8_t>(i)));
+		}
+	}
+
+	SECTION("closed ring drops pushed packets")
+	{
+		REQUIRE(ring->ClaimProducer("127.0.0.1:1000"));
+
+		ring->AcceptProducer("127.0.0.1:1000");
+		ring->Close();
+
+		REQUIRE(ring->IsClosed());
+		REQUIRE(!ring->Push(createPacket(100u, 0x07).data(), 100u));
+		REQUIRE(!ring->ClaimProducer("127.0.0.1:2000"));
+
+		runLoopUntil([]() { return false; }, 20u);
+
+		REQUIRE(listener.packets.empty());
+	}
+
+	SECTION("ring released by the listener while delivering a packet")
+	{
+		TestClosingPipeRingListener closingListener;
+
+		// NOTE: Not std::make_shared() so the ring memory is freed along with the
+		// last reference (and not when the std::weak_ptr goes away).
+		closingListener.ring.reset(new PipeRing(std::addressof(closingListener)));
+
+		const std::weak_ptr<PipeRing> weakRing = closingListener.ring;
+
+		REQUIRE(closingListener.ring->ClaimProducer("127.0.0.1:1000"));
+
+		closingListener.ring->AcceptProducer("127.0.0.1:1000");
+
+		REQUIRE(closingListener.ring->Push(createPacket(100u, 0x08).data(), 100u));
+		REQUIRE(closingListener.ring->Push(createPacket(100u, 0x09).data(), 100u));
+
+		runLoopUntil([&closingListener]() { return closingListener.numPackets != 0u; });
+
+		REQUIRE(closingListener.numPackets == 1u);
+		REQUIRE(weakRing.expired());
+	}
+
+	if (ring && !ring->IsClosed())
+	{
+		ring->Close();
+	}
+
+	// Let libuv close the async handle.
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+}
@@ -0,0 +1,175 @@
+#include "common.hpp"
+#include "RTC/RtpListener.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <string_view>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+#endif
+
+using namespace RTC;
+
+// RtpListener never dereferences Producers when demuxing packets, so fake
+// pointers are enough to fill its tables.
+static int fakeProducers[2];
+static auto* producer1 = reinterpret_cast<Producer*>(&fakeProducers[0]);
+static auto* producer2 = reinterpret_cast<Producer*>(&fakeProducers[1]);
+
+SCENARIO("RtpListener", "[rtp][listener]")
+{
+	// clang-format off
+	uint8_t buffer[] =
+	{
+		0b10010000, 0x01, 0x00, 0x08,
+		0x00, 0x00, 0x00, 0x04,
+		0x00, 0x00, 0x00, 0x05,
+		0xbe, 0xde, 0x00, 0x02, // Header Extension
+		0x12, 0x61, 0x62, 0x63, // MID "abc"
+		0x21, 0x72, 0x30, 0x00, // RID "r0" and padding
+		0x11, 0x22, 0x33, 0x44  // Payload
+	};
+	// clang-format on
+
+	std::unique_ptr<RtpPacket> packet{ RtpPacket::Parse(buffer, sizeof(buffer)) };
+
+	if (!packet)
+	{
+		FAIL("not a RTP packet");
+	}
+
+	packet->SetMidExtensionId(1);
+	packet->SetRidExtensionId(2);
+
+	RtpListener listener;
+
+	SECTION("MID and RID are read without copying them")
+	{
+		std::string_view mid;
+		std::string_view rid;
+
+		REQUIRE(packet->ReadMid(mid) == true);
+		REQUIRE(mid == "abc");
+		REQUIRE(reinterpret_cast<const uint8_t*>(mid.data()) == buffer + 17);
+		REQUIRE(packet->ReadRid(rid) == true);
+		REQUIRE(rid == "r0");
+		REQUIRE(reinterpret_cast<const uint8_t*>(rid.data()) == buffer + 21);
+
+		packet->SetMidExtensionId(0);
+
+		REQUIRE(packet->ReadMid(mid) == false);
+	}
+
+	SECTION("packet is demuxed by MID and its SSRC is learnt")
+	{
+		listener.midTable["abc"] = producer1;
+		listener.ridTable["r0"]  = producer2;
+
+		REQUIRE(listener.GetProducer(packet.get()) == producer1);
+		REQUIRE(listener.ssrcTable.size() == 1);
+		REQUIRE(listener.GetProducer(5) == producer1);
+
+		// Once learnt, the SSRC is used without looking at the MID.
+		listener.midTable.clear();
+
+		REQUIRE(listener.GetProducer(packet.get()) == producer1);
+	}
+
+	SECTION("packet is demuxed by RID if its MID is unknown")
+	{
+		listener.midTable["xyz"] = producer1;
+		listener.ridTable["r0"]  = producer2;
+
+		REQUIRE(listener.GetProducer(packet.get()) == producer2);
+		REQUIRE(listener.GetProducer(5) == producer2);
+	}
+
+	SECTION("unknown packet is not demuxed")
+	{
+		listener.midTable["xyz"] = producer1;
+		listener.ridTable["r1"]  = producer2;
+
+		REQUIRE(listener.GetProducer(packet.get()) == nullptr);
+		REQUIRE(listener.ssrcTable.empty());
+	}
+
+	SECTION("RemoveProducer() removes all entries of the Producer")
+	{
+		listener.ssrcTable[1111] = producer1;
+		listener.ssrcTable[2222] = producer2;
+		listener.midTable["abc"] = producer1;
+		listener.ridTable["r0"]  = producer1;
+		listener.ridTable["r1"]  = producer2;
+
+		listener.RemoveProducer(producer1);
+
+		REQUIRE(listener.ssrcTable.size() == 1);
+		REQUIRE(listener.GetProducer(2222) == producer2);
+		REQUIRE(listener.midTable.empty());
+		REQUIRE(listener.ridTable.size() == 1);
+		REQUIRE(listener.ridTable.find(std::string_view("r1"))->second == producer2);
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		const size_t iterations{ 10000000u };
+		size_t found{ 0u };
+
+		// Previous lookup: MID copied into a std::string for a std::unordered_map.
+		std::unordered_map<std::string, Producer*> unorderedMidTable;
+
+		unorderedMidTable["abc"] = producer1;
+		listener.midTable["abc"] = producer1;
+
+		auto start = std::chrono::system_clock::now();
+
+		for (size_t i{ 0u }; i < iterations; ++i)
+		{
+			std::string mid;
+
+			if (packet->ReadMid(mid))
+			{
+				found += unorderedMidTable.find(mid) != unorderedMidTable.end();
+			}
+		}
+
+		std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+		std::cout << "std::string MID lookup: \t" << dur.count() << " seconds" << std::endl;
+
+		start = std::chrono::system_clock::now();
+
+		for (size_t i{ 0u }; i < iterations; ++i)
+		{
+			std::string_view mid;
+
+			if (packet->ReadMid(mid))
+			{
+				found -= listener.midTable.find(mid) != listener.midTable.end();
+			}
+		}
+
+		dur = std::chrono::system_clock::now() - start;
+		std::cout << "std::string_view MID lookup: \t" << dur.count() << " seconds" << std::endl;
+
+		REQUIRE(found == 0u);
+
+		start = std::chrono::system_clock::now();
+
+		for (size_t i{ 0u }; i < iterations; ++i)
+		{
+			found += listener.GetProducer(packet.get()) == producer1;
+		}
+
+		dur = std::chrono::system_clock::now() - start;
+		std::cout << "learnt SSRC demux: \t\t" << dur.count() << " seconds" << std::endl;
+
+		REQUIRE(found == iterations);
+	}
+#endif
+}
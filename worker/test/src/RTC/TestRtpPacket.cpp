@@ -1,8 +1,9 @@
 #include "common.hpp"
 #include "helpers.hpp"
 #include "RTC/RtpPacket.hpp"
+#include "RTC/Codecs/VP8.hpp"
 #include <catch2/catch_test_macros.hpp>
-#include <cstring> // std::memset()
+#include <cstring> // std::memset(), std::memcpy(), std::memcmp()
 #include <string>
 #include <vector>
 
@@ -860,4 +861,175 @@ SCENARIO("parse RTP packets", "[parser][rtp]")
 		REQUIRE(frameMarking->lid == 1);
 		REQUIRE(frameMarking->tl0picidx == 5);
 	}
+
+	SECTION("copy header with a different MID")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x90, 0x01, 0x00, 0x08,
+			0x00, 0x00, 0x00, 0x04,
+			0x00, 0x00, 0x00, 0x05,
+			0xbe, 0xde, 0x00, 0x03, // Header Extension
+			0x12, 0x61, 0x62, 0x63, // MID "abc"
+			0x00, 0x00, 0x00, 0x00, // Padding (room for a longer MID)
+			0x00, 0x00, 0x00, 0x00,
+			0x11, 0x22, 0x33, 0x44  // Payload
+		};
+		// clang-format on
+
+		std::unique_ptr<RtpPacket> packet{ RtpPacket::Parse(buffer, sizeof(buffer)) };
+
+		if (!packet)
+		{
+			FAIL("not a RTP packet");
+		}
+
+		packet->SetMidExtensionId(1);
+
+		REQUIRE(packet->GetHeaderLength() == 28);
+
+		uint8_t copy[sizeof(buffer)];
+		std::string mid;
+
+		// Longer MID.
+		REQUIRE(packet->CopyHeader(copy, "012345") == 28);
+
+		std::memcpy(copy + 28, packet->GetPayload(), packet->GetPayloadLength());
+
+		std::unique_ptr<RtpPacket> copiedPacket{ RtpPacket::Parse(copy, sizeof(copy)) };
+
+		if (!copiedPacket)
+		{
+			FAIL("not a RTP packet");
+		}
+
+		copiedPacket->SetMidExtensionId(1);
+
+		REQUIRE(copiedPacket->ReadMid(mid) == true);
+		REQUIRE(mid == "012345");
+		REQUIRE(copiedPacket->GetPayloadLength() == 4);
+		REQUIRE(copiedPacket->GetPayload()[0] == 0x11);
+
+		// Original packet is not modified.
+		REQUIRE(packet->ReadMid(mid) == true);
+		REQUIRE(mid == "abc");
+
+		// Shorter MID.
+		REQUIRE(packet->CopyHeader(copy, "0") == 28);
+
+		copiedPacket.reset(RtpPacket::Parse(copy, sizeof(copy)));
+		copiedPacket->SetMidExtensionId(1);
+
+		REQUIRE(copiedPacket->ReadMid(mid) == true);
+		REQUIRE(mid == "0");
+		REQUIRE(copy[17] == 0x30);
+		REQUIRE(copy[18] == 0x00);
+		REQUIRE(copy[19] == 0x00);
+
+		// No MID, plain copy.
+		REQUIRE(packet->CopyHeader(copy, "") == 28);
+		REQUIRE(std::memcmp(copy, buffer, 28) == 0);
+	}
+
+	SECTION("copy header with a different MID (Two-Bytes header extension)")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x90, 0x01, 0x00, 0x08,
+			0x00, 0x00, 0x00, 0x04,
+			0x00, 0x00, 0x00, 0x05,
+			0x10, 0x00, 0x00, 0x03, // Header Extension
+			0x01, 0x03, 0x61, 0x62, // MID "abc"
+			0x63, 0x00, 0x00, 0x00, // Padding (room for a longer MID)
+			0x00, 0x00, 0x00, 0x00,
+			0x11, 0x22, 0x33, 0x44  // Payload
+		};
+		// clang-format on
+
+		std::unique_ptr<RtpPacket> packet{ RtpPacket::Parse(buffer, sizeof(buffer)) };
+
+		if (!packet)
+		{
+			FAIL("not a RTP packet");
+		}
+
+		packet->SetMidExtensionId(1);
+
+		uint8_t copy[sizeof(buffer)];
+		std::string mid;
+
+		REQUIRE(packet->CopyHeader(copy, "012345") == 28);
+
+		std::memcpy(copy + 28, packet->GetPayload(), packet->GetPayloadLength());
+
+		std::unique_ptr<RtpPacket> copiedPacket{ RtpPacket::Parse(copy, sizeof(copy)) };
+
+		if (!copiedPacket)
+		{
+			FAIL("not a RTP packet");
+		}
+
+		copiedPacket->SetMidExtensionId(1);
+
+		REQUIRE(copiedPacket->HasTwoBytesExtensions() == true);
+		REQUIRE(copiedPacket->ReadMid(mid) == true);
+		REQUIRE(mid == "012345");
+		REQUIRE(packet->ReadMid(mid) == true);
+		REQUIRE(mid == "abc");
+	}
+
+	SECTION("payload descriptor is parsed on demand and kept by Clone()")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x80, 0x01, 0x00, 0x08,
+			0x00, 0x00, 0x00, 0x04,
+			0x00, 0x00, 0x00, 0x05,
+			0x90, 0x20, 0x40, 0x01 // VP8 payload descriptor (TID 1) and non key frame
+		};
+		// clang-format on
+
+		std::unique_ptr<RtpPacket> packet{ RtpPacket::Parse(buffer, sizeof(buffer)) };
+
+		if (!packet)
+		{
+			FAIL("not a RTP packet");
+		}
+
+		REQUIRE(packet->IsKeyFrame() == false);
+		REQUIRE(packet->GetTemporalLayer() == 0);
+
+		packet->SetPayloadDescriptorParser(Codecs::VP8::ProcessRtpPacket);
+
+		// Not parsed yet, so this change is seen once it's parsed.
+		packet->GetPayload()[3] = 0x00;
+
+		REQUIRE(packet->IsKeyFrame() == true);
+		REQUIRE(packet->GetTemporalLayer() == 1);
+
+		// Already parsed, so this change is not seen.
+		packet->GetPayload()[3] = 0x01;
+
+		REQUIRE(packet->IsKeyFrame() == true);
+
+		std::unique_ptr<RtpPacket> clonedPacket{ packet->Clone() };
+
+		REQUIRE(clonedPacket->IsKeyFrame() == true);
+		REQUIRE(clonedPacket->GetTemporalLayer() == 1);
+
+		// A pending parser is kept by Clone() too.
+		packet->SetPayloadDescriptorParser(Codecs::VP8::ProcessRtpPacket);
+		clonedPacket.reset(packet->Clone());
+
+		REQUIRE(clonedPacket->IsKeyFrame() == false);
+		REQUIRE(clonedPacket->GetTemporalLayer() == 1);
+
+		packet->ResetPayloadDescriptorHandler();
+
+		REQUIRE(packet->IsKeyFrame() == false);
+		REQUIRE(packet->GetTemporalLayer() == 0);
+	}
 }
@@ -0,0 +1,219 @@
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpPacketBufferPool.hpp"
+#include "RTC/SharedRtpPacket.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring> // std::memset(), std::memcmp()
+#include <memory>
+#include <vector>
+
+using namespace RTC;
+
+// clang-format off
+alignas(4) static uint8_t RtpHeader[] =
+{
+	0x80, 0x01, 0x00, 0x08,
+	0x00, 0x00, 0x00, 0x04,
+	0x00, 0x00, 0x00, 0x05
+};
+// clang-format on
+
+// Max size of a packet that can be cloned into a pool buffer.
+static constexpr size_t MaxPacketSize{ RtpPacketBufferPool::BufferSize };
+
+alignas(4) static uint8_t Buffer[MaxPacketSize + 100u];
+
+static RtpPacket* createRtpPacket(size_t len)
+{
+	std::memcpy(Buffer, RtpHeader, sizeof(RtpHeader));
+
+	// Fill the payload with a recognizable pattern.
+	for (size_t i{ sizeof(RtpHeader) }; i < len; ++i)
+	{
+		Buffer[i] = static_cast<uint8_t>(i);
+	}
+
+	return RtpPacket::Parse(Buffer, len);
+}
+
+SCENARIO("RtpPacketBufferPool", "[rtp][pool]")
+{
+	// NOTE: The pool is per thread and shared by all tests, so check deltas.
+	const size_t initialInUse = RtpPacketBufferPool::GetInUse();
+
+	SECTION("released buffers are reused")
+	{
+		auto* buffer1 = RtpPacketBufferPool::Get();
+
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse + 1u);
+		REQUIRE(RtpPacketBufferPool::GetHighWaterMark() >= initialInUse + 1u);
+
+		RtpPacketBufferPool::Release(buffer1);
+
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse);
+
+		auto* buffer2 = RtpPacketBufferPool::Get();
+
+		REQUIRE(buffer2 == buffer1);
+
+		RtpPacketBufferPool::Release(buffer2);
+	}
+
+	SECTION("pool grows in slabs when exhausted and keeps its capacity")
+	{
+		const size_t initialCapacity = RtpPacketBufferPool::GetCapacity();
+		std::vector<uint8_t*> buffers;
+
+		// Take every available buffer plus one.
+		for (size_t i{ 0u }; i < initialCapacity - initialInUse + 1u; ++i)
+		{
+			buffers.push_back(RtpPacketBufferPool::Get());
+		}
+
+		REQUIRE(RtpPacketBufferPool::GetCapacity() == initialCapacity + RtpPacketBufferPool::SlabSize);
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse + buffers.size());
+		REQUIRE(RtpPacketBufferPool::GetHighWaterMark() >= RtpPacketBufferPool::GetInUse());
+
+		// Buffers don't overlap.
+		std::vector<uint8_t*> sorted(buffers);
+
+		std::sort(sorted.begin(), sorted.end());
+
+		for (size_t i{ 1u }; i < sorted.size(); ++i)
+		{
+			REQUIRE(static_cast<size_t>(sorted[i] - sorted[i - 1]) >= RtpPacketBufferPool::BufferSize);
+		}
+
+		for (auto* buffer : buffers)
+		{
+			RtpPacketBufferPool::Release(buffer);
+		}
+
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse);
+		// Buffers are never returned to the system.
+		REQUIRE(RtpPacketBufferPool::GetCapacity() == initialCapacity + RtpPacketBufferPool::SlabSize);
+	}
+
+	SECTION("cloned packets take a pool buffer and give it back when deleted")
+	{
+		std::unique_ptr<RtpPacket> packet{ createRtpPacket(200u) };
+
+		REQUIRE(packet);
+		// A parsed packet doesn't use the pool.
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse);
+
+		auto* clonedPacket = packet->Clone();
+
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse + 1u);
+		REQUIRE(clonedPacket->GetSize() == packet->GetSize());
+		REQUIRE(std::memcmp(clonedPacket->GetData(), packet->GetData(), packet->GetSize()) == 0);
+
+		delete clonedPacket;
+
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse);
+	}
+
+	SECTION("packet of the max buffer size is cloned entirely")
+	{
+		std::unique_ptr<RtpPacket> packet{ createRtpPacket(MaxPacketSize) };
+
+		REQUIRE(packet);
+		REQUIRE(packet->GetSize() == MaxPacketSize);
+
+		std::unique_ptr<RtpPacket> clonedPacket{ packet->Clone() };
+
+		REQUIRE(clonedPacket->GetSize() == MaxPacketSize);
+		REQUIRE(clonedPacket->GetPayloadLength() == MaxPacketSize - sizeof(RtpHeader));
+		REQUIRE(std::memcmp(clonedPacket->GetData(), packet->GetData(), MaxPacketSize) == 0);
+
+		// Next pool buffer is not overwritten by the clone.
+		auto* buffer = RtpPacketBufferPool::Get();
+
+		std::memset(buffer, 0xff, RtpPacketBufferPool::BufferSize);
+
+		REQUIRE(std::memcmp(clonedPacket->GetData(), packet->GetData(), MaxPacketSize) == 0);
+
+		RtpPacketBufferPool::Release(buffer);
+	}
+
+	SECTION("packet bigger than a pool buffer is not cloned")
+	{
+		std::unique_ptr<RtpPacket> packet{ createRtpPacket(MaxPacketSize + 100u) };
+
+		REQUIRE(packet);
+
+		std::unique_ptr<RtpPacket> clonedPacket{ packet->Clone() };
+
+		REQUIRE(!clonedPacket);
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse);
+	}
+}
+
+SCENARIO("SharedRtpPacket", "[rtp][pool]")
+{
+	const size_t initialInUse = RtpPacketBufferPool::GetInUse();
+	std::unique_ptr<RtpPacket> packet{ createRtpPacket(100u) };
+
+	REQUIRE(packet);
+
+	SECTION("copies share the packet and last reference deletes it")
+	{
+		SharedRtpPacket sharedPacket1(packet->Clone());
+
+		REQUIRE(sharedPacket1.GetRefCount() == 1u);
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse + 1u);
+
+		{
+			SharedRtpPacket sharedPacket2(sharedPacket1);
+			SharedRtpPacket sharedPacket3;
+
+			sharedPacket3 = sharedPacket2;
+
+			REQUIRE(sharedPacket2.Get() == sharedPacket1.Get());
+			REQUIRE(sharedPacket3.Get() == sharedPacket1.Get());
+			REQUIRE(sharedPacket1.GetRefCount() == 3u);
+		}
+
+		REQUIRE(sharedPacket1.GetRefCount() == 1u);
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse + 1u);
+
+		sharedPacket1.Reset();
+
+		REQUIRE(!sharedPacket1);
+		REQUIRE(sharedPacket1.GetRefCount() == 0u);
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse);
+	}
+
+	SECTION("moves transfer the reference")
+	{
+		SharedRtpPacket sharedPacket1(packet->Clone());
+		auto* clonedPacket = sharedPacket1.Get();
+
+		SharedRtpPacket sharedPacket2(std::move(sharedPacket1));
+
+		REQUIRE(!sharedPacket1); // NOLINT(bugprone-use-after-move)
+		REQUIRE(sharedPacket2.Get() == clonedPacket);
+		REQUIRE(sharedPacket2.GetRefCount() == 1u);
+
+		SharedRtpPacket sharedPacket3;
+
+		sharedPacket3 = std::move(sharedPacket2);
+
+		REQUIRE(!sharedPacket2); // NOLINT(bugprone-use-after-move)
+		REQUIRE(sharedPacket3.Get() == clonedPacket);
+		REQUIRE(sharedPacket3.GetRefCount() == 1u);
+		REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse + 1u);
+	}
+
+	SECTION("self assignment keeps the reference")
+	{
+		SharedRtpPacket sharedPacket(packet->Clone());
+		const auto& sameSharedPacket = sharedPacket;
+
+		sharedPacket = sameSharedPacket;
+
+		REQUIRE(sharedPacket.GetRefCount() == 1u);
+	}
+
+	REQUIRE(RtpPacketBufferPool::GetInUse() == initialInUse);
+}
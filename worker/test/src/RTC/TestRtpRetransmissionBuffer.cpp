@@ -4,10 +4,18 @@
 #include <catch2/catch_test_macros.hpp>
 #include <vector>
 
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <chrono>
+#include <deque>
+#include <iostream>
+#endif
+
 using namespace RTC;
 
 // Class inheriting from RtpRetransmissionBuffer so we can access its protected
-// buffer member.
+// buffer accessors.
 class RtpMyRetransmissionBuffer : public RtpRetransmissionBuffer
 {
 public:
@@ -41,26 +49,26 @@ public:
 		packet->SetSequenceNumber(seq);
 		packet->SetTimestamp(timestamp);
 
-		std::shared_ptr<RtpPacket> sharedPacket;
+		SharedRtpPacket sharedPacket;
 
 		RtpRetransmissionBuffer::Insert(packet.get(), sharedPacket);
 	}
 
 	void AssertBuffer(std::vector<VerificationItem> verificationBuffer)
 	{
-		REQUIRE(verificationBuffer.size() == this->buffer.size());
+		REQUIRE(verificationBuffer.size() == GetBufferSize());
 
 		for (size_t idx{ 0u }; idx < verificationBuffer.size(); ++idx)
 		{
 			auto& verificationItem = verificationBuffer.at(idx);
-			auto* item             = this->buffer.at(idx);
+			const auto& item       = GetBufferItem(idx);
 
-			REQUIRE(verificationItem.isPresent == !!item);
+			REQUIRE(verificationItem.isPresent == !!item.packet);
 
-			if (item)
+			if (item.packet)
 			{
-				REQUIRE(verificationItem.sequenceNumber == item->sequenceNumber);
-				REQUIRE(verificationItem.timestamp == item->timestamp);
+				REQUIRE(verificationItem.sequenceNumber == item.sequenceNumber);
+				REQUIRE(verificationItem.timestamp == item.timestamp);
 			}
 		}
 	}
@@ -275,6 +283,55 @@ SCENARIO("RtpRetransmissionBuffer", "[rtp][rtx]")
 		// clang-format on
 	}
 
+	SECTION("buffer grows and wraps around seq 65535")
+	{
+		uint16_t maxItems{ 200 };
+		uint32_t maxRetransmissionDelayMs{ 2000u };
+		uint32_t clockRate{ 90000 };
+
+		RtpMyRetransmissionBuffer myRetransmissionBuffer(maxItems, maxRetransmissionDelayMs, clockRate);
+
+		// Insert 150 packets (so ring grows) starting close to seq wrap, leaving
+		// a gap of one blank slot every 10 packets.
+		for (uint16_t i{ 0u }; i < 150u; ++i)
+		{
+			if (i % 10u == 5u)
+			{
+				continue;
+			}
+
+			myRetransmissionBuffer.Insert(65500u + i, 3000000000u + i);
+		}
+
+		// Insert missing ones out of order.
+		for (uint16_t i{ 5u }; i < 150u; i += 10u)
+		{
+			myRetransmissionBuffer.Insert(65500u + i, 3000000000u + i);
+		}
+
+		for (uint16_t i{ 0u }; i < 150u; ++i)
+		{
+			const uint16_t seq = 65500u + i;
+			auto* item         = myRetransmissionBuffer.Get(seq);
+
+			REQUIRE(item);
+			REQUIRE(item->sequenceNumber == seq);
+			REQUIRE(item->timestamp == 3000000000u + i);
+		}
+
+		REQUIRE(myRetransmissionBuffer.Get(65499u) == nullptr);
+		REQUIRE(myRetransmissionBuffer.Get(150u - 36u) == nullptr);
+
+		// Insert a packet 100 seqs ahead so 50 oldest items must be removed.
+		myRetransmissionBuffer.Insert(65500u + 249u, 3000000000u + 249u);
+
+		REQUIRE(myRetransmissionBuffer.Get(65500u + 49u) == nullptr);
+		REQUIRE(myRetransmissionBuffer.Get(65500u + 50u));
+		REQUIRE(myRetransmissionBuffer.Get(65500u + 149u));
+		REQUIRE(myRetransmissionBuffer.Get(65500u + 150u) == nullptr);
+		REQUIRE(myRetransmissionBuffer.Get(65500u + 249u));
+	}
+
 	SECTION("fuzzer generated packets")
 	{
 		uint16_t maxItems{ 2500u };
@@ -314,4 +371,127 @@ SCENARIO("RtpRetransmissionBuffer", "[rtp][rtx]")
 		myRetransmissionBuffer.Insert(33998, 2228092928);
 		myRetransmissionBuffer.Insert(33998, 2228092928);
 	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		// Minimal model of the previous storage: a deque of separately allocated
+		// items, shuffled on every removal from the front.
+		class DequeRetransmissionBuffer
+		{
+		public:
+			explicit DequeRetransmissionBuffer(uint16_t maxItems) : maxItems(maxItems)
+			{
+			}
+			~DequeRetransmissionBuffer()
+			{
+				Clear();
+			}
+
+		public:
+			void Insert(RtpPacket* packet, SharedRtpPacket& sharedPacket)
+			{
+				if (this->buffer.size() == this->maxItems)
+				{
+					delete this->buffer.front();
+					this->buffer.pop_front();
+				}
+
+				auto* item = new RtpRetransmissionBuffer::Item();
+
+				item->packet         = sharedPacket;
+				item->ssrc           = packet->GetSsrc();
+				item->sequenceNumber = packet->GetSequenceNumber();
+				item->timestamp      = packet->GetTimestamp();
+
+				this->buffer.push_back(item);
+			}
+			RtpRetransmissionBuffer::Item* Get(uint16_t seq)
+			{
+				if (this->buffer.empty())
+				{
+					return nullptr;
+				}
+
+				const uint16_t idx = seq - this->buffer.front()->sequenceNumber;
+
+				return idx < this->buffer.size() ? this->buffer[idx] : nullptr;
+			}
+			void Clear()
+			{
+				for (auto* item : this->buffer)
+				{
+					delete item;
+				}
+
+				this->buffer.clear();
+			}
+
+		private:
+			uint16_t maxItems;
+			std::deque<RtpRetransmissionBuffer::Item*> buffer;
+		};
+
+		// clang-format off
+		uint8_t rtpBuffer[] =
+		{
+			0b10000000, 0b01111011, 0b01010010, 0b00001110,
+			0b01011011, 0b01101011, 0b11001010, 0b10110101,
+			0, 0, 0, 2
+		};
+		// clang-format on
+
+		std::unique_ptr<RtpPacket> packet{ RtpPacket::Parse(rtpBuffer, sizeof(rtpBuffer)) };
+		SharedRtpPacket sharedPacket(packet->Clone());
+
+		const uint16_t maxItems{ 2500u };
+		const size_t iterations{ 10000000u };
+		size_t found{ 0u };
+
+		RtpRetransmissionBuffer ringBuffer(maxItems, 2000u, 90000u);
+		DequeRetransmissionBuffer dequeBuffer(maxItems);
+
+		auto start = std::chrono::system_clock::now();
+
+		for (size_t i{ 0u }; i < iterations; ++i)
+		{
+			packet->SetSequenceNumber(static_cast<uint16_t>(i));
+			packet->SetTimestamp(static_cast<uint32_t>(i / 4));
+
+			ringBuffer.Insert(packet.get(), sharedPacket);
+
+			found += ringBuffer.Get(static_cast<uint16_t>(i - 100u)) != nullptr;
+
+			if (i % 100000u == 0u)
+			{
+				ringBuffer.Clear();
+			}
+		}
+
+		std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+		std::cout << "ring buffer insert/get/clear: \t" << dur.count() << " seconds" << std::endl;
+
+		start = std::chrono::system_clock::now();
+
+		for (size_t i{ 0u }; i < iterations; ++i)
+		{
+			packet->SetSequenceNumber(static_cast<uint16_t>(i));
+			packet->SetTimestamp(static_cast<uint32_t>(i / 4));
+
+			dequeBuffer.Insert(packet.get(), sharedPacket);
+
+			found -= dequeBuffer.Get(static_cast<uint16_t>(i - 100u)) != nullptr;
+
+			if (i % 100000u == 0u)
+			{
+				dequeBuffer.Clear();
+			}
+		}
+
+		dur = std::chrono::system_clock::now() - start;
+		std::cout << "deque buffer insert/get/clear: \t" << dur.count() << " seconds" << std::endl;
+
+		REQUIRE(found == 0u);
+	}
+#endif
 }
@@ -23,7 +23,7 @@ static std::unique_ptr<RtpPacket> CreateRtpPacket(
 
 static void SendRtpPacket(std::vector<std::pair<RtpStreamSend*, uint32_t>> streams, RtpPacket* packet)
 {
-	std::shared_ptr<RtpPacket> sharedPacket;
+	SharedRtpPacket sharedPacket;
 
 	for (auto& stream : streams)
 	{
@@ -483,7 +483,7 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 			auto* packet = RtpPacket::Parse(rtpBuffer1, 1500);
 			packet->SetSsrc(1111);
 
-			std::shared_ptr<RtpPacket> sharedPacket(packet);
+			SharedRtpPacket sharedPacket(packet);
 
 			stream1->ReceivePacket(packet, sharedPacket);
 		}
@@ -498,7 +498,7 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 
 		for (size_t i = 0; i < iterations; i++)
 		{
-			std::shared_ptr<RtpPacket> sharedPacket;
+			SharedRtpPacket sharedPacket;
 
 			// Create packet.
 			auto* packet = RtpPacket::Parse(rtpBuffer1, 1500);
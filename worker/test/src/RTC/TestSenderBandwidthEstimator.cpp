@@ -0,0 +1,125 @@
+#include "common.hpp"
+#include "RTC/SenderBandwidthEstimator.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace RTC;
+
+class TestSenderBandwidthEstimatorListener : public SenderBandwidthEstimator::Listener
+{
+public:
+	void OnSenderBandwidthEstimatorAvailableBitrate(
+	  SenderBandwidthEstimator* /*senderBwe*/,
+	  uint32_t /*availableBitrate*/,
+	  uint32_t /*previousAvailableBitrate*/) override
+	{
+	}
+};
+
+// Class inheriting from SenderBandwidthEstimator so we can access its
+// protected sent infos accessor.
+class MySenderBandwidthEstimator : public SenderBandwidthEstimator
+{
+public:
+	explicit MySenderBandwidthEstimator(SenderBandwidthEstimator::Listener* listener)
+	  : SenderBandwidthEstimator(listener, 600000u)
+	{
+	}
+
+public:
+	void Sent(uint16_t wideSeq, size_t size)
+	{
+		SentInfo sentInfo;
+
+		sentInfo.wideSeq     = wideSeq;
+		sentInfo.size        = size;
+		sentInfo.sendingAtMs = 1000u;
+		sentInfo.sentAtMs    = 1000u;
+
+		RtpPacketSent(sentInfo);
+	}
+
+	bool HasSentInfo(uint16_t wideSeq) const
+	{
+		return GetSentInfo(wideSeq) != nullptr;
+	}
+
+	size_t GetSentInfoSize(uint16_t wideSeq) const
+	{
+		return GetSentInfo(wideSeq)->size;
+	}
+};
+
+SCENARIO("SenderBandwidthEstimator", "[rtp][bwe]")
+{
+	TestSenderBandwidthEstimatorListener listener;
+
+	SECTION("sent infos are retrievable by wide seq number")
+	{
+		MySenderBandwidthEstimator senderBwe(&listener);
+
+		REQUIRE(!senderBwe.HasSentInfo(0));
+
+		senderBwe.Sent(65534, 100);
+		senderBwe.Sent(65535, 101);
+		// 0 is not sent.
+		senderBwe.Sent(1, 102);
+
+		REQUIRE(senderBwe.HasSentInfo(65534));
+		REQUIRE(senderBwe.GetSentInfoSize(65534) == 100);
+		REQUIRE(senderBwe.HasSentInfo(65535));
+		REQUIRE(senderBwe.GetSentInfoSize(65535) == 101);
+		REQUIRE(!senderBwe.HasSentInfo(0));
+		REQUIRE(senderBwe.HasSentInfo(1));
+		REQUIRE(senderBwe.GetSentInfoSize(1) == 102);
+		REQUIRE(!senderBwe.HasSentInfo(2));
+
+		// Sent later than newer ones.
+		senderBwe.Sent(0, 103);
+
+		REQUIRE(senderBwe.HasSentInfo(0));
+		REQUIRE(senderBwe.GetSentInfoSize(0) == 103);
+
+		senderBwe.TransportDisconnected();
+
+		REQUIRE(!senderBwe.HasSentInfo(65534));
+		REQUIRE(!senderBwe.HasSentInfo(1));
+	}
+
+	SECTION("old sent infos are removed")
+	{
+		MySenderBandwidthEstimator senderBwe(&listener);
+
+		for (uint16_t wideSeq = 1; wideSeq <= 2000; ++wideSeq)
+		{
+			senderBwe.Sent(wideSeq, wideSeq);
+		}
+
+		REQUIRE(senderBwe.HasSentInfo(1));
+		REQUIRE(senderBwe.HasSentInfo(2000));
+
+		senderBwe.Sent(2001, 2001);
+
+		REQUIRE(!senderBwe.HasSentInfo(1));
+		REQUIRE(senderBwe.HasSentInfo(2));
+		REQUIRE(senderBwe.GetSentInfoSize(2) == 2);
+
+		// Too old, ignored.
+		senderBwe.Sent(1, 1);
+
+		REQUIRE(!senderBwe.HasSentInfo(1));
+
+		// Skip 100 wide seq numbers and later a whole ring.
+		senderBwe.Sent(2102, 2102);
+
+		REQUIRE(!senderBwe.HasSentInfo(2050));
+		REQUIRE(!senderBwe.HasSentInfo(2101));
+		REQUIRE(senderBwe.HasSentInfo(2001));
+		REQUIRE(senderBwe.HasSentInfo(2102));
+
+		senderBwe.Sent(10000, 10000);
+
+		REQUIRE(!senderBwe.HasSentInfo(2102));
+		REQUIRE(!senderBwe.HasSentInfo(10000 - 2048));
+		REQUIRE(senderBwe.HasSentInfo(10000));
+	}
+}
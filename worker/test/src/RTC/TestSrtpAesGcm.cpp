@@ -0,0 +1,265 @@
+#include "common.hpp"
+#include "DepLibSRTP.hpp"
+#include "RTC/SrtpAesGcm.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring> // std::memcpy(), std::memset()
+#include <srtp.h>
+#include <vector>
+
+using namespace RTC;
+
+// clang-format off
+static uint8_t masterKey[] =
+{
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+	0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+	0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21,
+	0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c
+};
+// clang-format on
+
+static srtp_t createLibSrtpSession(srtp_ssrc_type_t type, size_t keyLen)
+{
+	srtp_policy_t policy; // NOLINT(cppcoreguidelines-pro-type-member-init)
+	srtp_t session{ nullptr };
+
+	std::memset(&policy, 0, sizeof(srtp_policy_t));
+
+	if (keyLen == 16u)
+	{
+		srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtp);
+		srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtcp);
+	}
+	else
+	{
+		srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtp);
+		srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtcp);
+	}
+
+	policy.ssrc.type       = type;
+	policy.key             = masterKey;
+	policy.allow_repeat_tx = 1;
+	policy.window_size     = 1024;
+
+	REQUIRE(!DepLibSRTP::IsError(srtp_create(&session, &policy)));
+
+	return session;
+}
+
+static std::vector<uint8_t> createRtpPacket(uint32_t ssrc, uint16_t seq, bool withExtensionAndCsrc)
+{
+	std::vector<uint8_t> packet(1500, 0);
+	size_t len{ 12u };
+
+	packet[0] = 0x80;
+	packet[1] = 0x60;
+	packet[2] = static_cast<uint8_t>(seq >> 8);
+	packet[3] = static_cast<uint8_t>(seq);
+	packet[7] = static_cast<uint8_t>(seq);
+	packet[8]  = static_cast<uint8_t>(ssrc >> 24);
+	packet[9]  = static_cast<uint8_t>(ssrc >> 16);
+	packet[10] = static_cast<uint8_t>(ssrc >> 8);
+	packet[11] = static_cast<uint8_t>(ssrc);
+
+	if (withExtensionAndCsrc)
+	{
+		// One CSRC.
+		packet[0] |= 0x01;
+		len += 4u;
+
+		// One-Byte header extension with 1 word.
+		packet[0] |= 0x10;
+		packet[len]     = 0xBE;
+		packet[len + 1] = 0xDE;
+		packet[len + 3] = 0x01;
+		packet[len + 4] = 0x10;
+		packet[len + 5] = 0xAB;
+		len += 8u;
+	}
+
+	for (size_t i{ 0u }; i < 200u; ++i)
+	{
+		packet[len++] = static_cast<uint8_t>(i);
+	}
+
+	packet.resize(len);
+
+	return packet;
+}
+
+static std::vector<uint8_t> createRtcpPacket(uint32_t ssrc)
+{
+	// Empty Receiver Report followed by some bytes of an APP packet.
+	std::vector<uint8_t> packet{ 0x80, 0xc9, 0x00, 0x01 };
+
+	packet.push_back(static_cast<uint8_t>(ssrc >> 24));
+	packet.push_back(static_cast<uint8_t>(ssrc >> 16));
+	packet.push_back(static_cast<uint8_t>(ssrc >> 8));
+	packet.push_back(static_cast<uint8_t>(ssrc));
+
+	for (uint8_t b : { 0x81, 0xcc, 0x00, 0x02, 0x11, 0x22, 0x33, 0x44, 0x6d, 0x73, 0x6f, 0x70 })
+	{
+		packet.push_back(b);
+	}
+
+	return packet;
+}
+
+SCENARIO("SrtpAesGcm", "[rtc][srtp]")
+{
+	SECTION("RTP output is the same as libsrtp one")
+	{
+		for (const size_t keyLen : { 16u, 32u })
+		{
+			SrtpAesGcm aesGcm(keyLen, masterKey);
+			auto* libSrtpSession = createLibSrtpSession(ssrc_any_outbound, keyLen);
+
+			// Cross the seq boundary so the ROC is incremented, and send some
+			// packets twice and out of order as retransmissions do.
+			for (const uint16_t seq : { 65530, 65531, 65533, 65532, 65534, 65535, 0, 1, 65535, 2, 3 })
+			{
+				for (const bool withExtensionAndCsrc : { false, true })
+				{
+					const uint32_t ssrc = withExtensionAndCsrc ? 0x11223344 : 0xAABBCCDD;
+					auto packet         = createRtpPacket(ssrc, seq, withExtensionAndCsrc);
+					auto expected       = packet;
+					size_t len          = packet.size();
+					size_t expectedLen  = expected.size();
+
+					packet.resize(len + SrtpAesGcm::TagLength);
+					expected.resize(expectedLen + SRTP_MAX_TRAILER_LEN);
+
+					REQUIRE(aesGcm.ProtectRtp(packet.data(), &len));
+					REQUIRE(
+					  !DepLibSRTP::IsError(srtp_protect(libSrtpSession, expected.data(), &expectedLen)));
+					REQUIRE(len == expectedLen);
+					REQUIRE(std::memcmp(packet.data(), expected.data(), len) == 0);
+				}
+			}
+
+			srtp_dealloc(libSrtpSession);
+		}
+	}
+
+	SECTION("RTCP output is the same as libsrtp one")
+	{
+		for (const size_t keyLen : { 16u, 32u })
+		{
+			SrtpAesGcm aesGcm(keyLen, masterKey);
+			auto* libSrtpSession = createLibSrtpSession(ssrc_any_outbound, keyLen);
+
+			for (size_t i{ 0u }; i < 5u; ++i)
+			{
+				// Two SSRCs, each one with its own SRTCP index.
+				const uint32_t ssrc = i % 2 == 0 ? 0x01020304 : 0x05060708;
+				auto packet         = createRtcpPacket(ssrc);
+				auto expected       = packet;
+				size_t len          = packet.size();
+				size_t expectedLen  = expected.size();
+
+				packet.resize(len + SrtpAesGcm::TagLength + SrtpAesGcm::SrtcpTrailerLength);
+				expected.resize(expectedLen + SRTP_MAX_TRAILER_LEN + 4u);
+
+				REQUIRE(aesGcm.ProtectRtcp(packet.data(), &len));
+				REQUIRE(!DepLibSRTP::IsError(
+				  srtp_protect_rtcp(libSrtpSession, expected.data(), &expectedLen)));
+				REQUIRE(len == expectedLen);
+				REQUIRE(std::memcmp(packet.data(), expected.data(), len) == 0);
+			}
+
+			srtp_dealloc(libSrtpSession);
+		}
+	}
+
+	SECTION("RTP packets are decrypted by libsrtp")
+	{
+		for (const size_t keyLen : { 16u, 32u })
+		{
+			SrtpAesGcm aesGcm(keyLen, masterKey);
+			auto* libSrtpSession = createLibSrtpSession(ssrc_any_inbound, keyLen);
+			std::vector<std::vector<uint8_t>> packets;
+			std::vector<std::vector<uint8_t>> originals;
+			std::vector<SrtpAesGcm::RtpBuffer> buffers;
+
+			// Two SSRCs interleaved, protected in a single batch.
+			for (uint16_t seq{ 100u }; seq < 110u; ++seq)
+			{
+				const uint32_t ssrc = seq % 2 == 0 ? 0x01020304 : 0x05060708;
+
+				originals.push_back(createRtpPacket(ssrc, seq, seq % 3 == 0));
+				packets.push_back(originals.back());
+				packets.back().resize(originals.back().size() + SrtpAesGcm::TagLength);
+			}
+
+			for (size_t i{ 0u }; i < packets.size(); ++i)
+			{
+				buffers.push_back({ packets[i].data(), originals[i].size(), false });
+			}
+
+			aesGcm.ProtectRtp(buffers.data(), buffers.size());
+
+			for (size_t i{ 0u }; i < packets.size(); ++i)
+			{
+				REQUIRE(buffers[i].ok);
+				REQUIRE(buffers[i].len == originals[i].size() + SrtpAesGcm::TagLength);
+				REQUIRE(!DepLibSRTP::IsError(
+				  srtp_unprotect(libSrtpSession, packets[i].data(), &buffers[i].len)));
+				REQUIRE(buffers[i].len == originals[i].size());
+				REQUIRE(std::memcmp(packets[i].data(), originals[i].data(), buffers[i].len) == 0);
+			}
+
+			srtp_dealloc(libSrtpSession);
+		}
+	}
+
+	SECTION("RTCP packets are decrypted by libsrtp")
+	{
+		for (const size_t keyLen : { 16u, 32u })
+		{
+			SrtpAesGcm aesGcm(keyLen, masterKey);
+			auto* libSrtpSession = createLibSrtpSession(ssrc_any_inbound, keyLen);
+
+			for (size_t i{ 0u }; i < 5u; ++i)
+			{
+				const auto original = createRtcpPacket(0x01020304);
+				auto packet         = original;
+				size_t len          = packet.size();
+
+				packet.resize(len + SrtpAesGcm::TagLength + SrtpAesGcm::SrtcpTrailerLength);
+
+				REQUIRE(aesGcm.ProtectRtcp(packet.data(), &len));
+				REQUIRE(len == packet.size());
+				// E flag and SRTCP index.
+				REQUIRE(packet[len - 4] == 0x80);
+				REQUIRE(packet[len - 1] == static_cast<uint8_t>(i + 1));
+				REQUIRE(
+				  !DepLibSRTP::IsError(srtp_unprotect_rtcp(libSrtpSession, packet.data(), &len)));
+				REQUIRE(len == original.size());
+				REQUIRE(std::memcmp(packet.data(), original.data(), len) == 0);
+			}
+
+			srtp_dealloc(libSrtpSession);
+		}
+	}
+
+	SECTION("invalid packets are not protected")
+	{
+		SrtpAesGcm aesGcm(16u, masterKey);
+		uint8_t data[64]{ 0x90 };
+		size_t len{ 10u };
+
+		REQUIRE(!aesGcm.ProtectRtp(data, &len));
+		REQUIRE(len == 10u);
+
+		// Header extension beyond the packet.
+		len      = 16u;
+		data[14] = 0x00;
+		data[15] = 0x10;
+
+		REQUIRE(!aesGcm.ProtectRtp(data, &len));
+
+		len = 4u;
+
+		REQUIRE(!aesGcm.ProtectRtcp(data, &len));
+	}
+}
@@ -0,0 +1,94 @@
+#include "common.hpp"
+#include "RTC/SrtpSession.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring> // std::memcpy(), std::memcmp()
+#include <thread>
+#include <vector>
+
+using namespace RTC;
+
+// clang-format off
+static uint8_t key[] =
+{
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+	0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14,
+	0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e
+};
+// clang-format on
+
+static std::vector<uint8_t> createRtpPacket(uint16_t seq)
+{
+	// clang-format off
+	std::vector<uint8_t> packet =
+	{
+		0x80, 0x60, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x01,
+		0x11, 0x22, 0x33, 0x44
+	};
+	// clang-format on
+
+	packet[2] = static_cast<uint8_t>(seq >> 8);
+	packet[3] = static_cast<uint8_t>(seq);
+
+	for (uint8_t i{ 0u }; i < 100; ++i)
+	{
+		packet.push_back(i);
+	}
+
+	return packet;
+}
+
+SCENARIO("SrtpSession", "[rtc][srtp]")
+{
+	SrtpSession sendSession(
+	  SrtpSession::Type::OUTBOUND,
+	  SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_80,
+	  key,
+	  sizeof(key));
+	SrtpSession recvSession(
+	  SrtpSession::Type::INBOUND,
+	  SrtpSession::CryptoSuite::AES_CM_128_HMAC_SHA1_80,
+	  key,
+	  sizeof(key));
+
+	SECTION("packets protected in another thread are decrypted")
+	{
+		std::vector<std::vector<uint8_t>> packets;
+		std::vector<std::vector<uint8_t>> buffers;
+		std::vector<size_t> lens;
+
+		for (uint16_t seq{ 1u }; seq <= 10u; ++seq)
+		{
+			packets.push_back(createRtpPacket(seq));
+
+			const auto& packet = packets.back();
+
+			buffers.emplace_back(packet.size() + sendSession.GetRtpTrailerLength());
+			std::memcpy(buffers.back().data(), packet.data(), packet.size());
+			lens.push_back(packet.size());
+		}
+
+		std::vector<bool> protectedOk(buffers.size(), false);
+
+		// NOTE: Catch2 assertions are not thread safe.
+		std::thread thread(
+		  [&sendSession, &buffers, &lens, &protectedOk]()
+		  {
+			  for (size_t i{ 0u }; i < buffers.size(); ++i)
+			  {
+				  protectedOk[i] = sendSession.ProtectRtp(buffers[i].data(), &lens[i]);
+			  }
+		  });
+
+		thread.join();
+
+		for (size_t i{ 0u }; i < buffers.size(); ++i)
+		{
+			REQUIRE(protectedOk[i]);
+			REQUIRE(lens[i] == packets[i].size() + sendSession.GetRtpTrailerLength());
+			REQUIRE(recvSession.DecryptSrtp(buffers[i].data(), &lens[i]));
+			REQUIRE(lens[i] == packets[i].size());
+			REQUIRE(std::memcmp(buffers[i].data(), packets[i].data(), lens[i]) == 0);
+		}
+	}
+}
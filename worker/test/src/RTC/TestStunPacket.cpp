@@ -0,0 +1,128 @@
+#include "common.hpp"
+#include "Utils.hpp"
+#include "RTC/StunPacket.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring> // std::memcpy()
+#include <string>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <chrono>
+#include <iostream>
+#endif
+
+using namespace RTC;
+
+SCENARIO("STUN authentication", "[parser][stun]")
+{
+	static const uint8_t TransactionId[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+		                                       0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c };
+	static const std::string Password{ "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx" };
+
+	uint8_t buffer[1024];
+	uint8_t responseBuffer[1024];
+
+	// Build an ICE consent request (as a browser would send it) into buffer.
+	StunPacket request(
+	  StunPacket::Class::REQUEST, StunPacket::Method::BINDING, TransactionId, nullptr, 0);
+
+	request.SetUsername("local:remote", 12);
+	request.SetPriority(1853817087);
+	request.SetIceControlling(1234);
+	request.SetPassword(Password);
+	request.Serialize(buffer);
+
+	std::unique_ptr<StunPacket> packet{ StunPacket::Parse(buffer, request.GetSize()) };
+
+	if (!packet)
+	{
+		FAIL("not a STUN packet");
+	}
+
+	REQUIRE(packet->HasMessageIntegrity());
+	REQUIRE(packet->HasFingerprint());
+
+	EVP_MAC_CTX* hmacSha1Ctx = Utils::Crypto::CreateHmacSha1Ctx(Password);
+
+	SECTION("request is authenticated with password and with keyed HMAC context")
+	{
+		REQUIRE(packet->CheckAuthentication("local", Password) == StunPacket::Authentication::OK);
+		REQUIRE(packet->CheckAuthentication("local", hmacSha1Ctx) == StunPacket::Authentication::OK);
+		// Context can be reused.
+		REQUIRE(packet->CheckAuthentication("local", hmacSha1Ctx) == StunPacket::Authentication::OK);
+		REQUIRE(
+		  packet->CheckAuthentication("local", "yyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyy") ==
+		  StunPacket::Authentication::UNAUTHORIZED);
+		REQUIRE(
+		  packet->CheckAuthentication("other", hmacSha1Ctx) ==
+		  StunPacket::Authentication::UNAUTHORIZED);
+	}
+
+	SECTION("response serialized with keyed HMAC context matches the one with password")
+	{
+		std::unique_ptr<StunPacket> response1{ packet->CreateSuccessResponse() };
+		std::unique_ptr<StunPacket> response2{ packet->CreateSuccessResponse() };
+
+		response1->SetPassword(Password);
+		response1->Serialize(responseBuffer);
+
+		response2->SetHmacSha1Ctx(hmacSha1Ctx);
+		response2->Serialize(responseBuffer + 512);
+
+		REQUIRE(response1->GetSize() == response2->GetSize());
+		REQUIRE(std::memcmp(responseBuffer, responseBuffer + 512, response1->GetSize()) == 0);
+
+		std::unique_ptr<StunPacket> parsedResponse{ StunPacket::Parse(
+		  responseBuffer + 512, response2->GetSize()) };
+
+		REQUIRE(parsedResponse);
+		REQUIRE(parsedResponse->HasFingerprint());
+		REQUIRE(
+		  parsedResponse->CheckAuthentication("", hmacSha1Ctx) == StunPacket::Authentication::OK);
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		// ICE consent check fast path: authenticate the request and serialize a
+		// success response (MESSAGE-INTEGRITY and FINGERPRINT).
+		const size_t iterations{ 1000000u };
+		size_t ok{ 0u };
+
+		auto start = std::chrono::system_clock::now();
+
+		for (size_t i{ 0u }; i < iterations; ++i)
+		{
+			ok += packet->CheckAuthentication("local", Password) == StunPacket::Authentication::OK;
+
+			std::unique_ptr<StunPacket> response{ packet->CreateSuccessResponse() };
+
+			response->SetPassword(Password);
+			response->Serialize(responseBuffer);
+		}
+
+		std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+		std::cout << "password: \t\t" << dur.count() << " seconds" << std::endl;
+
+		start = std::chrono::system_clock::now();
+
+		for (size_t i{ 0u }; i < iterations; ++i)
+		{
+			ok -= packet->CheckAuthentication("local", hmacSha1Ctx) == StunPacket::Authentication::OK;
+
+			std::unique_ptr<StunPacket> response{ packet->CreateSuccessResponse() };
+
+			response->SetHmacSha1Ctx(hmacSha1Ctx);
+			response->Serialize(responseBuffer);
+		}
+
+		dur = std::chrono::system_clock::now() - start;
+		std::cout << "keyed HMAC context: \t" << dur.count() << " seconds" << std::endl;
+
+		REQUIRE(ok == 0u);
+	}
+#endif
+
+	Utils::Crypto::FreeHmacSha1Ctx(hmacSha1Ctx);
+}
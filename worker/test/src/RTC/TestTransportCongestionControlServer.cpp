@@ -2,6 +2,15 @@
 #include "DepLibUV.hpp"
 #include "RTC/TransportCongestionControlServer.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <random>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <chrono>
+#include <iostream>
+#endif
 
 using namespace RTC;
 
@@ -123,6 +132,266 @@ void validate(std::vector<TestTransportCongestionControlServerInput>& inputs, Te
 	listener.Check();
 };
 
+using SerializedFeedbacks = std::vector<std::vector<uint8_t>>;
+
+static void AppendSerializedFeedback(SerializedFeedbacks& feedbacks, RTCP::Packet* packet)
+{
+	auto* tccPacket = dynamic_cast<RTCP::FeedbackRtpTransportPacket*>(packet);
+
+	if (!tccPacket)
+	{
+		return;
+	}
+
+	std::vector<uint8_t> feedback(tccPacket->GetSize());
+
+	tccPacket->Serialize(feedback.data());
+	feedbacks.push_back(std::move(feedback));
+}
+
+class SerializingTransportCongestionControlServerListener
+  : public TransportCongestionControlServer::Listener
+{
+public:
+	void OnTransportCongestionControlServerSendRtcpPacket(
+	  RTC::TransportCongestionControlServer* /*tccServer*/, RTC::RTCP::Packet* packet) override
+	{
+		AppendSerializedFeedback(this->feedbacks, packet);
+	}
+
+public:
+	SerializedFeedbacks feedbacks;
+};
+
+// Previous arrival log of TransportCongestionControlServer (a std::map indexed
+// by wide seq number) and its feedback generation, used as reference.
+class MapTransportCcFeedbackGenerator
+{
+public:
+	explicit MapTransportCcFeedbackGenerator(size_t maxRtcpPacketLen)
+	  : maxRtcpPacketLen(maxRtcpPacketLen)
+	{
+		ResetTransportCcFeedback();
+	}
+
+public:
+	void IncomingPacket(uint64_t nowMs, uint16_t wideSeqNumber, uint32_t ssrc)
+	{
+		if (!this->mapPacketArrivalTimes.try_emplace(wideSeqNumber, nowMs).second)
+		{
+			return;
+		}
+
+		if (
+		  !this->transportWideSeqNumberReceived ||
+		  SeqManager<uint16_t>::IsSeqLowerThan(wideSeqNumber, this->transportCcFeedbackWideSeqNumStart))
+		{
+			this->transportCcFeedbackWideSeqNumStart = wideSeqNumber;
+		}
+
+		this->transportWideSeqNumberReceived = true;
+
+		if (nowMs >= 500u)
+		{
+			auto it = this->mapPacketArrivalTimes.begin();
+
+			while (it != this->mapPacketArrivalTimes.end() &&
+			       it->first != this->transportCcFeedbackWideSeqNumStart &&
+			       SeqManager<uint16_t>::IsSeqLowerThan(it->first, wideSeqNumber) &&
+			       it->second <= nowMs - 500u)
+			{
+				it = this->mapPacketArrivalTimes.erase(it);
+			}
+		}
+
+		this->transportCcFeedbackMediaSsrc = ssrc;
+	}
+
+	void FillAndSendTransportCcFeedback()
+	{
+		if (!this->transportWideSeqNumberReceived)
+		{
+			return;
+		}
+
+		auto it = this->mapPacketArrivalTimes.lower_bound(this->transportCcFeedbackWideSeqNumStart);
+
+		if (it == this->mapPacketArrivalTimes.end())
+		{
+			return;
+		}
+
+		for (; it != this->mapPacketArrivalTimes.end(); ++it)
+		{
+			if (!this->transportCcFeedbackPacket->IsBaseSet())
+			{
+				this->transportCcFeedbackPacket->SetBase(this->transportCcFeedbackWideSeqNumStart, it->second);
+			}
+
+			auto result =
+			  this->transportCcFeedbackPacket->AddPacket(it->first, it->second, this->maxRtcpPacketLen);
+
+			if (result != RTCP::FeedbackRtpTransportPacket::AddPacketResult::SUCCESS)
+			{
+				ResetTransportCcFeedback();
+			}
+			else if (this->transportCcFeedbackPacket->IsFull())
+			{
+				SendTransportCcFeedback();
+				ResetTransportCcFeedback();
+			}
+		}
+
+		SendTransportCcFeedback();
+		ResetTransportCcFeedback();
+	}
+
+private:
+	void SendTransportCcFeedback()
+	{
+		this->transportCcFeedbackPacket->Finish();
+
+		if (!this->transportCcFeedbackPacket->IsSerializable())
+		{
+			return;
+		}
+
+		AppendSerializedFeedback(this->feedbacks, this->transportCcFeedbackPacket.get());
+
+		++this->transportCcFeedbackPacketCount;
+		this->transportCcFeedbackWideSeqNumStart =
+		  this->transportCcFeedbackPacket->GetLatestSequenceNumber() + 1;
+	}
+
+	void ResetTransportCcFeedback()
+	{
+		this->transportCcFeedbackPacket.reset(
+		  new RTCP::FeedbackRtpTransportPacket(0u, this->transportCcFeedbackMediaSsrc));
+
+		this->transportCcFeedbackPacket->SetFeedbackPacketCount(this->transportCcFeedbackPacketCount);
+	}
+
+public:
+	SerializedFeedbacks feedbacks;
+
+private:
+	size_t maxRtcpPacketLen;
+	std::unique_ptr<RTCP::FeedbackRtpTransportPacket> transportCcFeedbackPacket;
+	uint8_t transportCcFeedbackPacketCount{ 0u };
+	uint32_t transportCcFeedbackMediaSsrc{ 0u };
+	bool transportWideSeqNumberReceived{ false };
+	uint16_t transportCcFeedbackWideSeqNumStart{ 0u };
+	std::map<uint16_t, uint64_t, SeqManager<uint16_t>::SeqLowerThan> mapPacketArrivalTimes;
+};
+
+// Synthetic arrival stream with loss, reordering and duplicates.
+static std::vector<TestTransportCongestionControlServerInput> CreateArrivalStream(
+  uint32_t seed, size_t numPackets)
+{
+	std::mt19937 rng(seed);
+	std::vector<TestTransportCongestionControlServerInput> inputs;
+	std::vector<uint16_t> delayed;
+	uint16_t wideSeqNumber = rng();
+	uint64_t nowUs         = 1000000u;
+
+	inputs.reserve(numPackets);
+
+	while (inputs.size() < numPackets)
+	{
+		// ~1000 packets per second.
+		nowUs += rng() % 2000u;
+
+		// Late arrival of reordered ones, a few packets later.
+		if (!delayed.empty() && rng() % 4u == 0u)
+		{
+			inputs.push_back({ delayed.front(), nowUs / 1000u });
+			delayed.erase(delayed.begin());
+
+			continue;
+		}
+
+		const uint32_t random = rng() % 100u;
+
+		// 5% loss.
+		if (random < 5u)
+		{
+			++wideSeqNumber;
+		}
+		// 5% reordered.
+		else if (random < 10u)
+		{
+			delayed.push_back(++wideSeqNumber);
+		}
+		// 1% duplicated.
+		else if (random < 11u)
+		{
+			inputs.push_back({ wideSeqNumber, nowUs / 1000u });
+		}
+		else
+		{
+			inputs.push_back({ ++wideSeqNumber, nowUs / 1000u });
+		}
+	}
+
+	return inputs;
+}
+
+// Feeds the arrival stream to a TransportCongestionControlServer and returns
+// the serialized feedback packets it generates.
+static SerializedFeedbacks GenerateFeedbacks(
+  std::vector<TestTransportCongestionControlServerInput>& inputs)
+{
+	SerializingTransportCongestionControlServerListener listener;
+	TransportCongestionControlServer tccServer(&listener, RTC::BweType::TRANSPORT_CC, RTC::MtuSize);
+
+	std::unique_ptr<RtpPacket> packet{ RtpPacket::Parse(buffer, sizeof(buffer)) };
+
+	packet->SetTransportWideCc01ExtensionId(5);
+
+	uint64_t lastFeedbackMs = inputs[0].nowMs;
+
+	for (auto& input : inputs)
+	{
+		if (input.nowMs - lastFeedbackMs >= 100u)
+		{
+			tccServer.FillAndSendTransportCcFeedback();
+			lastFeedbackMs = input.nowMs;
+		}
+
+		packet->UpdateTransportWideCc01(input.wideSeqNumber);
+		tccServer.IncomingPacket(input.nowMs, packet.get());
+	}
+
+	tccServer.FillAndSendTransportCcFeedback();
+
+	return std::move(listener.feedbacks);
+}
+
+// Same for the reference arrival log.
+static SerializedFeedbacks GenerateReferenceFeedbacks(
+  std::vector<TestTransportCongestionControlServerInput>& inputs)
+{
+	MapTransportCcFeedbackGenerator generator(RTC::MtuSize);
+
+	std::unique_ptr<RtpPacket> packet{ RtpPacket::Parse(buffer, sizeof(buffer)) };
+	uint64_t lastFeedbackMs = inputs[0].nowMs;
+
+	for (auto& input : inputs)
+	{
+		if (input.nowMs - lastFeedbackMs >= 100u)
+		{
+			generator.FillAndSendTransportCcFeedback();
+			lastFeedbackMs = input.nowMs;
+		}
+
+		generator.IncomingPacket(input.nowMs, input.wideSeqNumber, packet->GetSsrc());
+	}
+
+	generator.FillAndSendTransportCcFeedback();
+
+	return std::move(generator.feedbacks);
+}
+
 SCENARIO("TransportCongestionControlServer", "[rtp]")
 {
 	SECTION("normal time and sequence")
@@ -251,4 +520,41 @@ SCENARIO("TransportCongestionControlServer", "[rtp]")
 
 		validate(inputs, results);
 	}
+
+	SECTION("feedback matches the one of a std::map based arrival log")
+	{
+		for (uint32_t seed{ 0u }; seed < 20u; ++seed)
+		{
+			auto inputs = CreateArrivalStream(seed, 20000u);
+
+			auto feedbacks          = GenerateFeedbacks(inputs);
+			auto referenceFeedbacks = GenerateReferenceFeedbacks(inputs);
+
+			REQUIRE(!feedbacks.empty());
+			REQUIRE(feedbacks == referenceFeedbacks);
+		}
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		auto inputs = CreateArrivalStream(1234u, 5000000u);
+
+		auto start = std::chrono::system_clock::now();
+
+		auto feedbacks = GenerateFeedbacks(inputs);
+
+		std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+		std::cout << "ring arrival log: \t" << dur.count() << " seconds" << std::endl;
+
+		start = std::chrono::system_clock::now();
+
+		auto referenceFeedbacks = GenerateReferenceFeedbacks(inputs);
+
+		dur = std::chrono::system_clock::now() - start;
+		std::cout << "std::map arrival log: \t" << dur.count() << " seconds" << std::endl;
+
+		REQUIRE(feedbacks == referenceFeedbacks);
+	}
+#endif
 }
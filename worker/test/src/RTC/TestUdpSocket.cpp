@@ -0,0 +1,187 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/PortManager.hpp"
+#include "RTC/UdpSocket.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring> // std::memcpy()
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h> // close()
+#include <vector>
+
+class TestUdpSocketListener : public RTC::UdpSocket::Listener
+{
+public:
+	void OnUdpSocketPacketReceived(
+	  RTC::UdpSocket* socket,
+	  const uint8_t* /*data*/,
+	  size_t /*len*/,
+	  const struct sockaddr* /*remoteAddr*/) override
+	{
+		++this->received;
+		this->lastSocket = socket;
+
+		if (this->deleteOnReceive)
+		{
+			delete socket;
+		}
+	}
+
+public:
+	bool deleteOnReceive{ false };
+	size_t received{ 0u };
+	RTC::UdpSocket* lastSocket{ nullptr };
+};
+
+SCENARIO("UdpSocket", "[rtc][udpsocket]")
+{
+	std::string ip{ "127.0.0.1" };
+	RTC::Transport::SocketFlags flags;
+	TestUdpSocketListener listener;
+	const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+	REQUIRE(fd >= 0);
+
+	auto sendDatagrams = [fd](const RTC::UdpSocket* socket, size_t count)
+	{
+		const uint8_t data[4]{ 0 };
+
+		for (size_t i{ 0u }; i < count; ++i)
+		{
+			REQUIRE(
+			  sendto(fd, data, sizeof(data), 0, socket->GetLocalAddress(), sizeof(struct sockaddr_in)) ==
+			  sizeof(data));
+		}
+	};
+
+	SECTION("every datagram of a recvmmsg() batch is given to the listener")
+	{
+		auto* socket = new RTC::UdpSocket(std::addressof(listener), ip, 0, flags);
+
+		sendDatagrams(socket, 8u);
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(listener.received == 8u);
+		REQUIRE(socket->GetRecvBatches() == 1u);
+
+		delete socket;
+	}
+
+	SECTION("rest of the batch is dropped if the listener deletes the socket")
+	{
+		auto* socket = new RTC::UdpSocket(std::addressof(listener), ip, 0, flags);
+
+		listener.deleteOnReceive = true;
+
+		sendDatagrams(socket, 8u);
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(listener.received == 1u);
+	}
+
+#ifdef __linux__
+	SECTION("sharded sockets get STUN requests of their shard")
+	{
+		// Get a free port.
+		auto* socket    = new RTC::UdpSocket(std::addressof(listener), ip, 0, flags);
+		const auto port = socket->GetLocalPort();
+		struct sockaddr_in addr
+		{
+		};
+
+		std::memcpy(std::addressof(addr), socket->GetLocalAddress(), sizeof(addr));
+
+		delete socket;
+
+		std::vector<RTC::UdpSocket*> shards;
+
+		flags.udpShardingReusePort = true;
+		flags.udpShardingSteering  = true;
+
+		// NOTE: Created in index order, so the classic BPF fallback program
+		// (used without CAP_BPF) steers them too.
+		for (uint8_t shardIndex{ 0u }; shardIndex < 3u; ++shardIndex)
+		{
+			flags.udpShardIndex = shardIndex;
+
+			shards.push_back(new RTC::UdpSocket(std::addressof(listener), ip, port, flags));
+		}
+
+		auto sendStunRequest = [fd, &addr](char shardChar)
+		{
+			// clang-format off
+			uint8_t data[] =
+			{
+				0x00, 0x01, 0x00, 0x18, // Binding request, length 24
+				0x21, 0x12, 0xa4, 0x42, // Magic cookie
+				0x01, 0x02, 0x03, 0x04, // Transaction ID
+				0x05, 0x06, 0x07, 0x08,
+				0x09, 0x0a, 0x0b, 0x0c,
+				0x00, 0x24, 0x00, 0x04, // PRIORITY
+				0x6e, 0x7f, 0x00, 0xff,
+				0x00, 0x06, 0x00, 0x09, // USERNAME "Xabc:remo"
+				0x00, 0x61, 0x62, 0x63,
+				0x3a, 0x72, 0x65, 0x6d,
+				0x6f, 0x00, 0x00, 0x00
+			};
+			// clang-format on
+
+			data[32] = shardChar;
+
+			REQUIRE(
+			  sendto(
+			    fd, data, sizeof(data), 0, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) ==
+			  sizeof(data));
+
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		};
+
+		for (size_t i{ 0u }; i < 4u; ++i)
+		{
+			sendStunRequest('0');
+
+			REQUIRE(listener.lastSocket == shards[0]);
+
+			sendStunRequest('1');
+
+			REQUIRE(listener.lastSocket == shards[1]);
+
+			sendStunRequest('2');
+
+			REQUIRE(listener.lastSocket == shards[2]);
+		}
+
+		REQUIRE(listener.received == 12u);
+
+		// Closing a shard changes the position of others in the SO_REUSEPORT
+		// group, but not their key in the steering map of the eBPF program.
+		delete shards[1];
+
+		if (RTC::PortManager::HasUdpShardingProgram(ip, port))
+		{
+			for (size_t i{ 0u }; i < 4u; ++i)
+			{
+				sendStunRequest('0');
+
+				REQUIRE(listener.lastSocket == shards[0]);
+
+				sendStunRequest('2');
+
+				REQUIRE(listener.lastSocket == shards[2]);
+			}
+
+			REQUIRE(listener.received == 20u);
+		}
+
+		delete shards[0];
+		delete shards[2];
+	}
+#endif
+
+	close(fd);
+
+	// Let libuv close the handles.
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+}
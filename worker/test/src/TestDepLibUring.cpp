@@ -0,0 +1,241 @@
+#ifdef MS_LIBURING_SUPPORTED
+
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "DepLibUring.hpp"
+#include "MediaSoupErrors.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring> // std::memcpy()
+#include <memory>  // std::unique_ptr
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h> // close(), usleep()
+#include <vector>
+
+static std::unique_ptr<DepLibUring::LibUring> createLibUring()
+{
+	if (!DepLibUring::CheckRuntimeSupport())
+	{
+		return nullptr;
+	}
+
+	try
+	{
+		std::unique_ptr<DepLibUring::LibUring> liburing(new DepLibUring::LibUring());
+
+		liburing->StartPollingCQEs();
+
+		return liburing;
+	}
+	catch (const MediaSoupError& /*error*/)
+	{
+		return nullptr;
+	}
+}
+
+static void destroyLibUring(std::unique_ptr<DepLibUring::LibUring>& liburing)
+{
+	liburing->StopPollingCQEs();
+
+	// Let libuv close the poll handle.
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+	liburing.reset();
+}
+
+// Binds a UDP socket in 127.0.0.1 and fills its local address.
+static int bindUdp(struct sockaddr_in& addr)
+{
+	const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+	socklen_t addrLen{ sizeof(addr) };
+
+	REQUIRE(fd >= 0);
+
+	addr                 = {};
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	REQUIRE(bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0);
+	REQUIRE(getsockname(fd, reinterpret_cast<struct sockaddr*>(&addr), &addrLen) == 0);
+
+	return fd;
+}
+
+// Runs the loop until the given condition is met (or a while passes).
+template<typename T>
+static void runLoopUntil(T condition)
+{
+	for (size_t i{ 0u }; i < 1000u && !condition(); ++i)
+	{
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		if (!condition())
+		{
+			usleep(1000);
+		}
+	}
+}
+
+class TestRecvListener : public DepLibUring::RecvListener
+{
+	/* Pure virtual methods inherited from DepLibUring::RecvListener. */
+public:
+	void OnLibUringRecv(const DepLibUring::RecvData* recvs, size_t count) override
+	{
+		for (size_t i{ 0u }; i < count; ++i)
+		{
+			this->lens.push_back(recvs[i].len);
+		}
+	}
+
+	void OnLibUringRecvError(int err) override
+	{
+		this->errors.push_back(err);
+	}
+
+public:
+	std::vector<size_t> lens;
+	std::vector<int> errors;
+};
+
+SCENARIO("DepLibUring", "[liburing]")
+{
+	auto liburing = createLibUring();
+
+	if (!liburing)
+	{
+		SKIP("io_uring not available");
+	}
+
+	struct sockaddr_in recvAddr
+	{
+	};
+	struct sockaddr_in sendAddr
+	{
+	};
+	const int recvFd = bindUdp(recvAddr);
+	const int sendFd = bindUdp(sendAddr);
+
+	SECTION("zero copy sends in flight complete once after disabling zero copy")
+	{
+		if (!liburing->IsZeroCopyEnabled())
+		{
+			close(recvFd);
+			close(sendFd);
+			destroyLibUring(liburing);
+
+			SKIP("io_uring zero copy not available");
+		}
+
+		static constexpr size_t NumSends{ 32u };
+		const std::vector<uint8_t> data(100u, 0xAA);
+		std::vector<size_t> sentCounts(NumSends * 2, 0u);
+		std::vector<size_t> failedCounts(NumSends * 2, 0u);
+
+		auto prepareSend = [&](size_t i)
+		{
+			auto* cb = new DepLibUring::onSendCallback(
+			  [&sentCounts, &failedCounts, i](bool sent)
+			  {
+				  if (sent)
+				  {
+					  sentCounts[i]++;
+				  }
+				  else
+				  {
+					  failedCounts[i]++;
+				  }
+			  });
+
+			REQUIRE(liburing->PrepareSend(
+			  sendFd,
+			  data.data(),
+			  data.size(),
+			  reinterpret_cast<const struct sockaddr*>(&recvAddr),
+			  cb));
+		};
+
+		// Zero copy sends.
+		for (size_t i{ 0u }; i < NumSends; ++i)
+		{
+			prepareSend(i);
+		}
+
+		liburing->Submit();
+
+		// As if registering send buffers failed with zero copy sends in flight.
+		liburing->DisableZeroCopy();
+
+		REQUIRE(!liburing->IsZeroCopyEnabled());
+
+		// Regular sends.
+		for (size_t i{ NumSends }; i < NumSends * 2; ++i)
+		{
+			prepareSend(i);
+		}
+
+		liburing->Submit();
+
+		runLoopUntil(
+		  [liburing = liburing.get()]()
+		  { return liburing->GetAvailableSendBufferCount() >= liburing->GetSendBufferCount(); });
+
+		// Every send callback was called once.
+		for (size_t i{ 0u }; i < NumSends * 2; ++i)
+		{
+			REQUIRE(sentCounts[i] + failedCounts[i] == 1u);
+		}
+
+		// Every send buffer was released once.
+		REQUIRE(liburing->GetAvailableSendBufferCount() == liburing->GetSendBufferCount());
+	}
+
+	SECTION("datagrams bigger than a MTU are received")
+	{
+		TestRecvListener listener;
+		auto* request = liburing->StartRecv(recvFd, /*datagram*/ true, std::addressof(listener));
+
+		if (!request)
+		{
+			close(recvFd);
+			close(sendFd);
+			destroyLibUring(liburing);
+
+			SKIP("io_uring receive not available");
+		}
+
+		const std::vector<size_t> lens{ 100u, 4000u, 65000u, 200u };
+
+		for (auto len : lens)
+		{
+			const std::vector<uint8_t> data(len, 0xBB);
+
+			REQUIRE(
+			  sendto(
+			    sendFd,
+			    data.data(),
+			    data.size(),
+			    0,
+			    reinterpret_cast<const struct sockaddr*>(&recvAddr),
+			    sizeof(recvAddr)) == static_cast<ssize_t>(len));
+		}
+
+		runLoopUntil([&listener, &lens]() { return listener.lens.size() >= lens.size(); });
+
+		REQUIRE(listener.lens == lens);
+		REQUIRE(listener.errors.empty());
+
+		// NOTE: The request is released once canceled or when closing the ring.
+		liburing->StopRecv(request);
+	}
+
+	close(recvFd);
+	close(sendFd);
+
+	if (liburing)
+	{
+		destroyLibUring(liburing);
+	}
+}
+
+#endif
@@ -0,0 +1,70 @@
+#include "common.hpp"
+#include "Utils.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring> // std::memcmp(), std::strlen()
+#include <string>
+
+using namespace Utils;
+
+SCENARIO("Crypto::GetCRC32()")
+{
+	const char* data = "123456789";
+
+	REQUIRE(Crypto::GetCRC32(reinterpret_cast<const uint8_t*>(data), 9) == 0xcbf43926);
+	REQUIRE(Crypto::GetCRC32(reinterpret_cast<const uint8_t*>(data), 0) == 0x00000000);
+
+	// Compare with the byte-wise algorithm for every length (so all paths are
+	// covered).
+	uint8_t buffer[100];
+
+	for (size_t i{ 0 }; i < sizeof(buffer); ++i)
+	{
+		buffer[i] = static_cast<uint8_t>(i * 7 + 3);
+	}
+
+	for (size_t len{ 0 }; len <= sizeof(buffer); ++len)
+	{
+		uint32_t crc{ 0xFFFFFFFF };
+
+		for (size_t i{ 0 }; i < len; ++i)
+		{
+			crc ^= buffer[i];
+
+			for (int bit{ 0 }; bit < 8; ++bit)
+			{
+				crc = (crc & 1u) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+			}
+		}
+
+		REQUIRE(Crypto::GetCRC32(buffer, len) == (crc ^ ~0U));
+	}
+}
+
+SCENARIO("Crypto::GetHmacSha1()")
+{
+	// RFC 2202 test case 2.
+	const std::string key{ "Jefe" };
+	const char* data = "what do ya want for nothing?";
+	const uint8_t expected[] = { 0xef, 0xfc, 0xdf, 0x6a, 0xe5, 0xeb, 0x2f, 0xa2, 0xd2, 0x74,
+		                           0x16, 0xd5, 0xf1, 0x84, 0xdf, 0x9c, 0x25, 0x9a, 0x7c, 0x79 };
+
+	REQUIRE(
+	  std::memcmp(
+	    Crypto::GetHmacSha1(key, reinterpret_cast<const uint8_t*>(data), std::strlen(data)),
+	    expected,
+	    sizeof(expected)) == 0);
+
+	EVP_MAC_CTX* ctx = Crypto::CreateHmacSha1Ctx(key);
+
+	// Keyed context can be used many times.
+	for (int i{ 0 }; i < 3; ++i)
+	{
+		REQUIRE(
+		  std::memcmp(
+		    Crypto::GetHmacSha1(ctx, reinterpret_cast<const uint8_t*>(data), std::strlen(data)),
+		    expected,
+		    sizeof(expected)) == 0);
+	}
+
+	Crypto::FreeHmacSha1Ctx(ctx);
+}
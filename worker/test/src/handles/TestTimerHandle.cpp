@@ -0,0 +1,382 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "handles/TimerHandle.hpp"
+#include "handles/TimerWheel.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <random>
+#endif
+
+class TestTimerHandleListener : public TimerHandle::Listener
+{
+public:
+	using OnTimerFn = std::function<void(TimerHandle*)>;
+
+public:
+	explicit TestTimerHandleListener(OnTimerFn onTimerFn) : onTimerFn(std::move(onTimerFn))
+	{
+	}
+
+public:
+	void OnTimer(TimerHandle* timer) override
+	{
+		this->onTimerFn(timer);
+	}
+
+private:
+	OnTimerFn onTimerFn;
+};
+
+SCENARIO("TimerHandle", "[handles][timer]")
+{
+	SECTION("timers fire in order and not before their timeout")
+	{
+		struct Fired
+		{
+			uint64_t timeout;
+			uint64_t elapsedMs;
+		};
+
+		std::vector<Fired> fired;
+		// Timeouts covering level 0 and level 1 of the TimerWheel, and timers
+		// landing in the same slot.
+		const std::vector<uint64_t> timeouts{ 300, 0, 5, 255, 256, 20, 5, 700 };
+
+		// Timeouts are relative to the loop time (as with uv timers) so update it.
+		uv_update_time(DepLibUV::GetLoop());
+
+		const uint64_t startMs = DepLibUV::GetTimeMs();
+		std::vector<std::unique_ptr<TimerHandle>> timers;
+
+		TestTimerHandleListener listener(
+		  [&fired, startMs](TimerHandle* timer)
+		  {
+			  REQUIRE(timer->IsActive() == false);
+
+			  fired.push_back({ timer->GetTimeout(), DepLibUV::GetTimeMs() - startMs });
+		  });
+
+		for (auto timeout : timeouts)
+		{
+			timers.emplace_back(new TimerHandle(&listener));
+			timers.back()->Start(timeout);
+
+			REQUIRE(timers.back()->IsActive() == true);
+		}
+
+		REQUIRE(TimerWheel::GetInstance()->GetNumTimers() == timeouts.size());
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(fired.size() == timeouts.size());
+		REQUIRE(TimerWheel::GetInstance()->GetNumTimers() == 0);
+
+		for (size_t i{ 0 }; i < fired.size(); ++i)
+		{
+			REQUIRE(fired[i].elapsedMs >= fired[i].timeout);
+
+			if (i > 0)
+			{
+				REQUIRE(fired[i].timeout >= fired[i - 1].timeout);
+			}
+		}
+	}
+
+	SECTION("repeating timer can be stopped from its listener")
+	{
+		size_t count{ 0 };
+		std::unique_ptr<TimerHandle> longTimer;
+
+		TestTimerHandleListener listener(
+		  [&count, &longTimer](TimerHandle* timer)
+		  {
+			  REQUIRE(timer->IsActive() == true);
+
+			  if (++count == 5)
+			  {
+				  timer->Stop();
+
+				  // Also stop a timer far in the future so the loop ends.
+				  longTimer->Stop();
+			  }
+		  });
+
+		TestTimerHandleListener longListener([](TimerHandle* /*timer*/) { FAIL("must not fire"); });
+
+		TimerHandle timer(&listener);
+
+		longTimer.reset(new TimerHandle(&longListener));
+
+		timer.Start(2, 2);
+		// Goes into the last level of the TimerWheel.
+		longTimer->Start(100000000);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(count == 5);
+		REQUIRE(timer.IsActive() == false);
+		REQUIRE(longTimer->IsActive() == false);
+	}
+
+	SECTION("timers in the same slot can delete each other")
+	{
+		std::unique_ptr<TimerHandle> timer1;
+		std::unique_ptr<TimerHandle> timer2;
+		size_t count{ 0 };
+
+		TestTimerHandleListener listener(
+		  [&](TimerHandle* timer)
+		  {
+			  ++count;
+
+			  // Delete the other one and this one.
+			  if (timer == timer1.get())
+			  {
+				  timer2.reset();
+				  timer1.reset();
+			  }
+			  else
+			  {
+				  timer1.reset();
+				  timer2.reset();
+			  }
+		  });
+
+		timer1.reset(new TimerHandle(&listener));
+		timer2.reset(new TimerHandle(&listener));
+
+		timer1->Start(10);
+		timer2->Start(10);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(count == 1);
+		REQUIRE(TimerWheel::GetInstance()->GetNumTimers() == 0);
+	}
+
+	SECTION("restart, reset and restart from listener")
+	{
+		size_t count{ 0 };
+		uint64_t startMs{ 0 };
+		uint64_t firedAfterMs{ 0 };
+
+		TestTimerHandleListener listener(
+		  [&](TimerHandle* timer)
+		  {
+			  if (++count == 1)
+			  {
+				  startMs = DepLibUV::GetTimeMs();
+
+				  // Restart with a timeout landing in level 1.
+				  timer->Start(300);
+			  }
+			  else
+			  {
+				  firedAfterMs = DepLibUV::GetTimeMs() - startMs;
+			  }
+		  });
+
+		TimerHandle timer(&listener);
+
+		// Reset() has no effect if the timer is not repeating.
+		timer.Start(1000);
+		timer.Reset();
+
+		REQUIRE(timer.GetTimeout() == 1000);
+
+		// Restart() uses the same timeout.
+		timer.Start(10);
+		timer.Restart();
+
+		REQUIRE(timer.IsActive() == true);
+		REQUIRE(timer.GetTimeout() == 10);
+		REQUIRE(TimerWheel::GetInstance()->GetNumTimers() == 1);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(count == 2);
+		REQUIRE(firedAfterMs >= 300);
+	}
+
+	SECTION("restarting an active timer moves it without replacing the uv timer")
+	{
+		size_t count{ 0 };
+
+		TestTimerHandleListener listener([&count](TimerHandle* /*timer*/) { ++count; });
+
+		TimerHandle timer(&listener);
+
+		// Counts the handles of the loop, including closing ones.
+		auto countUvHandles = []()
+		{
+			size_t numHandles{ 0 };
+
+			uv_walk(
+			  DepLibUV::GetLoop(),
+			  [](uv_handle_t* /*handle*/, void* arg) { ++*static_cast<size_t*>(arg); },
+			  std::addressof(numHandles));
+
+			return numHandles;
+		};
+
+		timer.Start(20, 20);
+
+		const size_t numHandles = countUvHandles();
+
+		for (uint64_t timeout{ 1 }; timeout <= 50; ++timeout)
+		{
+			timer.Start(timeout * 10);
+			timer.Restart();
+		}
+
+		timer.Start(30, 30);
+		timer.Reset();
+
+		REQUIRE(countUvHandles() == numHandles);
+		REQUIRE(TimerWheel::GetInstance()->GetNumTimers() == 1);
+		REQUIRE(count == 0);
+
+		// Make it fire once with a timeout in level 0.
+		timer.Start(5);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(count == 1);
+		REQUIRE(timer.IsActive() == false);
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		// Compares the cost of running the loop with N repeating timers (each
+		// notification also restarts another random timer) using TimerHandle
+		// (TimerWheel) and using a uv timer per timer.
+		struct UvTimer
+		{
+			uv_timer_t handle;
+			uint64_t repeat;
+		};
+
+		static constexpr uint64_t RunMs{ 3000 };
+		static std::mt19937 rng(1);
+		static size_t numNotifications;
+		static std::vector<UvTimer*> uvTimers;
+
+		auto runLoopFor = [](uint64_t durationMs) -> double
+		{
+			uv_timer_t stopTimer;
+
+			uv_timer_init(DepLibUV::GetLoop(), &stopTimer);
+			uv_timer_start(&stopTimer, [](uv_timer_t* handle) { uv_stop(handle->loop); }, durationMs, 0);
+
+			const std::clock_t start = std::clock();
+
+			uv_run(DepLibUV::GetLoop(), UV_RUN_DEFAULT);
+
+			const std::clock_t end = std::clock();
+
+			uv_close(reinterpret_cast<uv_handle_t*>(&stopTimer), nullptr);
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+			return 1000.0 * static_cast<double>(end - start) / CLOCKS_PER_SEC;
+		};
+
+		for (const size_t numTimers : { 10000u, 50000u, 100000u })
+		{
+			std::uniform_int_distribution<uint64_t> repeatDist(10, 1000);
+
+			// TimerHandle.
+			{
+				std::vector<std::unique_ptr<TimerHandle>> timers;
+
+				TestTimerHandleListener listener(
+				  [&timers](TimerHandle* /*timer*/)
+				  {
+					  ++numNotifications;
+
+					  timers[rng() % timers.size()]->Restart();
+				  });
+
+				numNotifications = 0;
+				timers.reserve(numTimers);
+
+				for (size_t i{ 0 }; i < numTimers; ++i)
+				{
+					auto repeat = repeatDist(rng);
+
+					timers.emplace_back(new TimerHandle(&listener));
+					timers.back()->Start(repeat, repeat);
+				}
+
+				const double cpuMs = runLoopFor(RunMs);
+
+				std::cout << numTimers << " timers, TimerWheel: \t" << cpuMs << " ms CPU, "
+				          << numNotifications << " notifications, "
+				          << (1000000.0 * cpuMs / static_cast<double>(numNotifications))
+				          << " ns/notification" << std::endl;
+
+				timers.clear();
+			}
+
+			// uv timer per timer.
+			{
+				numNotifications = 0;
+				uvTimers.reserve(numTimers);
+
+				for (size_t i{ 0 }; i < numTimers; ++i)
+				{
+					auto* uvTimer   = new UvTimer();
+					uvTimer->repeat = repeatDist(rng);
+
+					uv_timer_init(DepLibUV::GetLoop(), &uvTimer->handle);
+					uv_timer_start(
+					  &uvTimer->handle,
+					  [](uv_timer_t* /*handle*/)
+					  {
+						  ++numNotifications;
+
+						  auto* other = uvTimers[rng() % uvTimers.size()];
+
+						  uv_timer_start(
+						    &other->handle, other->handle.timer_cb, other->repeat, other->repeat);
+					  },
+					  uvTimer->repeat,
+					  uvTimer->repeat);
+
+					uvTimers.push_back(uvTimer);
+				}
+
+				const double cpuMs = runLoopFor(RunMs);
+
+				std::cout << numTimers << " timers, uv timers: \t" << cpuMs << " ms CPU, "
+				          << numNotifications << " notifications, "
+				          << (1000000.0 * cpuMs / static_cast<double>(numNotifications))
+				          << " ns/notification" << std::endl;
+
+				for (auto* uvTimer : uvTimers)
+				{
+					uv_close(
+					  reinterpret_cast<uv_handle_t*>(&uvTimer->handle),
+					  [](uv_handle_t* handle) { delete reinterpret_cast<UvTimer*>(handle); });
+				}
+
+				uvTimers.clear();
+
+				uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+			}
+		}
+	}
+#endif
+
+	// Must run the loop to close the uv timer of the TimerWheel.
+	DepLibUV::RunLoop();
+}
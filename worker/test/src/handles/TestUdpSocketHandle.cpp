@@ -0,0 +1,267 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "handles/UdpSocketHandle.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring> // std::memcpy()
+#include <sys/socket.h>
+#include <unistd.h> // close()
+#include <vector>
+
+static uv_udp_t* bindUdp()
+{
+	auto* uvHandle = new uv_udp_t();
+	struct sockaddr_in addr
+	{
+	};
+
+	REQUIRE(uv_udp_init_ex(DepLibUV::GetLoop(), uvHandle, UV_UDP_RECVMMSG) == 0);
+	REQUIRE(uv_ip4_addr("127.0.0.1", 0, std::addressof(addr)) == 0);
+	REQUIRE(uv_udp_bind(uvHandle, reinterpret_cast<const struct sockaddr*>(&addr), 0) == 0);
+
+	return uvHandle;
+}
+
+class TestUdpSocket : public UdpSocketHandle
+{
+public:
+	explicit TestUdpSocket(uv_udp_t* uvHandle) : UdpSocketHandle(uvHandle)
+	{
+	}
+
+	/* Pure virtual methods inherited from UdpSocketHandle. */
+public:
+	void UserOnUdpDatagramsReceived(const std::vector<RecvDatagram>& datagrams) override
+	{
+		this->batchSizes.push_back(datagrams.size());
+
+		for (const auto& datagram : datagrams)
+		{
+			uint32_t value;
+
+			REQUIRE(datagram.len >= sizeof(value));
+
+			std::memcpy(std::addressof(value), datagram.data, sizeof(value));
+
+			this->values.push_back(value);
+			this->lens.push_back(datagram.len);
+		}
+	}
+
+public:
+	std::vector<size_t> batchSizes;
+	// First 4 bytes and length of every received datagram.
+	std::vector<uint32_t> values;
+	std::vector<size_t> lens;
+};
+
+// Sends the given number of datagrams (carrying their index) to the socket.
+static void sendDatagrams(int fd, const UdpSocketHandle& socket, uint32_t count)
+{
+	for (uint32_t value{ 0u }; value < count; ++value)
+	{
+		REQUIRE(
+		  sendto(
+		    fd,
+		    std::addressof(value),
+		    sizeof(value),
+		    0,
+		    socket.GetLocalAddress(),
+		    sizeof(struct sockaddr_in)) == sizeof(value));
+	}
+}
+
+#ifdef MS_SENDMMSG_SUPPORTED
+// Sends a datagram of the given length (carrying the given value) and counts
+// the result given to the send callback.
+static void sendDatagram(
+  UdpSocketHandle& socket,
+  const struct sockaddr* addr,
+  uint32_t value,
+  size_t len,
+  size_t& sentCount,
+  size_t& failedCount)
+{
+	std::vector<uint8_t> data(len, 0);
+
+	std::memcpy(data.data(), std::addressof(value), sizeof(value));
+
+	auto* cb = new UdpSocketHandle::onSendCallback(
+	  [&sentCount, &failedCount](bool sent)
+	  {
+		  if (sent)
+		  {
+			  ++sentCount;
+		  }
+		  else
+		  {
+			  ++failedCount;
+		  }
+	  });
+
+	socket.Send(data.data(), data.size(), addr, cb);
+}
+#endif
+
+SCENARIO("UdpSocketHandle", "[handles][udpsocket]")
+{
+	const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+	REQUIRE(fd >= 0);
+
+	SECTION("datagrams read by a single recvmmsg() are delivered as a batch")
+	{
+		TestUdpSocket socket(bindUdp());
+
+		sendDatagrams(fd, socket, 10u);
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(socket.batchSizes == std::vector<size_t>{ 10u });
+		REQUIRE(socket.GetRecvBatches() == 1u);
+		REQUIRE(socket.GetRecvBytes() == 10u * sizeof(uint32_t));
+
+		for (uint32_t value{ 0u }; value < 10u; ++value)
+		{
+			REQUIRE(socket.values[value] == value);
+		}
+	}
+
+	SECTION("datagrams exceeding the recvmmsg() width are split into batches in order")
+	{
+		TestUdpSocket socket(bindUdp());
+		const uint32_t count = UdpSocketHandle::RecvBatchSize * 2u + 3u;
+
+		sendDatagrams(fd, socket, count);
+
+		// NOTE: libuv reads up to 32 datagrams per loop iteration.
+		for (size_t i{ 0u }; i < 10u && socket.values.size() < count; ++i)
+		{
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		}
+
+		REQUIRE(socket.values.size() == count);
+		REQUIRE(socket.batchSizes.size() >= 3u);
+
+		for (const auto batchSize : socket.batchSizes)
+		{
+			REQUIRE(batchSize <= UdpSocketHandle::RecvBatchSize);
+		}
+
+		for (uint32_t value{ 0u }; value < count; ++value)
+		{
+			REQUIRE(socket.values[value] == value);
+		}
+	}
+
+#ifdef MS_SENDMMSG_SUPPORTED
+	SECTION("datagrams queued in a send batch are sent once flushed, coalesced by UDP GSO")
+	{
+		TestUdpSocket sender(bindUdp());
+		TestUdpSocket receiver(bindUdp());
+		size_t sentCount{ 0u };
+		size_t failedCount{ 0u };
+
+		UdpSocketHandle::StartSendBatch();
+
+		// Same destination and size, so they fit in a single GSO message. The
+		// last segment can be smaller.
+		for (uint32_t value{ 0u }; value < 9u; ++value)
+		{
+			sendDatagram(
+			  sender, receiver.GetLocalAddress(), value, value < 8u ? 1000u : 200u, sentCount, failedCount);
+		}
+
+		// Bigger than the segment size, so it starts a new message.
+		sendDatagram(sender, receiver.GetLocalAddress(), 9u, 1200u, sentCount, failedCount);
+
+		// Nothing is sent until the batch is flushed.
+		REQUIRE(sentCount == 0u);
+
+		UdpSocketHandle::FlushSendBatch();
+
+		REQUIRE(sentCount == 10u);
+		REQUIRE(failedCount == 0u);
+		REQUIRE(sender.GetSentBytes() == 8u * 1000u + 200u + 1200u);
+
+		for (size_t i{ 0u }; i < 10u && receiver.values.size() < 10u; ++i)
+		{
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		}
+
+		// GSO segments arrive as separate datagrams, in order.
+		REQUIRE(receiver.values.size() == 10u);
+
+		for (uint32_t value{ 0u }; value < 10u; ++value)
+		{
+			REQUIRE(receiver.values[value] == value);
+			REQUIRE(receiver.lens[value] == (value < 8u ? 1000u : value == 8u ? 200u : 1200u));
+		}
+	}
+
+	SECTION("datagrams failing within sendmmsg() fall back to per datagram sends")
+	{
+		TestUdpSocket sender(bindUdp());
+		TestUdpSocket receiver(bindUdp());
+		size_t sentCount{ 0u };
+		size_t failedCount{ 0u };
+		struct sockaddr_in6 ipv6Addr
+		{
+		};
+
+		// An IPv6 destination can't be used with an IPv4 socket, so sendmmsg()
+		// stops at it.
+		REQUIRE(uv_ip6_addr("::1", 1234, std::addressof(ipv6Addr)) == 0);
+
+		UdpSocketHandle::StartSendBatch();
+
+		sendDatagram(sender, receiver.GetLocalAddress(), 0u, 100u, sentCount, failedCount);
+		sendDatagram(
+		  sender,
+		  reinterpret_cast<const struct sockaddr*>(std::addressof(ipv6Addr)),
+		  1u,
+		  100u,
+		  sentCount,
+		  failedCount);
+		sendDatagram(sender, receiver.GetLocalAddress(), 2u, 100u, sentCount, failedCount);
+
+		UdpSocketHandle::FlushSendBatch();
+
+		// The failed one is given to libuv, which may report it asynchronously.
+		for (size_t i{ 0u }; i < 10u && (sentCount + failedCount < 3u || receiver.values.size() < 2u);
+		     ++i)
+		{
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		}
+
+		REQUIRE(sentCount == 2u);
+		REQUIRE(failedCount == 1u);
+		REQUIRE(receiver.values == std::vector<uint32_t>{ 0u, 2u });
+	}
+
+	SECTION("queued datagrams of a closed socket are dropped")
+	{
+		auto* sender = new TestUdpSocket(bindUdp());
+		TestUdpSocket receiver(bindUdp());
+		size_t sentCount{ 0u };
+		size_t failedCount{ 0u };
+
+		UdpSocketHandle::StartSendBatch();
+
+		sendDatagram(*sender, receiver.GetLocalAddress(), 0u, 100u, sentCount, failedCount);
+
+		delete sender;
+
+		REQUIRE(failedCount == 1u);
+
+		UdpSocketHandle::FlushSendBatch();
+
+		REQUIRE(sentCount == 0u);
+		REQUIRE(failedCount == 1u);
+	}
+#endif
+
+	close(fd);
+
+	// Let libuv close the handles.
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+}
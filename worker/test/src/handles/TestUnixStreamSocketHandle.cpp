@@ -0,0 +1,351 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "handles/UnixStreamSocketHandle.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring> // std::memcpy(), std::memmove()
+#include <sys/socket.h>
+#include <unistd.h> // close()
+#include <vector>
+
+// #define PERFORMANCE_TEST 1
+
+#ifdef PERFORMANCE_TEST
+#include <ctime>
+#include <iostream>
+#endif
+
+class TestProducerSocket : public UnixStreamSocketHandle
+{
+public:
+	explicit TestProducerSocket(int fd)
+	  : UnixStreamSocketHandle(fd, 65536, UnixStreamSocketHandle::Role::PRODUCER)
+	{
+	}
+
+public:
+	// Writes a length prefixed message whose payload starts with the given
+	// value.
+	void WriteMessage(uint64_t value, size_t payloadLen)
+	{
+		const uint32_t len = static_cast<uint32_t>(payloadLen);
+
+		this->message.resize(sizeof(len) + payloadLen);
+
+		std::memcpy(this->message.data(), &len, sizeof(len));
+		std::memcpy(this->message.data() + sizeof(len), &value, sizeof(value));
+
+		Write(this->message.data(), this->message.size());
+	}
+
+	/* Pure virtual methods inherited from UnixStreamSocketHandle. */
+public:
+	void UserOnUnixStreamRead() override
+	{
+	}
+	void UserOnUnixStreamSocketClosed() override
+	{
+	}
+
+private:
+	std::vector<uint8_t> message;
+};
+
+class TestConsumerSocket : public UnixStreamSocketHandle
+{
+public:
+	using OnMessageFn = void (*)(void* ctx, uint64_t value);
+
+public:
+	TestConsumerSocket(int fd, OnMessageFn onMessageFn, void* ctx)
+	  : UnixStreamSocketHandle(fd, 4194308, UnixStreamSocketHandle::Role::CONSUMER),
+	    onMessageFn(onMessageFn), ctx(ctx)
+	{
+	}
+
+	/* Pure virtual methods inherited from UnixStreamSocketHandle. */
+public:
+	void UserOnUnixStreamRead() override
+	{
+		size_t msgStart{ 0 };
+
+		++this->numReads;
+
+		while (!IsClosed())
+		{
+			const size_t readLen = this->bufferDataLen - msgStart;
+			uint32_t msgLen;
+
+			if (readLen < sizeof(msgLen))
+			{
+				break;
+			}
+
+			std::memcpy(&msgLen, this->buffer + msgStart, sizeof(msgLen));
+
+			if (readLen < sizeof(msgLen) + msgLen)
+			{
+				break;
+			}
+
+			uint64_t value;
+
+			std::memcpy(&value, this->buffer + msgStart + sizeof(msgLen), sizeof(value));
+
+			msgStart += sizeof(msgLen) + msgLen;
+
+			this->onMessageFn(this->ctx, value);
+		}
+
+		if (IsClosed())
+		{
+			return;
+		}
+
+		this->bufferDataLen -= msgStart;
+
+		if (this->bufferDataLen != 0)
+		{
+			std::memmove(this->buffer, this->buffer + msgStart, this->bufferDataLen);
+		}
+	}
+	void UserOnUnixStreamSocketClosed() override
+	{
+	}
+
+public:
+	size_t numReads{ 0 };
+
+private:
+	OnMessageFn onMessageFn{ nullptr };
+	void* ctx{ nullptr };
+};
+
+SCENARIO("UnixStreamSocketHandle", "[handles][unixstreamsocket]")
+{
+	struct Context
+	{
+		TestProducerSocket* producer{ nullptr };
+		TestConsumerSocket* consumer{ nullptr };
+		std::vector<uint64_t> received;
+		size_t expected{ 0 };
+	};
+
+	static auto onMessage = [](void* ctx, uint64_t value)
+	{
+		auto* context = static_cast<Context*>(ctx);
+
+		context->received.push_back(value);
+
+		if (context->received.size() == context->expected)
+		{
+			context->consumer->Close();
+			context->producer->Close();
+		}
+	};
+
+	auto test = [](bool writeCoalescing, size_t payloadLen)
+	{
+		int fds[2];
+
+		REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+		Context context;
+
+		context.producer = new TestProducerSocket(fds[0]);
+		context.consumer = new TestConsumerSocket(fds[1], onMessage, &context);
+		context.expected = 1000;
+
+		context.producer->SetWriteCoalescing(writeCoalescing);
+
+		for (uint64_t i{ 0 }; i < context.expected; ++i)
+		{
+			context.producer->WriteMessage(i, payloadLen);
+		}
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(context.received.size() == context.expected);
+
+		for (uint64_t i{ 0 }; i < context.expected; ++i)
+		{
+			REQUIRE(context.received[i] == i);
+		}
+
+		delete context.producer;
+		delete context.consumer;
+	};
+
+	SECTION("messages are received in order without write coalescing")
+	{
+		test(false, 100);
+	}
+
+	SECTION("messages are received in order with write coalescing")
+	{
+		test(true, 100);
+	}
+
+	SECTION("messages bigger than the coalescing limit are received in order")
+	{
+		test(true, 70000);
+	}
+
+	SECTION("coalesced data is written when closing the socket")
+	{
+		int fds[2];
+
+		REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+		Context context;
+
+		context.producer = new TestProducerSocket(fds[0]);
+		context.consumer = new TestConsumerSocket(fds[1], onMessage, &context);
+		context.expected = 11;
+
+		context.producer->SetWriteCoalescing(true);
+
+		for (uint64_t i{ 0 }; i < 10; ++i)
+		{
+			context.producer->WriteMessage(i, 8);
+		}
+
+		context.producer->Close();
+
+		DepLibUV::RunLoop();
+
+		// The consumer got everything but is still waiting for one more message.
+		REQUIRE(context.received.size() == 10);
+
+		delete context.producer;
+		delete context.consumer;
+	}
+
+	SECTION("coalesced data is written right away by Flush()")
+	{
+		int fds[2];
+
+		REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+		auto* producer = new TestProducerSocket(fds[0]);
+		uint8_t readBuffer[1024];
+
+		producer->SetWriteCoalescing(true);
+
+		for (uint64_t i{ 0 }; i < 10; ++i)
+		{
+			producer->WriteMessage(i, 8);
+		}
+
+		// Nothing written yet.
+		REQUIRE(recv(fds[1], readBuffer, sizeof(readBuffer), MSG_DONTWAIT) == -1);
+
+		producer->Flush();
+
+		// Without running the loop.
+		REQUIRE(recv(fds[1], readBuffer, sizeof(readBuffer), MSG_DONTWAIT) == 10 * (4 + 8));
+
+		delete producer;
+
+		DepLibUV::RunLoop();
+
+		close(fds[1]);
+	}
+
+#ifdef PERFORMANCE_TEST
+	SECTION("Performance")
+	{
+		// Writes bursts of messages (one burst per loop iteration) to the other
+		// end of a socketpair and measures CPU time and latency with and without
+		// write coalescing.
+		struct Bench
+		{
+			TestProducerSocket* producer{ nullptr };
+			TestConsumerSocket* consumer{ nullptr };
+			uv_idle_t idle;
+			size_t burst{ 0 };
+			size_t payloadLen{ 0 };
+			size_t total{ 0 };
+			size_t written{ 0 };
+			size_t received{ 0 };
+			uint64_t latencySumNs{ 0 };
+		};
+
+		static constexpr size_t NumMessages{ 500000 };
+
+		static auto onBenchMessage = [](void* ctx, uint64_t sentAtNs)
+		{
+			auto* bench = static_cast<Bench*>(ctx);
+
+			bench->latencySumNs += uv_hrtime() - sentAtNs;
+
+			if (++bench->received == bench->total)
+			{
+				bench->consumer->Close();
+				bench->producer->Close();
+			}
+		};
+
+		for (const bool writeCoalescing : { false, true })
+		{
+			for (const size_t burst : { 1u, 10u, 100u })
+			{
+				int fds[2];
+
+				REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+				Bench bench;
+
+				bench.producer   = new TestProducerSocket(fds[0]);
+				bench.consumer   = new TestConsumerSocket(fds[1], onBenchMessage, &bench);
+				bench.burst      = burst;
+				bench.payloadLen = 100;
+				bench.total      = NumMessages;
+				bench.idle.data  = &bench;
+
+				bench.producer->SetWriteCoalescing(writeCoalescing);
+
+				uv_idle_init(DepLibUV::GetLoop(), &bench.idle);
+				uv_idle_start(
+				  &bench.idle,
+				  [](uv_idle_t* handle)
+				  {
+					  auto* bench = static_cast<Bench*>(handle->data);
+
+					  for (size_t i{ 0 }; i < bench->burst && bench->written < bench->total; ++i)
+					  {
+						  bench->producer->WriteMessage(uv_hrtime(), bench->payloadLen);
+						  ++bench->written;
+					  }
+
+					  if (bench->written == bench->total)
+					  {
+						  uv_idle_stop(handle);
+					  }
+				  });
+
+				const std::clock_t start = std::clock();
+
+				DepLibUV::RunLoop();
+
+				const std::clock_t end = std::clock();
+
+				uv_close(reinterpret_cast<uv_handle_t*>(&bench.idle), nullptr);
+				DepLibUV::RunLoop();
+
+				REQUIRE(bench.received == NumMessages);
+
+				const double cpuMs = 1000.0 * static_cast<double>(end - start) / CLOCKS_PER_SEC;
+
+				std::cout << (writeCoalescing ? "coalesced" : "one write per message")
+				          << " [burst:" << burst << "]: " << cpuMs << " ms CPU, "
+				          << (1000000.0 * cpuMs / NumMessages) << " ns/message, avg latency "
+				          << (bench.latencySumNs / NumMessages / 1000) << " us, "
+				          << bench.consumer->numReads << " reads" << std::endl;
+
+				delete bench.producer;
+				delete bench.consumer;
+			}
+		}
+	}
+#endif
+}